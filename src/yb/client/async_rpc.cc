@@ -24,6 +24,7 @@
 
 #include "yb/util/cast.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 
 // TODO: do we need word Redis in following two metrics? ReadRpc and WriteRpc objects emitting
@@ -53,6 +54,13 @@ DEFINE_bool(forward_redis_requests, true, "If false, the redis op will not be se
             "part of the reply and ignores the rest. For now, if this flag is true, we will only "
             "attempt to read from leaders, so redis_allow_reads_from_followers will be ignored.");
 
+DEFINE_int32(redis_follower_read_max_staleness_ms, 0,
+             "If redis_allow_reads_from_followers is set, a follower serves a read only if its "
+             "safe time is at most this many milliseconds behind. Otherwise the read is retried "
+             "on another replica. Zero means no bound.");
+TAG_FLAG(redis_follower_read_max_staleness_ms, evolving);
+TAG_FLAG(redis_follower_read_max_staleness_ms, runtime);
+
 DEFINE_bool(detect_duplicates_for_retryable_requests, true,
             "Enable tracking of write requests that prevents the same write from being applied "
                 "twice.");
@@ -134,9 +142,8 @@ void AsyncRpc::SendRpc() {
   retained_self_ = shared_from_this();
   // For now, if this is a retry, execute this rpc on the leader even if
   // the consistency level is YBConsistencyLevel::CONSISTENT_PREFIX or
-  // FLAGS_redis_allow_reads_from_followers is set to true.
-  // TODO(hector): Temporarily blacklist the follower that couldn't serve the read so we can retry
-  // on another follower.
+  // FLAGS_redis_allow_reads_from_followers is set to true. Unless the previous replica rejected the
+  // read as too stale, then the invoker picks the next closest replica.
   tablet_invoker_.Execute(std::string(), num_attempts() > 1);
 }
 
@@ -156,6 +163,14 @@ const YBTable* AsyncRpc::table() const {
 void AsyncRpc::Finished(const Status& status) {
   Status new_status = status;
   if (tablet_invoker_.Done(&new_status)) {
+    if (tablet_invoker_.IsTabletSplit()) {
+      // Operations go back to the batcher, which sends them to the tablets that were created by
+      // the split.
+      SwapRequestsAndResponses(true /* skip_responses */);
+      batcher_->RetryAfterTabletSplit(ops_, new_status);
+      retained_self_.reset();
+      return;
+    }
     ProcessResponseFromTserver(new_status);
     batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, PropagatedHybridTime());
     batcher_->CheckForFinishedFlush();
@@ -164,6 +179,10 @@ void AsyncRpc::Finished(const Status& status) {
 }
 
 void AsyncRpc::Failed(const Status& status) {
+  if (tablet_invoker_.IsTabletSplit()) {
+    // Operations are retried on the tablets created by the split, see Finished.
+    return;
+  }
   std::string error_message = status.message().ToBuffer();
   auto redis_error_code = status.IsInvalidCommand() || status.IsInvalidArgument() ?
       RedisResponsePB_RedisStatusCode_PARSING_ERROR : RedisResponsePB_RedisStatusCode_SERVER_ERROR;
@@ -558,11 +577,25 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
   req_.set_consistency_level(yb_consistency_level);
   req_.set_proxy_uuid(data->batcher->proxy_uuid());
 
+  // The tightest staleness bound of the batched ops is used for the whole read.
+  MonoDelta max_staleness;
+  auto update_max_staleness = [&max_staleness](const MonoDelta& value) {
+    if (value.Initialized() && value > MonoDelta::kZero &&
+        (!max_staleness.Initialized() || value < max_staleness)) {
+      max_staleness = value;
+    }
+  };
+  const bool consistent_prefix = yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX;
+
   int ctr = 0;
   for (auto& op : ops_) {
     switch (op->yb_op->type()) {
       case YBOperation::Type::REDIS_READ: {
         CHECK_EQ(table()->table_type(), YBTableType::REDIS_TABLE_TYPE);
+        if (consistent_prefix) {
+          update_max_staleness(
+              MonoDelta::FromMilliseconds(FLAGS_redis_follower_read_max_staleness_ms));
+        }
         // Move Redis read request PB into tserver read request PB for performance. Will restore
         // in ProcessResponseFromTserver.
         auto* redis_op = down_cast<YBRedisReadOp*>(op->yb_op.get());
@@ -578,6 +611,9 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
         if (ql_op->read_time()) {
           ql_op->read_time().AddToPB(&req_);
         }
+        if (consistent_prefix) {
+          update_max_staleness(ql_op->follower_read_max_staleness());
+        }
         break;
       }
       case YBOperation::Type::PGSQL_READ: {
@@ -601,6 +637,9 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
     op->state = InFlightOpState::kRequestSent;
     VLOG(4) << ++ctr << ". Encoded row " << op->yb_op->ToString();
   }
+  if (max_staleness.Initialized()) {
+    req_.set_max_staleness_ms(max_staleness.ToMilliseconds());
+  }
 
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Created batch for " << data->tablet->tablet_id() << ":\n"
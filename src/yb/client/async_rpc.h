@@ -88,6 +88,10 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // Return latest hybrid time that was present on tserver during processing of this request.
   virtual HybridTime PropagatedHybridTime() = 0;
 
+  // Moves the requests of the operations into the RPC request and back, collecting the
+  // responses unless skip_responses is set.
+  virtual void SwapRequestsAndResponses(bool skip_responses) = 0;
+
   void Failed(const Status& status) override;
 
   // Is this a local call?
@@ -144,7 +148,7 @@ class WriteRpc : public AsyncRpcBase<tserver::WriteRequestPB, tserver::WriteResp
 
  private:
   void Finished(const Status& status) override;
-  void SwapRequestsAndResponses(bool skip_responses);
+  void SwapRequestsAndResponses(bool skip_responses) override;
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
 };
@@ -158,7 +162,7 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
 
  private:
   void Finished(const Status& status) override;
-  void SwapRequestsAndResponses(bool skip_responses);
+  void SwapRequestsAndResponses(bool skip_responses) override;
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
 };
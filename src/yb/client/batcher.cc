@@ -58,6 +58,9 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
@@ -68,6 +71,12 @@ DEFINE_bool(redis_allow_reads_from_followers, false,
 TAG_FLAG(redis_allow_reads_from_followers, evolving);
 TAG_FLAG(redis_allow_reads_from_followers, runtime);
 
+DEFINE_int32(tablet_split_retry_delay_ms, 100,
+             "Delay before looking up the tablets of operations that were sent to a tablet that "
+             "was split, so the master has a chance to make the new tablets visible.");
+TAG_FLAG(tablet_split_retry_delay_ms, advanced);
+TAG_FLAG(tablet_split_retry_delay_ms, runtime);
+
 using std::pair;
 using std::set;
 using std::unique_ptr;
@@ -611,6 +620,35 @@ void Batcher::RemoveInFlightOpsAfterFlushing(
   }
 }
 
+void Batcher::RetryAfterTabletSplit(const InFlightOps& ops, const Status& status) {
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    for (const auto& op : ops) {
+      std::lock_guard<simple_spinlock> l2(op->lock_);
+      op->state = InFlightOpState::kLookingUpTablet;
+      op->tablet.reset();
+    }
+    outstanding_lookups_ += ops.size();
+  }
+
+  BatcherPtr self(this);
+  client_->messenger()->scheduler().Schedule(
+      [self, ops, status](const Status& schedule_status) {
+    for (const auto& op : ops) {
+      if (!schedule_status.ok()) {
+        self->TabletLookupFinished(op, schedule_status);
+      } else if (op->yb_op->tablet()) {
+        // Operation was addressed to the split tablet explicitly.
+        self->TabletLookupFinished(op, status);
+      } else {
+        self->client_->data_->meta_cache_->LookupTabletByKey(
+            op->yb_op->table(), op->partition_key, self->deadline_,
+            std::bind(&Batcher::TabletLookupFinished, self, op, _1));
+      }
+    }
+  }, std::chrono::milliseconds(FLAGS_tablet_split_retry_delay_ms));
+}
+
 void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const Status &s) {
   // TODO: there is a potential race here -- if the Batcher gets destructed while
   // RPCs are in-flight, then accessing state_ will crash. We probably need to keep
@@ -187,6 +187,10 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   void RemoveInFlightOpsAfterFlushing(
       const InFlightOps& ops, const Status& status, HybridTime propagated_hybrid_time);
 
+  // Looks up the tablets of the operations again after their tablet was split, and sends them
+  // once all lookups are finished.
+  void RetryAfterTabletSplit(const InFlightOps& ops, const Status& status);
+
     // Return true if the batch has been aborted, and any in-flight ops should stop
   // processing wherever they are.
   bool IsAbortedUnlocked() const;
@@ -645,7 +645,13 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
           remote = new RemoteTablet(tablet_id, partition);
 
           CHECK(tablets_by_id_.emplace(tablet_id, remote).second);
-          CHECK(tablets_by_key.emplace(partition.partition_key_start(), remote).second);
+          // Tablet that was split is replaced by its child with the same start key.
+          auto& tablet_by_key = tablets_by_key[partition.partition_key_start()];
+          if (tablet_by_key) {
+            VLOG(1) << "Replacing tablet " << tablet_by_key->tablet_id() << " with " << tablet_id;
+            tablet_by_key->MarkStale();
+          }
+          tablet_by_key = remote;
         }
         remote->Refresh(ts_cache_, loc.replicas());
 
@@ -654,23 +660,44 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
           first = false;
         }
 
-        if (partition_group_start) {
-          auto lookup_by_group_iter =
-              table_data.tablet_lookups_by_group.find(*partition_group_start);
-          if (lookup_by_group_iter != table_data.tablet_lookups_by_group.end()) {
-            auto& lookups_by_partition_key = lookup_by_group_iter->second;
-            auto lookups_iter =
-                lookups_by_partition_key.find(loc.partition().partition_key_start());
-            if (lookups_iter != lookups_by_partition_key.end()) {
-              for (auto& lookup : lookups_iter->second) {
-                to_notify.emplace_back(std::move(lookup.callback), remote);
+      }
+    }
+
+    if (partition_group_start && !locations.empty()) {
+      for (const auto& table_id : locations.Get(0).table_ids()) {
+        auto& table_data = tables_[table_id];
+        auto lookup_by_group_iter =
+            table_data.tablet_lookups_by_group.find(*partition_group_start);
+        if (lookup_by_group_iter == table_data.tablet_lookups_by_group.end()) {
+          continue;
+        }
+        // Lookups are resolved by the tablet that contains their key, the partition starts the
+        // lookups were grouped by could be outdated by tablet splits.
+        auto& lookups_by_partition_key = lookup_by_group_iter->second;
+        for (auto lookups_iter = lookups_by_partition_key.begin();
+             lookups_iter != lookups_by_partition_key.end();) {
+          auto& lookups = lookups_iter->second;
+          auto w = lookups.begin();
+          for (auto i = lookups.begin(); i != lookups.end(); ++i) {
+            auto tablet = FindTabletUnlocked(table_data.tablets_by_partition, i->partition_key);
+            if (tablet) {
+              to_notify.emplace_back(std::move(i->callback), tablet);
+            } else {
+              if (i != w) {
+                *w = std::move(*i);
               }
-              lookups_by_partition_key.erase(lookups_iter);
-            }
-            if (lookups_by_partition_key.empty()) {
-              table_data.tablet_lookups_by_group.erase(lookup_by_group_iter);
+              ++w;
             }
           }
+          lookups.erase(w, lookups.end());
+          if (lookups.empty()) {
+            lookups_iter = lookups_by_partition_key.erase(lookups_iter);
+          } else {
+            ++lookups_iter;
+          }
+        }
+        if (lookups_by_partition_key.empty()) {
+          table_data.tablet_lookups_by_group.erase(lookup_by_group_iter);
         }
       }
     }
@@ -750,6 +777,39 @@ void MetaCache::LookupFailed(
   }
 }
 
+void MetaCache::ContinueLookups(const YBTable* table, const std::string& partition_group_start) {
+  std::string partition_key_start;
+  MonoTime max_deadline;
+  {
+    std::lock_guard<decltype(mutex_)> l(mutex_);
+    auto it = tables_.find(table->id());
+    if (it == tables_.end()) {
+      return;
+    }
+
+    auto gi = it->second.tablet_lookups_by_group.find(partition_group_start);
+    if (gi == it->second.tablet_lookups_by_group.end()) {
+      return;
+    }
+    bool first = true;
+    for (const auto& pair : gi->second) {
+      for (const auto& data : pair.second) {
+        if (first || data.partition_key < partition_key_start) {
+          partition_key_start = data.partition_key;
+          first = false;
+        }
+        max_deadline.MakeAtLeast(data.deadline);
+      }
+    }
+  }
+
+  VLOG(1) << "Continue lookup for table " << table->id() << " from partition "
+          << Slice(partition_key_start).ToDebugHexString();
+  rpc::StartRpc<LookupByKeyRpc>(
+      this, table, partition_group_start, max_deadline, client_->data_->messenger_,
+      client_->data_->proxy_cache_.get(), partition_key_start);
+}
+
 class LookupByIdRpc : public LookupRpc {
  public:
   LookupByIdRpc(const scoped_refptr<MetaCache>& meta_cache,
@@ -811,17 +871,20 @@ class LookupByKeyRpc : public LookupRpc {
                  MetaCache::PartitionGroupKey partition_group_start,
                  const MonoTime& deadline,
                  const shared_ptr<Messenger>& messenger,
-                 rpc::ProxyCache* proxy_cache)
+                 rpc::ProxyCache* proxy_cache,
+                 std::string partition_key_start = std::string())
       : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
         table_(table->shared_from_this()),
-        partition_group_start_(std::move(partition_group_start)) {
+        partition_group_start_(std::move(partition_group_start)),
+        partition_key_start_(partition_key_start.empty() ? partition_group_start_
+                                                         : std::move(partition_key_start)) {
   }
 
   std::string ToString() const override {
     return Format("GetTableLocations($0, $1, $2)",
                   table_->name(),
                   table_->partition_schema()
-                      .PartitionKeyDebugString(partition_group_start_,
+                      .PartitionKeyDebugString(partition_key_start_,
                                                internal::GetSchema(table_->schema())),
                   num_attempts());
   }
@@ -832,7 +895,7 @@ class LookupByKeyRpc : public LookupRpc {
   void DoSendRpc() override {
     // Fill out the request.
     req_.mutable_table()->set_table_id(table_->id());
-    req_.set_partition_key_start(partition_group_start_);
+    req_.set_partition_key_start(partition_key_start_);
     req_.set_max_returned_locations(kPartitionGroupSize);
 
     // The end partition key is left unset intentionally so that we'll prefetch
@@ -849,7 +912,9 @@ class LookupByKeyRpc : public LookupRpc {
 
   void Notify(const Status& status, const RemoteTabletPtr& result) override {
     if (status.ok()) {
-      return; // This case is handled by LookupTabletByKeyFastPathUnlocked.
+      // Resolved lookups were notified by ProcessTabletLocations.
+      meta_cache()->ContinueLookups(table_.get(), partition_group_start_);
+      return;
     }
     meta_cache()->LookupFailed(table_.get(), partition_group_start_, status);
   }
@@ -860,6 +925,10 @@ class LookupByKeyRpc : public LookupRpc {
   // Encoded partition key to lookup.
   MetaCache::PartitionGroupKey partition_group_start_;
 
+  // Encoded partition key the master returns the tablets from. Differs from the group start
+  // when the lookups of the group were not resolved by the first response.
+  std::string partition_key_start_;
+
   // Request body.
   GetTableLocationsRequestPB req_;
 
@@ -875,12 +944,18 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
     return nullptr;
   }
 
-  DCHECK_EQ(partition_key, table->FindPartitionStart(partition_key));
-  auto tablet_it = it->second.tablets_by_partition.find(partition_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
+  return FindTabletUnlocked(it->second.tablets_by_partition, partition_key);
+}
+
+RemoteTabletPtr MetaCache::FindTabletUnlocked(
+    const std::map<std::string, RemoteTabletPtr>& tablets_by_partition,
+    const std::string& partition_key) {
+  auto tablet_it = tablets_by_partition.upper_bound(partition_key);
+  if (PREDICT_FALSE(tablet_it == tablets_by_partition.begin())) {
     // No tablets with a start partition key lower than 'partition_key'.
     return nullptr;
   }
+  --tablet_it;
 
   const auto& result = tablet_it->second;
 
@@ -901,11 +976,11 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
 template <class Lock>
 bool MetaCache::FastLookupTabletByKeyUnlocked(
     const YBTable* table,
-    const std::string& partition_start,
+    const std::string& partition_key,
     const LookupTabletCallback& callback,
     Lock* lock) {
   // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table, partition_start);
+  auto result = LookupTabletByKeyFastPathUnlocked(table, partition_key);
   if (result && result->HasLeader()) {
     lock->unlock();
     VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
@@ -925,7 +1000,7 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
   rpc::Rpcs::Handle rpc;
   {
     boost::shared_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
+    if (FastLookupTabletByKeyUnlocked(table, partition_key, callback, &lock)) {
       return;
     }
   }
@@ -934,14 +1009,14 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
       table->FindPartitionStart(partition_start, kPartitionGroupSize);
   {
     std::unique_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
+    if (FastLookupTabletByKeyUnlocked(table, partition_key, callback, &lock)) {
       return;
     }
 
     auto& table_data = tables_[table->id()];
     auto& lookup = table_data.tablet_lookups_by_group[partition_group_start];
     bool was_empty = lookup.empty();
-    lookup[partition_start].push_back({std::move(callback), deadline});
+    lookup[partition_start].push_back({std::move(callback), deadline, partition_key});
     if (!was_empty) {
       return;
     }
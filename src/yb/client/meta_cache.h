@@ -368,6 +368,13 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(const YBTable* table,
                                                     const std::string& partition_key);
 
+  // Returns the cached tablet that contains partition_key, if it is not stale.
+  // Tablets could be split after the table partitions were fetched, so the lookup is done by
+  // the key itself instead of by the partition start.
+  static RemoteTabletPtr FindTabletUnlocked(
+      const std::map<std::string, RemoteTabletPtr>& tablets_by_partition,
+      const std::string& partition_key);
+
   RemoteTabletPtr LookupTabletByIdFastPath(const TabletId& tablet_id);
 
   // Update our information about the given tablet server.
@@ -383,10 +390,15 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   void LookupFailed(
       const YBTable* table, const std::string& partition_group_start, const Status& status);
 
+  // Restarts the lookup of specified partition group if some lookups were not resolved by
+  // the master response, i.e. the partition group contains more tablets than expected because
+  // of tablet splits.
+  void ContinueLookups(const YBTable* table, const std::string& partition_group_start);
+
   template <class Lock>
   bool FastLookupTabletByKeyUnlocked(
       const YBTable* table,
-      const std::string& partition_start,
+      const std::string& partition_key,
       const LookupTabletCallback& callback,
       Lock* lock);
 
@@ -412,9 +424,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   struct LookupData {
     LookupTabletCallback callback;
     MonoTime deadline;
+    std::string partition_key;
 
     std::string ToString() const {
-      return Format("{ deadline: $1 }", deadline);
+      return Format("{ deadline: $0 partition_key: $1 }",
+                    deadline, Slice(partition_key).ToDebugHexString());
     }
   };
 
@@ -423,7 +437,8 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   typedef std::string PartitionGroupKey;
 
   struct TableData {
-    std::unordered_map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+    // Ordered, so the tablet that contains a key could be found after tablet splits.
+    std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
     std::unordered_map<PartitionGroupKey, PartitionToLookupData> tablet_lookups_by_group;
   };
 
@@ -24,6 +24,7 @@
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/docdb/consensus_frontier.h"
 
@@ -33,6 +34,8 @@
 #include "yb/master/master.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/tablet/tablet_peer.h"
 
 #include "yb/server/skewed_clock.h"
 
@@ -53,6 +56,10 @@ DECLARE_string(time_source);
 DECLARE_int32(TEST_delay_execute_async_ms);
 DECLARE_int64(retryable_rpc_single_call_timeout_ms);
 DECLARE_int32(retryable_request_timeout_secs);
+DECLARE_bool(propagate_safe_time);
+DECLARE_int32(raft_quiescence_idle_ms);
+
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
 
 namespace yb {
 namespace client {
@@ -660,6 +667,110 @@ TEST_F(QLTabletTest, SkewedClocks) {
   cluster_.reset();
 }
 
+TEST_F(QLTabletTest, FollowerReadsWithBoundedStaleness) {
+  constexpr int kNumKeys = 20;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  FillTable(0, kNumKeys, &table);
+
+  auto read_all = [this, &table](MonoDelta max_staleness) {
+    auto session = CreateSession();
+    for (int i = 0; i != kNumKeys; ++i) {
+      auto op = CreateReadOp(i, &table);
+      op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      op->set_follower_read_max_staleness(max_staleness);
+      ASSERT_OK(session->ApplyAndFlush(op));
+      ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, op->response().status());
+      auto rowblock = RowsResult(op.get()).GetRowBlock();
+      ASSERT_EQ(1, rowblock->row_count());
+      ASSERT_EQ(ValueForKey(i), rowblock->row(0).column(0).int32_value());
+    }
+  };
+
+  // Read RPCs received by a tablet server, including the rejected ones, and reads it served.
+  struct ReadCounts {
+    int64_t rpcs = 0;
+    int64_t served = 0;
+  };
+  struct Replica {
+    tserver::TabletServer* server;
+    std::shared_ptr<tablet::TabletPeer> peer;
+
+    ReadCounts counts() const {
+      return ReadCounts {
+        METRIC_handler_latency_yb_tserver_TabletServerService_Read.Instantiate(
+            server->metric_entity())->TotalCount(),
+        peer->tablet()->metrics()->ql_read_latency->TotalCount()
+      };
+    }
+  };
+
+  boost::optional<Replica> leader;
+  std::vector<Replica> followers;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto server = cluster_->mini_tablet_server(i)->server();
+    for (const auto& peer : server->tablet_manager()->GetTabletPeers()) {
+      if (peer->tablet_metadata()->table_id() != table.table()->id()) {
+        continue;
+      }
+      Replica replica{server, peer};
+      if (peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY) {
+        leader = replica;
+      } else {
+        followers.push_back(replica);
+      }
+    }
+  }
+  ASSERT_TRUE(leader);
+  ASSERT_EQ(2, followers.size());
+
+  // The client picks a random replica, so with a loose bound some of the reads reach followers.
+  ASSERT_NO_FATALS(read_all(MonoDelta()));
+  auto leader_before = leader->counts();
+  ASSERT_NO_FATALS(read_all(10s));
+  ASSERT_LT(leader->counts().served - leader_before.served, kNumKeys);
+
+  // A follower that does not get updates from the leader falls behind the bound. It rejects
+  // reads, and every read is rejected by it at most once because the client blacklists it for
+  // that read.
+  constexpr auto kMaxStaleness = 3s;
+  auto* paused_consensus = down_cast<consensus::RaftConsensus*>(followers[0].peer->consensus());
+  paused_consensus->TEST_RejectMode(consensus::RejectMode::kAll);
+  std::this_thread::sleep_for(kMaxStaleness * 2);
+
+  auto paused_before = followers[0].counts();
+  ASSERT_NO_FATALS(read_all(kMaxStaleness));
+  auto paused_after = followers[0].counts();
+  ASSERT_EQ(paused_before.served, paused_after.served);
+  ASSERT_GT(paused_after.rpcs, paused_before.rpcs);
+  ASSERT_LE(paused_after.rpcs - paused_before.rpcs, kNumKeys);
+
+  // Without propagation the safe time of the other follower stays at the last replicated write,
+  // while it keeps acknowledging the leader. With both followers behind the bound every read
+  // falls back to the leader.
+  FLAGS_propagate_safe_time = false;
+  std::this_thread::sleep_for(kMaxStaleness * 2);
+
+  leader_before = leader->counts();
+  std::vector<ReadCounts> followers_before;
+  for (const auto& follower : followers) {
+    followers_before.push_back(follower.counts());
+  }
+  ASSERT_NO_FATALS(read_all(kMaxStaleness));
+  ASSERT_EQ(leader_before.served + kNumKeys, leader->counts().served);
+  int64_t rejected = 0;
+  for (size_t i = 0; i != followers.size(); ++i) {
+    auto counts = followers[i].counts();
+    ASSERT_EQ(followers_before[i].served, counts.served);
+    ASSERT_LE(counts.rpcs - followers_before[i].rpcs, kNumKeys);
+    rejected += counts.rpcs - followers_before[i].rpcs;
+  }
+  ASSERT_GT(rejected, 0);
+
+  paused_consensus->TEST_RejectMode(consensus::RejectMode::kNone);
+}
+
 TEST_F(QLTabletTest, LeaderChange) {
   const int32_t kKey = 1;
   const int32_t kValue1 = 2;
@@ -750,6 +861,76 @@ TEST_F(QLTabletTest, LeaderChange) {
   ASSERT_EQ(GetValue(session, kKey, &table), kValue3);
 }
 
+TEST_F(QLTabletTest, RaftQuiescence) {
+  FLAGS_raft_quiescence_idle_ms = 1000;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  FillTable(0, 10, &table);
+
+  auto count_quiescent_followers = [this] {
+    int result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto server = cluster_->mini_tablet_server(i)->server();
+      for (const auto& peer : server->tablet_manager()->GetTabletPeers()) {
+        auto* consensus = down_cast<consensus::RaftConsensus*>(peer->consensus());
+        if (consensus && consensus->IsQuiescentFollower()) {
+          ++result;
+        }
+      }
+    }
+    return result;
+  };
+  auto wait_quiescent_followers = [&count_quiescent_followers](int expected) {
+    return WaitFor([&count_quiescent_followers, expected] {
+      return count_quiescent_followers() == expected;
+    }, 30s, Format("$0 quiescent followers", expected));
+  };
+
+  // Both followers of the idle tablet stop their failure detectors.
+  ASSERT_OK(wait_quiescent_followers(2));
+
+  // A write wakes them up.
+  auto session = CreateSession();
+  SetValue(session, 10, ValueForKey(10), &table);
+  ASSERT_OK(wait_quiescent_followers(0));
+  ASSERT_OK(wait_quiescent_followers(2));
+
+  // Step down the leader replica while its server keeps sending keep-alives. The followers see
+  // that the keep-alives no longer list the tablet, wake up and elect a new leader.
+  tablet::TabletPeerPtr leader;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    for (const auto& peer : cluster_->mini_tablet_server(i)->server()->tablet_manager()
+                                ->GetTabletPeers()) {
+      if (peer->LeaderStatus() != consensus::LeaderStatus::NOT_LEADER) {
+        leader = peer;
+      }
+    }
+  }
+  ASSERT_NE(leader, nullptr);
+  const auto old_term = leader->LeaderTerm();
+  consensus::LeaderStepDownRequestPB req;
+  req.set_tablet_id(leader->tablet_id());
+  consensus::LeaderStepDownResponsePB resp;
+  ASSERT_OK(leader->consensus()->StepDown(&req, &resp));
+  ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+
+  ASSERT_OK(WaitFor([this, old_term] {
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      for (const auto& peer : cluster_->mini_tablet_server(i)->server()->tablet_manager()
+                                  ->GetTabletPeers()) {
+        if (peer->LeaderTerm() > old_term) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }, 30s, "New leader elected"));
+
+  SetValue(session, 11, ValueForKey(11), &table);
+  ASSERT_EQ(ValueForKey(11), GetValue(session, 11, &table));
+}
+
 void QLTabletTest::TestDeletePartialKey(int num_range_keys_in_delete) {
   YBSchemaBuilder builder;
   builder.AddColumn(kKeyColumn)->Type(INT32)->HashPrimaryKey()->NotNull();
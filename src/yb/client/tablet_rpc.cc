@@ -58,8 +58,12 @@ TabletInvoker::~TabletInvoker() {}
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   std::vector<RemoteTabletServer*> candidates;
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              stale_followers_, &candidates);
+  if (!current_ts_) {
+    // Every replica was too stale, the leader is always up to date.
+    SelectTabletServer();
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -141,7 +145,7 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
   // Sets current_ts_.
   if (local_tserver_only_) {
     SelectLocalTabletServer();
-  } else if (consistent_prefix_ && !leader_only) {
+  } else if (consistent_prefix_ && (!leader_only || !stale_followers_.empty())) {
     SelectTabletServerWithConsistentPrefix();
   } else {
     SelectTabletServer();
@@ -200,8 +204,12 @@ void TabletInvoker::FailToNewReplica(const Status& reason,
                                      const tserver::TabletServerErrorPB* error_code) {
   VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason.ToString();
 
-  bool found = ErrorCode(error_code) != tserver::TabletServerErrorPB::STALE_FOLLOWER &&
-               (!tablet_ || tablet_->MarkReplicaFailed(current_ts_, reason));
+  const bool stale_follower =
+      ErrorCode(error_code) == tserver::TabletServerErrorPB::STALE_FOLLOWER;
+  if (stale_follower) {
+    stale_followers_.insert(current_ts_->permanent_uuid());
+  }
+  bool found = !stale_follower && (!tablet_ || tablet_->MarkReplicaFailed(current_ts_, reason));
   if (!found) {
     // Its possible that current_ts_ is not part of replicas if RemoteTablet.Refresh() is invoked
     // which updates the set of replicas.
@@ -242,6 +250,18 @@ bool TabletInvoker::Done(Status* status) {
     *status = resp_error_status;
   }
 
+  // The tablet was split, so the command could not be retried on it. The caller has to find
+  // the tablets that now contain its keys.
+  if (ErrorCode(rpc_->response_error()) == tserver::TabletServerErrorPB::TABLET_SPLIT) {
+    VLOG(1) << "Tablet " << tablet_id_ << " was split: " << *status;
+    if (tablet_) {
+      tablet_->MarkStale();
+    }
+    tablet_split_ = true;
+    rpc_->Failed(*status);
+    return true;
+  }
+
   // Oops, we failed over to a replica that wasn't a LEADER. Unlikely as
   // we're using consensus configuration information from the master, but still possible
   // (e.g. leader restarted and became a FOLLOWER). Try again.
@@ -16,6 +16,8 @@
 #ifndef YB_CLIENT_TABLET_RPC_H
 #define YB_CLIENT_TABLET_RPC_H
 
+#include <set>
+#include <string>
 #include <unordered_set>
 
 #include "yb/client/client-internal.h"
@@ -75,11 +77,15 @@ class TabletInvoker {
   const RemoteTabletServer& current_ts() { return *current_ts_; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
+  // Whether the command finished because the tablet was split.
+  bool IsTabletSplit() const { return tablet_split_; }
+
  private:
   void SelectTabletServer();
 
   // This is an implementation of ReadRpc with consistency level as CONSISTENT_PREFIX. As a result,
-  // there is no requirement that the read needs to hit the leader.
+  // there is no requirement that the read needs to hit the leader. Picks the closest replica that
+  // has not rejected the read as too stale.
   void SelectTabletServerWithConsistentPrefix();
 
   // This is for Redis ops which always prefer to invoke the local tablet server. In case when it
@@ -128,10 +134,16 @@ class TabletInvoker {
   // Cleared when new consensus configuration information arrives from the master.
   std::unordered_set<RemoteTabletServer*> followers_;
 
+  // Uuids of the tablet servers that rejected a CONSISTENT_PREFIX read because their safe time
+  // did not satisfy the staleness bound. The read is retried on another replica.
+  std::set<std::string> stale_followers_;
+
   const bool local_tserver_only_;
 
   const bool consistent_prefix_;
 
+  bool tablet_split_ = false;
+
   // The TS receiving the write. May change if the write is retried.
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
@@ -500,6 +500,12 @@ void YBPgsqlWriteOp::SetHashCode(const uint16_t hash_code) {
   write_request_->set_hash_code(hash_code);
 }
 
+std::unique_ptr<YBPgsqlWriteOp> YBPgsqlWriteOp::DeepCopy() const {
+  std::unique_ptr<YBPgsqlWriteOp> result(new YBPgsqlWriteOp(table_));
+  *result->write_request_ = *write_request_;
+  return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // YBPgsqlReadOp
 
@@ -583,6 +589,14 @@ Status YBPgsqlReadOp::GetPartitionKey(string* partition_key) const {
   return Status::OK();
 }
 
+std::unique_ptr<YBPgsqlReadOp> YBPgsqlReadOp::DeepCopy() const {
+  std::unique_ptr<YBPgsqlReadOp> result(new YBPgsqlReadOp(table_));
+  *result->read_request_ = *read_request_;
+  result->yb_consistency_level_ = yb_consistency_level_;
+  result->read_time_ = read_time_;
+  return result;
+}
+
 std::vector<ColumnSchema> YBPgsqlReadOp::MakeColumnSchemasFromColDesc(
   const google::protobuf::RepeatedPtrField<PgsqlRSColDescPB>& rscol_descs) {
   std::vector<ColumnSchema> column_schemas;
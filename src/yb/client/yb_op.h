@@ -41,6 +41,8 @@
 #include "yb/common/partition.h"
 #include "yb/common/read_hybrid_time.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 
 class RedisWriteRequestPB;
@@ -351,6 +353,16 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Bound on how far behind the replica serving a CONSISTENT_PREFIX read could be. Not set means
+  // that any replica could serve the read.
+  const MonoDelta& follower_read_max_staleness() const {
+    return follower_read_max_staleness_;
+  }
+
+  void set_follower_read_max_staleness(const MonoDelta& value) {
+    follower_read_max_staleness_ = value;
+  }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -365,6 +377,7 @@ class YBqlReadOp : public YBqlOp {
   explicit YBqlReadOp(const std::shared_ptr<YBTable>& table);
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
+  MonoDelta follower_read_max_staleness_;
   ReadHybridTime read_time_;
 };
 
@@ -421,6 +434,10 @@ class YBPgsqlWriteOp : public YBPgsqlOp {
 
   virtual CHECKED_STATUS GetPartitionKey(std::string* partition_key) const override;
 
+  // Returns a new operation on the same table with a copy of the request, so the copy can be sent
+  // while this operation is being prepared for another request.
+  std::unique_ptr<YBPgsqlWriteOp> DeepCopy() const;
+
  protected:
   virtual Type type() const override {
     return PGSQL_WRITE;
@@ -476,6 +493,9 @@ class YBPgsqlReadOp : public YBPgsqlOp {
   static std::vector<ColumnSchema> MakeColumnSchemasFromColDesc(
       const google::protobuf::RepeatedPtrField<PgsqlRSColDescPB>& rscol_descs);
 
+  // Returns a new operation on the same table with a copy of the request and read options.
+  std::unique_ptr<YBPgsqlReadOp> DeepCopy() const;
+
  protected:
   virtual Type type() const override {
     return PGSQL_READ;
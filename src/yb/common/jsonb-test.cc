@@ -15,8 +15,11 @@
 #include <rapidjson/prettywriter.h>
 
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
+#include "yb/util/varint.h"
 
 using std::to_string;
 using std::numeric_limits;
@@ -151,5 +154,132 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+void AddObjectOp(const std::string& key, JsonOperatorPB op, QLJsonColumnOperationsPB* json_ops) {
+  auto* json_op = json_ops->add_json_operations();
+  json_op->set_json_operator(op);
+  json_op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+void AddArrayOp(int64_t index, JsonOperatorPB op, QLJsonColumnOperationsPB* json_ops) {
+  auto* json_op = json_ops->add_json_operations();
+  json_op->set_json_operator(op);
+  json_op->mutable_operand()->mutable_value()->set_varint_value(
+      util::VarInt(index).EncodeToComparable());
+}
+
+TEST(JsonbTest, TestJsonbOperators) {
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(R"#(
+      {
+        "b" : 1,
+        "a" : { "c" : "foo", "d" : [10, 20, { "e" : true }] },
+        "f" : "bar"
+      }
+      )#"));
+
+  {
+    // data->'b'
+    QLJsonColumnOperationsPB json_ops;
+    AddObjectOp("b", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    QLValue result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    std::string json;
+    ASSERT_OK(Jsonb(result.jsonb_value()).ToJsonString(&json));
+    ASSERT_EQ("1", json);
+  }
+
+  {
+    // data->'a'->>'c'
+    QLJsonColumnOperationsPB json_ops;
+    AddObjectOp("a", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddObjectOp("c", JsonOperatorPB::JSON_TEXT, &json_ops);
+    QLValue result;
+    ASSERT_OK(jsonb.ApplyJsonbOperators(json_ops, &result));
+    ASSERT_EQ("foo", result.string_value());
+  }
+
+  {
+    // data->'a'->'d'->1 and data->'a'->'d'->2->>'e'
+    QLJsonColumnOperationsPB json_ops;
+    AddObjectOp("a", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddObjectOp("d", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddArrayOp(1, JsonOperatorPB::JSON_TEXT, &json_ops);
+    QLValue result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    ASSERT_EQ("20", result.string_value());
+
+    json_ops.mutable_json_operations()->RemoveLast();
+    AddArrayOp(2, JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddObjectOp("e", JsonOperatorPB::JSON_TEXT, &json_ops);
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    ASSERT_EQ("true", result.string_value());
+  }
+
+  {
+    // Missing keys, out of range indexes and operators applied to scalars produce null.
+    for (const auto& key : {"x", "0", "aa"}) {
+      QLJsonColumnOperationsPB json_ops;
+      AddObjectOp(key, JsonOperatorPB::JSON_OBJECT, &json_ops);
+      QLValue result;
+      ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+      ASSERT_TRUE(result.IsNull()) << key;
+    }
+
+    QLJsonColumnOperationsPB json_ops;
+    AddObjectOp("a", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddObjectOp("d", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddArrayOp(3, JsonOperatorPB::JSON_OBJECT, &json_ops);
+    QLValue result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    ASSERT_TRUE(result.IsNull());
+
+    json_ops.Clear();
+    AddObjectOp("f", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    AddObjectOp("g", JsonOperatorPB::JSON_OBJECT, &json_ops);
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+    ASSERT_TRUE(result.IsNull());
+  }
+}
+
+// Compares evaluating data->'kN'->>'v' on the serialized jsonb with deserializing the document
+// through rapidjson, which is what the evaluation would cost without the binary format.
+TEST(JsonbTest, TestJsonbOperatorsPerformance) {
+  constexpr int kNumKeys = 100;
+  const int kNumIterations = AllowSlowTests() ? 100000 : 5000;
+
+  std::string json = "{";
+  for (int i = 0; i < kNumKeys; ++i) {
+    json += Format("$0\"k$1\" : { \"v\" : $1, \"s\" : \"value $1\" }", i ? ", " : "", i);
+  }
+  json += "}";
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(json));
+
+  QLJsonColumnOperationsPB json_ops;
+  AddObjectOp(Format("k$0", kNumKeys / 2), JsonOperatorPB::JSON_OBJECT, &json_ops);
+  AddObjectOp("v", JsonOperatorPB::JSON_TEXT, &json_ops);
+
+  int64_t sum = 0;
+  LOG_TIMING(INFO, Format("$0 iterations on serialized jsonb", kNumIterations)) {
+    for (int i = 0; i < kNumIterations; ++i) {
+      QLValue result;
+      ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), json_ops, &result));
+      sum += result.string_value().size();
+    }
+  }
+
+  const std::string key = Format("k$0", kNumKeys / 2);
+  LOG_TIMING(INFO, Format("$0 iterations with rapidjson", kNumIterations)) {
+    for (int i = 0; i < kNumIterations; ++i) {
+      rapidjson::Document document;
+      ASSERT_OK(jsonb.ToRapidJson(&document));
+      auto it = document.FindMember(key.c_str());
+      ASSERT_NE(it, document.MemberEnd());
+      sum -= std::to_string(it->value["v"].GetInt()).size();
+    }
+  }
+  ASSERT_EQ(0, sum);
+}
+
 }  // namespace common
 }  // namespace yb
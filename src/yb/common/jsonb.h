@@ -79,6 +79,13 @@ class Jsonb {
   CHECKED_STATUS ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops,
                                      QLValue* result) const;
 
+  // Applies the json operators to a serialized jsonb in place, only the result is copied. The
+  // operators use the JEntry offsets to locate keys and array elements without deserializing
+  // the document.
+  static CHECKED_STATUS ApplyJsonbOperators(const Slice& jsonb,
+                                            const QLJsonColumnOperationsPB& json_ops,
+                                            QLValue* result);
+
   const std::string& SerializedJsonb() const;
 
   // Use with extreme care since this destroys the internal state of the object. The only purpose
@@ -0,0 +1,209 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_compiled_expr.h"
+
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+namespace {
+
+constexpr ColumnIdRep kIntColumn = 10;
+constexpr ColumnIdRep kStringColumn = 11;
+constexpr ColumnIdRep kMissingColumn = 12;
+
+void SetColumn(ColumnIdRep column_id, QLExpressionPB* expr) {
+  expr->set_column_id(column_id);
+}
+
+void SetInt(int32_t value, QLExpressionPB* expr) {
+  expr->mutable_value()->set_int32_value(value);
+}
+
+void SetString(const std::string& value, QLExpressionPB* expr) {
+  expr->mutable_value()->set_string_value(value);
+}
+
+QLConditionPB* AddCondition(QLOperator op, QLConditionPB* parent) {
+  auto* condition = parent->add_operands()->mutable_condition();
+  condition->set_op(op);
+  return condition;
+}
+
+void AddRelational(QLOperator op, ColumnIdRep column_id, int32_t value, QLConditionPB* parent) {
+  auto* condition = AddCondition(op, parent);
+  SetColumn(column_id, condition->add_operands());
+  SetInt(value, condition->add_operands());
+}
+
+QLTableRow MakeRow(int32_t int_value, const std::string& string_value) {
+  QLTableRow row;
+  row.AllocColumn(kIntColumn).value.set_int32_value(int_value);
+  row.AllocColumn(kStringColumn).value.set_string_value(string_value);
+  return row;
+}
+
+// Checks that the compiled condition gives the same results as the interpreter.
+void CheckSameResults(const QLConditionPB& condition, const std::vector<QLTableRow>& rows) {
+  QLExprExecutor executor;
+  QLCompiledCondition compiled(condition, &executor);
+  for (const auto& row : rows) {
+    bool expected = false;
+    Status expected_status = executor.EvalCondition(condition, row, &expected);
+    bool result = false;
+    Status status = compiled.Eval(row, &result);
+    ASSERT_EQ(expected_status.ok(), status.ok()) << condition.ShortDebugString() << " "
+                                                 << row.ToString() << " " << status;
+    if (status.ok()) {
+      ASSERT_EQ(expected, result) << condition.ShortDebugString() << " " << row.ToString();
+    }
+  }
+}
+
+std::vector<QLTableRow> TestRows() {
+  std::vector<QLTableRow> rows;
+  for (int32_t i = -2; i <= 2; ++i) {
+    rows.push_back(MakeRow(i, i % 2 ? "odd" : "even"));
+  }
+  rows.emplace_back();
+  return rows;
+}
+
+} // namespace
+
+TEST(QLCompiledExprTest, Relational) {
+  const auto rows = TestRows();
+  for (auto op : {QL_OP_EQUAL, QL_OP_NOT_EQUAL, QL_OP_LESS_THAN, QL_OP_LESS_THAN_EQUAL,
+                  QL_OP_GREATER_THAN, QL_OP_GREATER_THAN_EQUAL}) {
+    for (auto column_id : {kIntColumn, kMissingColumn, kStringColumn}) {
+      QLConditionPB condition;
+      condition.set_op(QL_OP_AND);
+      AddRelational(op, column_id, 1, &condition);
+      ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+    }
+  }
+}
+
+TEST(QLCompiledExprTest, Logical) {
+  const auto rows = TestRows();
+
+  QLConditionPB condition;
+  condition.set_op(QL_OP_OR);
+  auto* and_condition = AddCondition(QL_OP_AND, &condition);
+  AddRelational(QL_OP_GREATER_THAN, kIntColumn, -2, and_condition);
+  AddRelational(QL_OP_LESS_THAN, kIntColumn, 1, and_condition);
+  auto* not_condition = AddCondition(QL_OP_NOT, &condition);
+  AddRelational(QL_OP_NOT_EQUAL, kIntColumn, 2, not_condition);
+  ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+
+  for (auto op : {QL_OP_IS_NULL, QL_OP_IS_NOT_NULL}) {
+    for (auto column_id : {kIntColumn, kMissingColumn}) {
+      condition.Clear();
+      condition.set_op(op);
+      SetColumn(column_id, condition.add_operands());
+      ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+    }
+  }
+
+  for (auto op : {QL_OP_EXISTS, QL_OP_NOT_EXISTS}) {
+    condition.Clear();
+    condition.set_op(op);
+    ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+  }
+}
+
+TEST(QLCompiledExprTest, In) {
+  const auto rows = TestRows();
+  for (auto op : {QL_OP_IN, QL_OP_NOT_IN}) {
+    QLConditionPB condition;
+    condition.set_op(op);
+    SetColumn(kStringColumn, condition.add_operands());
+    auto* list = condition.add_operands()->mutable_value()->mutable_list_value();
+    list->add_elems()->set_string_value("odd");
+    list->add_elems()->set_string_value("other");
+    ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+
+    // Not comparable.
+    condition.mutable_operands(0)->set_column_id(kIntColumn);
+    ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+  }
+}
+
+TEST(QLCompiledExprTest, Interpreted) {
+  const auto rows = TestRows();
+
+  // BETWEEN is evaluated by the executor.
+  QLConditionPB condition;
+  condition.set_op(QL_OP_BETWEEN);
+  SetColumn(kIntColumn, condition.add_operands());
+  SetInt(-1, condition.add_operands());
+  SetInt(1, condition.add_operands());
+  ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+
+  // Condition used as an operand of a relational operator.
+  condition.Clear();
+  condition.set_op(QL_OP_EQUAL);
+  auto* nested = condition.add_operands()->mutable_condition();
+  nested->set_op(QL_OP_IS_NULL);
+  SetColumn(kMissingColumn, nested->add_operands());
+  condition.add_operands()->mutable_value()->set_bool_value(true);
+  ASSERT_NO_FATALS(CheckSameResults(condition, rows));
+}
+
+// Compares the CPU time of filtering rows with the interpreter and with the compiled condition.
+TEST(QLCompiledExprTest, FilterPerformance) {
+  const int kNumRows = AllowSlowTests() ? 1000000 : 50000;
+
+  // int_column >= 10 AND int_column < 1000 AND string_column IN ('a', 'b', 'c')
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  AddRelational(QL_OP_GREATER_THAN_EQUAL, kIntColumn, 10, &condition);
+  AddRelational(QL_OP_LESS_THAN, kIntColumn, 1000, &condition);
+  auto* in_condition = AddCondition(QL_OP_IN, &condition);
+  SetColumn(kStringColumn, in_condition->add_operands());
+  auto* list = in_condition->add_operands()->mutable_value()->mutable_list_value();
+  for (const auto& value : {"a", "b", "c"}) {
+    list->add_elems()->set_string_value(value);
+  }
+
+  std::vector<QLTableRow> rows;
+  for (int i = 0; i != 100; ++i) {
+    rows.push_back(MakeRow(i * 20, std::string(1, 'a' + i % 5)));
+  }
+
+  QLExprExecutor executor;
+  int interpreted_matches = 0;
+  LOG_TIMING(INFO, Format("Filtering $0 rows with the interpreter", kNumRows)) {
+    for (int i = 0; i != kNumRows; ++i) {
+      bool match = false;
+      ASSERT_OK(executor.EvalCondition(condition, rows[i % rows.size()], &match));
+      interpreted_matches += match;
+    }
+  }
+
+  QLCompiledCondition compiled(condition, &executor);
+  int compiled_matches = 0;
+  LOG_TIMING(INFO, Format("Filtering $0 rows with the compiled condition", kNumRows)) {
+    for (int i = 0; i != kNumRows; ++i) {
+      bool match = false;
+      ASSERT_OK(compiled.Eval(rows[i % rows.size()], &match));
+      compiled_matches += match;
+    }
+  }
+  ASSERT_EQ(interpreted_matches, compiled_matches);
+}
+
+} // namespace yb
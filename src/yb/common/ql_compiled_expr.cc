@@ -0,0 +1,345 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/common/ql_compiled_expr.h"
+
+#include <functional>
+#include <vector>
+
+namespace yb {
+
+namespace {
+
+const QLValuePB& NullValue() {
+  static const QLValuePB null_value;
+  return null_value;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Expressions.
+
+class ConstantExpr : public QLCompiledExpr {
+ public:
+  explicit ConstantExpr(const QLValuePB& value) : value_(value) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, const QLValuePB** result) override {
+    *result = &value_;
+    return Status::OK();
+  }
+
+ private:
+  const QLValuePB& value_;
+};
+
+class ColumnExpr : public QLCompiledExpr {
+ public:
+  explicit ColumnExpr(ColumnIdRep column_id) : column_id_(column_id) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, const QLValuePB** result) override {
+    auto value = table_row.GetValue(column_id_);
+    *result = value ? &*value : &NullValue();
+    return Status::OK();
+  }
+
+ private:
+  const ColumnIdRep column_id_;
+};
+
+// Expression that is not compiled, evaluated by the executor.
+class InterpretedExpr : public QLCompiledExpr {
+ public:
+  InterpretedExpr(const QLExpressionPB& expr, QLExprExecutor* executor)
+      : expr_(expr), executor_(executor) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, const QLValuePB** result) override {
+    RETURN_NOT_OK(executor_->EvalExpr(expr_, table_row, &value_));
+    *result = &value_.value();
+    return Status::OK();
+  }
+
+ private:
+  const QLExpressionPB& expr_;
+  QLExprExecutor* const executor_;
+  QLValue value_;
+};
+
+std::unique_ptr<QLCompiledExpr> CompileExpr(const QLExpressionPB& expr, QLExprExecutor* executor) {
+  switch (expr.expr_case()) {
+    case QLExpressionPB::ExprCase::kValue:
+      return std::make_unique<ConstantExpr>(expr.value());
+    case QLExpressionPB::ExprCase::kColumnId:
+      return std::make_unique<ColumnExpr>(expr.column_id());
+    default:
+      return std::make_unique<InterpretedExpr>(expr, executor);
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Conditions.
+
+std::unique_ptr<QLCompiledBoolExpr> CompileCondition(
+    const QLConditionPB& condition, QLExprExecutor* executor);
+
+// Condition that is not compiled, evaluated by the executor.
+class InterpretedCondition : public QLCompiledBoolExpr {
+ public:
+  InterpretedCondition(const QLConditionPB& condition, QLExprExecutor* executor)
+      : condition_(condition), executor_(executor) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    return executor_->EvalCondition(condition_, table_row, result);
+  }
+
+ private:
+  const QLConditionPB& condition_;
+  QLExprExecutor* const executor_;
+};
+
+template <class Compare>
+class RelationalCondition : public QLCompiledBoolExpr {
+ public:
+  RelationalCondition(std::unique_ptr<QLCompiledExpr> left, std::unique_ptr<QLCompiledExpr> right)
+      : left_(std::move(left)), right_(std::move(right)) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    const QLValuePB* left;
+    const QLValuePB* right;
+    RETURN_NOT_OK(left_->Eval(table_row, &left));
+    RETURN_NOT_OK(right_->Eval(table_row, &right));
+    if (!Comparable(*left, *right)) {
+      return STATUS(RuntimeError, "values not comparable");
+    }
+    *result = Compare()(*left, *right);
+    return Status::OK();
+  }
+
+ private:
+  std::unique_ptr<QLCompiledExpr> left_;
+  std::unique_ptr<QLCompiledExpr> right_;
+};
+
+class IsNullCondition : public QLCompiledBoolExpr {
+ public:
+  IsNullCondition(std::unique_ptr<QLCompiledExpr> operand, bool negate)
+      : operand_(std::move(operand)), negate_(negate) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    const QLValuePB* value;
+    RETURN_NOT_OK(operand_->Eval(table_row, &value));
+    *result = IsNull(*value) != negate_;
+    return Status::OK();
+  }
+
+ private:
+  std::unique_ptr<QLCompiledExpr> operand_;
+  const bool negate_;
+};
+
+class InCondition : public QLCompiledBoolExpr {
+ public:
+  InCondition(std::unique_ptr<QLCompiledExpr> left, std::unique_ptr<QLCompiledExpr> right,
+              bool negate)
+      : left_(std::move(left)), right_(std::move(right)), negate_(negate) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    const QLValuePB* left;
+    const QLValuePB* right;
+    RETURN_NOT_OK(left_->Eval(table_row, &left));
+    RETURN_NOT_OK(right_->Eval(table_row, &right));
+    *result = negate_;
+    for (const QLValuePB& elem : right->list_value().elems()) {
+      if (!Comparable(elem, *left)) {
+        return STATUS(RuntimeError, "values not comparable");
+      }
+      if (elem == *left) {
+        *result = !negate_;
+        break;
+      }
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::unique_ptr<QLCompiledExpr> left_;
+  std::unique_ptr<QLCompiledExpr> right_;
+  const bool negate_;
+};
+
+class NotCondition : public QLCompiledBoolExpr {
+ public:
+  explicit NotCondition(std::unique_ptr<QLCompiledBoolExpr> operand)
+      : operand_(std::move(operand)) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    RETURN_NOT_OK(operand_->Eval(table_row, result));
+    *result = !*result;
+    return Status::OK();
+  }
+
+ private:
+  std::unique_ptr<QLCompiledBoolExpr> operand_;
+};
+
+// AND and OR, evaluation stops at the first operand that evaluates to stop_value.
+class LogicalCondition : public QLCompiledBoolExpr {
+ public:
+  LogicalCondition(std::vector<std::unique_ptr<QLCompiledBoolExpr>> operands, bool stop_value)
+      : operands_(std::move(operands)), stop_value_(stop_value) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    for (const auto& operand : operands_) {
+      RETURN_NOT_OK(operand->Eval(table_row, result));
+      if (*result == stop_value_) {
+        break;
+      }
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::vector<std::unique_ptr<QLCompiledBoolExpr>> operands_;
+  const bool stop_value_;
+};
+
+class ExistsCondition : public QLCompiledBoolExpr {
+ public:
+  explicit ExistsCondition(bool negate) : negate_(negate) {}
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) override {
+    *result = table_row.IsEmpty() == negate_;
+    return Status::OK();
+  }
+
+ private:
+  const bool negate_;
+};
+
+template <class Compare>
+std::unique_ptr<QLCompiledBoolExpr> CompileRelational(
+    const QLConditionPB& condition, QLExprExecutor* executor) {
+  return std::make_unique<RelationalCondition<Compare>>(
+      CompileExpr(condition.operands(0), executor), CompileExpr(condition.operands(1), executor));
+}
+
+std::unique_ptr<QLCompiledBoolExpr> CompileLogical(
+    const QLConditionPB& condition, QLExprExecutor* executor, bool stop_value) {
+  std::vector<std::unique_ptr<QLCompiledBoolExpr>> operands;
+  operands.reserve(condition.operands_size());
+  for (const auto& operand : condition.operands()) {
+    operands.push_back(CompileCondition(operand.condition(), executor));
+  }
+  return std::make_unique<LogicalCondition>(std::move(operands), stop_value);
+}
+
+bool OperandsAreConditions(const QLConditionPB& condition) {
+  for (const auto& operand : condition.operands()) {
+    if (operand.expr_case() != QLExpressionPB::ExprCase::kCondition) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<QLCompiledBoolExpr> CompileCondition(
+    const QLConditionPB& condition, QLExprExecutor* executor) {
+  const auto& operands = condition.operands();
+  // Malformed conditions are left to the executor, which reports them the same way as before.
+  switch (condition.op()) {
+    case QL_OP_NOT:
+      if (operands.size() == 1 && OperandsAreConditions(condition)) {
+        return std::make_unique<NotCondition>(
+            CompileCondition(operands.Get(0).condition(), executor));
+      }
+      break;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      if (operands.size() == 1) {
+        return std::make_unique<IsNullCondition>(
+            CompileExpr(operands.Get(0), executor), condition.op() == QL_OP_IS_NOT_NULL);
+      }
+      break;
+
+    case QL_OP_EQUAL:
+      if (operands.size() == 2) {
+        return CompileRelational<std::equal_to<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_LESS_THAN:
+      if (operands.size() == 2) {
+        return CompileRelational<std::less<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_LESS_THAN_EQUAL:
+      if (operands.size() == 2) {
+        return CompileRelational<std::less_equal<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_GREATER_THAN:
+      if (operands.size() == 2) {
+        return CompileRelational<std::greater<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_GREATER_THAN_EQUAL:
+      if (operands.size() == 2) {
+        return CompileRelational<std::greater_equal<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_NOT_EQUAL:
+      if (operands.size() == 2) {
+        return CompileRelational<std::not_equal_to<QLValuePB>>(condition, executor);
+      }
+      break;
+
+    case QL_OP_AND: FALLTHROUGH_INTENDED;
+    case QL_OP_OR:
+      if (operands.size() > 0 && OperandsAreConditions(condition)) {
+        return CompileLogical(condition, executor, condition.op() == QL_OP_OR);
+      }
+      break;
+
+    case QL_OP_EXISTS: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EXISTS:
+      return std::make_unique<ExistsCondition>(condition.op() == QL_OP_NOT_EXISTS);
+
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN:
+      if (operands.size() == 2) {
+        return std::make_unique<InCondition>(
+            CompileExpr(operands.Get(0), executor), CompileExpr(operands.Get(1), executor),
+            condition.op() == QL_OP_NOT_IN);
+      }
+      break;
+
+    default:
+      break;
+  }
+  return std::make_unique<InterpretedCondition>(condition, executor);
+}
+
+} // namespace
+
+QLCompiledCondition::QLCompiledCondition(const QLConditionPB& condition, QLExprExecutor* executor)
+    : root_(CompileCondition(condition, executor)) {
+}
+
+QLCompiledCondition::~QLCompiledCondition() {
+}
+
+} // namespace yb
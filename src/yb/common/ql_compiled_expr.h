@@ -0,0 +1,66 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// This module compiles the QL conditions that are evaluated for every row of a scan.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_COMMON_QL_COMPILED_EXPR_H_
+#define YB_COMMON_QL_COMPILED_EXPR_H_
+
+#include <memory>
+
+#include "yb/common/ql_expr.h"
+
+namespace yb {
+
+// Evaluates an expression to a value that stays valid until the next evaluation or until the row
+// is modified.
+class QLCompiledExpr {
+ public:
+  virtual ~QLCompiledExpr() {}
+
+  virtual CHECKED_STATUS Eval(const QLTableRow& table_row, const QLValuePB** result) = 0;
+};
+
+// Evaluates a condition to a bool.
+class QLCompiledBoolExpr {
+ public:
+  virtual ~QLCompiledBoolExpr() {}
+
+  virtual CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) = 0;
+};
+
+// A QLConditionPB compiled into a tree of evaluators once per request. Compared with
+// QLExprExecutor::EvalCondition, evaluating a row does not dispatch on the protobuf expression
+// and operator cases, and column references and constants resolve to the values stored in the row
+// and the request instead of being copied into QLValue temporaries. Expressions and conditions
+// that are not compiled are evaluated by the executor, so the results are the same.
+//
+// The compiled condition references the condition protobuf and the executor, which must outlive
+// it. It keeps scratch values, so it must not be evaluated concurrently.
+class QLCompiledCondition {
+ public:
+  QLCompiledCondition(const QLConditionPB& condition, QLExprExecutor* executor);
+  ~QLCompiledCondition();
+
+  CHECKED_STATUS Eval(const QLTableRow& table_row, bool* result) const {
+    return root_->Eval(table_row, result);
+  }
+
+ private:
+  std::unique_ptr<QLCompiledBoolExpr> root_;
+};
+
+} // namespace yb
+
+#endif // YB_COMMON_QL_COMPILED_EXPR_H_
@@ -31,11 +31,15 @@ CHECKED_STATUS QLExprExecutor::EvalExpr(const QLExpressionPB& ql_expr,
       break;
 
     case QLExpressionPB::ExprCase::kJsonColumn: {
-      QLValue ql_value;
       const QLJsonColumnOperationsPB& json_ops = ql_expr.json_column();
-      RETURN_NOT_OK(table_row.ReadColumn(json_ops.column_id(), &ql_value));
-      common::Jsonb jsonb(std::move(ql_value.jsonb_value()));
-      RETURN_NOT_OK(jsonb.ApplyJsonbOperators(json_ops, result));
+      // Evaluate the operators on the column value in place, the document can be large while
+      // the result usually is a single field.
+      auto value = table_row.GetValue(json_ops.column_id());
+      if (!value || value->value_case() != QLValuePB::kJsonbValue) {
+        result->SetNull();
+      } else {
+        RETURN_NOT_OK(common::Jsonb::ApplyJsonbOperators(value->jsonb_value(), json_ops, result));
+      }
       break;
     }
 
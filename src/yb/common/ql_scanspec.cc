@@ -15,6 +15,15 @@
 
 #include "yb/common/ql_scanspec.h"
 
+#include <gflags/gflags.h>
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(ql_compile_scan_conditions, true,
+            "Compile the WHERE condition of a QL scan once per request instead of interpreting "
+            "the condition protobuf for every row.");
+TAG_FLAG(ql_compile_scan_conditions, advanced);
+
 namespace yb {
 namespace common {
 
@@ -309,10 +318,16 @@ QLScanSpec::QLScanSpec(const QLConditionPB* condition,
   if (executor_ == nullptr) {
     executor_ = std::make_shared<QLExprExecutor>();
   }
+  if (condition_ != nullptr && FLAGS_ql_compile_scan_conditions) {
+    compiled_condition_ = std::make_unique<QLCompiledCondition>(*condition_, executor_.get());
+  }
 }
 
 // Evaluate the WHERE condition for the given row.
 CHECKED_STATUS QLScanSpec::Match(const QLTableRow& table_row, bool* match) const {
+  if (compiled_condition_ != nullptr) {
+    return compiled_condition_->Eval(table_row, match);
+  }
   if (condition_ != nullptr) {
     return executor_->EvalCondition(*condition_, table_row, match);
   }
@@ -21,6 +21,7 @@
 #include "yb/common/schema.h"
 #include "yb/common/ql_protocol.pb.h"
 #include "yb/common/ql_rowblock.h"
+#include "yb/common/ql_compiled_expr.h"
 #include "yb/common/ql_expr.h"
 
 namespace yb {
@@ -115,6 +116,9 @@ class QLScanSpec : public YQLScanSpec {
   const QLConditionPB* condition_;
   const bool is_forward_scan_;
   QLExprExecutor::SharedPtr executor_;
+
+  // The WHERE condition compiled for evaluating it on every row of the scan.
+  std::unique_ptr<QLCompiledCondition> compiled_condition_;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -83,6 +83,9 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   if (HasCopartitionTableId()) {
     pb->set_copartition_table_id(copartition_table_id_);
   }
+  if (bloom_filter_range_components_ != 0) {
+    pb->set_bloom_filter_range_components(bloom_filter_range_components_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -102,6 +105,9 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_copartition_table_id()) {
     table_properties.SetCopartitionTableId(pb.copartition_table_id());
   }
+  if (pb.has_bloom_filter_range_components()) {
+    table_properties.SetBloomFilterRangeComponents(pb.bloom_filter_range_components());
+  }
   return table_properties;
 }
 
@@ -126,6 +132,7 @@ void TableProperties::Reset() {
   is_transactional_ = false;
   consistency_level_ = YBConsistencyLevel::STRONG;
   copartition_table_id_ = kNoCopartitionTableId;
+  bloom_filter_range_components_ = 0;
 }
 
 Schema::Schema(const Schema& other)
@@ -431,6 +431,14 @@ class TableProperties {
     copartition_table_id_ = copartition_table_id;
   }
 
+  uint32_t bloom_filter_range_components() const {
+    return bloom_filter_range_components_;
+  }
+
+  void SetBloomFilterRangeComponents(uint32_t bloom_filter_range_components) {
+    bloom_filter_range_components_ = bloom_filter_range_components;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -446,6 +454,7 @@ class TableProperties {
   bool is_transactional_ = false;
   YBConsistencyLevel consistency_level_ = YBConsistencyLevel::STRONG;
   TableId copartition_table_id_ = kNoCopartitionTableId;
+  uint32_t bloom_filter_range_components_ = 0;
 };
 
 // The schema for a set of rows.
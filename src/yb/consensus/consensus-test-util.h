@@ -909,6 +909,7 @@ class TestRaftConsensusQueueIface : public PeerMessageQueueObserver {
   virtual void NotifyFailedFollower(const std::string& uuid,
                                     int64_t term,
                                     const std::string& reason) override {}
+  virtual void NotifyLogReadAheadDone() override {}
 
  private:
   mutable simple_spinlock lock_;
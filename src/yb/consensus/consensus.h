@@ -345,6 +345,12 @@ class Consensus {
   // This includes heartbeats too.
   virtual MonoTime TimeSinceLastMessageFromLeader() = 0;
 
+  // The leader of a quiescent tablet does not extend its lease. Makes it send heartbeats again, so
+  // it acquires a new lease. Returns false if the leader was not quiescent.
+  virtual bool WakeUpIfQuiescent() {
+    return false;
+  }
+
  protected:
   friend class RefCountedThreadSafe<Consensus>;
   friend class tablet::TabletPeer;
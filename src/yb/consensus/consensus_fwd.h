@@ -21,8 +21,10 @@ namespace yb {
 namespace consensus {
 
 class Consensus;
+class MultiRaftManager;
 class PeerProxyFactory;
 class PeerMessageQueue;
+class RaftConsensus;
 class ReplicaOperationFactory;
 class ReplicateMsg;
 class RetryableRequests;
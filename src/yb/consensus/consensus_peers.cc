@@ -149,7 +149,22 @@ Status Peer::Init() {
   return Status::OK();
 }
 
+bool Peer::WakeUpIfQuiescent() {
+  std::lock_guard<simple_spinlock> lock(peer_lock_);
+  if (!quiescent_ || state_ != kPeerRunning) {
+    return false;
+  }
+  VLOG_WITH_PREFIX(1) << "Waking up";
+  quiescent_ = false;
+  proxy_->SetQuiescent(tablet_id_, false);
+  heartbeater_->Start();
+  return true;
+}
+
 Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
+  // Any signal wakes up a quiescent peer, even if a request is being sent now.
+  WakeUpIfQuiescent();
+
   // If the peer is currently sending, return Status::OK().
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_lock = LockPerforming(std::try_to_lock);
@@ -293,6 +308,16 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     heartbeater_->Snooze();
   }
 
+  // The tablet is listed as quiescent in the keep-alives before the follower could accept
+  // quiescence, so the follower does not see a keep-alive without it while quiescent.
+  if (!req_has_ops && proxy_->SupportsQuiescence() &&
+      queue_->CanPeerQuiesce(peer_pb_.permanent_uuid())) {
+    request_.set_quiescent(true);
+  } else {
+    request_.clear_quiescent();
+  }
+  proxy_->SetQuiescent(tablet_id_, request_.quiescent());
+
   MAYBE_FAULT(FLAGS_fault_crash_on_leader_request_fraction);
   controller_.Reset();
 
@@ -388,6 +413,17 @@ void Peer::DoProcessResponse() {
   bool more_pending = false;
   queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), response_, &more_pending);
 
+  // Stop heartbeating if the follower accepted quiescence. The queue is checked again under
+  // peer_lock_, so an operation appended after the request was sent wakes us up in SignalRequest().
+  if (!more_pending && request_.quiescent() && response_.quiescent() &&
+      queue_->CanPeerQuiesce(peer_pb_.permanent_uuid())) {
+    VLOG_WITH_PREFIX(1) << "Quiescent";
+    quiescent_ = true;
+    heartbeater_->Stop();
+  } else if (request_.quiescent()) {
+    proxy_->SetQuiescent(tablet_id_, false);
+  }
+
   if (more_pending) {
     processing_lock.unlock();
     performing_lock.release();
@@ -457,6 +493,9 @@ void Peer::Close() {
 
   auto retain_self = shared_from_this();
 
+  // Followers of this tablet on the remote server wake up and elect a new leader once keep-alives
+  // stop listing the tablet.
+  proxy_->SetQuiescent(tablet_id_, false);
   queue_->UntrackPeer(peer_pb_.permanent_uuid());
 
   auto performing_lock = LockPerforming(std::try_to_lock);
@@ -480,8 +519,10 @@ void Peer::ReleaseResourcesUnlocked() {
   LOG_WITH_PREFIX(INFO) << "Closed peer";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -490,6 +531,12 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  // Only heartbeats are batched, requests with operations are sent right away.
+  if (multi_raft_batcher_ && trigger_mode == RequestTriggerMode::kAlwaysSend &&
+      request->ops_size() == 0) {
+    multi_raft_batcher_->AddRequestToBatch(request, response, controller, callback);
+    return;
+  }
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
@@ -522,16 +569,29 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
   consensus_proxy_->StartRemoteBootstrapAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::SupportsQuiescence() const {
+  return multi_raft_batcher_ && multi_raft_batcher_->BatchingSupported();
+}
+
+void RpcPeerProxy::SetQuiescent(const std::string& tablet_id, bool quiescent) {
+  if (multi_raft_batcher_) {
+    multi_raft_batcher_->SetTabletQuiescent(tablet_id, quiescent);
+  }
+}
+
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    shared_ptr<Messenger> messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(std::move(messenger)), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    shared_ptr<Messenger> messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(std::move(messenger)), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto batcher = multi_raft_manager_ ? multi_raft_manager_->AddOrGetBatcher(peer_pb) : nullptr;
+  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy), std::move(batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
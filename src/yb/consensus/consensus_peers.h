@@ -42,6 +42,7 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/consensus_util.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/rpc_controller.h"
@@ -134,6 +135,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Signals that this peer has a new request to replicate/store.
   CHECKED_STATUS SignalRequest(RequestTriggerMode trigger_mode);
 
+  // Restarts the heartbeats of a quiescent peer. Returns true if the peer was quiescent.
+  bool WakeUpIfQuiescent();
+
   const RaftPeerPB& peer_pb() const { return peer_pb_; }
 
   // Returns the PeerProxy if this is a remote peer or NULL if it
@@ -262,6 +266,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // holding peer_lock_.
   mutable simple_spinlock peer_lock_;
   State state_ = kPeerCreated;
+
+  // Set when the peer accepted quiescence and the heartbeater is stopped, cleared by the next
+  // SignalRequest() or WakeUpIfQuiescent().
+  bool quiescent_ = false;
   Consensus* consensus_ = nullptr;
   std::shared_ptr<rpc::Messenger> messenger_;
 };
@@ -307,6 +315,15 @@ class PeerProxy {
     LOG(DFATAL) << "Not implemented";
   }
 
+  // Whether the remote server gets keep-alives from this server, so the leader may stop sending
+  // heartbeats to the peer when the tablet is idle.
+  virtual bool SupportsQuiescence() const {
+    return false;
+  }
+
+  // Tells the remote server whether the local leader of the tablet may stop heartbeating it.
+  virtual void SetQuiescent(const std::string& tablet_id, bool quiescent) {}
+
   virtual ~PeerProxy() {}
 };
 
@@ -323,12 +340,17 @@ class PeerProxyFactory {
   virtual std::shared_ptr<rpc::Messenger> messenger() const {
     return nullptr;
   }
+
+  virtual MultiRaftManager* multi_raft_manager() const {
+    return nullptr;
+  }
 };
 
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -356,18 +378,24 @@ class RpcPeerProxy : public PeerProxy {
                                        rpc::RpcController* controller,
                                        const rpc::ResponseCallback& callback) override;
 
+  bool SupportsQuiescence() const override;
+
+  void SetQuiescent(const std::string& tablet_id, bool quiescent) override;
+
   virtual ~RpcPeerProxy();
 
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  // Used for heartbeats if set.
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
   RpcPeerProxyFactory(std::shared_ptr<rpc::Messenger> messenger, rpc::ProxyCache* proxy_cache,
-                      CloudInfoPB from);
+                      CloudInfoPB from, MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -375,10 +403,15 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
 
   std::shared_ptr<rpc::Messenger> messenger() const override;
 
+  MultiRaftManager* multi_raft_manager() const override {
+    return multi_raft_manager_;
+  }
+
  private:
   std::shared_ptr<rpc::Messenger> messenger_;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
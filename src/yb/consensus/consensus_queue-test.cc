@@ -54,6 +54,7 @@
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_int32(consensus_max_batch_size_bytes);
+DECLARE_int32(raft_quiescence_idle_ms);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -864,5 +865,47 @@ TEST_F(ConsensusQueueTest, TestTriggerRemoteBootstrapIfTabletNotFound) {
             rb_req.source_private_addr()[0].ShortDebugString());
 }
 
+TEST_F(ConsensusQueueTest, TestPeerQuiescence) {
+  queue_->Init(MinimumOpId());
+  queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), BuildRaftConfigPBForTests(2));
+  queue_->TrackPeer(kPeerUuid);
+
+  ConsensusRequestPB request;
+  ReplicateMsgs refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+
+  // The peer has everything.
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  SetLastReceivedAndLastCommitted(&response, MinimumOpId());
+  bool more_pending = true;
+  queue_->ResponseFromPeer(kPeerUuid, response, &more_pending);
+  ASSERT_FALSE(more_pending);
+
+  // Disabled.
+  FLAGS_raft_quiescence_idle_ms = 0;
+  ASSERT_FALSE(queue_->CanPeerQuiesce(kPeerUuid));
+
+  const auto kIdleTime = MonoDelta::FromMilliseconds(100);
+  FLAGS_raft_quiescence_idle_ms = kIdleTime.ToMilliseconds();
+  ASSERT_FALSE(queue_->CanPeerQuiesce(kPeerUuid));
+  SleepFor(kIdleTime * 2);
+  ASSERT_TRUE(queue_->CanPeerQuiesce(kPeerUuid));
+  ASSERT_FALSE(queue_->CanPeerQuiesce("unknown-peer"));
+
+  // Waking up resets the idle time.
+  ASSERT_TRUE(queue_->NotifyActivity());
+  ASSERT_FALSE(queue_->CanPeerQuiesce(kPeerUuid));
+  ASSERT_FALSE(queue_->NotifyActivity());
+
+  // The peer does not have the new operation.
+  SleepFor(kIdleTime * 2);
+  ASSERT_TRUE(queue_->CanPeerQuiesce(kPeerUuid));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 1);
+  SleepFor(kIdleTime * 2);
+  ASSERT_FALSE(queue_->CanPeerQuiesce(kPeerUuid));
+}
+
 }  // namespace consensus
 }  // namespace yb
@@ -97,6 +97,13 @@ DECLARE_int32(rpc_max_message_size);
 
 DEFINE_bool(propagate_safe_time, true, "Propagate safe time to read from leader to followers");
 
+DEFINE_int32(raft_quiescence_idle_ms, 0,
+             "Time without new operations after which the leader of a tablet stops sending "
+             "heartbeats to followers that have all operations. Followers of such tablets rely on "
+             "keep-alives between servers instead of heartbeats. 0 to disable.");
+TAG_FLAG(raft_quiescence_idle_ms, evolving);
+TAG_FLAG(raft_quiescence_idle_ms, advanced);
+
 namespace yb {
 namespace consensus {
 
@@ -139,13 +146,16 @@ PeerMessageQueue::PeerMessageQueue(const scoped_refptr<MetricEntity>& metric_ent
                                    const RaftPeerPB& local_peer_pb,
                                    const string& tablet_id,
                                    const server::ClockPtr& clock,
-                                   unique_ptr<ThreadPoolToken> raft_pool_token)
+                                   unique_ptr<ThreadPoolToken> raft_pool_token,
+                                   ThreadPool* log_prefetch_pool)
     : raft_pool_observers_token_(std::move(raft_pool_token)),
       local_peer_pb_(local_peer_pb),
       local_peer_uuid_(local_peer_pb_.has_permanent_uuid() ? local_peer_pb_.permanent_uuid()
                                                            : string()),
       tablet_id_(tablet_id),
-      log_cache_(metric_entity, log, server_tracker, local_peer_pb.permanent_uuid(), tablet_id),
+      log_cache_(metric_entity, log, server_tracker, local_peer_pb.permanent_uuid(), tablet_id,
+                 log_prefetch_pool,
+                 std::bind(&PeerMessageQueue::NotifyObserversOfLogReadAheadDone, this)),
       metrics_(metric_entity),
       clock_(clock) {
   DCHECK(local_peer_pb_.has_permanent_uuid());
@@ -175,6 +185,7 @@ void PeerMessageQueue::SetLeaderMode(const OpId& committed_index,
       << queue_state_.active_config->ShortDebugString();
   queue_state_.majority_size_ = MajoritySize(CountVoters(*queue_state_.active_config));
   queue_state_.mode = Mode::LEADER;
+  queue_state_.last_activity_time = CoarseMonoClock::Now();
 
   LOG_WITH_PREFIX_UNLOCKED(INFO) << "Queue going to LEADER mode. State: "
       << queue_state_.ToString();
@@ -316,6 +327,7 @@ Status PeerMessageQueue::AppendOperations(const ReplicateMsgs& msgs,
   if (!msgs.empty()) {
     std::unique_lock<simple_spinlock> lock(queue_lock_);
     queue_state_.last_appended = last_id;
+    queue_state_.last_activity_time = CoarseMonoClock::Now();
     UpdateMetrics();
   }
 
@@ -889,8 +901,10 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     }
 
     // If our log has the next request for the peer or if the peer's committed index is lower than
-    // our own, set 'more_pending' to true.
-    *more_pending = log_cache_.HasOpBeenWritten(peer->next_index) ||
+    // our own, set 'more_pending' to true. Ops that are being read ahead from the disk are sent when
+    // the read-ahead notifies the observers.
+    *more_pending = (log_cache_.HasOpBeenWritten(peer->next_index) &&
+                     !log_cache_.IsReadAheadPending(peer->next_index)) ||
         (peer->last_known_committed_idx < queue_state_.committed_index.index());
 
     mode_copy = queue_state_.mode;
@@ -1139,6 +1153,53 @@ void PeerMessageQueue::NotifyObserversOfFailedFollowerTask(const string& uuid,
   }
 }
 
+void PeerMessageQueue::NotifyObserversOfLogReadAheadDone() {
+  WARN_NOT_OK(raft_pool_observers_token_->SubmitFunc(
+      std::bind(&PeerMessageQueue::NotifyObserversOfLogReadAheadDoneTask, this)),
+              LogPrefixUnlocked() + "Unable to notify RaftConsensus of log read-ahead.");
+}
+
+void PeerMessageQueue::NotifyObserversOfLogReadAheadDoneTask() {
+  std::vector<PeerMessageQueueObserver*> observers_copy;
+  {
+    LockGuard lock(queue_lock_);
+    observers_copy = observers_;
+  }
+  for (PeerMessageQueueObserver* observer : observers_copy) {
+    observer->NotifyLogReadAheadDone();
+  }
+}
+
+bool PeerMessageQueue::CanPeerQuiesce(const std::string& peer_uuid) const {
+  const auto idle_ms = FLAGS_raft_quiescence_idle_ms;
+  if (idle_ms <= 0) {
+    return false;
+  }
+  LockGuard lock(queue_lock_);
+  if (queue_state_.mode != Mode::LEADER || queue_state_.state != State::kQueueOpen ||
+      CoarseMonoClock::Now() < queue_state_.last_activity_time + idle_ms * 1ms) {
+    return false;
+  }
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
+  // The peer should have all operations and know that they are committed, otherwise it would not
+  // be able to apply them until the tablet wakes up.
+  return peer != nullptr && !peer->is_new && peer->is_last_exchange_successful &&
+         !peer->needs_remote_bootstrap &&
+         OpIdEquals(queue_state_.committed_index, queue_state_.last_appended) &&
+         OpIdEquals(peer->last_received, queue_state_.last_appended) &&
+         peer->last_known_committed_idx == queue_state_.committed_index.index();
+}
+
+bool PeerMessageQueue::NotifyActivity() {
+  const auto idle_ms = FLAGS_raft_quiescence_idle_ms;
+  LockGuard lock(queue_lock_);
+  const auto now = CoarseMonoClock::Now();
+  const bool was_idle = idle_ms > 0 && queue_state_.mode == Mode::LEADER &&
+                        now >= queue_state_.last_activity_time + idle_ms * 1ms;
+  queue_state_.last_activity_time = now;
+  return was_idle;
+}
+
 bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
   std::lock_guard<simple_spinlock> lock(queue_lock_);
   TrackedPeer* peer = FindPtrOrNull(peers_map_, peer_uuid);
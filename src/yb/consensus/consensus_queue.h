@@ -61,6 +61,7 @@ template<class T>
 class AtomicGauge;
 class MemTracker;
 class MetricEntity;
+class ThreadPool;
 class ThreadPoolToken;
 
 namespace log {
@@ -163,7 +164,8 @@ class PeerMessageQueue {
                    const RaftPeerPB& local_peer_pb,
                    const std::string& tablet_id,
                    const server::ClockPtr& clock,
-                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token);
+                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token,
+                   ThreadPool* log_prefetch_pool = nullptr);
 
   // Initialize the queue.
   virtual void Init(const OpId& last_locally_replicated);
@@ -285,6 +287,14 @@ class PeerMessageQueue {
 
   bool CanPeerBecomeLeader(const std::string& peer_uuid) const;
 
+  // Returns true if the leader could stop sending heartbeats to the peer, because no operations
+  // were appended for raft_quiescence_idle_ms and the peer has all of them.
+  bool CanPeerQuiesce(const std::string& peer_uuid) const;
+
+  // Resets the time since the last operation was appended. Returns true if it was long enough for
+  // the peers to be quiescent.
+  bool NotifyActivity();
+
   struct Metrics {
     // Keeps track of the number of ops. that are completed by a majority but still need
     // to be replicated to a minority (IsDone() is true, IsAllDone() is false).
@@ -352,6 +362,9 @@ class PeerMessageQueue {
     // The opid of the last operation appended to the queue.
     OpId last_appended = MinimumOpId();
 
+    // The time when the last operation was appended or the queue went to leader mode.
+    CoarseTimePoint last_activity_time;
+
     // The queue's owner current_term.  Set by the last appended operation.  If the queue owner's
     // term is less than the term observed from another peer the queue owner must step down.
     // TODO: it is likely to be cleaner to get this from the ConsensusMetadata rather than by
@@ -391,6 +404,9 @@ class PeerMessageQueue {
                                            int64_t term,
                                            const std::string& reason);
 
+  void NotifyObserversOfLogReadAheadDone();
+  void NotifyObserversOfLogReadAheadDoneTask();
+
   typedef std::unordered_map<std::string, TrackedPeer*> PeersMap;
 
   std::string ToStringUnlocked() const;
@@ -503,6 +519,10 @@ class PeerMessageQueueObserver {
                                     int64_t term,
                                     const std::string& reason) = 0;
 
+  // Notify Consensus that the log cache has read ahead ops from the disk, so the peers waiting for
+  // them can be sent their next request.
+  virtual void NotifyLogReadAheadDone() = 0;
+
   virtual ~PeerMessageQueueObserver() {}
 };
 
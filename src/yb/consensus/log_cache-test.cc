@@ -59,6 +59,7 @@ using std::thread;
 
 DECLARE_int32(log_cache_size_limit_mb);
 DECLARE_int32(global_log_cache_size_limit_mb);
+DECLARE_int32(log_cache_read_ahead_bytes);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -106,12 +107,13 @@ class LogCacheTest : public YBTest {
     ASSERT_OK(log_->WaitUntilAllFlushed());
   }
 
-  void CloseAndReopenCache(const OpId& preceding_id) {
+  void CloseAndReopenCache(const OpId& preceding_id, ThreadPool* prefetch_pool = nullptr) {
     // Blow away the memtrackers before creating the new cache.
     cache_.reset();
 
     cache_.reset(new LogCache(
-        metric_entity_, log_.get(), nullptr /* mem_tracker */, kPeerUuid, kTestTablet));
+        metric_entity_, log_.get(), nullptr /* mem_tracker */, kPeerUuid, kTestTablet,
+        prefetch_pool, [this] { ++read_ahead_done_count_; }));
     cache_->Init(preceding_id);
   }
 
@@ -141,7 +143,9 @@ class LogCacheTest : public YBTest {
   scoped_refptr<MetricEntity> metric_entity_;
   gscoped_ptr<FsManager> fs_manager_;
   std::unique_ptr<ThreadPool> append_pool_;
+  std::unique_ptr<ThreadPool> prefetch_pool_;
   gscoped_ptr<LogCache> cache_;
+  std::atomic<int> read_ahead_done_count_{0};
   scoped_refptr<log::Log> log_;
   scoped_refptr<server::Clock> clock_;
 };
@@ -342,6 +346,65 @@ TEST_F(LogCacheTest, TestReplaceMessages) {
             cache_->ToString());
 }
 
+// Test that ops read from disk for a lagging peer are cached and that the following ops are read
+// ahead in the background, so other peers catching up over the same range don't hit the disk.
+TEST_F(LogCacheTest, TestReadAhead) {
+  FLAGS_log_cache_read_ahead_bytes = 1024 * 1024;
+  ASSERT_OK(ThreadPoolBuilder("prefetch").Build(&prefetch_pool_));
+  CloseAndReopenCache(MinimumOpId(), prefetch_pool_.get());
+
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 100));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(100);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  // The ops are not cached, so the first read returns nothing and loads them in the background.
+  ReplicateMsgs messages;
+  OpId preceding;
+  bool have_more_messages = false;
+  ASSERT_OK(cache_->ReadOps(0, 100, &messages, &preceding, &have_more_messages));
+  ASSERT_TRUE(messages.empty());
+  ASSERT_TRUE(have_more_messages);
+
+  cache_->prefetch_token_->Wait();
+  ASSERT_EQ(1, read_ahead_done_count_.load());
+  ASSERT_FALSE(cache_->IsReadAheadPending(1));
+  ASSERT_EQ(100, cache_->num_cached_ops());
+  const auto disk_reads = cache_->metrics_.log_cache_disk_reads->value();
+  ASSERT_GE(disk_reads, 100);
+
+  messages.clear();
+  ASSERT_OK(cache_->ReadOps(0, 8 * 1024 * 1024, &messages, &preceding, &have_more_messages));
+  ASSERT_EQ(100, messages.size());
+  ASSERT_EQ("0.1", OpIdToString(messages[0]->id()));
+  ASSERT_FALSE(have_more_messages);
+  ASSERT_EQ(disk_reads, cache_->metrics_.log_cache_disk_reads->value());
+}
+
+// When the read-ahead cannot cache the ops, the next read loads them synchronously.
+TEST_F(LogCacheTest, TestReadAheadOverMemoryLimit) {
+  FLAGS_log_cache_size_limit_mb = 1;
+  FLAGS_log_cache_read_ahead_bytes = 4 * 1024 * 1024;
+  ASSERT_OK(ThreadPoolBuilder("prefetch").Build(&prefetch_pool_));
+  CloseAndReopenCache(MinimumOpId(), prefetch_pool_.get());
+
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 100, 20 * 1024));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(100);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  ReplicateMsgs messages;
+  OpId preceding;
+  ASSERT_OK(cache_->ReadOps(0, 100 * 1024, &messages, &preceding));
+  ASSERT_TRUE(messages.empty());
+  cache_->prefetch_token_->Wait();
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  ASSERT_OK(cache_->ReadOps(0, 100 * 1024, &messages, &preceding));
+  ASSERT_FALSE(messages.empty());
+  ASSERT_EQ("0.1", OpIdToString(messages[0]->id()));
+}
+
 TEST_F(LogCacheTest, TestMTReadAndWrite) {
   atomic<bool> stop { false };
   bool stopped = false;
@@ -55,6 +55,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace std::literals;
 
@@ -70,6 +71,13 @@ DEFINE_int32(global_log_cache_size_limit_mb, 1024,
              "caching log entries across all tablets is kept under this threshold.");
 TAG_FLAG(global_log_cache_size_limit_mb, advanced);
 
+DEFINE_int32(log_cache_read_ahead_bytes, 4 * 1024 * 1024,
+             "When a peer needs entries that are no longer in the log cache, read ahead up to "
+             "this many bytes of the following entries from disk in the background, so that the "
+             "next requests to that peer are served from memory. 0 disables read-ahead.");
+TAG_FLAG(log_cache_read_ahead_bytes, advanced);
+TAG_FLAG(log_cache_read_ahead_bytes, runtime);
+
 using strings::Substitute;
 
 namespace yb {
@@ -81,11 +89,24 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_num_ops, "Log Cache Operation Count"
 METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
                           MetricUnit::kBytes,
                           "Amount of memory in use for caching the local log.");
+METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
+                      MetricUnit::kOperations,
+                      "Number of operations read from the on-disk log because they were not in "
+                      "the log cache.");
 
 namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
 
+// Calculate the total byte size that will be used on the wire to replicate this message as part of
+// a consensus update request. This accounts for the length delimiting and tagging of the message.
+int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
+  int msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
+    msg.ByteSize());
+  msg_size += 1; // for the type tag
+  return msg_size;
+}
+
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -94,11 +115,14 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
                    const scoped_refptr<log::Log>& log,
                    const MemTrackerPtr& server_tracker,
                    const string& local_uuid,
-                   const string& tablet_id)
+                   const string& tablet_id,
+                   ThreadPool* prefetch_pool,
+                   std::function<void()> read_ahead_done_callback)
   : log_(log),
     local_uuid_(local_uuid),
     tablet_id_(tablet_id),
     next_sequential_op_index_(0),
+    read_ahead_done_callback_(std::move(read_ahead_done_callback)),
     min_pinned_op_index_(0),
     metrics_(metric_entity) {
 
@@ -117,13 +141,22 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
       AddToParent::kTrue, CreateMetrics::kFalse);
   tracker_->SetMetricEntity(metric_entity, kParentMemTrackerId);
 
+  if (prefetch_pool) {
+    prefetch_token_ = prefetch_pool->NewToken(ThreadPool::ExecutionMode::SERIAL);
+  }
+
   // Put a fake message at index 0, since this simplifies a lot of our code paths elsewhere.
   auto zero_op = std::make_shared<ReplicateMsg>();
   *zero_op->mutable_id() = MinimumOpId();
-  InsertOrDie(&cache_, 0, { zero_op, zero_op->SpaceUsed() });
+  InsertOrDie(&cache_, 0, MakeCacheEntry(zero_op));
 }
 
 LogCache::~LogCache() {
+  // Wait for a running read-ahead, it accesses the cache and the trackers.
+  if (prefetch_token_) {
+    prefetch_token_->Shutdown();
+  }
+
   tracker_->Release(tracker_->consumption());
   cache_.clear();
 
@@ -137,13 +170,17 @@ void LogCache::Init(const OpId& preceding_op) {
   min_pinned_op_index_ = next_sequential_op_index_;
 }
 
+LogCache::CacheEntry LogCache::MakeCacheEntry(const ReplicateMsgPtr& msg) {
+  return { msg, static_cast<int64_t>(msg->SpaceUsedLong()), TotalByteSizeForMessage(*msg) };
+}
+
 Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const ReplicateMsgs& msgs) {
   // SpaceUsed is relatively expensive, so do calculations outside the lock
   PrepareAppendResult result;
   std::vector<CacheEntry> entries_to_insert;
   entries_to_insert.reserve(msgs.size());
   for (const auto& msg : msgs) {
-    CacheEntry e = { msg, static_cast<int64_t>(msg->SpaceUsedLong()) };
+    CacheEntry e = MakeCacheEntry(msg);
     result.mem_required += e.mem_usage;
     entries_to_insert.emplace_back(std::move(e));
   }
@@ -158,6 +195,7 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
     // If the index is not consecutive then it must be lower than or equal to the last index, i.e.
     // we're overwriting.
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
+    ++overwrite_generation_;
 
     // Now remove the overwritten operations.
     for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
@@ -252,6 +290,11 @@ bool LogCache::HasOpBeenWritten(int64_t index) const {
   return index < next_sequential_op_index_;
 }
 
+bool LogCache::IsReadAheadPending(int64_t index) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  return read_ahead_in_progress_ && cache_.count(index) == 0;
+}
+
 Status LogCache::LookupOpId(int64_t op_index, OpId* op_id) const {
   // First check the log cache itself.
   {
@@ -276,19 +319,6 @@ Status LogCache::LookupOpId(int64_t op_index, OpId* op_id) const {
   return log_->GetLogReader()->LookupOpId(op_index, op_id);
 }
 
-namespace {
-
-// Calculate the total byte size that will be used on the wire to replicate this message as part of
-// a consensus update request. This accounts for the length delimiting and tagging of the message.
-int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
-  int msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
-    msg.ByteSize());
-  msg_size += 1; // for the type tag
-  return msg_size;
-}
-
-} // anonymous namespace
-
 Status LogCache::ReadOps(int64_t after_op_index,
                          int max_size_bytes,
                          ReplicateMsgs* messages,
@@ -304,6 +334,7 @@ Status LogCache::ReadOps(int64_t after_op_index,
 
   std::unique_lock<simple_spinlock> l(lock_);
   int64_t next_index = after_op_index + 1;
+  int64_t read_ahead_from = -1;
 
   // Return as many operations as we can, up to the limit
   int64_t remaining_space = max_size_bytes;
@@ -312,25 +343,33 @@ Status LogCache::ReadOps(int64_t after_op_index,
     // If the messages the peer needs haven't been loaded into the queue yet, load them.
     MessageCache::const_iterator iter = cache_.lower_bound(next_index);
     if (iter == cache_.end() || iter->first != next_index) {
-      int64_t up_to;
-      if (iter == cache_.end()) {
-        // Read all the way to the current op.
-        up_to = next_sequential_op_index_ - 1;
-      } else {
-        // Read up to the next entry that's in the cache.
-        up_to = iter->first - 1;
+      if (next_index != sync_read_index_ && ReadAheadEnabled()) {
+        // Respond with the ops we already have and load the missing ones in the background.
+        read_ahead_from = next_index;
+        if (have_more_messages) {
+          *have_more_messages = true;
+        }
+        break;
       }
+      if (next_index == sync_read_index_) {
+        sync_read_index_ = -1;
+      }
+
+      const int64_t up_to = MissingRangeEndUnlocked(next_index);
+      const int64_t generation = overwrite_generation_;
 
       l.unlock();
 
       ReplicateMsgs raw_replicate_ptrs;
       RETURN_NOT_OK_PREPEND(
-        log_->GetLogReader()->ReadReplicatesInRange(
-            next_index, up_to, remaining_space, &raw_replicate_ptrs),
+        LoadOpsFromDisk(next_index, up_to, remaining_space, generation, &raw_replicate_ptrs),
         Substitute("Failed to read ops $0..$1", next_index, up_to));
       l.lock();
       LOG_WITH_PREFIX_UNLOCKED(INFO) << "Successfully read " << raw_replicate_ptrs.size() << " ops "
                             << "from disk.";
+      if (!raw_replicate_ptrs.empty()) {
+        read_ahead_from = raw_replicate_ptrs.back()->id().index() + 1;
+      }
 
       for (auto& msg : raw_replicate_ptrs) {
         CHECK_EQ(next_index, msg->id().index());
@@ -345,15 +384,16 @@ Status LogCache::ReadOps(int64_t after_op_index,
       }
 
     } else {
-      // Pull contiguous messages from the cache until the size limit is achieved.
+      // Pull contiguous messages from the cache until the size limit is achieved. Stop at the
+      // first gap, the missing ops are then loaded from disk by the next iteration.
       for (; iter != cache_.end(); ++iter) {
         const ReplicateMsgPtr& msg = iter->second.msg;
         int64_t index = msg->id().index();
         if (index != next_index) {
-          continue;
+          break;
         }
 
-        remaining_space -= TotalByteSizeForMessage(*msg);
+        remaining_space -= iter->second.wire_size;
         if (remaining_space < 0 && !messages->empty()) {
           if (have_more_messages) {
             *have_more_messages = true;
@@ -366,9 +406,131 @@ Status LogCache::ReadOps(int64_t after_op_index,
       }
     }
   }
+  l.unlock();
+
+  if (read_ahead_from >= 0) {
+    MaybeScheduleReadAhead(read_ahead_from);
+  }
   return Status::OK();
 }
 
+int64_t LogCache::MissingRangeEndUnlocked(int64_t start_index) const {
+  auto iter = cache_.lower_bound(start_index);
+  if (iter == cache_.end()) {
+    // Read all the way to the current op.
+    return next_sequential_op_index_ - 1;
+  }
+  // Read up to the next entry that's in the cache.
+  return iter->first - 1;
+}
+
+Status LogCache::LoadOpsFromDisk(int64_t start_index,
+                                 int64_t up_to,
+                                 int64_t max_bytes,
+                                 int64_t generation,
+                                 ReplicateMsgs* messages) {
+  RETURN_NOT_OK(log_->GetLogReader()->ReadReplicatesInRange(
+      start_index, up_to, max_bytes, messages));
+  metrics_.log_cache_disk_reads->IncrementBy(messages->size());
+
+  // SpaceUsed is relatively expensive, so do calculations outside the lock
+  int64_t mem_required = 0;
+  std::vector<CacheEntry> entries_to_insert;
+  entries_to_insert.reserve(messages->size());
+  for (const auto& msg : *messages) {
+    entries_to_insert.push_back(MakeCacheEntry(msg));
+    mem_required += entries_to_insert.back().mem_usage;
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  if (generation != overwrite_generation_) {
+    // The log was overwritten while we were reading, so these ops could be stale.
+    return Status::OK();
+  }
+
+  // Unlike appended ops, ops read from the disk never cause eviction. They are only cached when
+  // they fit.
+  if (!tracker_->TryConsume(mem_required)) {
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "Not caching " << messages->size() << " ops read from disk: "
+                                 << "memory limit would be exceeded";
+    return Status::OK();
+  }
+
+  for (auto& e : entries_to_insert) {
+    auto index = e.msg->id().index();
+    if (index >= next_sequential_op_index_ || cache_.count(index)) {
+      // Already loaded by a concurrent reader.
+      tracker_->Release(e.mem_usage);
+      continue;
+    }
+    metrics_.log_cache_size->IncrementBy(e.mem_usage);
+    metrics_.log_cache_num_ops->Increment();
+    cache_.emplace(index, std::move(e));
+  }
+
+  return Status::OK();
+}
+
+bool LogCache::ReadAheadEnabled() const {
+  return prefetch_token_ && FLAGS_log_cache_read_ahead_bytes > 0;
+}
+
+void LogCache::MaybeScheduleReadAhead(int64_t start_index) {
+  if (!ReadAheadEnabled()) {
+    return;
+  }
+
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    if (read_ahead_in_progress_ || start_index >= next_sequential_op_index_) {
+      return;
+    }
+    read_ahead_in_progress_ = true;
+  }
+
+  auto status = prefetch_token_->SubmitFunc(std::bind(&LogCache::ReadAhead, this, start_index));
+  if (!status.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Failed to schedule log cache read-ahead: " << status;
+    std::lock_guard<simple_spinlock> lock(lock_);
+    read_ahead_in_progress_ = false;
+  }
+}
+
+void LogCache::ReadAhead(int64_t start_index) {
+  int64_t up_to;
+  int64_t generation;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    up_to = MissingRangeEndUnlocked(start_index);
+    generation = overwrite_generation_;
+  }
+
+  if (up_to >= start_index) {
+    ReplicateMsgs messages;
+    auto status = LoadOpsFromDisk(
+        start_index, up_to, FLAGS_log_cache_read_ahead_bytes, generation, &messages);
+    if (status.ok()) {
+      VLOG_WITH_PREFIX_UNLOCKED(1) << "Read ahead " << messages.size() << " ops starting from "
+                                   << start_index;
+    } else {
+      LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Log cache read-ahead from " << start_index
+                                        << " failed: " << status;
+    }
+  }
+
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    read_ahead_in_progress_ = false;
+    if (start_index < next_sequential_op_index_ && cache_.count(start_index) == 0) {
+      sync_read_index_ = start_index;
+    }
+  }
+
+  if (read_ahead_done_callback_) {
+    read_ahead_done_callback_();
+  }
+}
+
 
 void LogCache::EvictThroughOp(int64_t index) {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -503,7 +665,8 @@ void LogCache::DumpToHtml(std::ostream& out) const {
   x.Instantiate(metric_entity, 0)
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : log_cache_num_ops(INSTANTIATE_METRIC(METRIC_log_cache_num_ops)),
-    log_cache_size(INSTANTIATE_METRIC(METRIC_log_cache_size)) {
+    log_cache_size(INSTANTIATE_METRIC(METRIC_log_cache_size)),
+    log_cache_disk_reads(METRIC_log_cache_disk_reads.Instantiate(metric_entity)) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -32,6 +32,7 @@
 #ifndef YB_CONSENSUS_LOG_CACHE_H
 #define YB_CONSENSUS_LOG_CACHE_H
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -54,6 +55,8 @@ namespace yb {
 
 class MetricEntity;
 class MemTracker;
+class ThreadPool;
+class ThreadPoolToken;
 
 namespace log {
 class Log;
@@ -68,14 +71,22 @@ class ReplicateMsg;
 //
 // This stores a set of log messages by their index. New operations can be appended to the end as
 // they are written to the log. Readers fetch entries that were explicitly appended, or they can
-// fetch older entries which are asynchronously fetched from the disk.
+// fetch older entries which are read from the disk. Entries read from the disk are added to the
+// cache, so they are shared by all peers that are catching up over the same range.
+//
+// When 'prefetch_pool' is provided, entries missing from the cache are read from the disk
+// asynchronously on that pool, together with the following entries, so that a lagging peer does not
+// block the caller and its next requests are served from memory. 'read_ahead_done_callback' is
+// invoked on the prefetch pool after each such read, so that the waiting peers can be signaled.
 class LogCache {
  public:
   LogCache(const scoped_refptr<MetricEntity>& metric_entity,
            const scoped_refptr<log::Log>& log,
            const std::shared_ptr<MemTracker>& server_tracker,
            const std::string& local_uuid,
-           const std::string& tablet_id);
+           const std::string& tablet_id,
+           ThreadPool* prefetch_pool = nullptr,
+           std::function<void()> read_ahead_done_callback = std::function<void()>());
   ~LogCache();
 
   // Initialize the cache.
@@ -95,9 +106,13 @@ class LogCache {
   // The OpId which precedes the returned ops is returned in *preceding_op.  The index of this OpId
   // will match 'after_op_index'.
   //
-  // If the ops being requested are not available in the log, this will synchronously read these ops
-  // from disk. Therefore, this function may take a substantial amount of time and should not be
-  // called with important locks held, etc.
+  // If the ops being requested are not available in the cache and there is no prefetch pool, this
+  // will synchronously read these ops from disk. Therefore, this function may take a substantial
+  // amount of time and should not be called with important locks held, etc.
+  //
+  // With a prefetch pool, only the ops that are already cached are returned, possibly none, and the
+  // missing ops are read ahead in the background. 'have_more_messages' is set in this case. If a
+  // read-ahead could not add the ops to the cache, the next read of them is synchronous.
   CHECKED_STATUS ReadOps(int64_t after_op_index,
                  int max_size_bytes,
                  ReplicateMsgs* messages,
@@ -119,6 +134,10 @@ class LogCache {
   // operation may not necessarily be durable yet -- it could still be en route to the log.
   bool HasOpBeenWritten(int64_t log_index) const;
 
+  // Return true if the operation with the given index is not in the cache and a read-ahead is in
+  // progress, so ReadOps() would not return it until the read-ahead is done.
+  bool IsReadAheadPending(int64_t log_index) const;
+
   // Evict any operations with op index <= 'index'.
   void EvictThroughOp(int64_t index);
 
@@ -153,6 +172,8 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestAppendAndGetMessages);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimit);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestReadAhead);
+  FRIEND_TEST(LogCacheTest, TestReadAheadOverMemoryLimit);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -161,8 +182,34 @@ class LogCache {
     // The cached value of msg->SpaceUsedLong(). This method is expensive
     // to compute, so we compute it only once upon insertion.
     int64_t mem_usage;
+    // The size this message takes in a consensus update request. Computed once upon insertion,
+    // instead of once per peer request.
+    int64_t wire_size;
   };
 
+  static CacheEntry MakeCacheEntry(const ReplicateMsgPtr& msg);
+
+  // Returns the last index of the run of ops starting at 'start_index' that are missing from the
+  // cache.
+  int64_t MissingRangeEndUnlocked(int64_t start_index) const;
+
+  // Reads ops [start_index, up_to] from the on-disk log, reading at most 'max_bytes' (but at least
+  // one op), and adds them to the cache if the memory limits allow it. The ops are not added when
+  // the log was overwritten after 'generation' was observed.
+  CHECKED_STATUS LoadOpsFromDisk(int64_t start_index,
+                                 int64_t up_to,
+                                 int64_t max_bytes,
+                                 int64_t generation,
+                                 ReplicateMsgs* messages);
+
+  bool ReadAheadEnabled() const;
+
+  // Schedules an asynchronous read-ahead of the ops starting at 'start_index', if there is a
+  // prefetch pool and no read-ahead is already in progress.
+  void MaybeScheduleReadAhead(int64_t start_index);
+
+  void ReadAhead(int64_t start_index);
+
   // Try to evict the oldest operations from the queue, stopping either when
   // 'bytes_to_evict' bytes have been evicted, or the op with index
   // 'stop_after_index' has been evicted, whichever comes first.
@@ -216,6 +263,23 @@ class LogCache {
   // go backward (but never skip forward).
   int64_t next_sequential_op_index_;
 
+  // Incremented every time operations are overwritten, so that ops read from the disk concurrently
+  // with the overwrite are not added to the cache.
+  int64_t overwrite_generation_ = 0;
+
+  // Used to read ahead ops for lagging peers. Null when read-ahead is disabled.
+  std::unique_ptr<ThreadPoolToken> prefetch_token_;
+
+  std::function<void()> read_ahead_done_callback_;
+
+  // Whether a read-ahead task is scheduled or running. Protected by lock_.
+  bool read_ahead_in_progress_ = false;
+
+  // The index of the op that the last read-ahead failed to add to the cache. ReadOps() reads it
+  // synchronously, so that the peer makes progress and read errors are reported. Protected by
+  // lock_.
+  int64_t sync_read_index_ = -1;
+
   // Any operation with an index >= min_pinned_op_ may not be evicted from the cache. This is used
   // to prevent ops from being evicted until they successfully have been appended to the underlying
   // log.  Protected by lock_.
@@ -239,6 +303,9 @@ class LogCache {
 
     // Keeps track of the memory consumed by the cache, in bytes.
     scoped_refptr<AtomicGauge<int64_t> > log_cache_size;
+
+    // Number of operations read from the on-disk log because they were not in the cache.
+    scoped_refptr<Counter> log_cache_disk_reads;
   };
   Metrics metrics_;
 
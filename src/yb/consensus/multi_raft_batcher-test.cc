@@ -0,0 +1,210 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.service.h"
+#include "yb/rpc/proxy.h"
+#include "yb/rpc/rpc-test-base.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(multi_raft_batch_size);
+DECLARE_int32(multi_raft_heartbeat_window_ms);
+
+namespace yb {
+namespace consensus {
+
+namespace {
+
+constexpr int kNumTablets = 3;
+
+// Answers every update with the tablet id of the request as the responder uuid, so the test can
+// check that the batched responses are matched to the right requests.
+class TestConsensusService : public ConsensusServiceIf {
+ public:
+  TestConsensusService(const scoped_refptr<MetricEntity>& entity, bool supports_batches)
+      : ConsensusServiceIf(entity), supports_batches_(supports_batches) {}
+
+  void UpdateConsensus(const ConsensusRequestPB* req, ConsensusResponsePB* resp,
+                       rpc::RpcContext context) override {
+    num_updates_.fetch_add(1, std::memory_order_acq_rel);
+    resp->set_responder_uuid(req->tablet_id());
+    context.RespondSuccess();
+  }
+
+  void MultiRaftUpdateConsensus(const MultiRaftConsensusRequestPB* req,
+                                MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override {
+    num_batch_calls_.fetch_add(1, std::memory_order_acq_rel);
+    if (!supports_batches_) {
+      // What a server that does not know the method answers.
+      context.RespondRpcFailure(rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD,
+                                STATUS(NotSupported, "MultiRaftUpdateConsensus"));
+      return;
+    }
+    for (const auto& request : req->consensus_request()) {
+      resp->add_consensus_response()->set_responder_uuid(request.tablet_id());
+    }
+    num_batched_updates_.fetch_add(req->consensus_request_size(), std::memory_order_acq_rel);
+    context.RespondSuccess();
+  }
+
+#define TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(Method, Request, Response) \
+  void Method(const Request* req, Response* resp, rpc::RpcContext context) override { \
+    context.RespondFailure(STATUS(NotSupported, #Method)); \
+  }
+
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      RequestConsensusVote, VoteRequestPB, VoteResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      ChangeConfig, ChangeConfigRequestPB, ChangeConfigResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      GetNodeInstance, GetNodeInstanceRequestPB, GetNodeInstanceResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      RunLeaderElection, RunLeaderElectionRequestPB, RunLeaderElectionResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      LeaderElectionLost, LeaderElectionLostRequestPB, LeaderElectionLostResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      LeaderStepDown, LeaderStepDownRequestPB, LeaderStepDownResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      GetLastOpId, GetLastOpIdRequestPB, GetLastOpIdResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      GetConsensusState, GetConsensusStateRequestPB, GetConsensusStateResponsePB)
+  TEST_CONSENSUS_SERVICE_NOT_SUPPORTED(
+      StartRemoteBootstrap, StartRemoteBootstrapRequestPB, StartRemoteBootstrapResponsePB)
+
+#undef TEST_CONSENSUS_SERVICE_NOT_SUPPORTED
+
+  int num_updates() const { return num_updates_.load(std::memory_order_acquire); }
+  int num_batch_calls() const { return num_batch_calls_.load(std::memory_order_acquire); }
+  int num_batched_updates() const { return num_batched_updates_.load(std::memory_order_acquire); }
+
+ private:
+  const bool supports_batches_;
+  std::atomic<int> num_updates_{0};
+  std::atomic<int> num_batch_calls_{0};
+  std::atomic<int> num_batched_updates_{0};
+};
+
+// Request, response and controller of a single heartbeat, which have to outlive the call.
+struct Heartbeat {
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  rpc::RpcController controller;
+};
+
+} // namespace
+
+class MultiRaftBatcherTest : public rpc::RpcTestBase {
+ protected:
+  void StartServer(bool supports_batches) {
+    auto service = std::make_unique<TestConsensusService>(metric_entity(), supports_batches);
+    service_ = service.get();
+    server_ = std::make_unique<rpc::TestServer>(
+        std::move(service), CreateMessenger("server", rpc::kDefaultServerMessengerOptions));
+    client_messenger_ = CreateMessenger("client");
+    proxy_cache_ = std::make_unique<rpc::ProxyCache>(client_messenger_);
+    batcher_ = std::make_shared<MultiRaftHeartbeatBatcher>(
+        HostPort(server_->bound_endpoint()), "local-uuid", proxy_cache_.get(), client_messenger_);
+  }
+
+  void TearDown() override {
+    batcher_.reset();
+    proxy_cache_.reset();
+    if (client_messenger_) {
+      client_messenger_->Shutdown();
+    }
+    server_.reset();
+    rpc::RpcTestBase::TearDown();
+  }
+
+  // Sends a heartbeat for every tablet through the batcher and waits for all the responses.
+  void SendHeartbeats(int num_tablets) {
+    std::vector<Heartbeat> heartbeats(num_tablets);
+    CountDownLatch latch(num_tablets);
+    for (int i = 0; i != num_tablets; ++i) {
+      auto& request = heartbeats[i].request;
+      request.set_tablet_id(Format("tablet-$0", i));
+      request.set_caller_uuid("local-uuid");
+      request.set_caller_term(1);
+      request.mutable_committed_index()->set_term(0);
+      request.mutable_committed_index()->set_index(0);
+      heartbeats[i].controller.set_timeout(MonoDelta::FromSeconds(10));
+      batcher_->AddRequestToBatch(&request, &heartbeats[i].response, &heartbeats[i].controller,
+                                  [&latch] { latch.CountDown(); });
+    }
+    ASSERT_TRUE(latch.WaitFor(MonoDelta::FromSeconds(30)));
+    for (const auto& heartbeat : heartbeats) {
+      ASSERT_OK(heartbeat.controller.status());
+      ASSERT_EQ(heartbeat.request.tablet_id(), heartbeat.response.responder_uuid());
+    }
+  }
+
+  TestConsensusService* service_ = nullptr;
+  std::unique_ptr<rpc::TestServer> server_;
+  std::shared_ptr<rpc::Messenger> client_messenger_;
+  std::unique_ptr<rpc::ProxyCache> proxy_cache_;
+  MultiRaftHeartbeatBatcherPtr batcher_;
+};
+
+TEST_F(MultiRaftBatcherTest, Batching) {
+  StartServer(/* supports_batches */ true);
+
+  // A full batch is sent right away.
+  FLAGS_multi_raft_batch_size = kNumTablets;
+  FLAGS_multi_raft_heartbeat_window_ms = 60000;
+  ASSERT_NO_FATALS(SendHeartbeats(kNumTablets));
+  ASSERT_EQ(1, service_->num_batch_calls());
+  ASSERT_EQ(kNumTablets, service_->num_batched_updates());
+  ASSERT_EQ(0, service_->num_updates());
+
+  // A partial batch is sent when the window ends.
+  FLAGS_multi_raft_batch_size = 256;
+  FLAGS_multi_raft_heartbeat_window_ms = 100;
+  ASSERT_NO_FATALS(SendHeartbeats(kNumTablets));
+  ASSERT_EQ(2, service_->num_batch_calls());
+  ASSERT_EQ(2 * kNumTablets, service_->num_batched_updates());
+  ASSERT_EQ(0, service_->num_updates());
+
+  // A single heartbeat is not worth a batch.
+  ASSERT_NO_FATALS(SendHeartbeats(1));
+  ASSERT_EQ(2, service_->num_batch_calls());
+  ASSERT_EQ(1, service_->num_updates());
+  ASSERT_TRUE(batcher_->BatchingSupported());
+}
+
+TEST_F(MultiRaftBatcherTest, FallbackWhenNotSupported) {
+  StartServer(/* supports_batches */ false);
+
+  // The batch is rejected, so every heartbeat is resent as an individual UpdateConsensus.
+  FLAGS_multi_raft_batch_size = kNumTablets;
+  ASSERT_NO_FATALS(SendHeartbeats(kNumTablets));
+  ASSERT_EQ(1, service_->num_batch_calls());
+  ASSERT_EQ(kNumTablets, service_->num_updates());
+  ASSERT_FALSE(batcher_->BatchingSupported());
+
+  // Later heartbeats skip the batch.
+  ASSERT_NO_FATALS(SendHeartbeats(kNumTablets));
+  ASSERT_EQ(1, service_->num_batch_calls());
+  ASSERT_EQ(2 * kNumTablets, service_->num_updates());
+}
+
+} // namespace consensus
+} // namespace yb
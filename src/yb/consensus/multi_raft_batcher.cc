@@ -0,0 +1,363 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.proxy.h"
+#include "yb/consensus/consensus_meta.h"
+#include "yb/consensus/raft_consensus.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/periodic.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, true,
+            "Whether heartbeats sent by the tablet leaders of this server to the same remote "
+            "server should be batched into a single RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+
+DEFINE_int32(multi_raft_heartbeat_window_ms, 50,
+             "Maximum time a heartbeat waits for other heartbeats to the same server to be "
+             "batched with.");
+TAG_FLAG(multi_raft_heartbeat_window_ms, advanced);
+TAG_FLAG(multi_raft_heartbeat_window_ms, runtime);
+
+DEFINE_int32(multi_raft_batch_size, 256,
+             "Maximum number of heartbeats sent in a single batch.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+TAG_FLAG(multi_raft_batch_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int32(raft_quiescence_idle_ms);
+
+namespace yb {
+namespace consensus {
+
+struct MultiRaftHeartbeatBatcher::BatchCall {
+  MultiRaftConsensusRequestPB request;
+  MultiRaftConsensusResponsePB response;
+  rpc::RpcController controller;
+  std::vector<BatchEntry> entries;
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, std::string local_uuid, rpc::ProxyCache* proxy_cache,
+    std::shared_ptr<rpc::Messenger> messenger)
+    : hostport_(hostport),
+      local_uuid_(std::move(local_uuid)),
+      proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
+      messenger_(std::move(messenger)) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB* request,
+                                                  ConsensusResponsePB* response,
+                                                  rpc::RpcController* controller,
+                                                  rpc::ResponseCallback callback) {
+  BatchEntry entry{request, response, controller, std::move(callback)};
+  if (batching_unsupported_.load(std::memory_order_acquire)) {
+    SendIndividually(entry);
+    return;
+  }
+
+  std::vector<BatchEntry> entries;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(std::move(entry));
+    if (pending_.size() >= static_cast<size_t>(std::max(FLAGS_multi_raft_batch_size, 1))) {
+      entries.swap(pending_);
+    } else if (!flush_scheduled_) {
+      flush_scheduled_ = schedule_flush = true;
+    }
+  }
+
+  if (!entries.empty()) {
+    SendBatch(std::move(entries));
+    return;
+  }
+
+  if (schedule_flush) {
+    auto task_id = messenger_->ScheduleOnReactor(
+        [self = shared_from_this()](const Status& status) {
+          // The batch is sent even if the task was aborted, so the callbacks are invoked.
+          self->FlushScheduled();
+        },
+        MonoDelta::FromMilliseconds(FLAGS_multi_raft_heartbeat_window_ms), SOURCE_LOCATION(),
+        messenger_);
+    if (task_id == rpc::kInvalidTaskId) {
+      FlushScheduled();
+    }
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushScheduled() {
+  std::vector<BatchEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries.swap(pending_);
+    flush_scheduled_ = false;
+  }
+  if (!entries.empty()) {
+    SendBatch(std::move(entries));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(std::vector<BatchEntry> entries) {
+  if (entries.size() == 1) {
+    SendIndividually(entries.front());
+    return;
+  }
+
+  auto call = std::make_shared<BatchCall>();
+  call->request.mutable_consensus_request()->Reserve(entries.size());
+  for (const auto& entry : entries) {
+    // Heartbeats don't contain operations, so they are cheap to copy.
+    call->request.add_consensus_request()->CopyFrom(*entry.request);
+  }
+  call->entries = std::move(entries);
+  SendCall(call);
+}
+
+void MultiRaftHeartbeatBatcher::SendKeepAliveIfIdle(MonoDelta interval) {
+  if (!BatchingSupported() ||
+      last_batch_time_.load(std::memory_order_acquire) + interval.ToSteadyDuration() >
+          CoarseMonoClock::Now()) {
+    return;
+  }
+  SendCall(std::make_shared<BatchCall>());
+}
+
+void MultiRaftHeartbeatBatcher::SetTabletQuiescent(const std::string& tablet_id, bool quiescent) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (quiescent) {
+    quiescent_tablets_.insert(tablet_id);
+  } else {
+    quiescent_tablets_.erase(tablet_id);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendCall(const std::shared_ptr<BatchCall>& call) {
+  last_batch_time_.store(CoarseMonoClock::Now(), std::memory_order_release);
+  call->request.set_caller_uuid(local_uuid_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    call->request.mutable_quiescent_tablet_ids()->Reserve(quiescent_tablets_.size());
+    for (const auto& tablet_id : quiescent_tablets_) {
+      call->request.add_quiescent_tablet_ids(tablet_id);
+    }
+  }
+  call->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  proxy_->MultiRaftUpdateConsensusAsync(
+      call->request, &call->response, &call->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::BatchResponseReceived, shared_from_this(), call));
+}
+
+void MultiRaftHeartbeatBatcher::BatchResponseReceived(const std::shared_ptr<BatchCall>& call) {
+  const Status status = call->controller.status();
+  if (status.ok() &&
+      static_cast<size_t>(call->response.consensus_response_size()) == call->entries.size()) {
+    for (size_t i = 0; i != call->entries.size(); ++i) {
+      auto& entry = call->entries[i];
+      entry.response->Swap(call->response.mutable_consensus_response(i));
+      entry.callback();
+    }
+    return;
+  }
+
+  if (status.ok()) {
+    LOG(DFATAL) << "Wrong number of responses from " << hostport_ << ": "
+                << call->response.consensus_response_size() << ", expected "
+                << call->entries.size();
+  } else {
+    const auto* error = call->controller.error_response();
+    if (error && (error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD ||
+                  error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_SERVICE)) {
+      LOG(INFO) << "Server " << hostport_ << " does not support batched heartbeats: " << status;
+      batching_unsupported_.store(true, std::memory_order_release);
+    } else if (!call->entries.empty()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << "Batched heartbeats to " << hostport_
+                                      << " failed, resending individually: " << status;
+    }
+  }
+
+  for (const auto& entry : call->entries) {
+    SendIndividually(entry);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::SendIndividually(const BatchEntry& entry) {
+  proxy_->UpdateConsensusAsync(*entry.request, entry.response, entry.controller, entry.callback);
+}
+
+MultiRaftManager::MultiRaftManager(std::shared_ptr<rpc::Messenger> messenger,
+                                   rpc::ProxyCache* proxy_cache,
+                                   const RaftPeerPB& local_peer_pb)
+    : messenger_(std::move(messenger)),
+      proxy_cache_(proxy_cache),
+      local_uuid_(local_peer_pb.permanent_uuid()),
+      local_peer_cloud_info_(local_peer_pb.cloud_info()) {
+}
+
+MultiRaftManager::~MultiRaftManager() {
+  Shutdown();
+}
+
+void MultiRaftManager::Start() {
+  std::weak_ptr<MultiRaftManager> weak_self = shared_from_this();
+  timer_ = rpc::PeriodicTimer::Create(
+      messenger_,
+      [weak_self]() {
+        if (auto self = weak_self.lock()) {
+          self->Heartbeat();
+        }
+      },
+      MonoDelta::FromMilliseconds(FLAGS_raft_heartbeat_interval_ms));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+  }
+  timer_->Start();
+}
+
+void MultiRaftManager::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+    quiescent_followers_.clear();
+  }
+  timer_->Stop();
+}
+
+void MultiRaftManager::ServerIsAlive(
+    const std::string& server_uuid,
+    const google::protobuf::RepeatedPtrField<std::string>& quiescent_tablet_ids) {
+  const auto now = CoarseMonoClock::Now();
+  // A batch built just before the leader asked the follower to quiesce does not list the tablet
+  // yet, and could be received after the follower became quiescent.
+  const auto grace_period = std::chrono::milliseconds(FLAGS_raft_heartbeat_interval_ms);
+  std::unordered_set<std::string> quiescent_tablets(
+      quiescent_tablet_ids.begin(), quiescent_tablet_ids.end());
+
+  std::vector<std::shared_ptr<RaftConsensus>> to_wake_up;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_alive_time_[server_uuid] = now;
+    auto it = quiescent_followers_.begin();
+    while (it != quiescent_followers_.end()) {
+      if (it->leader_uuid != server_uuid || it->since + grace_period > now ||
+          quiescent_tablets.count(it->tablet_id)) {
+        ++it;
+        continue;
+      }
+      if (auto consensus = it->consensus.lock()) {
+        to_wake_up.push_back(std::move(consensus));
+      }
+      it = quiescent_followers_.erase(it);
+    }
+  }
+
+  for (const auto& consensus : to_wake_up) {
+    consensus->WakeUpQuiescentFollower("tablet is no longer quiescent on the leader server");
+  }
+}
+
+bool MultiRaftManager::AddQuiescentFollower(const std::string& leader_uuid,
+                                            const std::string& tablet_id,
+                                            std::weak_ptr<RaftConsensus> consensus) {
+  auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!running_) {
+    return false;
+  }
+  // The follower has just received a request from the leader.
+  last_alive_time_[leader_uuid] = now;
+  quiescent_followers_.push_back(
+      QuiescentFollower{leader_uuid, tablet_id, now, std::move(consensus)});
+  return true;
+}
+
+void MultiRaftManager::Heartbeat() {
+  const auto interval = MonoDelta::FromMilliseconds(FLAGS_raft_heartbeat_interval_ms);
+  // Same as the leader failure timeout of RaftConsensus.
+  const std::chrono::milliseconds failure_timeout(static_cast<int64_t>(
+      FLAGS_leader_failure_max_missed_heartbeat_periods * FLAGS_raft_heartbeat_interval_ms));
+  const auto now = CoarseMonoClock::Now();
+
+  std::vector<MultiRaftHeartbeatBatcherPtr> batchers;
+  std::vector<std::shared_ptr<RaftConsensus>> to_wake_up;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FLAGS_raft_quiescence_idle_ms > 0) {
+      batchers.reserve(batchers_.size());
+      for (const auto& entry : batchers_) {
+        batchers.push_back(entry.second);
+      }
+    }
+
+    auto it = quiescent_followers_.begin();
+    while (it != quiescent_followers_.end()) {
+      auto consensus = it->consensus.lock();
+      if (!consensus || !consensus->IsQuiescentFollower()) {
+        // Destroyed or already woken up by its leader.
+        it = quiescent_followers_.erase(it);
+        continue;
+      }
+      auto alive_it = last_alive_time_.find(it->leader_uuid);
+      if (alive_it == last_alive_time_.end() || alive_it->second + failure_timeout < now) {
+        to_wake_up.push_back(std::move(consensus));
+        it = quiescent_followers_.erase(it);
+        continue;
+      }
+      ++it;
+    }
+  }
+
+  for (const auto& batcher : batchers) {
+    batcher->SendKeepAliveIfIdle(interval);
+  }
+  for (const auto& consensus : to_wake_up) {
+    consensus->WakeUpQuiescentFollower("no keep-alive from the leader server");
+  }
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB& remote_peer_pb) {
+  if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return nullptr;
+  }
+
+  auto hostport = HostPortFromPB(DesiredHostPort(remote_peer_pb, local_peer_cloud_info_));
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& batcher = batchers_[hostport];
+  if (!batcher) {
+    batcher = std::make_shared<MultiRaftHeartbeatBatcher>(
+        hostport, local_uuid_, proxy_cache_, messenger_);
+  }
+  return batcher;
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,164 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <google/protobuf/repeated_field.h>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/metadata.pb.h"
+
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+class ConsensusRequestPB;
+class ConsensusResponsePB;
+
+// Collects heartbeats sent by the tablet leaders of this server to the same remote server and
+// sends them in a single MultiRaftUpdateConsensus RPC.
+//
+// A heartbeat waits for at most multi_raft_heartbeat_window_ms for other heartbeats to join the
+// batch. If the batch RPC fails, the heartbeats are resent as individual UpdateConsensus RPCs, so
+// every peer gets the status of its own call, and the batcher falls back to individual RPCs when
+// the remote server does not support batches.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(const HostPort& hostport, std::string local_uuid,
+                            rpc::ProxyCache* proxy_cache,
+                            std::shared_ptr<rpc::Messenger> messenger);
+  ~MultiRaftHeartbeatBatcher();
+
+  // Sends the request as a part of a batch. The arguments have the same meaning and lifetime
+  // requirements as for ConsensusServiceProxy::UpdateConsensusAsync.
+  void AddRequestToBatch(const ConsensusRequestPB* request,
+                         ConsensusResponsePB* response,
+                         rpc::RpcController* controller,
+                         rpc::ResponseCallback callback);
+
+  // Sends an empty batch if no batch was sent during the last 'interval', so the followers of
+  // quiescent tablets on the remote server know that this server is alive.
+  void SendKeepAliveIfIdle(MonoDelta interval);
+
+  // Adds the tablet to or removes it from the list of quiescent tablets led by this server, that
+  // is sent with every batch and keep-alive to the remote server.
+  void SetTabletQuiescent(const std::string& tablet_id, bool quiescent);
+
+  // Whether heartbeats are actually batched, i.e. the remote server gets keep-alives.
+  bool BatchingSupported() const {
+    return !batching_unsupported_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct BatchEntry {
+    const ConsensusRequestPB* request;
+    ConsensusResponsePB* response;
+    rpc::RpcController* controller;
+    rpc::ResponseCallback callback;
+  };
+
+  struct BatchCall;
+
+  void FlushScheduled();
+  void SendBatch(std::vector<BatchEntry> entries);
+  void SendCall(const std::shared_ptr<BatchCall>& call);
+  void BatchResponseReceived(const std::shared_ptr<BatchCall>& call);
+  void SendIndividually(const BatchEntry& entry);
+
+  const HostPort hostport_;
+  const std::string local_uuid_;
+  ConsensusServiceProxyPtr proxy_;
+  std::shared_ptr<rpc::Messenger> messenger_;
+
+  std::mutex mutex_;
+  std::vector<BatchEntry> pending_;
+  bool flush_scheduled_ = false;
+  std::unordered_set<std::string> quiescent_tablets_;
+
+  // Set when the remote server does not support MultiRaftUpdateConsensus.
+  std::atomic<bool> batching_unsupported_{false};
+
+  std::atomic<CoarseTimePoint> last_batch_time_{CoarseTimePoint()};
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Holds the heartbeat batchers of a server, one per remote server.
+//
+// Also provides server level liveness for quiescent tablets. Every raft_heartbeat_interval_ms the
+// manager sends keep-alives to the remote servers that got no batch since the last round, and wakes
+// up the quiescent followers whose leader server stopped sending them.
+class MultiRaftManager : public std::enable_shared_from_this<MultiRaftManager> {
+ public:
+  MultiRaftManager(std::shared_ptr<rpc::Messenger> messenger, rpc::ProxyCache* proxy_cache,
+                   const RaftPeerPB& local_peer_pb);
+  ~MultiRaftManager();
+
+  void Start();
+  void Shutdown();
+
+  // Returns the batcher for heartbeats to the remote peer, or nullptr if batching is disabled.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const RaftPeerPB& remote_peer_pb);
+
+  // Records that a batch or a keep-alive was received from the server with 'server_uuid', and
+  // wakes up the quiescent followers of that server whose tablets are not in
+  // 'quiescent_tablet_ids', i.e. are no longer led by a quiescent replica on that server.
+  void ServerIsAlive(const std::string& server_uuid,
+                     const google::protobuf::RepeatedPtrField<std::string>& quiescent_tablet_ids);
+
+  // Returns false if the manager is not running, i.e. could not track quiescent followers.
+  bool AddQuiescentFollower(const std::string& leader_uuid, const std::string& tablet_id,
+                            std::weak_ptr<RaftConsensus> consensus);
+
+ private:
+  struct QuiescentFollower {
+    std::string leader_uuid;
+    std::string tablet_id;
+    // When the follower became quiescent.
+    CoarseTimePoint since;
+    std::weak_ptr<RaftConsensus> consensus;
+  };
+
+  void Heartbeat();
+
+  std::shared_ptr<rpc::Messenger> messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+  const std::string local_uuid_;
+  const CloudInfoPB local_peer_cloud_info_;
+
+  std::shared_ptr<rpc::PeriodicTimer> timer_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, MultiRaftHeartbeatBatcherPtr, HostPortHash> batchers_;
+  std::unordered_map<std::string, CoarseTimePoint> last_alive_time_;
+  std::vector<QuiescentFollower> quiescent_followers_;
+  bool running_ = false;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -110,6 +110,17 @@ void PeerManager::SignalRequest(RequestTriggerMode trigger_mode) {
   }
 }
 
+bool PeerManager::WakeUpQuiescentPeers() {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  bool woken_up = false;
+  for (const auto& entry : peers_) {
+    if (entry.second->WakeUpIfQuiescent()) {
+      woken_up = true;
+    }
+  }
+  return woken_up;
+}
+
 void PeerManager::Close() {
   std::lock_guard<simple_spinlock> lock(lock_);
   for (const auto& entry : peers_) {
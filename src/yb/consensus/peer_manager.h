@@ -81,6 +81,9 @@ class PeerManager {
   // Signals all peers of the current configuration that there is a new request pending.
   virtual void SignalRequest(RequestTriggerMode trigger_mode);
 
+  // Restarts the heartbeats of the quiescent peers. Returns true if any peer was quiescent.
+  virtual bool WakeUpQuiescentPeers();
+
   // Closes all peers.
   virtual void Close();
 
@@ -205,9 +205,11 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests) {
+    ThreadPool* log_prefetch_pool,
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager) {
   gscoped_ptr<PeerProxyFactory> rpc_factory(new RpcPeerProxyFactory(
-      messenger, proxy_cache, local_peer_pb.cloud_info()));
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager));
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -218,7 +220,8 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
                            local_peer_pb,
                            options.tablet_id,
                            clock,
-                           raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL)));
+                           raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL),
+                           log_prefetch_pool));
 
   DCHECK(local_peer_pb.has_permanent_uuid());
   const string& peer_uuid = local_peer_pb.permanent_uuid();
@@ -1030,6 +1033,10 @@ void RaftConsensus::NotifyTermChange(int64_t term) {
   WARN_NOT_OK(HandleTermAdvanceUnlocked(term), "Couldn't advance consensus term.");
 }
 
+void RaftConsensus::NotifyLogReadAheadDone() {
+  peer_manager_->SignalRequest(RequestTriggerMode::kNonEmptyOnly);
+}
+
 void RaftConsensus::NotifyFailedFollower(const string& uuid,
                                          int64_t term,
                                          const std::string& reason) {
@@ -1520,7 +1527,12 @@ Status RaftConsensus::UpdateReplica(ConsensusRequestPB* request,
     // Snooze the failure detector as soon as we decide to accept the message.
     // We are guaranteed to be acting as a FOLLOWER at this point by the above
     // sanity check.
-    SnoozeFailureDetector(DO_NOT_LOG);
+    if (!request->quiescent() && follower_quiescent_.load(std::memory_order_acquire)) {
+      VLOG_WITH_PREFIX(1) << "Leader woke up";
+      EnableFailureDetector();
+    } else {
+      SnoozeFailureDetector(DO_NOT_LOG);
+    }
 
     last_message_from_leader_time_ = MonoTime::Now();
 
@@ -1558,6 +1570,13 @@ Status RaftConsensus::UpdateReplica(ConsensusRequestPB* request,
     // we actually reply to the leader, we'll just wait for the messages to be durable.
     FillConsensusResponseOKUnlocked(response);
 
+    // Accept quiescence only when there is nothing left to apply.
+    if (request->quiescent() && deduped_req.messages.empty() &&
+        OpIdEquals(state_->GetCommittedOpIdUnlocked(), state_->GetLastReceivedOpIdUnlocked()) &&
+        QuiesceFailureDetectorUnlocked(request->caller_uuid())) {
+      response->set_quiescent(true);
+    }
+
     // Check if there is an election pending and the op id pending upon has just been committed.
     if (state_->HasOpIdCommittedUnlocked(state_->GetPendingElectionOpIdUnlocked())) {
       start_election = true;
@@ -2746,17 +2765,58 @@ void RaftConsensus::NonTxRoundReplicationFinished(ConsensusRound* round,
 }
 
 void RaftConsensus::EnableFailureDetector(MonoDelta delta) {
+  follower_quiescent_.store(false, std::memory_order_release);
   if (PREDICT_TRUE(FLAGS_enable_leader_failure_detection)) {
     failure_detector_->Start(delta);
   }
 }
 
 void RaftConsensus::DisableFailureDetector() {
+  follower_quiescent_.store(false, std::memory_order_release);
   if (PREDICT_TRUE(FLAGS_enable_leader_failure_detection)) {
     failure_detector_->Stop();
   }
 }
 
+bool RaftConsensus::QuiesceFailureDetectorUnlocked(const std::string& leader_uuid) {
+  DCHECK(state_->IsLocked());
+  if (follower_quiescent_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  auto* multi_raft_manager = peer_proxy_factory_->multi_raft_manager();
+  if (!multi_raft_manager) {
+    return false;
+  }
+
+  DisableFailureDetector();
+  follower_quiescent_.store(true, std::memory_order_release);
+  if (!multi_raft_manager->AddQuiescentFollower(leader_uuid, tablet_id(), shared_from_this())) {
+    EnableFailureDetector();
+    return false;
+  }
+  VLOG_WITH_PREFIX(1) << "Quiescent, leader: " << leader_uuid;
+  return true;
+}
+
+void RaftConsensus::WakeUpQuiescentFollower(const std::string& reason) {
+  auto lock = state_->LockForRead();
+  if (!follower_quiescent_.load(std::memory_order_acquire)) {
+    return;
+  }
+  LOG_WITH_PREFIX(INFO) << "Waking up quiescent follower: " << reason;
+  EnableFailureDetector();
+}
+
+bool RaftConsensus::WakeUpIfQuiescent() {
+  // Reset the idle timer in any case, so the peers do not quiesce again right away.
+  queue_->NotifyActivity();
+  if (!peer_manager_->WakeUpQuiescentPeers()) {
+    return false;
+  }
+  peer_manager_->SignalRequest(RequestTriggerMode::kAlwaysSend);
+  return true;
+}
+
 void RaftConsensus::SnoozeFailureDetector(AllowLogging allow_logging, MonoDelta delta) {
   if (PREDICT_TRUE(GetAtomicFlag(&FLAGS_enable_leader_failure_detection))) {
     if (allow_logging == ALLOW_LOGGING) {
@@ -107,7 +107,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests);
+    ThreadPool* log_prefetch_pool,
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager);
 
   RaftConsensus(
     const ConsensusOptions& options,
@@ -212,6 +214,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
                             int64_t term,
                             const std::string& reason) override;
 
+  void NotifyLogReadAheadDone() override;
+
   CHECKED_STATUS GetLastOpId(OpIdType type, OpId* id) override;
 
   MicrosTime MajorityReplicatedHtLeaseExpiration(
@@ -233,6 +237,17 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     reject_mode_.store(value, std::memory_order_release);
   }
 
+  bool WakeUpIfQuiescent() override;
+
+  // Whether the failure detector of this follower is stopped because its leader stopped sending
+  // heartbeats to the idle tablet.
+  bool IsQuiescentFollower() const {
+    return follower_quiescent_.load(std::memory_order_acquire);
+  }
+
+  // Restarts the failure detector of a quiescent follower.
+  void WakeUpQuiescentFollower(const std::string& reason);
+
  protected:
   // Trigger that a non-Operation ConsensusRound has finished replication.
   // If the replication was successful, an status will be OK. Otherwise, it
@@ -477,6 +492,11 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   void SnoozeFailureDetector(AllowLogging allow_logging,
                              MonoDelta delta = MonoDelta());
 
+  // Stops the failure detector of a follower whose leader requested quiescence, it is restarted by
+  // the next request without the quiescent flag or when the leader server stops sending
+  // keep-alives. Returns false if quiescence is not supported.
+  bool QuiesceFailureDetectorUnlocked(const std::string& leader_uuid);
+
   // Return the minimum election timeout. Due to backoff and random
   // jitter, election timeouts may be longer than this.
   MonoDelta MinimumElectionTimeout() const;
@@ -590,6 +610,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   std::shared_ptr<rpc::PeriodicTimer> failure_detector_;
 
+  // Set while the failure detector is stopped by QuiesceFailureDetectorUnlocked().
+  std::atomic<bool> follower_quiescent_{false};
+
   // If any RequestVote() RPC arrives before this hybrid time,
   // the request will be ignored. This prevents abandoned or partitioned
   // nodes from disturbing the healthy leader.
@@ -17,6 +17,7 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
 
 namespace yb {
 namespace docdb {
@@ -30,6 +31,8 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+// 1 if the file contains entries with explicit TTL, 0 otherwise.
+constexpr rocksdb::UserBoundaryTag kExplicitTtlTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -80,6 +83,60 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores whether the entry has explicit TTL.
+class ExplicitTtlValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit ExplicitTtlValue(bool explicit_ttl) : value_(explicit_ttl ? 1 : 0) {}
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != 1) {
+      return STATUS_SUBSTITUTE(Corruption, "Wrong size of explicit TTL value: $0", data.size());
+    }
+
+    *value = std::make_shared<ExplicitTtlValue>(data[0] != 0);
+    return Status::OK();
+  }
+
+  virtual ~ExplicitTtlValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kExplicitTtlTag;
+  }
+
+  Slice Encode() override {
+    return Slice(&value_, 1);
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const ExplicitTtlValue*>(&pre_rhs);
+    return static_cast<int>(value_) - static_cast<int>(rhs->value_);
+  }
+
+ private:
+  uint8_t value_;
+};
+
+// Returns true if the entry could expire differently from the table default TTL, i.e. it has its
+// own TTL or is a TTL-only merge record. Values that could not be decoded are also reported, so
+// files containing them are never treated as expired by the table TTL.
+bool HasExplicitTtl(Slice value) {
+  uint64_t merge_flags = 0;
+  if (!Value::DecodeMergeFlags(&value, &merge_flags).ok() || merge_flags == Value::kTtlFlag) {
+    return true;
+  }
+  if (DecodeValueType(value) == ValueType::kHybridTime) {
+    // Intent doc hybrid time of the value written by a transaction.
+    ConsumeValueType(&value);
+    DocHybridTime intent_doc_ht;
+    if (!intent_doc_ht.DecodeFrom(&value).ok()) {
+      return true;
+    }
+  }
+  MonoDelta ttl;
+  return !Value::DecodeTTL(&value, &ttl).ok() || !ttl.Equals(Value::kMaxTtl);
+}
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -147,6 +204,9 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kExplicitTtlTag) {
+      return ExplicitTtlValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -176,6 +236,7 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     rocksdb::UserBoundaryValuePtr temp;
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
+    values->push_back(std::make_shared<ExplicitTtlValue>(HasExplicitTtl(value)));
 
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
@@ -256,5 +317,13 @@ rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
 
+rocksdb::UserBoundaryTag TagForDocHybridTime() {
+  return kDocHybridTimeTag;
+}
+
+rocksdb::UserBoundaryTag TagForExplicitTtl() {
+  return kExplicitTtlTag;
+}
+
 } // namespace docdb
 } // namespace yb
@@ -373,6 +373,44 @@ TEST(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST(DocKeyTest, TestRangeComponentsKeyMatching) {
+  DocDbAwareFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, /* num_range_components */ 1);
+  const auto* transformer = policy.GetKeyTransformer();
+  auto encode = [](const std::vector<PrimitiveValue>& range_components) {
+    return DocKey(0, PrimitiveValues("hash_key"), range_components).Encode();
+  };
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  for (const auto& range_key : { "a", "b", "c" }) {
+    builder->AddKey(transformer->Transform(EncodeSubDocKey("hash_key", range_key, "sub_key", 1)));
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& key) {
+    return reader->MayMatch(transformer->Transform(key));
+  };
+  for (const auto& range_key : { "a", "b", "c" }) {
+    ASSERT_TRUE(may_match(EncodeSubDocKey("hash_key", range_key, "another_sub_key", 2)))
+        << "Range key: " << range_key;
+  }
+  ASSERT_FALSE(may_match(EncodeSubDocKey("hash_key", "d", "sub_key", 1)));
+
+  // Keys without the first range component can't be checked against the filter.
+  ASSERT_FALSE(transformer->IsFilterable(encode({}).AsSlice()));
+  ASSERT_TRUE(transformer->IsFilterable(encode(PrimitiveValues("a")).AsSlice()));
+  ASSERT_TRUE(transformer->IsFilterable(encode(PrimitiveValues("a", 10)).AsSlice()));
+
+  // Scans between keys that differ in the first range component can only use the hashed part.
+  DocKey lower(0, PrimitiveValues("hash_key"), PrimitiveValues("a", 10));
+  ASSERT_EQ(DocKey(0, PrimitiveValues("hash_key"), PrimitiveValues("a")),
+            lower.CommonPrefix(DocKey(0, PrimitiveValues("hash_key"), PrimitiveValues("a", 20))));
+  ASSERT_EQ(DocKey(0, PrimitiveValues("hash_key")),
+            lower.CommonPrefix(DocKey(0, PrimitiveValues("hash_key"), PrimitiveValues("b", 10))));
+}
+
 TEST(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/doc_key.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -415,6 +416,15 @@ bool DocKey::HashedComponentsEqual(const DocKey& other) const {
       (!hash_present_ || (hash_ == other.hash_ && hashed_group_ == other.hashed_group_));
 }
 
+DocKey DocKey::CommonPrefix(const DocKey& other) const {
+  DocKey result = *this;
+  auto mismatch = std::mismatch(
+      range_group_.begin(), range_group_.end(), other.range_group_.begin(),
+      other.range_group_.end());
+  result.range_group_.resize(mismatch.first - range_group_.begin());
+  return result;
+}
+
 void DocKey::AddRangeComponent(const PrimitiveValue& val) {
   range_group_.push_back(val);
 }
@@ -798,25 +808,67 @@ KeyBytes SubDocKey::AdvanceOutOfDocKeyPrefix() const {
 
 namespace {
 
+// Extracts the hashed components and the first num_range_components range components of the key.
+// Encoded components are self-delimiting, so the order of keys is preserved.
 class HashedComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
  public:
-  HashedComponentsExtractor() {}
+  explicit HashedComponentsExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
   HashedComponentsExtractor(const HashedComponentsExtractor&) = delete;
   HashedComponentsExtractor& operator=(const HashedComponentsExtractor&) = delete;
 
-  static HashedComponentsExtractor& GetInstance() {
-    static HashedComponentsExtractor instance;
-    return instance;
+  // Keys with fewer range components, like intents DB keys that are not document keys, are added
+  // to the filter with the components they have.
+  Slice Transform(Slice key) const override {
+    return Slice(key.data(), CHECK_RESULT(ExtractPrefix(key)).size);
   }
 
-  Slice Transform(Slice key) const override {
-    auto size = CHECK_RESULT(DocKey::EncodedSize(key, DocKeyPart::HASHED_PART_ONLY));
-    return Slice(key.data(), size);
+  bool IsFilterable(Slice key) const override {
+    auto prefix = ExtractPrefix(key);
+    return prefix.ok() && prefix->num_range_components == num_range_components_;
+  }
+
+ private:
+  struct Prefix {
+    size_t size;
+    size_t num_range_components;
+  };
+
+  Result<Prefix> ExtractPrefix(Slice key) const {
+    auto size = VERIFY_RESULT(DocKey::EncodedSize(key, DocKeyPart::HASHED_PART_ONLY));
+    Slice range_part(key.data() + size, key.end());
+    size_t num_range_components = 0;
+    while (num_range_components < num_range_components_ && !range_part.empty()) {
+      // Key prefixes used for lookups are not required to end with the group end.
+      Slice rest = range_part;
+      auto consumed = ConsumePrimitiveValueFromKey(&rest);
+      if (!consumed.ok() || !*consumed) {
+        break;
+      }
+      range_part = rest;
+      ++num_range_components;
+    }
+    return Prefix{static_cast<size_t>(range_part.data() - key.data()), num_range_components};
   }
+
+  const size_t num_range_components_;
 };
 
 } // namespace
 
+DocDbAwareFilterPolicy::DocDbAwareFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components)
+    : builtin_policy_(rocksdb::NewFixedSizeFilterPolicy(
+          filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger)),
+      key_transformer_(new HashedComponentsExtractor(num_range_components)),
+      name_(num_range_components == 0
+          ? "DocKeyHashedComponentsFilter"
+          : Format("DocKeyHashedAndRangeComponentsFilter$0", num_range_components)) {
+}
+
+DocDbAwareFilterPolicy::~DocDbAwareFilterPolicy() {
+}
+
 
 void DocDbAwareFilterPolicy::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
@@ -843,7 +895,7 @@ rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicy::GetFilterType() const
 }
 
 const rocksdb::FilterPolicy::KeyTransformer* DocDbAwareFilterPolicy::GetKeyTransformer() const {
-  return &HashedComponentsExtractor::GetInstance();
+  return key_transformer_.get();
 }
 
 }  // namespace docdb
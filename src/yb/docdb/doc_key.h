@@ -158,6 +158,10 @@ class DocKey {
 
   bool HashedComponentsEqual(const DocKey& other) const;
 
+  // Returns the key made of the hashed components of this key followed by the leading range
+  // components shared with other. All keys between this key and other start with it.
+  DocKey CommonPrefix(const DocKey& other) const;
+
   void AddRangeComponent(const PrimitiveValue& val);
 
   void SetRangeComponent(const PrimitiveValue& val, int idx);
@@ -543,15 +547,19 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
-// This filter policy only takes into account hashed components of keys for filtering.
+// This filter policy only takes into account hashed components of keys and the first
+// num_range_components range components for filtering. Lookups of keys with fewer range components
+// can't use such a filter, so tables scanned within a hash key should keep num_range_components
+// at 0, while tables with many rows per hash key read by point lookups benefit from a larger one.
 class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  DocDbAwareFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components = 0);
+  ~DocDbAwareFilterPolicy();
 
-  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
+  // The name is stored in SST files, so files written with a different number of range components
+  // are not checked against this filter.
+  const char* Name() const override { return name_.c_str(); }
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -567,6 +575,8 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 
  private:
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+  std::unique_ptr<const KeyTransformer> key_transformer_;
+  std::string name_;
 };
 
 // Combined DB to store regular records and intents.
@@ -70,7 +70,8 @@ Status DocRowwiseIterator::Init() {
 
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, BloomFilterMode::DONT_USE_BLOOM_FILTER,
-      boost::none /* user_key_for_filter */, query_id, txn_op_context_, deadline_, read_time_);
+      boost::none /* user_key_for_filter */, query_id, txn_op_context_, deadline_, read_time_,
+      CreateHybridTimeFileFilter(read_time_, schema_));
 
   row_key_ = DocKey(schema_);
   db_iter_->Seek(row_key_);
@@ -98,12 +99,13 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
       BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
-  const KeyBytes row_key_encoded = lower_doc_key.Encode();
-  const Slice row_key_encoded_as_slice = row_key_encoded.AsSlice();
+  // Filter on the most specific key shared by all rows in the scanned range.
+  const KeyBytes filter_key_encoded = lower_doc_key.CommonPrefix(upper_doc_key).Encode();
 
   db_iter_ = CreateIntentAwareIterator(
-      doc_db_, mode, row_key_encoded_as_slice, doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      doc_db_, mode, filter_key_encoded.AsSlice(), doc_spec.QueryId(), txn_op_context_,
+      deadline_, read_time_, CreateHybridTimeFileFilter(read_time_, schema_,
+                                                        doc_spec.CreateFileFilter()));
 
   row_ready_ = false;
 
@@ -175,12 +177,13 @@ Status DocRowwiseIterator::Init(const common::PgsqlScanSpec& spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
       BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
-  const KeyBytes row_key_encoded = lower_doc_key.Encode();
-  const Slice row_key_encoded_as_slice = row_key_encoded.AsSlice();
+  // Filter on the most specific key shared by all rows in the scanned range.
+  const KeyBytes filter_key_encoded = lower_doc_key.CommonPrefix(upper_doc_key).Encode();
 
   db_iter_ = CreateIntentAwareIterator(
-      doc_db_, mode, row_key_encoded_as_slice, doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      doc_db_, mode, filter_key_encoded.AsSlice(), doc_spec.QueryId(), txn_op_context_,
+      deadline_, read_time_, CreateHybridTimeFileFilter(read_time_, schema_,
+                                                        doc_spec.CreateFileFilter()));
 
   row_ready_ = false;
 
@@ -270,17 +270,16 @@ CHECKED_STATUS DocWriteBatch::SetPrimitiveInternal(
       DCHECK(!value.has_user_timestamp());
 
       // The document/subdocument that this subkey is supposed to live in does not exist, create it.
-      KeyBytes parent_key(key_prefix_);
-
       // Add the parent key to key/value batch before appending the encoded HybridTime to it.
       // (We replicate key/value pairs without the HybridTime and only add it before writing to
       // RocksDB.)
-      put_batch_.emplace_back(std::move(*parent_key.mutable_data()),
-                              string(1, ValueTypeAsChar::kObject));
+      KeyValuePairPB* kv_pair = put_batch_.Add();
+      kv_pair->set_key(key_prefix_.data());
+      kv_pair->mutable_value()->assign(1, ValueTypeAsChar::kObject);
 
       // Update our local cache to record the fact that we're adding this subdocument, so that
       // future operations in this DocWriteBatch don't have to add it or look for it in RocksDB.
-      cache_.Put(KeyBytes(key_prefix_.AsSlice()), hybrid_time, ValueType::kObject);
+      cache_.Put(key_prefix_, hybrid_time, ValueType::kObject);
       subkey.AppendToKey(&key_prefix_);
     }
   }
@@ -290,7 +289,9 @@ CHECKED_STATUS DocWriteBatch::SetPrimitiveInternal(
   RETURN_NOT_OK(should_apply);
   if (should_apply.get()) {
     // The key in the key/value batch does not have an encoded HybridTime.
-    put_batch_.emplace_back(key_prefix_.AsStringRef(), value.Encode());
+    KeyValuePairPB* kv_pair = put_batch_.Add();
+    kv_pair->set_key(key_prefix_.data());
+    value.EncodeAndAppend(kv_pair->mutable_value());
 
     // The key we use in the DocWriteBatchCache does not have a final hybrid_time, because that's
     // the key we expect to look up.
@@ -578,26 +579,25 @@ Status DocWriteBatch::ReplaceInList(
 }
 
 void DocWriteBatch::Clear() {
-  put_batch_.clear();
+  put_batch_.Clear();
   cache_.Clear();
 }
 
 void DocWriteBatch::MoveToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) {
-  kv_pb->mutable_write_pairs()->Reserve(put_batch_.size());
+  auto* write_pairs = kv_pb->mutable_write_pairs();
+  if (write_pairs->empty()) {
+    write_pairs->Swap(&put_batch_);
+    return;
+  }
+  write_pairs->Reserve(write_pairs->size() + put_batch_.size());
   for (auto& entry : put_batch_) {
-    KeyValuePairPB* kv_pair = kv_pb->add_write_pairs();
-    kv_pair->mutable_key()->swap(entry.first);
-    kv_pair->mutable_value()->swap(entry.second);
+    write_pairs->Add()->Swap(&entry);
   }
+  put_batch_.Clear();
 }
 
 void DocWriteBatch::TEST_CopyToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) const {
-  kv_pb->mutable_write_pairs()->Reserve(put_batch_.size());
-  for (auto& entry : put_batch_) {
-    KeyValuePairPB* kv_pair = kv_pb->add_write_pairs();
-    kv_pair->mutable_key()->assign(entry.first);
-    kv_pair->mutable_value()->assign(entry.second);
-  }
+  kv_pb->mutable_write_pairs()->MergeFrom(put_batch_);
 }
 
 }  // namespace docdb
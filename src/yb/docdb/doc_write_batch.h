@@ -16,6 +16,7 @@
 
 #include "yb/docdb/doc_path.h"
 #include "yb/docdb/doc_write_batch_cache.h"
+#include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 #include "yb/rocksdb/cache.h"
@@ -30,7 +31,6 @@ class DB;
 namespace yb {
 namespace docdb {
 
-class KeyValueWriteBatchPB;
 class IntentAwareIterator;
 
 struct LazyIterator {
@@ -189,10 +189,12 @@ class DocWriteBatch {
 
   size_t size() const { return put_batch_.size(); }
 
-  const std::vector<std::pair<std::string, std::string>>& key_value_pairs() const {
+  const google::protobuf::RepeatedPtrField<KeyValuePairPB>& key_value_pairs() const {
     return put_batch_;
   }
 
+  // Moves the accumulated key/value pairs to kv_pb. When kv_pb has no write pairs yet, the pairs
+  // are handed over without copying or allocating.
   void MoveToWriteBatchPB(KeyValueWriteBatchPB *kv_pb);
 
   // This method has worse performance comparing to MoveToWriteBatchPB and intented to be used in
@@ -239,7 +241,9 @@ class DocWriteBatch {
 
   const InitMarkerBehavior init_marker_behavior_;
   std::atomic<int64_t>* monotonic_counter_;
-  std::vector<std::pair<std::string, std::string>> put_batch_;
+  // Key/value pairs are encoded directly into the protobuf representation that is replicated, so
+  // there is no intermediate copy when the batch is moved to the write request.
+  google::protobuf::RepeatedPtrField<KeyValuePairPB> put_batch_;
 
   // Taken from internal_doc_iterator
   KeyBytes key_prefix_;
@@ -22,8 +22,6 @@
 #include "yb/docdb/primitive_value.h"
 #include "yb/util/bytes_formatter.h"
 
-using std::back_inserter;
-using std::copy;
 using std::endl;
 using std::ostringstream;
 using std::pair;
@@ -37,6 +35,20 @@ using yb::util::FormatBytesAsStr;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Most write batches touch a handful of key prefixes, so start small.
+constexpr size_t kArenaInitialBlockSize = 1024;
+constexpr size_t kInitialBucketCount = 16;
+
+} // namespace
+
+DocWriteBatchCache::DocWriteBatchCache()
+    : arena_(new Arena(kArenaInitialBlockSize)),
+      prefix_to_gen_ht_(kInitialBucketCount, Slice::Hash(), std::equal_to<Slice>(),
+                        ArenaAllocator<MapValue>(arena_.get())) {
+}
+
 void DocWriteBatchCache::Put(const KeyBytes& key_bytes, const DocWriteBatchCache::Entry& entry) {
     DOCDB_DEBUG_LOG(
       "Writing to DocWriteBatchCache: encoded_key_prefix=$0, gen_ht=$1, value_type=$2",
@@ -44,12 +56,18 @@ void DocWriteBatchCache::Put(const KeyBytes& key_bytes, const DocWriteBatchCache
       entry.doc_hybrid_time.ToString(),
       ToString(entry.value_type));
 
-  prefix_to_gen_ht_[key_bytes.AsStringRef()] = entry;
+  const Slice key = key_bytes.AsSlice();
+  auto it = prefix_to_gen_ht_.find(key);
+  if (it != prefix_to_gen_ht_.end()) {
+    it->second = entry;
+    return;
+  }
+  prefix_to_gen_ht_.emplace(Slice(arena_->AddSlice(key), key.size()), entry);
 }
 
 boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
     const KeyBytes& encoded_key_prefix) {
-  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix.AsStringRef());
+  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix.AsSlice());
 #ifdef DOCDB_DEBUG
   if (iter == prefix_to_gen_ht_.end()) {
     DOCDB_DEBUG_LOG("DocWriteBatchCache contained no entry for $0",
@@ -64,7 +82,10 @@ boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
 
 string DocWriteBatchCache::ToDebugString() {
   vector<pair<string, Entry>> sorted_contents;
-  copy(prefix_to_gen_ht_.begin(), prefix_to_gen_ht_.end(), back_inserter(sorted_contents));
+  sorted_contents.reserve(prefix_to_gen_ht_.size());
+  for (const auto& kv : prefix_to_gen_ht_) {
+    sorted_contents.emplace_back(kv.first.ToBuffer(), kv.second);
+  }
   sort(sorted_contents.begin(), sorted_contents.end());
   ostringstream ss;
   ss << "DocWriteBatchCache[" << endl;
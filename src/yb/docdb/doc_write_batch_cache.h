@@ -14,6 +14,7 @@
 #ifndef YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 #define YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 
@@ -23,6 +24,7 @@
 #include "yb/docdb/key_bytes.h"
 #include "yb/docdb/value_type.h"
 #include "yb/docdb/value.h"
+#include "yb/util/memory/arena.h"
 
 namespace yb {
 namespace docdb {
@@ -31,9 +33,13 @@ namespace docdb {
 // or deletion) for key prefixes that were read from RocksDB or created by previous operations
 // performed on the DocWriteBatch.
 //
+// Cached key prefixes are copied into an arena owned by the cache, so populating the cache does
+// not perform a heap allocation per key. The arena is released together with the cache.
+//
 // This class is not thread-safe.
 class DocWriteBatchCache {
  public:
+  DocWriteBatchCache();
   struct Entry {
     DocHybridTime doc_hybrid_time;
     ValueType value_type;
@@ -64,17 +70,24 @@ class DocWriteBatchCache {
 
   // Returns the latest generation hybrid_time for the document/subdocument identified by the given
   // encoded key prefix.
-  // TODO: switch to taking a slice as an input to avoid making a copy on lookup.
   boost::optional<Entry> Get(const KeyBytes& encoded_key_prefix);
 
   std::string ToDebugString();
 
   static std::string EntryToStr(const Entry& entry);
 
+  // Removes all entries. Memory used by the keys is retained by the arena until the cache is
+  // destroyed.
   void Clear();
 
  private:
-  std::unordered_map<std::string, Entry> prefix_to_gen_ht_;
+  typedef std::pair<const Slice, Entry> MapValue;
+  typedef std::unordered_map<Slice, Entry, Slice::Hash, std::equal_to<Slice>,
+                             ArenaAllocator<MapValue>> Map;
+
+  // Allocated separately, so the cache (and the DocWriteBatch that owns it) remains movable.
+  std::unique_ptr<Arena> arena_;
+  Map prefix_to_gen_ht_;
 };
 
 
@@ -21,8 +21,10 @@
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
+#include "yb/common/partition.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
@@ -1934,6 +1936,27 @@ SubDocKey(DocKey([], ["k1"]), ["s3"; HT{ physical: 2000 }]) -> "v3"; ttl: 0.000s
       )#");
 }
 
+TEST_F(DocDBTest, CompactionRemovesKeysOutOfBounds) {
+  const DocKey doc_key1(0x1000, PrimitiveValues("h1"), PrimitiveValues());
+  const DocKey doc_key2(0x5000, PrimitiveValues("h2"), PrimitiveValues());
+  const DocKey doc_key3(0x9000, PrimitiveValues("h3"), PrimitiveValues());
+  for (const auto* doc_key : {&doc_key1, &doc_key2, &doc_key3}) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key->Encode(), PrimitiveValue("c")), PrimitiveValue("v"), 1000_usec_ht));
+  }
+
+  // Bounds of the tablet that got the [0x4000, 0x8000) hash range after a split.
+  auto hash_bound = [](uint16_t hash) {
+    return std::string(1, static_cast<char>(ValueType::kUInt16Hash)) +
+           PartitionSchema::EncodeMultiColumnHashValue(hash);
+  };
+  key_bounds_ = KeyBounds(hash_bound(0x4000), hash_bound(0x8000));
+  FullyCompactHistoryBefore(500_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey(0x5000, ["h2"], []), ["c"; HT{ physical: 1000 }]) -> "v"
+      )#");
+}
+
 TEST_F(DocDBTest, MinorCompactionNoDeletions) {
   ASSERT_OK(DisableCompactions());
   const DocKey doc_key(PrimitiveValues("k"));
@@ -2353,6 +2376,33 @@ TEST_F(DocDBTest, MultiOperationDocWriteBatch) {
       )#", dwb_str);
 }
 
+TEST_F(DocDBTest, MoveDocWriteBatchToPB) {
+  const auto encoded_doc_key = DocKey(PrimitiveValues("a")).Encode();
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "b"), PrimitiveValue("v1")));
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "c"), PrimitiveValue("v2")));
+  ASSERT_EQ(2U, dwb.size());
+
+  KeyValueWriteBatchPB copy_pb;
+  dwb.TEST_CopyToWriteBatchPB(&copy_pb);
+  ASSERT_EQ(2U, dwb.size());
+
+  KeyValueWriteBatchPB write_batch;
+  dwb.MoveToWriteBatchPB(&write_batch);
+  ASSERT_TRUE(dwb.IsEmpty());
+  ASSERT_EQ(copy_pb.ShortDebugString(), write_batch.ShortDebugString());
+
+  // Pairs moved into a non-empty batch are appended after the existing ones.
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "d"), PrimitiveValue("v3")));
+  dwb.MoveToWriteBatchPB(&write_batch);
+  ASSERT_TRUE(dwb.IsEmpty());
+  ASSERT_EQ(3, write_batch.write_pairs_size());
+  for (int i = 0; i != copy_pb.write_pairs_size(); ++i) {
+    ASSERT_EQ(copy_pb.write_pairs(i).key(), write_batch.write_pairs(i).key());
+  }
+  ASSERT_EQ(Value(PrimitiveValue("v3")).Encode(), write_batch.write_pairs(2).value());
+}
+
 class DocDBTestBoundaryValues: public DocDBTest {
  protected:
   void TestBoundaryValues(size_t flush_rate) {
@@ -2443,6 +2493,46 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+TEST_F(DocDBTest, HybridTimeFileFilter) {
+  // Files with one key each, written at 1000, 2000 and 3000 microseconds.
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_OK(SetPrimitive(DocPath(DocKey(PrimitiveValues(Format("key$0", i))).Encode()),
+                           PrimitiveValue(i), HybridTime::FromMicros(i * 1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  Schema schema;
+  auto count_keys = [this, &schema](const ReadHybridTime& read_time) {
+    auto iter = CreateRocksDBIterator(
+        rocksdb(), BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
+        rocksdb::kDefaultQueryId, CreateHybridTimeFileFilter(read_time, schema));
+    size_t result = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++result;
+    }
+    return result;
+  };
+
+  auto read_time = ReadHybridTime::FromMicros(2500);
+  // The file written after the read time is skipped.
+  ASSERT_EQ(2, count_keys(read_time));
+
+  // But not when it could require a read restart.
+  read_time.local_limit = read_time.global_limit = HybridTime::FromMicros(3000);
+  ASSERT_EQ(3, count_keys(read_time));
+
+  // The first file has expired by the table TTL.
+  schema.SetDefaultTimeToLive(1);
+  ASSERT_EQ(2, count_keys(read_time));
+
+  // Entry with explicit TTL could outlive the table TTL, so files are not filtered by TTL anymore.
+  ASSERT_OK(SetPrimitive(DocPath(DocKey(PrimitiveValues("key4")).Encode()),
+                         Value(PrimitiveValue(4), MonoDelta::FromMilliseconds(10)),
+                         HybridTime::FromMicros(500)));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_EQ(4, count_keys(read_time));
+}
+
 TEST_F(DocDBTest, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
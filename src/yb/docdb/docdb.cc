@@ -47,6 +47,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/status.h"
 #include "yb/util/metrics.h"
+#include "yb/util/request_stages.h"
 
 using std::endl;
 using std::list;
@@ -259,12 +260,13 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
 
   FilterKeysToLock(&determine_keys_to_lock_result.lock_batch);
 
-  const MonoTime start_time = (write_lock_latency != nullptr) ? MonoTime::Now() : MonoTime();
+  const MonoTime start_time = MonoTime::Now();
   result.lock_batch = LockBatch(lock_manager, std::move(determine_keys_to_lock_result.lock_batch));
+  const MonoDelta elapsed_time = MonoTime::Now().GetDeltaSince(start_time);
   if (write_lock_latency != nullptr) {
-    const MonoDelta elapsed_time = MonoTime::Now().GetDeltaSince(start_time);
     write_lock_latency->Increment(elapsed_time.ToMicroseconds());
   }
+  RecordRequestStage(RequestStage::kLockWait, elapsed_time);
 
   return result;
 }
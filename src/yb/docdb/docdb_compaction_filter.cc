@@ -39,9 +39,11 @@ namespace docdb {
 
 DocDBCompactionFilter::DocDBCompactionFilter(
     HistoryRetentionDirective retention,
-    IsMajorCompaction is_major_compaction)
+    IsMajorCompaction is_major_compaction,
+    const KeyBounds* key_bounds)
     : retention_(std::move(retention)),
-      is_major_compaction_(is_major_compaction) {
+      is_major_compaction_(is_major_compaction),
+      key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -80,6 +82,11 @@ bool DocDBCompactionFilter::Filter(int level,
     DISCARD_KEY_AND_RETURN();
   }
 
+  // Remove the keys that belong to the other half of a split tablet.
+  if (key_bounds_ && !key_bounds_->IsWithinBounds(key)) {
+    DISCARD_KEY_AND_RETURN();
+  }
+
   SubDocKey subdoc_key;
 
   // TODO: Find a better way for handling of data corruption encountered during compactions.
@@ -292,8 +299,9 @@ const char* DocDBCompactionFilter::Name() const {
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
-    shared_ptr<HistoryRetentionPolicy> retention_policy)
-    : retention_policy_(retention_policy) {
+    shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds)
+    : retention_policy_(retention_policy),
+      key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
@@ -304,7 +312,8 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
   return unique_ptr<DocDBCompactionFilter>(
       new DocDBCompactionFilter(
           retention_policy_->GetRetentionDirective(),
-          IsMajorCompaction(context.is_full_compaction)));
+          IsMajorCompaction(context.is_full_compaction),
+          key_bounds_));
 }
 
 const char* DocDBCompactionFilterFactory::Name() const {
@@ -50,12 +50,34 @@ struct HistoryRetentionDirective {
   MonoDelta table_ttl;
 };
 
+// Range of encoded DocDB keys owned by a tablet. Keys outside of the range are left behind by a
+// tablet split and are removed by compactions. An empty bound means the range is unbounded on that
+// side.
+struct KeyBounds {
+  std::string lower;
+  std::string upper;
+
+  KeyBounds() = default;
+  KeyBounds(std::string lower_, std::string upper_)
+      : lower(std::move(lower_)), upper(std::move(upper_)) {}
+
+  bool IsWithinBounds(const Slice& key) const {
+    return (lower.empty() || key.compare(lower) >= 0) &&
+           (upper.empty() || key.compare(upper) < 0);
+  }
+
+  bool IsInitialized() const {
+    return !lower.empty() || !upper.empty();
+  }
+};
+
 // DocDB compaction filter. A new instance of this class is created for every compaction.
 class DocDBCompactionFilter : public rocksdb::CompactionFilter {
  public:
   DocDBCompactionFilter(
       HistoryRetentionDirective retention,
-      IsMajorCompaction is_major_compaction);
+      IsMajorCompaction is_major_compaction,
+      const KeyBounds* key_bounds);
 
   ~DocDBCompactionFilter() override;
   bool Filter(int level,
@@ -77,6 +99,7 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
  private:
   const HistoryRetentionDirective retention_;
   const IsMajorCompaction is_major_compaction_;
+  const KeyBounds* key_bounds_;
 
   mutable bool is_first_key_value_ = true;
   mutable SubDocKey prev_subdoc_key_;
@@ -136,7 +159,10 @@ class HistoryRetentionPolicy {
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
  public:
-  explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy);
+  // key_bounds, when specified, should outlive the factory.
+  explicit DocDBCompactionFilterFactory(
+      std::shared_ptr<HistoryRetentionPolicy> retention_policy,
+      const KeyBounds* key_bounds = nullptr);
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
@@ -144,6 +170,7 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
 
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
+  const KeyBounds* key_bounds_;
 };
 
 // A history retention policy that can be configured manually. Useful in tests. This class is
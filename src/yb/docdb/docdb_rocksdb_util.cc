@@ -20,7 +20,9 @@
 
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/db/compaction.h"
 
+#include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
@@ -73,6 +75,9 @@ DEFINE_int64(db_write_buffer_size, -1,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_hybrid_time_file_filter, true,
+            "Whether scans should skip SST files that have no data visible at the read time, "
+            "because it was written after the read time or has expired by the table TTL.");
 DEFINE_int32(max_nexts_to_avoid_seek, 1,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
@@ -89,6 +94,8 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+rocksdb::UserBoundaryTag TagForDocHybridTime();
+rocksdb::UserBoundaryTag TagForExplicitTtl();
 
 Status SeekToValidKvAtTs(
     rocksdb::Iterator *iter,
@@ -339,8 +346,78 @@ rocksdb::ReadOptions PrepareReadOptions(
   return read_opts;
 }
 
+bool DecodeDocHybridTime(const rocksdb::LightweightBoundaries& boundaries, DocHybridTime* out) {
+  const Slice* value = boundaries.user_value_with_tag(TagForDocHybridTime());
+  return value && out->FullyDecodeFrom(*value).ok();
+}
+
+// Filters out files whose entries are all written after the read time, or have all expired by the
+// table TTL at the read time. The key based filter, if any, is applied first.
+//
+// Files are filtered by TTL only if the table TTL is the only TTL that applies to their entries,
+// i.e. no file of the level has entries with explicit TTL. Then all versions of a key that are
+// older than an expired one have also expired, so skipping the file does not expose them. Older
+// files don't have the explicit TTL boundary value and disable filtering by TTL.
+class HybridTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  HybridTimeFileFilter(const ReadHybridTime& read_time, const MonoDelta& table_ttl,
+                       std::shared_ptr<rocksdb::ReadFileFilter> key_filter)
+      : read_time_(read_time), table_ttl_(table_ttl), key_filter_(std::move(key_filter)) {
+  }
+
+  void Prepare(const rocksdb::FdWithBoundaries* files, size_t num_files) override {
+    if (key_filter_) {
+      key_filter_->Prepare(files, num_files);
+    }
+    filter_by_ttl_ = !table_ttl_.Equals(Value::kMaxTtl);
+    for (size_t i = 0; filter_by_ttl_ && i != num_files; ++i) {
+      const Slice* explicit_ttl = files[i].largest.user_value_with_tag(TagForExplicitTtl());
+      filter_by_ttl_ = explicit_ttl && *explicit_ttl == Slice("\0", 1);
+    }
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (key_filter_ && !key_filter_->Filter(file)) {
+      return false;
+    }
+    DocHybridTime doc_ht;
+    // Values written after global_limit are not visible and don't require a read restart.
+    if (DecodeDocHybridTime(file.smallest, &doc_ht) &&
+        doc_ht.hybrid_time() > read_time_.global_limit) {
+      return false;
+    }
+    if (filter_by_ttl_ && DecodeDocHybridTime(file.largest, &doc_ht)) {
+      bool has_expired = false;
+      if (HasExpiredTTL(doc_ht.hybrid_time(), table_ttl_, read_time_.read, &has_expired).ok() &&
+          has_expired) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  const ReadHybridTime read_time_;
+  const MonoDelta table_ttl_;
+  std::shared_ptr<rocksdb::ReadFileFilter> key_filter_;
+  bool filter_by_ttl_ = false;
+};
+
 } // namespace
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    const ReadHybridTime& read_time, const Schema& schema,
+    std::shared_ptr<rocksdb::ReadFileFilter> key_filter) {
+  if (!FLAGS_use_hybrid_time_file_filter) {
+    return key_filter;
+  }
+  // Transactional writes are ordered by commit time, so the table TTL is not enough to tell that
+  // older versions of the keys from a file have expired.
+  const MonoDelta table_ttl = schema.table_properties().is_transactional() ? Value::kMaxTtl
+                                                                           : TableTTL(schema);
+  return std::make_shared<HybridTimeFileFilter>(read_time, table_ttl, std::move(key_filter));
+}
+
 unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -421,7 +498,8 @@ void AutoInitRocksDBFlags(rocksdb::Options* options) {
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& tablet_id,
     const shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options) {
+    const tablet::TabletOptions& tablet_options,
+    size_t bloom_filter_range_components) {
   AutoInitRocksDBFlags(options);
   options->create_if_missing = true;
   options->disableDataSync = true;
@@ -457,7 +535,8 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     table_options.filter_policy.reset(new DocDbAwareFilterPolicy(
-        table_options.filter_block_size * 8, options->info_log.get()));
+        table_options.filter_block_size * 8, options->info_log.get(),
+        bloom_filter_range_components));
   }
 
   if (FLAGS_use_multi_level_index) {
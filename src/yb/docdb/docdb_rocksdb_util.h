@@ -107,7 +107,9 @@ enum class BloomFilterMode {
 // keys with the same hashed components as key specified for seek operation.
 // Note: bloom_filter_mode should be specified explicitly to avoid using it incorrectly by default.
 // user_key_for_filter is used with BloomFilterMode::USE_BLOOM_FILTER to exclude SST files which
-// have the same hashed components as (Sub)DocKey encoded in user_key_for_filter.
+// have the same hashed components as (Sub)DocKey encoded in user_key_for_filter. When the filter
+// also covers range components, user_key_for_filter should contain the range components shared by
+// all scanned keys. SST files are not filtered if it has fewer range components than the filter.
 std::unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -116,6 +118,12 @@ std::unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
     const Slice* iterate_upper_bound = nullptr);
 
+// Returns the filter that skips SST files with no entries visible at read_time, according to
+// their hybrid time and the table TTL from schema, combined with key_filter.
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    const ReadHybridTime& read_time, const Schema& schema,
+    std::shared_ptr<rocksdb::ReadFileFilter> key_filter = nullptr);
+
 // Values and transactions committed later than high_ht can be skipped, so we won't spend time
 // for re-requesting pending transaction status if we already know it wasn't committed at high_ht.
 std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
@@ -131,11 +139,13 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
 
 // Initialize the RocksDB 'options' object for tablet identified by 'tablet_id'. The 'statistics'
 // object provided by the caller will be used by RocksDB to maintain the stats for the tablet
-// specified by 'tablet_id'.
+// specified by 'tablet_id'. Bloom filters are built on the hashed components of keys and the first
+// 'bloom_filter_range_components' range components.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& tablet_id,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options);
+    const tablet::TabletOptions& tablet_options,
+    size_t bloom_filter_range_components = 0);
 
 }  // namespace docdb
 }  // namespace yb
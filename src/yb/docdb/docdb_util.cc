@@ -161,8 +161,8 @@ Status DocDBRocksDBUtil::PopulateRocksDBWriteBatch(
       SubDocKey subdoc_key;
       // We don't expect any invalid encoded keys in the write batch. However, these encoded keys
       // don't contain the HybridTime.
-      RETURN_NOT_OK_PREPEND(subdoc_key.FullyDecodeFromKeyWithOptionalHybridTime(entry.first),
-          Substitute("when decoding key: $0", FormatBytesAsStr(entry.first)));
+      RETURN_NOT_OK_PREPEND(subdoc_key.FullyDecodeFromKeyWithOptionalHybridTime(entry.key()),
+          Substitute("when decoding key: $0", FormatBytesAsStr(entry.key())));
     }
   }
 
@@ -186,13 +186,13 @@ Status DocDBRocksDBUtil::PopulateRocksDBWriteBatch(
         // HybridTime provided. Append a PrimitiveValue with the HybridTime to the key.
         const KeyBytes encoded_ht =
             PrimitiveValue(DocHybridTime(hybrid_time, write_id)).ToKeyBytes();
-        rocksdb_key = entry.first + encoded_ht.data();
+        rocksdb_key = entry.key() + encoded_ht.data();
       } else {
         // Useful when printing out a write batch that does not yet know the HybridTime it will be
         // committed with.
-        rocksdb_key = entry.first;
+        rocksdb_key = entry.key();
       }
-      rocksdb_write_batch->Put(rocksdb_key, entry.second);
+      rocksdb_write_batch->Put(rocksdb_key, entry.value());
       if (increment_write_id) {
         ++write_id;
       }
@@ -250,7 +250,7 @@ Status DocDBRocksDBUtil::InitCommonRocksDBOptions() {
                             tablet_options);
   InitRocksDBWriteOptions(&write_options_);
   rocksdb_options_.compaction_filter_factory =
-      std::make_shared<docdb::DocDBCompactionFilterFactory>(retention_policy_);
+      std::make_shared<docdb::DocDBCompactionFilterFactory>(retention_policy_, &key_bounds_);
   return Status::OK();
 }
 
@@ -202,6 +202,8 @@ class DocDBRocksDBUtil {
   std::shared_ptr<rocksdb::Cache> block_cache_;
   std::shared_ptr<ManualHistoryRetentionPolicy> retention_policy_ {
       std::make_shared<ManualHistoryRetentionPolicy>() };
+  // Keys outside of these bounds are removed by compactions.
+  KeyBounds key_bounds_;
 
   rocksdb::WriteOptions write_options_;
   Schema schema_;
@@ -0,0 +1,190 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/common/wire_protocol.h"
+#include "yb/integration-tests/cluster_verifier.h"
+#include "yb/integration-tests/external_mini_cluster-itest-base.h"
+#include "yb/integration-tests/test_workload.h"
+#include "yb/master/master.proxy.h"
+#include "yb/rpc/rpc_controller.h"
+
+using std::string;
+using std::vector;
+
+namespace yb {
+
+namespace {
+
+const MonoDelta kTimeout = MonoDelta::FromSeconds(60);
+
+} // namespace
+
+class TabletSplitITest : public ExternalMiniClusterITestBase {
+ protected:
+  void StartClusterAndWorkload(const vector<string>& extra_ts_flags = {},
+                               const vector<string>& extra_master_flags = {}) {
+    ASSERT_NO_FATALS(StartCluster(extra_ts_flags, extra_master_flags));
+    workload_.reset(new TestWorkload(cluster_.get()));
+    workload_->set_num_tablets(1);
+    workload_->set_num_write_threads(2);
+    workload_->Setup();
+  }
+
+  void TearDown() override {
+    workload_.reset();
+    ExternalMiniClusterITestBase::TearDown();
+  }
+
+  Result<vector<TabletId>> GetTabletIds() {
+    vector<TabletId> tablet_ids;
+    vector<string> ranges;
+    RETURN_NOT_OK(client_->GetTablets(workload_->table_name(), 0 /* max_tablets */, &tablet_ids,
+                                      &ranges));
+    return tablet_ids;
+  }
+
+  // Asks the master to split the tablet in the middle of its hash range.
+  Result<vector<TabletId>> SplitTablet(const TabletId& tablet_id) {
+    master::SplitTabletRequestPB req;
+    master::SplitTabletResponsePB resp;
+    rpc::RpcController rpc;
+    rpc.set_timeout(kTimeout);
+    req.set_tablet_id(tablet_id);
+    RETURN_NOT_OK(cluster_->master_proxy()->SplitTablet(req, &resp, &rpc));
+    if (resp.has_error()) {
+      return StatusFromPB(resp.error().status());
+    }
+    return vector<TabletId>(resp.new_tablet_ids().begin(), resp.new_tablet_ids().end());
+  }
+
+  // Waits until the table has at least the given number of tablets and returns them.
+  Result<vector<TabletId>> WaitForTablets(size_t num_tablets) {
+    vector<TabletId> tablet_ids;
+    RETURN_NOT_OK(WaitFor([this, num_tablets, &tablet_ids]() -> Result<bool> {
+      tablet_ids = VERIFY_RESULT(GetTabletIds());
+      return tablet_ids.size() >= num_tablets;
+    }, kTimeout, Format("Wait for $0 tablets", num_tablets)));
+    return tablet_ids;
+  }
+
+  void WaitInserted(int64_t num_rows) {
+    ASSERT_OK(WaitFor([this, num_rows] {
+      return workload_->rows_inserted() >= num_rows;
+    }, kTimeout, Format("Wait for $0 rows", num_rows)));
+  }
+
+  void CheckRowCount(int64_t num_rows) {
+    ClusterVerifier cluster_verifier(cluster_.get());
+    ASSERT_NO_FATALS(cluster_verifier.CheckRowCountWithRetries(
+        workload_->table_name(), ClusterVerifier::AT_LEAST, num_rows, kTimeout));
+  }
+
+  void RestartCluster() {
+    cluster_->Shutdown();
+    ASSERT_OK(cluster_->Restart());
+    ASSERT_OK(cluster_->WaitForTabletServerCount(cluster_->num_tablet_servers(), kTimeout));
+  }
+
+  std::unique_ptr<TestWorkload> workload_;
+};
+
+// Splits the tablet while it is written, so the writes sent to the split tablet are retried by the
+// client on the new tablets, and checks that the data survives a restart.
+TEST_F(TabletSplitITest, SplitUnderLoadAndRestart) {
+  ASSERT_NO_FATALS(StartClusterAndWorkload());
+  workload_->Start();
+  ASSERT_NO_FATALS(WaitInserted(500));
+
+  auto tablet_ids = ASSERT_RESULT(GetTabletIds());
+  ASSERT_EQ(1, tablet_ids.size());
+  auto new_tablet_ids = ASSERT_RESULT(SplitTablet(tablet_ids[0]));
+  ASSERT_EQ(2, new_tablet_ids.size());
+
+  // Asking again while the split is in progress returns the same tablets.
+  auto repeated_split = SplitTablet(tablet_ids[0]);
+  if (repeated_split.ok()) {
+    ASSERT_EQ(new_tablet_ids, *repeated_split);
+  }
+
+  auto split_tablet_ids = ASSERT_RESULT(WaitForTablets(2));
+  std::sort(split_tablet_ids.begin(), split_tablet_ids.end());
+  std::sort(new_tablet_ids.begin(), new_tablet_ids.end());
+  ASSERT_EQ(new_tablet_ids, split_tablet_ids);
+
+  // The client of the workload cached the split tablet, writes should go on.
+  ASSERT_NO_FATALS(WaitInserted(workload_->rows_inserted() + 500));
+  workload_->StopAndJoin();
+  const int64_t rows_inserted = workload_->rows_inserted();
+  ASSERT_NO_FATALS(CheckRowCount(rows_inserted));
+
+  ASSERT_NO_FATALS(RestartCluster());
+  auto tablet_ids_after_restart = ASSERT_RESULT(GetTabletIds());
+  std::sort(tablet_ids_after_restart.begin(), tablet_ids_after_restart.end());
+  ASSERT_EQ(split_tablet_ids, tablet_ids_after_restart);
+  ASSERT_NO_FATALS(CheckRowCount(rows_inserted));
+}
+
+// The master splits the tablet once its size reported by the tablet servers gets above the
+// threshold.
+TEST_F(TabletSplitITest, SplitBySize) {
+  ASSERT_NO_FATALS(StartClusterAndWorkload(
+      {"--memstore_size_mb=1"}, {"--tablet_split_size_threshold_bytes=262144"}));
+  workload_->set_payload_bytes(1024);
+  workload_->Start();
+
+  ASSERT_OK(WaitForTablets(2));
+  ASSERT_OK(cluster_->SetFlag(cluster_->master(), "tablet_split_size_threshold_bytes", "0"));
+  workload_->StopAndJoin();
+  ASSERT_NO_FATALS(CheckRowCount(workload_->rows_inserted()));
+}
+
+// A tablet server that crashes after creating the data of a new tablet but before marking it ready
+// creates the tablet again after restart.
+TEST_F(TabletSplitITest, CrashBeforeNewTabletReady) {
+  constexpr int kTsIndex = 0;
+  ASSERT_NO_FATALS(StartClusterAndWorkload());
+  workload_->Start();
+  ASSERT_NO_FATALS(WaitInserted(500));
+  workload_->StopAndJoin();
+  const int64_t rows_inserted = workload_->rows_inserted();
+
+  ASSERT_OK(cluster_->SetFlag(
+      cluster_->tablet_server(kTsIndex), "fault_crash_before_split_tablet_ready", "1.0"));
+  auto tablet_ids = ASSERT_RESULT(GetTabletIds());
+  ASSERT_EQ(1, tablet_ids.size());
+  auto new_tablet_ids = ASSERT_RESULT(SplitTablet(tablet_ids[0]));
+  ASSERT_OK(cluster_->WaitForTSToCrash(kTsIndex));
+
+  // The other replicas complete the split.
+  ASSERT_OK(WaitForTablets(2));
+
+  cluster_->tablet_server(kTsIndex)->Shutdown();
+  ASSERT_OK(cluster_->tablet_server(kTsIndex)->Restart());
+  for (const auto& tablet_id : new_tablet_ids) {
+    ASSERT_OK(inspect_->WaitForTabletDataStateOnTS(
+        kTsIndex, tablet_id, tablet::TABLET_DATA_READY, kTimeout));
+  }
+  ASSERT_OK(cluster_->WaitForTabletsRunning(cluster_->tablet_server(kTsIndex), kTimeout));
+  ASSERT_NO_FATALS(CheckRowCount(rows_inserted));
+
+  ASSERT_NO_FATALS(RestartCluster());
+  ASSERT_NO_FATALS(CheckRowCount(rows_inserted));
+}
+
+} // namespace yb
@@ -13,6 +13,7 @@
 #ifndef YB_MASTER_ASYNC_RPC_TASKS_H
 #define YB_MASTER_ASYNC_RPC_TASKS_H
 
+#include <array>
 #include <atomic>
 #include <string>
 
@@ -385,6 +386,35 @@ class AsyncTruncate : public RetryingTSRpcTask {
   tserver::TruncateResponsePB resp_;
 };
 
+// Send a SplitTablet() RPC request to the leader of the tablet.
+class AsyncSplitTablet : public RetryingTSRpcTask {
+ public:
+  AsyncSplitTablet(Master* master,
+                   ThreadPool* callback_pool,
+                   const scoped_refptr<TabletInfo>& tablet,
+                   const std::array<TabletId, 2>& new_tablet_ids,
+                   const std::string& split_partition_key);
+
+  Type type() const override { return ASYNC_SPLIT_TABLET; }
+
+  std::string type_name() const override { return "Split Tablet"; }
+
+  std::string description() const override;
+
+ protected:
+  TabletId tablet_id() const override;
+
+  TabletServerId permanent_uuid() const;
+
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+  scoped_refptr<TabletInfo> tablet_;
+  const std::array<TabletId, 2> new_tablet_ids_;
+  const std::string split_partition_key_;
+  tserver::SplitTabletResponsePB resp_;
+};
+
 class CommonInfoForRaftTask : public RetryingTSRpcTask {
  public:
   CommonInfoForRaftTask(
@@ -179,6 +179,16 @@ class TestLoadBalancerBase {
 
     PrepareTestState(ts_descs_multi_az);
     TestLeaderOverReplication();
+
+    gflags::SetCommandLineOption("leader_balance_threshold", "0");
+    PrepareTestState(ts_descs_multi_az);
+    TestBalancingHotLeaders();
+
+    PrepareTestState(ts_descs_multi_az);
+    TestBalancingHotReplicas();
+
+    PrepareTestState(ts_descs_multi_az);
+    TestBalancingLargeReplicas();
   }
 
  protected:
@@ -737,6 +747,99 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
   }
 
+  void TestBalancingHotLeaders() {
+    LOG(INFO) << "Testing moving leaders of hot tablets";
+    LOG(INFO) << "Leader distribution: 2 1 1";
+
+    ASSERT_OK(AnalyzeTablets());
+
+    // Without any reported load, the leaders are as balanced as they can be.
+    string placeholder, tablet_id;
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    // Both tablets led by ts0 are hot.
+    TServerMetricsPB metrics;
+    AddTabletLoad(tablets_[0]->tablet_id(), 1000, &metrics);
+    AddTabletLoad(tablets_[1]->tablet_id(), 10, &metrics);
+    AddTabletLoad(tablets_[2]->tablet_id(), 20, &metrics);
+    AddTabletLoad(tablets_[3]->tablet_id(), 1000, &metrics);
+    ts_descs_[0]->UpdateMetrics(metrics);
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // One hot leader is moved off ts0 to the coldest server, ts1.
+    TestMoveLeader(&tablet_id, ts_descs_[0]->permanent_uuid(), ts_descs_[1]->permanent_uuid());
+    ASSERT_EQ(tablets_[0]->tablet_id(), tablet_id);
+
+    // ts1 is now the hottest server, but moving the hot leader again would just overload ts2, so
+    // the cold leader of ts1 is moved instead.
+    TestMoveLeader(&tablet_id, ts_descs_[1]->permanent_uuid(), ts_descs_[2]->permanent_uuid());
+    ASSERT_EQ(tablets_[1]->tablet_id(), tablet_id);
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    ts_descs_[0]->ClearMetrics();
+  }
+
+  void TestBalancingHotReplicas() {
+    LOG(INFO) << "Testing moving replicas of hot tablets";
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    TServerMetricsPB metrics;
+    AddTabletLoad(tablets_[0]->tablet_id(), 10, &metrics);
+    AddTabletLoad(tablets_[1]->tablet_id(), 10, &metrics);
+    AddTabletLoad(tablets_[2]->tablet_id(), 10, &metrics);
+    AddTabletLoad(tablets_[3]->tablet_id(), 1000, &metrics);
+    ts_descs_[0]->UpdateMetrics(metrics);
+
+    // Add an empty fourth TS.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // The hot tablet is moved first, as that balances the load the most.
+    TestAddLoad(tablets_[3]->tablet_id(), ts_descs_[2]->permanent_uuid(),
+                ts_descs_[3]->permanent_uuid());
+
+    ts_descs_[0]->ClearMetrics();
+  }
+
+  void TestBalancingLargeReplicas() {
+    LOG(INFO) << "Testing moving replicas of large hot tablets";
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    // All tablets are equally hot, but tablet 1 holds much more data than the others.
+    TServerMetricsPB metrics;
+    AddTabletLoad(tablets_[0]->tablet_id(), 100, &metrics, 1 << 20);
+    AddTabletLoad(tablets_[1]->tablet_id(), 100, &metrics, 1 << 30);
+    AddTabletLoad(tablets_[2]->tablet_id(), 100, &metrics, 1 << 20);
+    AddTabletLoad(tablets_[3]->tablet_id(), 100, &metrics, 1 << 20);
+    ts_descs_[0]->UpdateMetrics(metrics);
+
+    // Add an empty fourth TS.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // The large tablet is moved first, as that balances the load the most.
+    TestAddLoad(tablets_[1]->tablet_id(), ts_descs_[2]->permanent_uuid(),
+                ts_descs_[3]->permanent_uuid());
+
+    ts_descs_[0]->ClearMetrics();
+  }
+
+  void AddTabletLoad(const TabletId& tablet_id, double ops_per_sec, TServerMetricsPB* metrics,
+                     uint64_t sst_file_size = 0) {
+    auto* load = metrics->add_tablet_loads();
+    load->set_tablet_id(tablet_id);
+    load->set_read_ops_per_sec(ops_per_sec);
+    load->set_sst_file_size(sst_file_size);
+  }
+
   void TestMissingPlacementSingleAz() {
     LOG(INFO) << "Testing single az deployment where min_num_replicas different from num_replicas";
     // Setup cluster level placement to single AZ.
@@ -63,6 +63,7 @@
 
 #include <glog/logging.h>
 #include <boost/optional.hpp>
+#include <boost/scope_exit.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include "yb/common/common_flags.h"
 #include "yb/common/partial_row.h"
@@ -118,6 +119,7 @@
 #include "yb/yql/redis/redisserver/redis_constants.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crypt.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
@@ -185,12 +187,28 @@ DEFINE_bool(catalog_manager_check_ts_count_for_create_table, true,
             "a table to be created.");
 TAG_FLAG(catalog_manager_check_ts_count_for_create_table, hidden);
 
+DEFINE_int32(master_tablet_report_num_shards, 4,
+             "Number of shards the tablets of a single tablet report are split into, by tablet "
+             "id, to be processed in parallel. 1 means that reports are processed sequentially.");
+TAG_FLAG(master_tablet_report_num_shards, advanced);
+
+DEFINE_int32(master_tablet_report_parallel_threshold, 16,
+             "Minimum number of tablets in a tablet report to process it in parallel.");
+TAG_FLAG(master_tablet_report_parallel_threshold, advanced);
+
 METRIC_DEFINE_gauge_uint32(cluster, num_tablet_servers_live,
                            "Number of live tservers in the cluster", yb::MetricUnit::kUnits,
                            "The number of tablet servers that have responded or done a heartbeat "
                            "in the time interval defined by the gflag "
                            "FLAGS_tserver_unresponsive_timeout_ms.");
 
+METRIC_DEFINE_histogram(
+  server, tablet_report_processing_time,
+  "Tablet Report Processing Time",
+  yb::MetricUnit::kMicroseconds,
+  "Microseconds spent processing the tablet report of a tablet server heartbeat.",
+  60000000LU, 2);
+
 DEFINE_test_flag(uint64, inject_latency_during_remote_bootstrap_secs, 0,
                  "Number of seconds to sleep during a remote bootstrap.");
 
@@ -215,6 +233,18 @@ DEFINE_bool(
     "This cuts down test logs significantly.");
 TAG_FLAG(hide_pg_catalog_table_creation_logs, hidden);
 
+DEFINE_uint64(tablet_split_size_threshold_bytes, 0,
+              "Tablets whose SST files are larger than this are split in the middle of their "
+              "hash range. 0 to disable splitting tablets by size.");
+TAG_FLAG(tablet_split_size_threshold_bytes, advanced);
+TAG_FLAG(tablet_split_size_threshold_bytes, runtime);
+
+DEFINE_double(tablet_split_ops_per_sec_threshold, 0,
+              "Tablets that serve more read and write operations per second than this are split "
+              "in the middle of their hash range. 0 to disable splitting tablets by load.");
+TAG_FLAG(tablet_split_ops_per_sec_threshold, advanced);
+TAG_FLAG(tablet_split_ops_per_sec_threshold, runtime);
+
 namespace yb {
 namespace master {
 
@@ -383,8 +413,11 @@ class TabletLoader : public Visitor<PersistentTabletInfo> {
         return STATUS(Corruption, "Missing table for tablet: ", tablet_id);
       }
 
-      // Add the tablet to the Table.
-      if (!l->mutable_data()->is_deleted()) {
+      // Add the tablet to the Table. Tablets created by a split replace the split tablet once
+      // they are running.
+      if (!l->mutable_data()->is_deleted() &&
+          (l->mutable_data()->is_running() ||
+           l->mutable_data()->pb.split_parent_tablet_id().empty())) {
         table->AddTablet(tablet);
       }
     }
@@ -693,6 +726,9 @@ void CatalogManagerBgTasks::Run() {
       // Report metrics.
       catalog_manager_->ReportMetrics();
 
+      // Split the tablets that got too large or too hot.
+      catalog_manager_->SplitTabletsByLoad();
+
       TabletInfos to_delete;
       TabletInfos to_process;
 
@@ -759,6 +795,8 @@ CatalogManager::CatalogManager(Master* master)
   CHECK_OK(ThreadPoolBuilder("leader-initialization")
            .set_max_threads(1)
            .Build(&worker_pool_));
+  CHECK_OK(ThreadPoolBuilder("tablet-report")
+           .Build(&tablet_report_pool_));
 
   if (master_) {
     sys_catalog_.reset(new SysCatalogTable(
@@ -781,6 +819,8 @@ Status CatalogManager::Init(bool is_first_run) {
   // Initialize the metrics emitted by the catalog manager.
   metric_num_tablet_servers_live_ =
     METRIC_num_tablet_servers_live.Instantiate(master_->metric_entity_cluster(), 0);
+  metric_tablet_report_processing_time_ =
+    METRIC_tablet_report_processing_time.Instantiate(master_->metric_entity());
 
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(is_first_run),
                         "Failed to initialize sys tables async");
@@ -898,6 +938,10 @@ Status CatalogManager::VisitSysCatalog(int64_t term) {
 
   LOG(INFO) << __func__ << ": Acquire catalog manager lock_ before loading sys catalog..";
   boost::lock_guard<LockType> lock(lock_);
+  // The maps are reloaded below, invalidate the catalog snapshot even if loading fails halfway.
+  BOOST_SCOPE_EXIT(this_) {
+    this_->CatalogMapsChangedUnlocked();
+  } BOOST_SCOPE_EXIT_END;
 
   // Abort any outstanding tasks. All TableInfos are orphaned below, so
   // it's important to end their tasks now; otherwise Shutdown() will
@@ -1517,6 +1561,8 @@ void CatalogManager::Shutdown() {
   }
   AbortAndWaitForAllTasks(copy);
 
+  tablet_report_pool_->Shutdown();
+
   // Shut down the underlying storage for tables and tablets.
   if (sys_catalog_) {
     sys_catalog_->Shutdown();
@@ -1570,6 +1616,7 @@ Status CatalogManager::AbortTableCreation(TableInfo* table,
       << "Unable to erase table named " << table_name << " from table names map.";
   CHECK_EQ(table_ids_map_.erase(table_id), 1)
       << "Unable to erase tablet with id " << table_id << " from tablet ids map.";
+  CatalogMapsChangedUnlocked();
 
   return CheckIfNoLongerLeaderAndSetupError(s, resp);
 }
@@ -1727,6 +1774,7 @@ Status CatalogManager::CreateCopartitionedTable(const CreateTableRequestPB req,
   for (TabletInfo *tablet : tablets) {
     tablet->mutable_metadata()->CommitMutation();
   }
+  TabletLocationsChanged();
 
   for (const auto& tablet : scoped_ref_tablets) {
     SendCopartitionTabletRequest(tablet, this_table_info);
@@ -1834,6 +1882,7 @@ Status CatalogManager::CreatePgsqlSysTable(const CreateTableRequestPB* req,
 
   // Commit the in-memory state.
   table->mutable_metadata()->CommitMutation();
+  TabletLocationsChanged();
 
   tserver::ChangeMetadataRequestPB change_req;
   change_req.set_tablet_id(kSysCatalogTabletId);
@@ -2172,6 +2221,7 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
   for (TabletInfo *tablet : tablets) {
     tablet->mutable_metadata()->CommitMutation();
   }
+  TabletLocationsChanged();
 
   if (req.has_creator_role_name()) {
     const NamespaceName& keyspace_name = req.namespace_().name();
@@ -2215,6 +2265,7 @@ Status CatalogManager::CreateTabletsFromTable(const vector<Partition>& partition
   for (TabletInfo* tablet : *tablets) {
     InsertOrDie(&tablet_map_, tablet->tablet_id(), tablet);
   }
+  CatalogMapsChangedUnlocked();
   return Status::OK();
 }
 
@@ -2310,6 +2361,7 @@ Status CatalogManager::CreateTableInMemory(const CreateTableRequestPB& req,
   if (req.table_type() != PGSQL_TABLE_TYPE) {
     table_names_map_[{namespace_id, req.name()}] = *table;
   }
+  CatalogMapsChangedUnlocked();
 
   if (create_tablets) {
     RETURN_NOT_OK(CreateTabletsFromTable(partitions, *table, tablets));
@@ -2513,10 +2565,10 @@ TabletInfo* CatalogManager::CreateTabletInfo(TableInfo* table,
 
 Status CatalogManager::FindTable(const TableIdentifierPB& table_identifier,
                                  scoped_refptr<TableInfo> *table_info) {
-  boost::shared_lock<LockType> l(lock_);
+  auto snapshot = GetCatalogSnapshot();
 
   if (table_identifier.has_table_id()) {
-    *table_info = FindPtrOrNull(table_ids_map_, table_identifier.table_id());
+    *table_info = FindPtrOrNull(snapshot->table_ids_map, table_identifier.table_id());
   } else if (table_identifier.has_table_name()) {
     NamespaceId namespace_id;
 
@@ -2525,7 +2577,7 @@ Status CatalogManager::FindTable(const TableIdentifierPB& table_identifier,
         namespace_id = table_identifier.namespace_().id();
       } else if (table_identifier.namespace_().has_name()) {
         // Find namespace by its name.
-        scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(namespace_names_map_,
+        scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(snapshot->namespace_names_map,
             table_identifier.namespace_().name());
 
         if (ns == nullptr) {
@@ -2544,7 +2596,8 @@ Status CatalogManager::FindTable(const TableIdentifierPB& table_identifier,
       return STATUS(InvalidArgument, "No namespace used");
     }
 
-    *table_info = FindPtrOrNull(table_names_map_, {namespace_id, table_identifier.table_name()});
+    *table_info = FindPtrOrNull(
+        snapshot->table_names_map, {namespace_id, table_identifier.table_name()});
   } else {
     return STATUS(InvalidArgument, "Neither table id or table name are specified");
   }
@@ -2553,15 +2606,15 @@ Status CatalogManager::FindTable(const TableIdentifierPB& table_identifier,
 
 Status CatalogManager::FindNamespace(const NamespaceIdentifierPB& ns_identifier,
                                      scoped_refptr<NamespaceInfo>* ns_info) const {
-  boost::shared_lock<LockType> l(lock_);
+  auto snapshot = GetCatalogSnapshot();
 
   if (ns_identifier.has_id()) {
-    *ns_info = FindPtrOrNull(namespace_ids_map_, ns_identifier.id());
+    *ns_info = FindPtrOrNull(snapshot->namespace_ids_map, ns_identifier.id());
     if (*ns_info == nullptr) {
       return STATUS(NotFound, "Keyspace identifier not found", ns_identifier.id());
     }
   } else if (ns_identifier.has_name()) {
-    *ns_info = FindPtrOrNull(namespace_names_map_, ns_identifier.name());
+    *ns_info = FindPtrOrNull(snapshot->namespace_names_map, ns_identifier.name());
     if (*ns_info == nullptr) {
       return STATUS(NotFound, "Keyspace name not found", ns_identifier.name());
     }
@@ -2710,6 +2763,278 @@ Status CatalogManager::IsTruncateTableDone(const IsTruncateTableDoneRequestPB* r
   return Status::OK();
 }
 
+Status CatalogManager::SplitTablet(const SplitTabletRequestPB* req,
+                                   SplitTabletResponsePB* resp,
+                                   rpc::RpcContext* rpc) {
+  LOG(INFO) << "Servicing SplitTablet request from " << RequestorString(rpc)
+            << ": " << req->ShortDebugString();
+
+  RETURN_NOT_OK(CheckOnline());
+
+  return SplitTablet(req->tablet_id(), req->split_partition_key(), resp);
+}
+
+Status CatalogManager::SplitTablet(const TabletId& tablet_id,
+                                   const std::string& split_partition_key,
+                                   SplitTabletResponsePB* resp) {
+  auto snapshot = GetCatalogSnapshot();
+  scoped_refptr<TabletInfo> tablet = FindPtrOrNull(snapshot->tablet_map, tablet_id);
+  if (tablet == nullptr || !tablet->table()) {
+    Status s = STATUS_FORMAT(NotFound, "The tablet $0 does not exist", tablet_id);
+    return SetupError(resp->mutable_error(), MasterErrorPB::TABLET_NOT_RUNNING, s);
+  }
+  scoped_refptr<TableInfo> table = tablet->table();
+
+  // Tablets of transactional tables keep intents that refer to the tablet ids, and index tables
+  // are written by the tablets of their indexed tables, so only plain YCQL tables are split.
+  auto table_lock = table->LockForRead();
+  const auto& table_pb = table_lock->data().pb;
+  if (table_pb.table_type() != YQL_TABLE_TYPE ||
+      table_pb.schema().table_properties().is_transactional() ||
+      !table_pb.partition_schema().has_hash_schema() ||
+      !table_pb.indexed_table_id().empty() || table_pb.indexes_size() > 0 ||
+      IsSystemTable(*table)) {
+    Status s = STATUS_FORMAT(
+        NotSupported, "Only non-transactional hash partitioned YCQL tables without indexes could "
+        "be split, tablet $0 belongs to $1", tablet_id, table->ToString());
+    return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_REQUEST, s);
+  }
+  if (!table_lock->data().is_running()) {
+    Status s = STATUS_FORMAT(IllegalState, "The table $0 is not running", table->ToString());
+    return SetupError(resp->mutable_error(), MasterErrorPB::TABLE_NOT_FOUND, s);
+  }
+
+  auto tablet_lock = tablet->LockForWrite();
+  if (!tablet_lock->data().is_running()) {
+    Status s = STATUS_FORMAT(IllegalState, "The tablet $0 is not running", tablet_id);
+    return SetupError(resp->mutable_error(), MasterErrorPB::TABLET_NOT_RUNNING, s);
+  }
+  const auto& partition = tablet_lock->data().pb.partition();
+  const auto& child_ids = tablet_lock->data().pb.split_child_tablet_ids();
+
+  // The split is already in progress, resend it in case it was started by another master leader.
+  if (child_ids.size() == 2) {
+    std::array<TabletId, 2> new_tablet_ids = {child_ids.Get(0), child_ids.Get(1)};
+    scoped_refptr<TabletInfo> child = FindPtrOrNull(snapshot->tablet_map, new_tablet_ids[1]);
+    if (child == nullptr) {
+      Status s = STATUS_FORMAT(
+          IllegalState, "Tablet $0 created by the split of $1 is missing", new_tablet_ids[1],
+          tablet_id);
+      return SetupError(resp->mutable_error(), MasterErrorPB::UNKNOWN_ERROR, s);
+    }
+    for (const auto& new_tablet_id : new_tablet_ids) {
+      resp->add_new_tablet_ids(new_tablet_id);
+    }
+    if (!table->HasTasks(MonitoredTask::Type::ASYNC_SPLIT_TABLET)) {
+      SendSplitTabletRequest(
+          tablet, new_tablet_ids, child->metadata().state().pb.partition().partition_key_start());
+    }
+    return Status::OK();
+  }
+
+  std::string split_key = split_partition_key;
+  if (split_key.empty()) {
+    const uint32_t start = partition.partition_key_start().empty()
+        ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+    const uint32_t end = partition.partition_key_end().empty()
+        ? PartitionSchema::kMaxPartitionKey + 1
+        : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+    if (end - start < 2) {
+      Status s = STATUS_FORMAT(
+          IllegalState, "The tablet $0 covers a single hash value", tablet_id);
+      return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_REQUEST, s);
+    }
+    split_key = PartitionSchema::EncodeMultiColumnHashValue((start + end) / 2);
+  }
+  if (split_key <= partition.partition_key_start() ||
+      (!partition.partition_key_end().empty() && split_key >= partition.partition_key_end())) {
+    Status s = STATUS_FORMAT(
+        InvalidArgument, "Split partition key $0 is not inside the partition of tablet $1",
+        Slice(split_key).ToDebugHexString(), tablet_id);
+    return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_REQUEST, s);
+  }
+
+  // The new tablets are only added to the table once the split is complete, see
+  // MaybeCompleteTabletSplit.
+  std::vector<scoped_refptr<TabletInfo>> new_tablets;
+  std::vector<TabletInfo*> tablets_to_add;
+  std::array<TabletId, 2> new_tablet_ids;
+  for (int i = 0; i != 2; ++i) {
+    PartitionPB partition_pb;
+    partition_pb.set_partition_key_start(i == 0 ? partition.partition_key_start() : split_key);
+    partition_pb.set_partition_key_end(i == 0 ? split_key : partition.partition_key_end());
+    new_tablets.emplace_back(CreateTabletInfo(table.get(), partition_pb));
+    auto* new_tablet = new_tablets.back().get();
+    auto* metadata = new_tablet->mutable_metadata()->mutable_dirty();
+    metadata->set_state(SysTabletsEntryPB::CREATING, Substitute("Splitting tablet $0", tablet_id));
+    metadata->pb.set_split_parent_tablet_id(tablet_id);
+    tablets_to_add.push_back(new_tablet);
+    new_tablet_ids[i] = new_tablet->tablet_id();
+    tablet_lock->mutable_data()->pb.add_split_child_tablet_ids(new_tablet_ids[i]);
+  }
+
+  Status s = sys_catalog_->AddAndUpdateItems(tablets_to_add, {tablet.get()}, leader_ready_term_);
+  if (!s.ok()) {
+    for (auto* new_tablet : tablets_to_add) {
+      new_tablet->mutable_metadata()->AbortMutation();
+    }
+    s = s.CloneAndPrepend("An error occurred while updating sys-tablets");
+    LOG(WARNING) << s;
+    return CheckIfNoLongerLeaderAndSetupError(s, resp);
+  }
+  for (auto* new_tablet : tablets_to_add) {
+    new_tablet->mutable_metadata()->CommitMutation();
+  }
+  tablet_lock->Commit();
+  table_lock->Unlock();
+
+  {
+    std::lock_guard<LockType> l(lock_);
+    for (const auto& new_tablet : new_tablets) {
+      InsertOrDie(&tablet_map_, new_tablet->tablet_id(), new_tablet);
+    }
+    CatalogMapsChangedUnlocked();
+  }
+
+  for (const auto& new_tablet_id : new_tablet_ids) {
+    resp->add_new_tablet_ids(new_tablet_id);
+  }
+  LOG(INFO) << "Splitting tablet " << tablet_id << " at "
+            << Slice(split_key).ToDebugHexString() << " into " << yb::ToString(new_tablet_ids);
+  SendSplitTabletRequest(tablet, new_tablet_ids, split_key);
+  return Status::OK();
+}
+
+void CatalogManager::SendSplitTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                                            const std::array<TabletId, 2>& new_tablet_ids,
+                                            const std::string& split_partition_key) {
+  auto call = std::make_shared<AsyncSplitTablet>(
+      master_, worker_pool_.get(), tablet, new_tablet_ids, split_partition_key);
+  tablet->table()->AddTask(call);
+  auto status = call->Run();
+  WARN_NOT_OK(status, Substitute("Failed to send split request for tablet $0", tablet->id()));
+}
+
+void CatalogManager::AbortTabletSplit(const scoped_refptr<TabletInfo>& tablet,
+                                      const Status& status) {
+  auto snapshot = GetCatalogSnapshot();
+  auto tablet_lock = tablet->LockForWrite();
+  std::vector<scoped_refptr<TabletInfo>> new_tablets;
+  std::vector<std::unique_ptr<TabletInfo::lock_type>> new_tablet_locks;
+  std::vector<TabletInfo*> tablets_to_update = {tablet.get()};
+  for (const auto& new_tablet_id : tablet_lock->data().pb.split_child_tablet_ids()) {
+    scoped_refptr<TabletInfo> new_tablet = FindPtrOrNull(snapshot->tablet_map, new_tablet_id);
+    if (new_tablet == nullptr) {
+      continue;
+    }
+    new_tablet_locks.push_back(new_tablet->LockForWrite());
+    new_tablet_locks.back()->mutable_data()->set_state(
+        SysTabletsEntryPB::DELETED, Substitute("Split aborted: $0", status.ToString()));
+    tablets_to_update.push_back(new_tablet.get());
+    new_tablets.push_back(std::move(new_tablet));
+  }
+  tablet_lock->mutable_data()->pb.clear_split_child_tablet_ids();
+
+  Status s = sys_catalog_->UpdateItems(tablets_to_update, leader_ready_term_);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to abort split of tablet " << tablet->tablet_id() << ": " << s;
+    return;
+  }
+  for (auto& lock : new_tablet_locks) {
+    lock->Commit();
+  }
+  tablet_lock->Commit();
+
+  {
+    std::lock_guard<LockType> l(lock_);
+    for (const auto& new_tablet : new_tablets) {
+      tablet_map_.erase(new_tablet->tablet_id());
+    }
+    CatalogMapsChangedUnlocked();
+  }
+  LOG(INFO) << "Aborted split of tablet " << tablet->tablet_id() << ": " << status;
+}
+
+Status CatalogManager::MaybeCompleteTabletSplit(const TabletId& parent_tablet_id) {
+  auto snapshot = GetCatalogSnapshot();
+  scoped_refptr<TabletInfo> parent = FindPtrOrNull(snapshot->tablet_map, parent_tablet_id);
+  if (parent == nullptr) {
+    return Status::OK();
+  }
+
+  auto parent_lock = parent->LockForWrite();
+  const auto& child_ids = parent_lock->data().pb.split_child_tablet_ids();
+  if (parent_lock->data().is_deleted() || child_ids.size() != 2) {
+    return Status::OK();
+  }
+
+  std::vector<TabletInfo*> children;
+  std::vector<std::unique_ptr<TabletInfo::lock_type>> child_locks;
+  for (const auto& child_id : child_ids) {
+    TabletInfo* child = FindPtrOrNull(snapshot->tablet_map, child_id).get();
+    if (child == nullptr) {
+      return STATUS_FORMAT(
+          IllegalState, "Tablet $0 created by the split of $1 is missing", child_id,
+          parent_tablet_id);
+    }
+    child_locks.push_back(child->LockForWrite());
+    // Wait for both tablets, so clients never see a partial set of the tablets that replace the
+    // split one.
+    if (!child_locks.back()->data().pb.committed_consensus_state().has_leader_uuid()) {
+      return Status::OK();
+    }
+    children.push_back(child);
+  }
+
+  for (auto& child_lock : child_locks) {
+    child_lock->mutable_data()->set_state(
+        SysTabletsEntryPB::RUNNING, Substitute("Split from tablet $0", parent_tablet_id));
+  }
+  parent_lock->mutable_data()->set_state(
+      SysTabletsEntryPB::DELETED,
+      Substitute("Split into tablets $0 and $1 at $2", children[0]->tablet_id(),
+                 children[1]->tablet_id(), LocalTimeAsString()));
+
+  std::vector<TabletInfo*> tablets_to_update = {parent.get(), children[0], children[1]};
+  RETURN_NOT_OK(sys_catalog_->UpdateItems(tablets_to_update, leader_ready_term_));
+  for (auto& child_lock : child_locks) {
+    child_lock->Commit();
+  }
+  parent_lock->Commit();
+
+  // The first new tablet has the same partition start, so it replaces the split tablet.
+  parent->table()->AddTablets(children);
+  TabletLocationsChanged();
+
+  LOG(INFO) << "Tablet " << parent_tablet_id << " was split into " << children[0]->tablet_id()
+            << " and " << children[1]->tablet_id();
+  return Status::OK();
+}
+
+void CatalogManager::SplitTabletsByLoad() {
+  const uint64_t size_threshold = FLAGS_tablet_split_size_threshold_bytes;
+  const double ops_threshold = FLAGS_tablet_split_ops_per_sec_threshold;
+  if (size_threshold == 0 && ops_threshold <= 0) {
+    return;
+  }
+
+  TSDescriptorVector descs;
+  master_->ts_manager()->GetAllLiveDescriptors(&descs);
+  std::set<TabletId> tablet_ids;
+  for (const auto& ts_desc : descs) {
+    for (auto& tablet_id : ts_desc->GetTabletsAboveLoad(size_threshold, ops_threshold)) {
+      tablet_ids.insert(std::move(tablet_id));
+    }
+  }
+  for (const auto& tablet_id : tablet_ids) {
+    SplitTabletResponsePB resp;
+    Status s = SplitTablet(tablet_id, std::string() /* split_partition_key */, &resp);
+    if (!s.ok()) {
+      VLOG(1) << "Not splitting tablet " << tablet_id << ": " << s;
+    }
+  }
+}
+
 Status CatalogManager::DeleteIndexInfoFromTable(const TableId& indexed_table_id,
                                                 const TableId& index_table_id,
                                                 DeleteTableResponsePB* resp) {
@@ -2810,6 +3135,7 @@ Status CatalogManager::DeleteTable(const DeleteTableRequestPB* req,
   for (int i = 0; i < table_locks.size(); i++) {
     table_locks[i]->Commit();
   }
+  TabletLocationsChanged();
 
   // The table lock (l) and the global lock (lock_) must be released for the next call.
   for (int i = 0; i < deleted_tables.size(); i++) {
@@ -2930,6 +3256,7 @@ Status CatalogManager::DeleteTableInMemory(const TableIdentifierPB& table_identi
       if (table_names_map_.erase({l->data().namespace_id(), l->data().name()}) != 1) {
         PANIC_RPC(rpc, "Could not remove table from map, name=" + table->ToString());
       }
+      CatalogMapsChangedUnlocked();
     }
 
     TRACE("Add deleted table tablets into tablet wait list");
@@ -3001,6 +3328,7 @@ void CatalogManager::CleanUpDeletedTables() {
       if (l->data().is_deleted()) {
         LOG(INFO) << "Removing from by-ids map table " << table->ToString();
         it = table_ids_map_.erase(it);
+        CatalogMapsChangedUnlocked();
         // TODO: Check if we want to delete the totally deleted table from the sys_catalog here.
         continue;
       }
@@ -3211,6 +3539,7 @@ Status CatalogManager::AlterTable(const AlterTableRequestPB* req,
 
     // Acquire the new table name (now we have 2 name for the same table).
     table_names_map_[{new_namespace_id, new_table_name}] = table;
+    CatalogMapsChangedUnlocked();
     l->mutable_data()->pb.set_namespace_id(new_namespace_id);
     l->mutable_data()->pb.set_name(new_table_name);
 
@@ -3247,6 +3576,7 @@ Status CatalogManager::AlterTable(const AlterTableRequestPB* req,
     if (req->has_new_namespace() || req->has_new_table_name()) {
       std::lock_guard<LockType> catalog_lock(lock_);
       CHECK_EQ(table_names_map_.erase({new_namespace_id, new_table_name}), 1);
+      CatalogMapsChangedUnlocked();
     }
     // TableMetadaLock follows RAII paradigm: when it leaves scope,
     // 'l' will be unlocked, and the mutation will be aborted.
@@ -3261,11 +3591,13 @@ Status CatalogManager::AlterTable(const AlterTableRequestPB* req,
     if (table_names_map_.erase({namespace_id, table_name}) != 1) {
       PANIC_RPC(rpc, "Could not remove table from map, name=" + l->data().name());
     }
+    CatalogMapsChangedUnlocked();
   }
 
   // Update the in-memory state.
   TRACE("Committing in-memory state");
   l->Commit();
+  TabletLocationsChanged();
 
   SendAlterTableRequest(table);
 
@@ -3387,9 +3719,9 @@ Status CatalogManager::ListTables(const ListTablesRequestPB* req,
     namespace_id = ns->id();
   }
 
-  boost::shared_lock<LockType> l(lock_);
+  auto snapshot = GetCatalogSnapshot();
 
-  for (const auto& entry : table_ids_map_) {
+  for (const auto& entry : snapshot->table_ids_map) {
     auto& table_info = *entry.second;
     auto ltm = table_info.LockForRead();
 
@@ -3416,7 +3748,7 @@ Status CatalogManager::ListTables(const ListTablesRequestPB* req,
     table->set_name(ltm->data().name());
     table->set_table_type(ltm->data().table_type());
 
-    scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(namespace_ids_map_,
+    scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(snapshot->namespace_ids_map,
         ltm->data().namespace_id());
 
     if (CHECK_NOTNULL(ns.get())) {
@@ -3429,18 +3761,18 @@ Status CatalogManager::ListTables(const ListTablesRequestPB* req,
 }
 
 scoped_refptr<TableInfo> CatalogManager::GetTableInfo(const TableId& table_id) {
-  boost::shared_lock<LockType> l(lock_);
-  return FindPtrOrNull(table_ids_map_, table_id);
+  return FindPtrOrNull(GetCatalogSnapshot()->table_ids_map, table_id);
 }
 scoped_refptr<TableInfo> CatalogManager::GetTableInfoFromNamespaceNameAndTableName(
     const NamespaceName& namespace_name, const TableName& table_name) {
 
-  boost::shared_lock<LockType> l(lock_);
-  const scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(namespace_names_map_, namespace_name);
+  auto snapshot = GetCatalogSnapshot();
+  const scoped_refptr<NamespaceInfo> ns = FindPtrOrNull(
+      snapshot->namespace_names_map, namespace_name);
   if (ns == nullptr) {
     return nullptr;
   }
-  return FindPtrOrNull(table_names_map_, {ns->id(), table_name});
+  return FindPtrOrNull(snapshot->table_names_map, {ns->id(), table_name});
 }
 
 scoped_refptr<TableInfo> CatalogManager::GetTableInfoUnlocked(const TableId& table_id) {
@@ -3450,8 +3782,8 @@ scoped_refptr<TableInfo> CatalogManager::GetTableInfoUnlocked(const TableId& tab
 void CatalogManager::GetAllTables(std::vector<scoped_refptr<TableInfo>> *tables,
                                   bool includeOnlyRunningTables) {
   tables->clear();
-  boost::shared_lock<LockType> l(lock_);
-  for (const TableInfoMap::value_type& e : table_ids_map_) {
+  auto snapshot = GetCatalogSnapshot();
+  for (const TableInfoMap::value_type& e : snapshot->table_ids_map) {
     if (includeOnlyRunningTables && !e.second->is_running()) {
       continue;
     }
@@ -3461,12 +3793,46 @@ void CatalogManager::GetAllTables(std::vector<scoped_refptr<TableInfo>> *tables,
 
 void CatalogManager::GetAllNamespaces(std::vector<scoped_refptr<NamespaceInfo>>* namespaces) {
   namespaces->clear();
-  boost::shared_lock<LockType> l(lock_);
-  for (const NamespaceInfoMap::value_type& e : namespace_ids_map_) {
+  auto snapshot = GetCatalogSnapshot();
+  for (const NamespaceInfoMap::value_type& e : snapshot->namespace_ids_map) {
     namespaces->push_back(e.second);
   }
 }
 
+CatalogSnapshotPtr CatalogManager::GetCatalogSnapshot() const {
+  auto snapshot = std::atomic_load(&catalog_snapshot_);
+  if (snapshot && snapshot->version == catalog_maps_version_.load(std::memory_order_acquire)) {
+    return snapshot;
+  }
+
+  // The maps are copied before taking catalog_snapshot_mutex_, so that mutex is never held while
+  // acquiring lock_. Readers that race here may copy the maps more than once, only the newest copy
+  // is published.
+  auto new_snapshot = std::make_shared<CatalogSnapshot>();
+  {
+    boost::shared_lock<LockType> l(lock_);
+    // The version is only changed under the exclusive lock, so it matches the copied maps.
+    new_snapshot->version = catalog_maps_version_.load(std::memory_order_acquire);
+    new_snapshot->table_ids_map = table_ids_map_;
+    new_snapshot->table_names_map = table_names_map_;
+    new_snapshot->tablet_map = tablet_map_;
+    new_snapshot->namespace_ids_map = namespace_ids_map_;
+    new_snapshot->namespace_names_map = namespace_names_map_;
+  }
+
+  std::lock_guard<std::mutex> snapshot_lock(catalog_snapshot_mutex_);
+  snapshot = std::atomic_load(&catalog_snapshot_);
+  if (snapshot && snapshot->version >= new_snapshot->version) {
+    // Somebody published the same or a newer version while we were copying.
+    return snapshot;
+  }
+  VLOG(2) << "Rebuilt catalog snapshot for version " << new_snapshot->version;
+
+  snapshot = std::move(new_snapshot);
+  std::atomic_store(&catalog_snapshot_, snapshot);
+  return snapshot;
+}
+
 void CatalogManager::GetAllUDTypes(std::vector<scoped_refptr<UDTypeInfo>>* types) {
   types->clear();
   boost::shared_lock<LockType> l(lock_);
@@ -3752,12 +4118,10 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   // the server should have, compare vs the ones being reported, and somehow mark
   // any that have been "lost" (eg somehow the tablet metadata got corrupted or something).
 
-  for (const ReportedTabletPB& reported : report.updated_tablets()) {
-    ReportedTabletUpdatesPB *tablet_report = report_update->add_tablets();
-    tablet_report->set_tablet_id(reported.tablet_id());
-    RETURN_NOT_OK_PREPEND(HandleReportedTablet(ts_desc, reported, tablet_report),
-                          Substitute("Error handling $0", reported.ShortDebugString()));
-  }
+  MonoTime start = MonoTime::Now();
+  RETURN_NOT_OK(HandleReportedTablets(ts_desc, report, report_update));
+  metric_tablet_report_processing_time_->Increment(
+      MonoTime::Now().GetDeltaSince(start).ToMicroseconds());
 
   if (!ts_desc->has_tablet_report()) {
     LOG(INFO) << ts_desc->permanent_uuid() << " now has full report for "
@@ -3779,6 +4143,64 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   return Status::OK();
 }
 
+Status CatalogManager::HandleReportedTablets(TSDescriptor* ts_desc,
+                                             const TabletReportPB& report,
+                                             TabletReportUpdatesPB* report_update) {
+  const int num_tablets = report.updated_tablets_size();
+  // Response entries are added upfront, so that shards could fill them without synchronization.
+  for (const ReportedTabletPB& reported : report.updated_tablets()) {
+    report_update->add_tablets()->set_tablet_id(reported.tablet_id());
+  }
+
+  int num_shards = 1;
+  if (num_tablets >= FLAGS_master_tablet_report_parallel_threshold) {
+    num_shards = std::min(std::max(FLAGS_master_tablet_report_num_shards, 1), num_tablets);
+  }
+
+  // Tablets are assigned to shards by tablet id, so all reports about the same tablet within
+  // a single heartbeat are handled by the same thread, in the order they were reported.
+  std::vector<std::vector<int>> shards(num_shards);
+  std::hash<TabletId> tablet_id_hash;
+  for (int i = 0; i != num_tablets; ++i) {
+    shards[tablet_id_hash(report.updated_tablets(i).tablet_id()) % num_shards].push_back(i);
+  }
+
+  std::vector<Status> statuses(num_shards);
+  auto handle_shard = [this, ts_desc, &report, report_update, &shards, &statuses](int shard) {
+    for (int idx : shards[shard]) {
+      const ReportedTabletPB& reported = report.updated_tablets(idx);
+      Status s = HandleReportedTablet(ts_desc, reported, report_update->mutable_tablets(idx));
+      if (!s.ok()) {
+        statuses[shard] = s.CloneAndPrepend(
+            Substitute("Error handling $0", reported.ShortDebugString()));
+        return;
+      }
+    }
+  };
+
+  CountDownLatch latch(num_shards - 1);
+  Trace* trace = Trace::CurrentTrace();
+  for (int shard = 1; shard < num_shards; ++shard) {
+    Status s = tablet_report_pool_->SubmitFunc([&handle_shard, &latch, trace, shard] {
+      ADOPT_TRACE(trace);
+      handle_shard(shard);
+      latch.CountDown();
+    });
+    if (!s.ok()) {
+      // The pool is shutting down, handle the shard in the current thread.
+      handle_shard(shard);
+      latch.CountDown();
+    }
+  }
+  handle_shard(0);
+  latch.Wait();
+
+  for (const Status& s : statuses) {
+    RETURN_NOT_OK(s);
+  }
+  return Status::OK();
+}
+
 namespace {
 // Return true if receiving 'report' for a tablet in CREATING state should
 // transition it to the RUNNING state.
@@ -3802,11 +4224,8 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
                                             ReportedTabletUpdatesPB *report_updates) {
   TRACE_EVENT1("master", "HandleReportedTablet",
                "tablet_id", report.tablet_id());
-  scoped_refptr<TabletInfo> tablet;
-  {
-    boost::shared_lock<LockType> l(lock_);
-    tablet = FindPtrOrNull(tablet_map_, report.tablet_id());
-  }
+  scoped_refptr<TabletInfo> tablet = FindPtrOrNull(
+      GetCatalogSnapshot()->tablet_map, report.tablet_id());
   RETURN_NOT_OK_PREPEND(CheckIsLeaderAndReady(),
       Substitute("This master is no longer the leader, unable to handle report for tablet $0",
                  report.tablet_id()));
@@ -3891,6 +4310,7 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
 
   // The report will not have a committed_consensus_state if it is in the
   // middle of starting up, such as during tablet bootstrap.
+  TabletId split_parent_tablet_id;
   if (report.has_committed_consensus_state()) {
     const ConsensusStatePB& prev_cstate = tablet_lock->data().pb.committed_consensus_state();
     ConsensusStatePB cstate = report.committed_consensus_state();
@@ -3919,7 +4339,11 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
     // could incorrectly consider a tablet created when only a minority of its replicas
     // were successful. In that case, the tablet would be stuck in this bad state
     // forever.
-    if (!tablet_lock->data().is_running() && ShouldTransitionTabletToRunning(report)) {
+    if (!tablet_lock->data().is_running() && ShouldTransitionTabletToRunning(report) &&
+        !tablet_lock->data().pb.split_parent_tablet_id().empty()) {
+      // Tablets created by a split become running together, see MaybeCompleteTabletSplit.
+      split_parent_tablet_id = tablet_lock->data().pb.split_parent_tablet_id();
+    } else if (!tablet_lock->data().is_running() && ShouldTransitionTabletToRunning(report)) {
       DCHECK_EQ(SysTabletsEntryPB::CREATING, tablet_lock->data().pb.state())
           << "Tablet in unexpected state: " << tablet->ToString()
           << ": " << tablet_lock->data().pb.ShortDebugString();
@@ -4020,6 +4444,11 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
     return s;
   }
   tablet_lock->Commit();
+  TabletLocationsChanged();
+
+  if (!split_parent_tablet_id.empty()) {
+    RETURN_NOT_OK(MaybeCompleteTabletSplit(split_parent_tablet_id));
+  }
 
   // Need to defer the AlterTable command to after we've committed the new tablet data,
   // since the tablet report may also be updating the raft config, and the Alter Table
@@ -4312,6 +4741,7 @@ Status CatalogManager::CreateNamespace(const CreateNamespaceRequestPB* req,
     // Add the namespace to the in-memory map for the assignment.
     namespace_ids_map_[ns->id()] = ns;
     namespace_names_map_[req->name()] = ns;
+    CatalogMapsChangedUnlocked();
 
     resp->set_id(ns->id());
   }
@@ -4433,6 +4863,7 @@ Status CatalogManager::DeleteNamespace(const DeleteNamespaceRequestPB* req,
     if (namespace_ids_map_.erase(ns->id()) < 1) {
       PANIC_RPC(rpc, "Could not remove namespace from map, name=" + l->data().name());
     }
+    CatalogMapsChangedUnlocked();
   }
 
   // Update the in-memory state.
@@ -5236,6 +5667,7 @@ Status CatalogManager::ResetTabletReplicasFromReportedConfig(
     InsertOrDie(&replica_locations, replica.ts_desc->permanent_uuid(), replica);
   }
   tablet->SetReplicaLocations(std::move(replica_locations));
+  TabletLocationsChanged();
 
   if (FLAGS_master_tombstone_evicted_tablet_replicas) {
     unordered_set<string> current_member_uuids;
@@ -5265,7 +5697,9 @@ void CatalogManager::AddReplicaToTabletIfNotFound(TSDescriptor* ts_desc,
   TabletReplica replica;
   NewReplica(ts_desc, report, &replica);
   // Only inserts if a replica with a matching UUID was not already present.
-  ignore_result(tablet->AddToReplicaLocations(replica));
+  if (tablet->AddToReplicaLocations(replica)) {
+    TabletLocationsChanged();
+  }
 }
 
 void CatalogManager::NewReplica(TSDescriptor* ts_desc,
@@ -5525,6 +5959,7 @@ void CatalogManager::DeleteTabletsAndSendRequests(const scoped_refptr<TableInfo>
     CHECK_OK(sys_catalog_->UpdateItem(tablet.get(), leader_ready_term_));
     tablet_lock->Commit();
   }
+  TabletLocationsChanged();
 }
 
 void CatalogManager::SendDeleteTabletRequest(
@@ -5662,6 +6097,11 @@ void CatalogManager::ExtractTabletsToProcess(
       continue;
     }
 
+    // Tablets created by a split are created by the tablet servers that host the split tablet.
+    if (!tablet_lock->data().pb.split_parent_tablet_id().empty()) {
+      continue;
+    }
+
     // Tablets not yet assigned or with a report just received.
     tablets_to_process->push_back(tablet);
   }
@@ -5713,6 +6153,7 @@ void CatalogManager::HandleAssignCreatingTablet(TabletInfo* tablet,
   {
     std::lock_guard<LockType> l_maps(lock_);
     tablet_map_[replacement->tablet_id()] = replacement;
+    CatalogMapsChangedUnlocked();
   }
 
   // Mark old tablet as replaced.
@@ -5767,6 +6208,7 @@ Status CatalogManager::HandleTabletSchemaVersionReport(TabletInfo *tablet, uint3
   }
 
   l->Commit();
+  TabletLocationsChanged();
   LOG(INFO) << table->ToString() << " - Alter table completed version=" << current_version;
   return Status::OK();
 }
@@ -5902,6 +6344,7 @@ Status CatalogManager::ProcessPendingAssignments(const TabletInfos& tablets) {
       CHECK_EQ(tablet_map_.erase(tablet_id_to_remove), 1)
           << "Unable to erase " << tablet_id_to_remove << " from tablet map.";
     }
+    CatalogMapsChangedUnlocked();
     return s;
   }
 
@@ -6291,11 +6734,8 @@ Status CatalogManager::GetTabletLocations(const TabletId& tablet_id, TabletLocat
 
   locs_pb->mutable_replicas()->Clear();
   scoped_refptr<TabletInfo> tablet_info;
-  {
-    boost::shared_lock<LockType> l(lock_);
-    if (!FindCopy(tablet_map_, tablet_id, &tablet_info)) {
-      return STATUS(NotFound, Substitute("Unknown tablet $0", tablet_id));
-    }
+  if (!FindCopy(GetCatalogSnapshot()->tablet_map, tablet_id, &tablet_info)) {
+    return STATUS(NotFound, Substitute("Unknown tablet $0", tablet_id));
   }
 
   Status s = BuildLocationsForTablet(tablet_info, locs_pb);
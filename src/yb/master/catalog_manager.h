@@ -32,8 +32,12 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_H
 #define YB_MASTER_CATALOG_MANAGER_H
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -670,12 +674,30 @@ typedef std::unordered_map<TableId, scoped_refptr<TableInfo>> TableInfoMap;
 typedef std::pair<NamespaceId, TableName> TableNameKey;
 typedef std::unordered_map<
     TableNameKey, scoped_refptr<TableInfo>, boost::hash<TableNameKey>> TableInfoByNameMap;
+typedef std::unordered_map<NamespaceName, scoped_refptr<NamespaceInfo>> NamespaceInfoMap;
 
 typedef std::unordered_map<UDTypeId, scoped_refptr<UDTypeInfo>> UDTypeInfoMap;
 typedef std::pair<NamespaceId, UDTypeName> UDTypeNameKey;
 typedef std::unordered_map<
     UDTypeNameKey, scoped_refptr<UDTypeInfo>, boost::hash<UDTypeNameKey>> UDTypeInfoByNameMap;
 
+// Immutable copy of the table, tablet and namespace maps of the CatalogManager, taken at some
+// catalog version. Read-only paths use it instead of the maps guarded by CatalogManager::lock_,
+// so that concurrent metadata reads do not contend with each other. The info objects themselves
+// are shared with the CatalogManager and still have to be locked to read their metadata.
+struct CatalogSnapshot {
+  // Number of catalog map modifications at the time the snapshot was taken.
+  int64_t version = 0;
+
+  TableInfoMap table_ids_map;
+  TableInfoByNameMap table_names_map;
+  TabletInfoMap tablet_map;
+  NamespaceInfoMap namespace_ids_map;
+  NamespaceInfoMap namespace_names_map;
+};
+
+typedef std::shared_ptr<const CatalogSnapshot> CatalogSnapshotPtr;
+
 // The component of the master which tracks the state and location
 // of tables/tablets in the cluster.
 //
@@ -829,6 +851,19 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Get the information about an in-progress truncate operation.
   CHECKED_STATUS IsTruncateTableDone(const IsTruncateTableDoneRequestPB* req,
                                      IsTruncateTableDoneResponsePB* resp);
+
+  // Split the specified tablet into two tablets.
+  //
+  // The RPC context is provided for logging/tracing purposes,
+  // but this function does not itself respond to the RPC.
+  CHECKED_STATUS SplitTablet(const SplitTabletRequestPB* req,
+                             SplitTabletResponsePB* resp,
+                             rpc::RpcContext* rpc);
+
+  // Forget the tablets created for the split of the specified tablet, after its leader refused
+  // to split it.
+  void AbortTabletSplit(const scoped_refptr<TabletInfo>& tablet, const Status& status);
+
   // Delete the specified table.
   //
   // The RPC context is provided for logging/tracing purposes,
@@ -1013,6 +1048,20 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
 
   void GetAllNamespaces(std::vector<scoped_refptr<NamespaceInfo> >* namespaces);
 
+  // Returns a snapshot of the catalog maps that includes all the modifications completed so far.
+  // The latest snapshot is reused until the maps are modified again, so in the common case this
+  // does not take lock_. When the snapshot is stale, lock_ is taken in shared mode to copy the maps
+  // and only then catalog_snapshot_mutex_ to publish them, so this must not be called with lock_
+  // held.
+  CatalogSnapshotPtr GetCatalogSnapshot() const;
+
+  // Version of the committed table/tablet states and tablet replica locations, i.e. of everything
+  // that GetTabletLocations() could return differently. Used together with the catalog snapshot
+  // version to invalidate cached system.partitions contents.
+  int64_t tablet_locations_version() const {
+    return tablet_locations_version_.load(std::memory_order_acquire);
+  }
+
   // Return all the available (user-defined) types.
   void GetAllUDTypes(std::vector<scoped_refptr<UDTypeInfo> >* types);
 
@@ -1059,6 +1108,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   virtual CHECKED_STATUS StartRemoteBootstrap(const consensus::StartRemoteBootstrapRequestPB& req)
       override;
 
+  consensus::MultiRaftManager* multi_raft_manager() const override {
+    return nullptr;
+  }
+
   int GetNumReplicasFromPlacementInfo(const PlacementInfoPB& placement_info);
 
   // Loops through the table's placement infos to make sure the overall replication info is valid.
@@ -1324,8 +1377,16 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS BuildLocationsForTablet(const scoped_refptr<TabletInfo>& tablet,
                                          TabletLocationsPB* locs_pb);
 
-  // Handle one of the tablets in a tablet reported.
-  // Requires that the lock is already held.
+  // Handle all the tablets of a tablet report, adding an entry per tablet to 'report_update'.
+  // Large reports are split into FLAGS_master_tablet_report_num_shards shards by tablet id, which
+  // are processed in parallel on tablet_report_pool_.
+  CHECKED_STATUS HandleReportedTablets(TSDescriptor* ts_desc,
+                                       const TabletReportPB& report,
+                                       TabletReportUpdatesPB* report_update);
+
+  // Handle one of the tablets in a tablet report. Called concurrently for the tablets of different
+  // shards of a report on tablet_report_pool_, so it does not take the catalog manager lock: the
+  // tablet is looked up in the catalog snapshot, and only the table and tablet locks are taken.
   CHECKED_STATUS HandleReportedTablet(TSDescriptor* ts_desc,
                                       const ReportedTabletPB& report,
                                       ReportedTabletUpdatesPB *report_updates);
@@ -1427,6 +1488,21 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Start the background task to send the TruncateTable() RPC to the leader for this tablet.
   void SendTruncateTabletRequest(const scoped_refptr<TabletInfo>& tablet);
 
+  // Split the tablet at the specified partition key, an empty key splits it in the middle of its
+  // hash range.
+  CHECKED_STATUS SplitTablet(const TabletId& tablet_id,
+                             const std::string& split_partition_key,
+                             SplitTabletResponsePB* resp);
+
+  // Start the background task to send the SplitTablet() RPC to the leader for this tablet.
+  void SendSplitTabletRequest(const scoped_refptr<TabletInfo>& tablet,
+                              const std::array<TabletId, 2>& new_tablet_ids,
+                              const std::string& split_partition_key);
+
+  // Replace the split tablet with the tablets created by the split, once both of them are
+  // reported with a leader.
+  CHECKED_STATUS MaybeCompleteTabletSplit(const TabletId& parent_tablet_id);
+
   // Truncate the specified table/index.
   CHECKED_STATUS TruncateTable(const TableId& table_id,
                                bool is_index,
@@ -1505,6 +1581,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Report metrics.
   void ReportMetrics();
 
+  // Split the tablets whose size or load reported by the live tablet servers exceeds the split
+  // thresholds. Called periodically by the background tasks thread.
+  void SplitTabletsByLoad();
+
   // Conventional "T xxx P yyy: " prefix for logging.
   std::string LogPrefix() const;
 
@@ -1575,6 +1655,18 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   typedef rw_spinlock LockType;
   mutable LockType lock_;
 
+  // Must be called after modifying table_ids_map_, table_names_map_, tablet_map_,
+  // namespace_ids_map_ or namespace_names_map_, while still holding lock_ in exclusive mode.
+  void CatalogMapsChangedUnlocked() {
+    catalog_maps_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // Must be called after a table or tablet state change is committed, or after tablet replica
+  // locations are updated.
+  void TabletLocationsChanged() {
+    tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
   TableInfoMap table_ids_map_;         // Table map: table-id -> TableInfo
   TableInfoByNameMap table_names_map_; // Table map: [namespace-id, table-name] -> TableInfo
 
@@ -1585,10 +1677,23 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   TabletInfoMap tablet_map_;
 
   // Namespace maps: namespace-id -> NamespaceInfo and namespace-name -> NamespaceInfo
-  typedef std::unordered_map<NamespaceName, scoped_refptr<NamespaceInfo> > NamespaceInfoMap;
   NamespaceInfoMap namespace_ids_map_;
   NamespaceInfoMap namespace_names_map_;
 
+  // Number of modifications of the table, tablet and namespace maps above. Incremented by
+  // CatalogMapsChangedUnlocked() while lock_ is held in exclusive mode.
+  std::atomic<int64_t> catalog_maps_version_{0};
+
+  // The latest snapshot of the maps, read and published with std::atomic_load/atomic_store.
+  mutable CatalogSnapshotPtr catalog_snapshot_;
+
+  // Serializes publishing of catalog_snapshot_, so an older copy never replaces a newer one.
+  // This is a leaf lock: no other lock (in particular lock_) is acquired while it is held.
+  mutable std::mutex catalog_snapshot_mutex_;
+
+  // See tablet_locations_version().
+  std::atomic<int64_t> tablet_locations_version_{0};
+
   // User-Defined type maps: udtype-id -> UDTypeInfo and udtype-name -> UDTypeInfo
   UDTypeInfoMap udtype_ids_map_;
   UDTypeInfoByNameMap udtype_names_map_;
@@ -1668,6 +1773,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // upon closely timed consecutive elections).
   gscoped_ptr<ThreadPool> worker_pool_;
 
+  // Used to process the shards of large tablet reports in parallel.
+  gscoped_ptr<ThreadPool> tablet_report_pool_;
+
   // This field is updated when a node becomes leader master,
   // waits for all outstanding uncommitted metadata (table and tablet metadata)
   // in the sys catalog to commit, and then reads that metadata into in-memory
@@ -1694,6 +1802,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Number of live tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_live_;
 
+  // Time spent processing the tablet report of a single heartbeat.
+  scoped_refptr<Histogram> metric_tablet_report_processing_time_;
+
   friend class ClusterLoadBalancer;
 
   // Policy for load balancing tablets on tablet servers.
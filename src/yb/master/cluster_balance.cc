@@ -14,12 +14,14 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <boost/thread/locks.hpp>
 
 #include "yb/consensus/quorum_util.h"
 #include "yb/master/master.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 
 DEFINE_bool(enable_load_balancing,
@@ -60,6 +62,31 @@ DEFINE_int32(load_balancer_max_concurrent_moves,
              "Maximum number of tablet leaders on tablet servers to move in any one run of the "
              "load balancer.");
 
+DEFINE_double(load_balancer_heat_weight,
+              1.0,
+              "Weight of the reported tablet load relative to the tablet count when balancing "
+              "replicas and leaders. A tablet server hosting replicas that serve the average "
+              "tablet's ops per second gets one extra unit of load per replica. Set to 0 to "
+              "balance on tablet counts only.");
+TAG_FLAG(load_balancer_heat_weight, advanced);
+TAG_FLAG(load_balancer_heat_weight, runtime);
+
+DEFINE_double(load_balancer_min_heat_ops_per_sec,
+              10.0,
+              "Average ops per second per tablet of a table below which the reported tablet load "
+              "is ignored by the load balancer, to avoid moving tablets around because of noise.");
+TAG_FLAG(load_balancer_min_heat_ops_per_sec, advanced);
+TAG_FLAG(load_balancer_min_heat_ops_per_sec, runtime);
+
+DEFINE_double(load_balancer_heat_size_weight,
+              0.5,
+              "Weight of the SST file size of loaded tablets relative to the tablet count when "
+              "balancing replicas. A tablet server hosting replicas of the average size gets this "
+              "many extra units of load per replica. Only used while the table is hot enough for "
+              "heat to be taken into account. Set to 0 to ignore tablet sizes.");
+TAG_FLAG(load_balancer_heat_size_weight, advanced);
+TAG_FLAG(load_balancer_heat_size_weight, runtime);
+
 DECLARE_int32(min_leader_stepdown_retry_interval_ms);
 
 namespace yb {
@@ -298,6 +325,9 @@ Status ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
   // low for the given configuration.
   state_->AdjustLeaderBalanceThreshold();
 
+  // Heat has to be normalized before sorting, as it is part of the load.
+  state_->ComputeHeatUnits();
+
   // Once we've analyzed both the tablet server information as well as the tablets, we can sort the
   // load and are ready to apply the load balancing rules.
   state_->SortLoad();
@@ -442,7 +472,7 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   out << "Table load: ";
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
-    int load = state_->GetLoad(uuid);
+    double load = state_->GetLoad(uuid);
     out << uuid << ":" << load << " ";
   }
   VLOG(1) << out.str();
@@ -479,7 +509,7 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < state_->options_->kMinLoadVarianceToBalance) {
@@ -493,7 +523,8 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
       }
 
       // If we don't find a tablet_id to move between these two TSs, advance the state.
-      if (VERIFY_RESULT(GetTabletToMove(high_load_uuid, low_load_uuid, moving_tablet_id))) {
+      if (VERIFY_RESULT(GetTabletToMove(
+              high_load_uuid, low_load_uuid, load_variance, moving_tablet_id))) {
         // If we got this far, we have the candidate we want, so fill in the output params and
         // return. The tablet_id is filled in from GetTabletToMove.
         *from_ts = high_load_uuid;
@@ -531,7 +562,8 @@ Result<bool> ClusterLoadBalancer::ShouldSkipLeaderAsVictim(const TabletId& table
 }
 
 Result<bool> ClusterLoadBalancer::GetTabletToMove(
-    const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id) {
+    const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+    TabletId* moving_tablet_id) {
   const auto& from_ts_meta = state_->per_ts_meta_[from_ts];
   set<TabletId> non_over_replicated_tablets;
   set<TabletId> all_tablets;
@@ -556,6 +588,8 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
 
   bool same_placement = state_->per_ts_meta_[from_ts].descriptor->placement_id() ==
                         state_->per_ts_meta_[to_ts].descriptor->placement_id();
+  bool found = false;
+  double best_remaining_variance = load_variance;
   for (const auto& tablet_id : non_over_replicated_tablets) {
     const auto& placement_info = GetPlacementByTablet(tablet_id);
     // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -573,13 +607,19 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
       continue;
     }
     // If we got here, it means we either have no placement, in which case we can pick any TS, or
-    // we have placement and it's valid to move across these two tablet servers, so set the tablet
-    // and leave.
-    *moving_tablet_id = tablet_id;
-    return true;
+    // we have placement and it's valid to move across these two tablet servers. Pick the tablet
+    // that leaves the two tablet servers closest to each other, and never one so hot that moving
+    // it would just swap which of them is overloaded.
+    const double remaining_variance =
+        std::abs(load_variance - 2 * state_->GetTabletLoad(tablet_id));
+    if (remaining_variance < best_remaining_variance) {
+      *moving_tablet_id = tablet_id;
+      best_remaining_variance = remaining_variance;
+      found = true;
+    }
   }
   // If we couldn't select a tablet above, we have to return failure.
-  return false;
+  return found;
 }
 
 Result<bool> ClusterLoadBalancer::GetLeaderToMove(
@@ -616,7 +656,7 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_leader_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
-      int load_variance =
+      double load_variance =
           state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
@@ -638,10 +678,15 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       const auto& itr = std::inserter(intersection, intersection.begin());
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
 
+      // As for tablets, pick the leader that leaves the two tablet servers closest to each other.
+      bool found = false;
+      double best_remaining_variance = load_variance;
       for (const auto& tablet_id : intersection) {
-        *moving_tablet_id = tablet_id;
-        *from_ts = high_load_uuid;
-        *to_ts = low_load_uuid;
+        const double remaining_variance =
+            std::abs(load_variance - 2 * state_->GetTabletLeaderLoad(tablet_id));
+        if (remaining_variance >= best_remaining_variance) {
+          continue;
+        }
 
         const auto& per_tablet_meta = state_->per_tablet_meta_;
         const auto tablet_meta_iter = per_tablet_meta.find(tablet_id);
@@ -653,7 +698,8 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
             const auto time_since_failure = current_time - stepdown_failure_iter->second;
             if (time_since_failure.ToMilliseconds() < FLAGS_min_leader_stepdown_retry_interval_ms) {
               LOG(INFO) << "Cannot move tablet " << tablet_id << " leader from TS "
-                        << *from_ts << " to TS " << *to_ts << " yet: previous attempt with the same"
+                        << high_load_uuid << " to TS " << low_load_uuid
+                        << " yet: previous attempt with the same"
                         << " intended leader failed only " << ToString(time_since_failure)
                         << " ago (less " << "than " << FLAGS_min_leader_stepdown_retry_interval_ms
                         << "ms).";
@@ -661,8 +707,15 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
             continue;
           }
         } else {
-          LOG(WARNING) << "Did not find load balancer metadata for tablet " << *moving_tablet_id;
+          LOG(WARNING) << "Did not find load balancer metadata for tablet " << tablet_id;
         }
+        *moving_tablet_id = tablet_id;
+        *from_ts = high_load_uuid;
+        *to_ts = low_load_uuid;
+        best_remaining_variance = remaining_variance;
+        found = true;
+      }
+      if (found) {
         return true;
       }
     }
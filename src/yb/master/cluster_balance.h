@@ -206,8 +206,11 @@ class ClusterLoadBalancer {
   Result<bool> GetLoadToMove(
       TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts);
 
+  // Pick a tablet to move from from_ts to to_ts, whose loads differ by load_variance. Only tablets
+  // whose move reduces the difference are considered.
   Result<bool> GetTabletToMove(
-      const TabletServerId& from_ts, const TabletServerId& to_ts, TabletId* moving_tablet_id);
+      const TabletServerId& from_ts, const TabletServerId& to_ts, double load_variance,
+      TabletId* moving_tablet_id);
 
   // Go through sorted_leader_load_ and figure out which leader to rebalance and from which TS
   // that is serving it to which other TS.
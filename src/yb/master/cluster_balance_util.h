@@ -48,6 +48,12 @@ DECLARE_int32(load_balancer_max_concurrent_removals);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_double(load_balancer_heat_weight);
+
+DECLARE_double(load_balancer_min_heat_ops_per_sec);
+
+DECLARE_double(load_balancer_heat_size_weight);
+
 namespace yb {
 namespace master {
 
@@ -116,16 +122,22 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Highest smoothed ops per second reported by any of the replicas of this tablet.
+  double ops_per_sec = 0;
+
+  // Largest SST file size reported by any of the replicas of this tablet.
+  uint64_t sst_file_size = 0;
+
   std::string ToString() const {
     return Format("{ running: $0 starting: $1 is_under_replicated: $2 "
                       "under_replicated_placements: $3 is_over_replicated: $4 "
                       "over_replicated_tablet_servers: $5 wrong_placement_tablet_servers: $6 "
                       "blacklisted_tablet_servers: $7 leader_uuid: $8 "
-                      "leader_stepdown_failures: $9 }",
+                      "leader_stepdown_failures: $9 ops_per_sec: $10 sst_file_size: $11 }",
                   running, starting, is_under_replicated, under_replicated_placements,
                   is_over_replicated, over_replicated_tablet_servers,
                   wrong_placement_tablet_servers, blacklisted_tablet_servers,
-                  leader_uuid, leader_stepdown_failures);
+                  leader_uuid, leader_stepdown_failures, ops_per_sec, sst_file_size);
   }
 };
 
@@ -141,6 +153,15 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // Sum of the ops per second of the tablets in running_tablets and starting_tablets.
+  double replica_heat = 0;
+
+  // Sum of the ops per second of the tablets in leaders.
+  double leader_heat = 0;
+
+  // Sum of the SST file sizes of the tablets in running_tablets and starting_tablets.
+  double replica_size = 0;
 };
 
 struct Options {
@@ -187,8 +208,8 @@ class ClusterLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    double load_a = GetLoad(a);
+    double load_b = GetLoad(b);
     if (load_a == load_b) {
       return a < b;
     } else {
@@ -224,15 +245,87 @@ class ClusterLoadState {
     ClusterLoadState* state_;
   };
 
-  // Get the load for a certain TS.
-  int GetLoad(const TabletServerId& ts_uuid) const {
+  // Get the load for a certain TS. Each replica counts as one unit of load, plus its share of the
+  // heat of the tablet, once tablets report enough operations for heat to be taken into account.
+  // The heat of a replica grows with its data size, since larger replicas are slower to compact
+  // and to move.
+  double GetLoad(const TabletServerId& ts_uuid) const {
     const auto& ts_meta = per_ts_meta_.at(ts_uuid);
-    return ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+    double load = ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+    if (replica_heat_unit_ > 0) {
+      load += FLAGS_load_balancer_heat_weight * ts_meta.replica_heat / replica_heat_unit_;
+    }
+    if (replica_size_unit_ > 0) {
+      load += FLAGS_load_balancer_heat_size_weight * ts_meta.replica_size / replica_size_unit_;
+    }
+    return load;
+  }
+
+  // Get the leader load for a certain TS.
+  double GetLeaderLoad(const TabletServerId& ts_uuid) const {
+    const auto& ts_meta = per_ts_meta_.at(ts_uuid);
+    double load = ts_meta.leaders.size();
+    if (leader_heat_unit_ > 0) {
+      load += FLAGS_load_balancer_heat_weight * ts_meta.leader_heat / leader_heat_unit_;
+    }
+    return load;
+  }
+
+  // Get the load that moving a replica of this tablet takes off its tablet server.
+  double GetTabletLoad(const TabletId& tablet_id) const {
+    double load = 1 + TabletHeat(tablet_id, replica_heat_unit_);
+    auto it = per_tablet_meta_.find(tablet_id);
+    if (replica_size_unit_ > 0 && it != per_tablet_meta_.end()) {
+      load += FLAGS_load_balancer_heat_size_weight * it->second.sst_file_size / replica_size_unit_;
+    }
+    return load;
+  }
+
+  // Get the load that moving the leader of this tablet takes off its tablet server.
+  double GetTabletLeaderLoad(const TabletId& tablet_id) const {
+    return 1 + TabletHeat(tablet_id, leader_heat_unit_);
+  }
+
+  // Weighted heat of the tablet, expressed in heat_unit.
+  double TabletHeat(const TabletId& tablet_id, double heat_unit) const {
+    auto it = per_tablet_meta_.find(tablet_id);
+    if (heat_unit <= 0 || it == per_tablet_meta_.end()) {
+      return 0;
+    }
+    return FLAGS_load_balancer_heat_weight * it->second.ops_per_sec / heat_unit;
   }
 
-  // Get the load for a certain TS.
-  int GetLeaderLoad(const TabletServerId& ts_uuid) const {
-    return per_ts_meta_.at(ts_uuid).leaders.size();
+  // Compute the average heat and size of a replica and the average heat of a leader, which are
+  // used to normalize heat into the same units as the replica and leader counts. Heat is ignored
+  // while the table is too cold for per-tablet rates to be meaningful. Sizes are only reported
+  // for loaded tablets, so they are ignored together with the replica heat.
+  void ComputeHeatUnits() {
+    double total_replica_heat = 0;
+    double total_replica_size = 0;
+    for (const auto& entry : per_ts_meta_) {
+      total_replica_heat += entry.second.replica_heat;
+      total_replica_size += entry.second.replica_size;
+    }
+    double total_tablet_heat = 0;
+    for (const auto& entry : per_tablet_meta_) {
+      total_tablet_heat += entry.second.ops_per_sec;
+    }
+    const int total_replicas = total_running_ + total_starting_;
+    replica_heat_unit_ = total_replicas > 0 ? total_replica_heat / total_replicas : 0;
+    replica_size_unit_ = total_replicas > 0 ? total_replica_size / total_replicas : 0;
+    leader_heat_unit_ =
+        per_tablet_meta_.empty() ? 0 : total_tablet_heat / per_tablet_meta_.size();
+    if (FLAGS_load_balancer_heat_weight <= 0 ||
+        replica_heat_unit_ < FLAGS_load_balancer_min_heat_ops_per_sec) {
+      replica_heat_unit_ = 0;
+    }
+    if (replica_heat_unit_ <= 0 || FLAGS_load_balancer_heat_size_weight <= 0) {
+      replica_size_unit_ = 0;
+    }
+    if (FLAGS_load_balancer_heat_weight <= 0 ||
+        leader_heat_unit_ < FLAGS_load_balancer_min_heat_ops_per_sec) {
+      leader_heat_unit_ = 0;
+    }
   }
 
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
@@ -249,6 +342,16 @@ class ClusterLoadState {
     // Get replicas for this tablet.
     TabletInfo::ReplicaMap replica_map;
     GetReplicaLocations(tablet, &replica_map);
+    // A follower only reports the writes it replicates, so take the busiest replica as the load of
+    // the tablet.
+    for (const auto& replica : replica_map) {
+      if (replica.second.ts_desc) {
+        tablet_meta.ops_per_sec = std::max(
+            tablet_meta.ops_per_sec, replica.second.ts_desc->GetTabletOpsPerSec(tablet_id));
+        tablet_meta.sst_file_size = std::max(
+            tablet_meta.sst_file_size, replica.second.ts_desc->GetTabletSSTFileSize(tablet_id));
+      }
+    }
     // Set state information for both the tablet and the tablet server replicas.
     for (const auto& replica : replica_map) {
       const auto& ts_uuid = replica.first;
@@ -272,16 +375,21 @@ class ClusterLoadState {
       if (replica.second.role == consensus::RaftPeerPB::LEADER) {
         tablet_meta.leader_uuid = ts_uuid;
         ts_meta_it->second.leaders.insert(tablet_id);
+        ts_meta_it->second.leader_heat += tablet_meta.ops_per_sec;
       }
 
       const tablet::TabletStatePB& tablet_state = replica.second.state;
       if (tablet_state == tablet::RUNNING) {
         ts_meta_it->second.running_tablets.insert(tablet_id);
+        ts_meta_it->second.replica_heat += tablet_meta.ops_per_sec;
+        ts_meta_it->second.replica_size += tablet_meta.sst_file_size;
         ++tablet_meta.running;
         ++total_running_;
       } else if (tablet_state == tablet::BOOTSTRAPPING || tablet_state == tablet::NOT_STARTED) {
         // Keep track of transitioning state (not running, but not in a stopped or failed state).
         ts_meta_it->second.starting_tablets.insert(tablet_id);
+        ts_meta_it->second.replica_heat += tablet_meta.ops_per_sec;
+        ts_meta_it->second.replica_size += tablet_meta.sst_file_size;
         ++tablet_meta.starting;
         ++total_starting_;
       }
@@ -518,6 +626,8 @@ class ClusterLoadState {
 
   Status AddReplica(const TabletId& tablet_id, const TabletServerId& to_ts) {
     per_ts_meta_[to_ts].starting_tablets.insert(tablet_id);
+    per_ts_meta_[to_ts].replica_heat += per_tablet_meta_[tablet_id].ops_per_sec;
+    per_ts_meta_[to_ts].replica_size += per_tablet_meta_[tablet_id].sst_file_size;
     ++per_tablet_meta_[tablet_id].starting;
     ++total_starting_;
     tablets_added_.insert(tablet_id);
@@ -528,11 +638,15 @@ class ClusterLoadState {
   Status RemoveReplica(const TabletId& tablet_id, const TabletServerId& from_ts) {
     if (per_ts_meta_[from_ts].running_tablets.count(tablet_id)) {
       per_ts_meta_[from_ts].running_tablets.erase(tablet_id);
+      per_ts_meta_[from_ts].replica_heat -= per_tablet_meta_[tablet_id].ops_per_sec;
+      per_ts_meta_[from_ts].replica_size -= per_tablet_meta_[tablet_id].sst_file_size;
       --per_tablet_meta_[tablet_id].running;
       --total_running_;
     }
     if (per_ts_meta_[from_ts].starting_tablets.count(tablet_id)) {
       per_ts_meta_[from_ts].starting_tablets.erase(tablet_id);
+      per_ts_meta_[from_ts].replica_heat -= per_tablet_meta_[tablet_id].ops_per_sec;
+      per_ts_meta_[from_ts].replica_size -= per_tablet_meta_[tablet_id].sst_file_size;
       --per_tablet_meta_[tablet_id].starting;
       --total_starting_;
     }
@@ -562,10 +676,13 @@ class ClusterLoadState {
       return STATUS_SUBSTITUTE(IllegalState, "Tablet $0 has leader $1, but $2 expected.",
                                tablet_id, per_tablet_meta_[tablet_id].leader_uuid, from_ts);
     }
+    const double ops_per_sec = per_tablet_meta_[tablet_id].ops_per_sec;
     per_tablet_meta_[tablet_id].leader_uuid = to_ts;
     per_ts_meta_[from_ts].leaders.erase(tablet_id);
+    per_ts_meta_[from_ts].leader_heat -= ops_per_sec;
     if (!to_ts.empty()) {
       per_ts_meta_[to_ts].leaders.insert(tablet_id);
+      per_ts_meta_[to_ts].leader_heat += ops_per_sec;
     }
     SortLeaderLoad();
     return Status::OK();
@@ -578,7 +695,8 @@ class ClusterLoadState {
 
   inline bool IsLeaderLoadBelowThreshold(const TabletServerId& ts_uuid) {
     return ((leader_balance_threshold_ > 0) &&
-            (GetLeaderLoad(ts_uuid) <= leader_balance_threshold_));
+            (static_cast<int>(per_ts_meta_.at(ts_uuid).leaders.size()) <=
+                 leader_balance_threshold_));
   }
 
   void AdjustLeaderBalanceThreshold() {
@@ -653,6 +771,15 @@ class ClusterLoadState {
   // Number of leaders per each tablet server to balance below.
   int leader_balance_threshold_ = 0;
 
+  // Average ops per second of a tablet replica and of a tablet leader, used as the unit in which
+  // heat is added to the replica and leader counts. 0 if heat is not taken into account.
+  double replica_heat_unit_ = 0;
+  double leader_heat_unit_ = 0;
+
+  // Average SST file size of a tablet replica, used as the unit in which replica sizes are added
+  // to the replica counts. 0 if sizes are not taken into account.
+  double replica_size_unit_ = 0;
+
   // List of table server ids sorted by their leader load.
   // If affinitized leaders is enabled, stores leader load for affinitized nodes.
   vector<TabletServerId> sorted_leader_load_;
@@ -660,6 +660,28 @@ TEST_F(MasterTest, TestInvalidGetTableLocations) {
   }
 }
 
+TEST_F(MasterTest, TestCatalogSnapshot) {
+  const TableName kTableName = "testtb";
+  Schema schema({ ColumnSchema("key", INT32) }, 1);
+  auto* catalog_manager = mini_master_->master()->catalog_manager();
+
+  // The snapshot is reused while the catalog is not modified.
+  auto snapshot = catalog_manager->GetCatalogSnapshot();
+  ASSERT_EQ(snapshot, catalog_manager->GetCatalogSnapshot());
+  const auto num_tables = snapshot->table_ids_map.size();
+
+  ASSERT_OK(CreateTable(kTableName, schema));
+
+  // Creating a table publishes a new snapshot, the old one stays unchanged.
+  auto new_snapshot = catalog_manager->GetCatalogSnapshot();
+  ASSERT_NE(snapshot, new_snapshot);
+  ASSERT_GT(new_snapshot->version, snapshot->version);
+  ASSERT_EQ(num_tables, snapshot->table_ids_map.size());
+  ASSERT_EQ(num_tables + 1, new_snapshot->table_ids_map.size());
+  ASSERT_EQ(1, new_snapshot->table_names_map.count({default_namespace_id, kTableName}));
+  ASSERT_EQ(new_snapshot, catalog_manager->GetCatalogSnapshot());
+}
+
 TEST_F(MasterTest, TestInvalidPlacementInfo) {
   const TableName kTableName = "test";
   Schema schema({ColumnSchema("key", INT32)}, 1);
@@ -260,6 +260,12 @@ void MasterServiceImpl::TruncateTable(const TruncateTableRequestPB* req,
   HandleIn(req, resp, &rpc, &CatalogManager::TruncateTable);
 }
 
+void MasterServiceImpl::SplitTablet(const SplitTabletRequestPB* req,
+                                    SplitTabletResponsePB* resp,
+                                    RpcContext rpc) {
+  HandleIn(req, resp, &rpc, &CatalogManager::SplitTablet);
+}
+
 void MasterServiceImpl::IsTruncateTableDone(const IsTruncateTableDoneRequestPB* req,
                                             IsTruncateTableDoneResponsePB* resp,
                                             RpcContext rpc) {
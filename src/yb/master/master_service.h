@@ -66,6 +66,9 @@ class MasterServiceImpl : public MasterServiceIf,
   virtual void TruncateTable(const TruncateTableRequestPB* req,
                              TruncateTableResponsePB* resp,
                              rpc::RpcContext rpc) override;
+  virtual void SplitTablet(const SplitTabletRequestPB* req,
+                           SplitTabletResponsePB* resp,
+                           rpc::RpcContext rpc) override;
   virtual void IsTruncateTableDone(const IsTruncateTableDoneRequestPB* req,
                                    IsTruncateTableDoneResponsePB* resp,
                                    rpc::RpcContext rpc) override;
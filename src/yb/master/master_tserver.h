@@ -48,6 +48,10 @@ class MasterTabletServer : public tserver::TabletServerIf,
 
   CHECKED_STATUS StartRemoteBootstrap(const consensus::StartRemoteBootstrapRequestPB& req) override;
 
+  consensus::MultiRaftManager* multi_raft_manager() const override {
+    return nullptr;
+  }
+
  private:
   Master* master_ = nullptr;
   std::unique_ptr<MetricRegistry> metric_registry_;
@@ -511,8 +511,11 @@ Status SysCatalogTable::OpenTablet(const scoped_refptr<tablet::TabletMetadata>&
                                                      log,
                                                      tablet->GetMetricEntity(),
                                                      raft_pool(),
+                                                     nullptr /* log_prefetch_pool */,
                                                      tablet_prepare_pool(),
-                                                     nullptr /* retryable_requests */),
+                                                     nullptr /* apply_pool */,
+                                                     nullptr /* retryable_requests */,
+                                                     nullptr /* multi_raft_manager */),
                         "Failed to Init() TabletPeer");
 
   RETURN_NOT_OK_PREPEND(tablet_peer()->Start(consensus_info),
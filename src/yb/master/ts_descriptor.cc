@@ -35,6 +35,7 @@
 #include <math.h>
 
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "yb/common/wire_protocol.h"
@@ -43,8 +44,16 @@
 #include "yb/master/master.pb.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 #include "yb/tserver/tserver_service.proxy.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/net/net_util.h"
 
+DEFINE_double(tablet_load_smoothing_factor, 0.3,
+              "Weight of the most recent heartbeat in the exponential moving average of the "
+              "per-tablet load reported by tablet servers. Lower values make the load balancer "
+              "react slower to load spikes.");
+TAG_FLAG(tablet_load_smoothing_factor, advanced);
+TAG_FLAG(tablet_load_smoothing_factor, runtime);
+
 namespace yb {
 namespace master {
 
@@ -255,6 +264,70 @@ void TSDescriptor::UpdateMetrics(const TServerMetricsPB& metrics) {
   tsMetrics_.read_ops_per_sec = metrics.read_ops_per_sec();
   tsMetrics_.write_ops_per_sec = metrics.write_ops_per_sec();
   tsMetrics_.uptime_seconds = metrics.uptime_seconds();
+
+  // Tablets that are not reported did not serve any operations during the last interval.
+  const double alpha = std::min(std::max(FLAGS_tablet_load_smoothing_factor, 0.0), 1.0);
+  std::unordered_map<std::string, double> tablet_ops_per_sec;
+  tablet_ops_per_sec.swap(tsMetrics_.tablet_ops_per_sec);
+  for (const auto& load : metrics.tablet_loads()) {
+    const double ops = load.read_ops_per_sec() + load.write_ops_per_sec();
+    if (load.has_sst_file_size()) {
+      tsMetrics_.tablet_sst_file_size[load.tablet_id()] = load.sst_file_size();
+    }
+    auto it = tablet_ops_per_sec.find(load.tablet_id());
+    if (it == tablet_ops_per_sec.end()) {
+      // Idle tablets are only reported when their size changes.
+      if (ops > 0) {
+        tsMetrics_.tablet_ops_per_sec.emplace(load.tablet_id(), ops);
+      }
+    } else {
+      tsMetrics_.tablet_ops_per_sec.emplace(
+          load.tablet_id(), alpha * ops + (1 - alpha) * it->second);
+      tablet_ops_per_sec.erase(it);
+    }
+  }
+  for (const auto& entry : tablet_ops_per_sec) {
+    const double ops = (1 - alpha) * entry.second;
+    if (ops >= 1) {
+      tsMetrics_.tablet_ops_per_sec.emplace(entry.first, ops);
+    }
+  }
+}
+
+double TSDescriptor::GetTabletOpsPerSec(const std::string& tablet_id) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  auto it = tsMetrics_.tablet_ops_per_sec.find(tablet_id);
+  return it == tsMetrics_.tablet_ops_per_sec.end() ? 0 : it->second;
+}
+
+uint64_t TSDescriptor::GetTabletSSTFileSize(const std::string& tablet_id) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (tsMetrics_.tablet_ops_per_sec.count(tablet_id) == 0) {
+    return 0;
+  }
+  auto it = tsMetrics_.tablet_sst_file_size.find(tablet_id);
+  return it == tsMetrics_.tablet_sst_file_size.end() ? 0 : it->second;
+}
+
+std::vector<std::string> TSDescriptor::GetTabletsAboveLoad(
+    uint64_t sst_file_size_threshold, double ops_per_sec_threshold) const {
+  std::set<std::string> result;
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (sst_file_size_threshold != 0) {
+    for (const auto& entry : tsMetrics_.tablet_sst_file_size) {
+      if (entry.second >= sst_file_size_threshold) {
+        result.insert(entry.first);
+      }
+    }
+  }
+  if (ops_per_sec_threshold > 0) {
+    for (const auto& entry : tsMetrics_.tablet_ops_per_sec) {
+      if (entry.second >= ops_per_sec_threshold) {
+        result.insert(entry.first);
+      }
+    }
+  }
+  return std::vector<std::string>(result.begin(), result.end());
 }
 
 bool TSDescriptor::HasTabletDeletePending() const {
@@ -275,6 +348,8 @@ void TSDescriptor::AddPendingTabletDelete(const std::string& tablet_id) {
 void TSDescriptor::ClearPendingTabletDelete(const std::string& tablet_id) {
   std::lock_guard<simple_spinlock> l(lock_);
   tablets_pending_delete_.erase(tablet_id);
+  // The replica is gone, so its size should not be used anymore.
+  tsMetrics_.tablet_sst_file_size.erase(tablet_id);
 }
 
 std::string TSDescriptor::ToString() const {
@@ -35,6 +35,8 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/master/master.pb.h"
@@ -228,9 +230,23 @@ class TSDescriptor {
   void UpdateMetrics(const TServerMetricsPB& metrics);
 
   void ClearMetrics() {
+    std::lock_guard<simple_spinlock> l(lock_);
     tsMetrics_.ClearMetrics();
   }
 
+  // Smoothed read plus write ops per second served by the replica of the given tablet hosted on
+  // this tablet server, or 0 if the tablet was not reported as loaded.
+  double GetTabletOpsPerSec(const std::string& tablet_id) const;
+
+  // Last reported SST file size of the replica of the given tablet hosted on this tablet server,
+  // or 0 if the tablet is not considered loaded.
+  uint64_t GetTabletSSTFileSize(const std::string& tablet_id) const;
+
+  // Tablets whose replicas hosted on this tablet server are at least as large or as hot as the
+  // given thresholds. A threshold of 0 is not checked.
+  std::vector<std::string> GetTabletsAboveLoad(
+      uint64_t sst_file_size_threshold, double ops_per_sec_threshold) const;
+
   // Set of methods to keep track of pending tablet deletes for a tablet server. We use them to
   // avoid assigning more tablets to a tserver that might be potentially unresponsive.
   bool HasTabletDeletePending() const;
@@ -286,6 +302,13 @@ class TSDescriptor {
 
     uint64_t uptime_seconds = 0;
 
+    // Exponential moving average of the ops per second of each loaded tablet replica.
+    std::unordered_map<std::string, double> tablet_ops_per_sec;
+
+    // SST file size of each tablet replica, as of its latest report. Kept until the replica is
+    // deleted, since idle tablets are only reported when their size changes.
+    std::unordered_map<std::string, uint64_t> tablet_sst_file_size;
+
     void ClearMetrics() {
       total_memory_usage = 0;
       total_sst_file_size = 0;
@@ -293,6 +316,8 @@ class TSDescriptor {
       read_ops_per_sec = 0;
       write_ops_per_sec = 0;
       uptime_seconds = 0;
+      tablet_ops_per_sec.clear();
+      tablet_sst_file_size.clear();
     }
   };
 
@@ -16,6 +16,14 @@
 #include "yb/common/ql_value.h"
 #include "yb/master/catalog_manager.h"
 #include "yb/master/master_util.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(partitions_vtable_cache_refresh_secs, 30,
+             "Maximum time in seconds to serve the cached system.partitions contents. The cache is "
+             "also invalidated as soon as tables, tablets or their replica locations change. "
+             "0 disables the cache.");
+TAG_FLAG(partitions_vtable_cache_refresh_secs, advanced);
+TAG_FLAG(partitions_vtable_cache_refresh_secs, runtime);
 
 namespace yb {
 namespace master {
@@ -26,7 +34,38 @@ YQLPartitionsVTable::YQLPartitionsVTable(const Master* const master)
 
 Status YQLPartitionsVTable::RetrieveData(const QLReadRequestPB& request,
                                          std::unique_ptr<QLRowBlock>* vtable) const {
-  vtable->reset(new QLRowBlock(schema_));
+  if (FLAGS_partitions_vtable_cache_refresh_secs <= 0) {
+    vtable->reset(new QLRowBlock(schema_));
+    return BuildRows(vtable->get());
+  }
+
+  CatalogManager* catalog_manager = master_->catalog_manager();
+  // Versions are read before building the rows, so a change that races with the build makes
+  // the next call rebuild the cache instead of serving stale contents.
+  const int64_t tablet_locations_version = catalog_manager->tablet_locations_version();
+  const int64_t catalog_version = catalog_manager->GetCatalogSnapshot()->version;
+  const MonoTime now = MonoTime::Now();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!cached_rows_ ||
+      cached_catalog_version_ != catalog_version ||
+      cached_tablet_locations_version_ != tablet_locations_version ||
+      now >= cache_expiration_) {
+    auto rows = std::make_shared<QLRowBlock>(schema_);
+    RETURN_NOT_OK(BuildRows(rows.get()));
+    cached_rows_ = std::move(rows);
+    cached_catalog_version_ = catalog_version;
+    cached_tablet_locations_version_ = tablet_locations_version;
+    cache_expiration_ = now + MonoDelta::FromSeconds(FLAGS_partitions_vtable_cache_refresh_secs);
+  }
+
+  // The caller filters the returned rows, so give it its own copy.
+  vtable->reset(new QLRowBlock(*cached_rows_));
+  return Status::OK();
+}
+
+Status YQLPartitionsVTable::BuildRows(QLRowBlock* vtable) const {
+  num_builds_.fetch_add(1, std::memory_order_acq_rel);
   std::vector<scoped_refptr<TableInfo> > tables;
   CatalogManager* catalog_manager = master_->catalog_manager();
   catalog_manager->GetAllTables(&tables, true /* includeOnlyRunningTables */);
@@ -54,7 +93,7 @@ Status YQLPartitionsVTable::RetrieveData(const QLReadRequestPB& request,
         continue;
       }
 
-      QLRow& row = (*vtable)->Extend();
+      QLRow& row = vtable->Extend();
       RETURN_NOT_OK(SetColumnValue(kKeyspaceName, nsInfo->name(), &row));
       RETURN_NOT_OK(SetColumnValue(kTableName, table->name(), &row));
 
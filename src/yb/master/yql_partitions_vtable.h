@@ -14,6 +14,9 @@
 #ifndef YB_MASTER_YQL_PARTITIONS_VTABLE_H
 #define YB_MASTER_YQL_PARTITIONS_VTABLE_H
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/master/master.h"
 #include "yb/master/yql_virtual_table.h"
 
@@ -21,14 +24,36 @@ namespace yb {
 namespace master {
 
 // VTable implementation of system.partitions.
+//
+// Drivers poll this table frequently and building it requires going over all tablets, so the
+// contents are cached and only rebuilt when the catalog or the tablet locations change.
 class YQLPartitionsVTable : public YQLVirtualTable {
  public:
   explicit YQLPartitionsVTable(const Master* const master);
   CHECKED_STATUS RetrieveData(const QLReadRequestPB& request,
                               std::unique_ptr<QLRowBlock>* vtable) const;
+
+  // Number of times the contents were built from the catalog, i.e. not served from the cache.
+  int64_t TEST_num_builds() const {
+    return num_builds_.load(std::memory_order_acquire);
+  }
+
  protected:
   Schema CreateSchema() const;
  private:
+  // Builds the contents of the table from the current catalog state.
+  CHECKED_STATUS BuildRows(QLRowBlock* vtable) const;
+
+  // Protects the cache below. Also held while rebuilding it, so that concurrent readers wait for
+  // the new contents instead of building them again.
+  mutable std::mutex mutex_;
+  mutable std::shared_ptr<const QLRowBlock> cached_rows_;
+  mutable int64_t cached_catalog_version_ = -1;
+  mutable int64_t cached_tablet_locations_version_ = -1;
+  mutable MonoTime cache_expiration_;
+
+  mutable std::atomic<int64_t> num_builds_{0};
+
   static constexpr const char* const kKeyspaceName = "keyspace_name";
   static constexpr const char* const kTableName = "table_name";
   static constexpr const char* const kStartKey = "start_key";
@@ -40,6 +40,24 @@ Status PeersVTable::RetrieveData(const QLReadRequestPB& request,
   vector<shared_ptr<TSDescriptor> > descs;
   GetSortedLiveDescriptors(&descs);
 
+  std::vector<std::pair<string, int64_t>> instances;
+  instances.reserve(descs.size());
+  for (const auto& desc : descs) {
+    instances.emplace_back(desc->permanent_uuid(), desc->latest_seqno());
+  }
+
+  shared_ptr<const PeersCache> cache;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!cache_ || cache_->instances != instances) {
+      auto new_cache = std::make_shared<PeersCache>();
+      new_cache->instances = std::move(instances);
+      RETURN_NOT_OK(BuildCache(descs, new_cache.get()));
+      cache_ = std::move(new_cache);
+    }
+    cache = cache_;
+  }
+
   // Collect all unique ip addresses.
   InetAddress remote_endpoint;
   RETURN_NOT_OK(remote_endpoint.FromString(request.remote_endpoint().host()));
@@ -49,16 +67,15 @@ Status PeersVTable::RetrieveData(const QLReadRequestPB& request,
   // Populate the YQL rows.
   vtable->reset(new QLRowBlock(schema_));
 
-  size_t index = 0;
-  for (const shared_ptr<TSDescriptor>& desc : descs) {
-    size_t current_index = index++;
-
-    TSInformationPB ts_info;
-    // This is thread safe since all operations are reads.
-    desc->GetTSInformationPB(&ts_info);
+  for (size_t index = 0; index != cache->ts_infos.size(); ++index) {
+    const TSInformationPB& ts_info = cache->ts_infos[index];
 
+    // The system.peers table has one entry for each of its peers, whereas there is no entry for
+    // the node that the CQL client connects to. In this case, this node is the 'remote_endpoint'
+    // in QLReadRequestPB since that is address of the CQL proxy which sent this request. As a
+    // result, skip 'remote_endpoint' in the results.
     if (!proxy_uuid.empty()) {
-      if (desc->permanent_uuid() == proxy_uuid) {
+      if (cache->instances[index].first == proxy_uuid) {
         continue;
       }
     } else {
@@ -68,10 +85,27 @@ Status PeersVTable::RetrieveData(const QLReadRequestPB& request,
       }
     }
 
-    // The system.peers table has one entry for each of its peers, whereas there is no entry for
-    // the node that the CQL client connects to. In this case, this node is the 'remote_endpoint'
-    // in QLReadRequestPB since that is address of the CQL proxy which sent this request. As a
-    // result, skip 'remote_endpoint' in the results.
+    const int row_index = cache->row_indexes[index];
+    if (row_index >= 0) {
+      RETURN_NOT_OK((*vtable)->AddRow(cache->rows->rows()[row_index]));
+    }
+  }
+
+  return Status::OK();
+}
+
+Status PeersVTable::BuildCache(const vector<shared_ptr<TSDescriptor>>& descs,
+                               PeersCache* cache) const {
+  num_builds_.fetch_add(1, std::memory_order_acq_rel);
+  cache->rows.reset(new QLRowBlock(schema_));
+  cache->ts_infos.resize(descs.size());
+  cache->row_indexes.resize(descs.size(), -1);
+
+  for (size_t index = 0; index != descs.size(); ++index) {
+    TSInformationPB& ts_info = cache->ts_infos[index];
+    // This is thread safe since all operations are reads.
+    descs[index]->GetTSInformationPB(&ts_info);
+
     auto ips = util::GetPublicPrivateIPs(ts_info);
     if (!ips.ok()) {
       LOG(ERROR) << "Failed to get IPs from " << ts_info.ShortDebugString() << ": " << ips.status();
@@ -80,7 +114,8 @@ Status PeersVTable::RetrieveData(const QLReadRequestPB& request,
 
     // Need to use only 1 rpc address per node since system.peers has only 1 entry for each host,
     // so pick the first one.
-    QLRow &row = (*vtable)->Extend();
+    cache->row_indexes[index] = cache->rows->row_count();
+    QLRow &row = cache->rows->Extend();
     RETURN_NOT_OK(SetColumnValue(kPeer, ips->public_ip, &row));
     RETURN_NOT_OK(SetColumnValue(kRPCAddress, ips->public_ip, &row));
     RETURN_NOT_OK(SetColumnValue(kPreferredIp, ips->private_ip, &row));
@@ -102,7 +137,7 @@ Status PeersVTable::RetrieveData(const QLReadRequestPB& request,
 
     // Tokens.
     RETURN_NOT_OK(SetColumnValue(
-        kTokens, util::GetTokensValue(current_index, descs.size()), &row));
+        kTokens, util::GetTokensValue(index, descs.size()), &row));
   }
 
   return Status::OK();
@@ -14,6 +14,9 @@
 #ifndef YB_MASTER_YQL_PEERS_VTABLE_H
 #define YB_MASTER_YQL_PEERS_VTABLE_H
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/master/master.h"
 #include "yb/master/yql_virtual_table.h"
 
@@ -27,10 +30,35 @@ class PeersVTable : public YQLVirtualTable {
   CHECKED_STATUS RetrieveData(const QLReadRequestPB& request,
                               std::unique_ptr<QLRowBlock>* vtable) const;
 
+  // Number of times the rows were rebuilt because the set of live tablet servers changed.
+  int64_t TEST_num_builds() const {
+    return num_builds_.load(std::memory_order_acquire);
+  }
+
  protected:
   Schema CreateSchema() const;
 
  private:
+  // Rows for all live tablet servers. Resolving the addresses of the tablet servers is relatively
+  // expensive, so the rows are reused until the set of live tablet servers changes.
+  struct PeersCache {
+    // Uuids and instance sequence numbers of the live tablet servers, sorted by uuid.
+    std::vector<std::pair<std::string, int64_t>> instances;
+    // Information about each of the live tablet servers, in the same order.
+    std::vector<TSInformationPB> ts_infos;
+    // Index of the row of each live tablet server in rows, -1 if it has no row.
+    std::vector<int> row_indexes;
+    std::unique_ptr<QLRowBlock> rows;
+  };
+
+  CHECKED_STATUS BuildCache(const std::vector<std::shared_ptr<TSDescriptor>>& descs,
+                            PeersCache* cache) const;
+
+  mutable std::mutex mutex_;
+  mutable std::shared_ptr<const PeersCache> cache_;
+
+  mutable std::atomic<int64_t> num_builds_{0};
+
   static constexpr const char* const kPeer = "peer";
   static constexpr const char* const kDataCenter = "data_center";
   static constexpr const char* const kHostId = "host_id";
@@ -802,6 +802,10 @@ void Version::AddIterators(const ReadOptions& read_options,
   auto* arena = merge_iter_builder->GetArena();
 
   // Merge all level zero files together since they may overlap
+  if (read_options.file_filter) {
+    read_options.file_filter->Prepare(
+        storage_info_.LevelFilesBrief(0).files, storage_info_.LevelFilesBrief(0).num_files);
+  }
   for (size_t i = 0; i < storage_info_.LevelFilesBrief(0).num_files; i++) {
     const auto& file = storage_info_.LevelFilesBrief(0).files[i];
     if (!read_options.file_filter || read_options.file_filter->Filter(file)) {
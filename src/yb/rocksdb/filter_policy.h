@@ -148,6 +148,10 @@ class FilterPolicy {
 
     // Transform a key.
     virtual Slice Transform(Slice key) const = 0;
+
+    // Returns false if the key does not contain the whole part of the key that transformation
+    // keeps, so the filter can't tell whether there are keys starting with the given one.
+    virtual bool IsFilterable(Slice key) const { return true; }
   };
 
   // Filter policy can optionally return key transformer to be used before writing key to filter or
@@ -1372,6 +1372,10 @@ enum ReadTier {
 struct FdWithBoundaries;
 class ReadFileFilter {
  public:
+  // Called with all files of the level before Filter is invoked for them, so the filter could make
+  // decisions that depend on the whole set of files.
+  virtual void Prepare(const FdWithBoundaries* files, size_t num_files) {}
+
   virtual bool Filter(const FdWithBoundaries&) const = 0;
 
  protected:
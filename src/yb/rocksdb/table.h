@@ -478,7 +478,8 @@ class TableFactory {
   // Returns SST file filter for pruning out files which doesn't contain some part of user_key.
   // It should be in sync with FilterPolicy used for bloom filter construction. For example,
   // file filter should only consider hashed components of the key when using with
-  // DocDbAwareFilterPolicy and HashedComponentsExtractor.
+  // DocDbAwareFilterPolicy and HashedComponentsExtractor. Returns nullptr if user_key is too short
+  // to be checked against the filter.
   virtual std::shared_ptr<TableAwareReadFileFilter> NewTableAwareReadFileFilter(
       const ReadOptions &read_options, const Slice &user_key) const { return nullptr; }
 };
@@ -198,6 +198,11 @@ const BlockBasedTableOptions& BlockBasedTableFactory::table_options() const {
 }
 std::shared_ptr<TableAwareReadFileFilter> BlockBasedTableFactory::NewTableAwareReadFileFilter(
     const ReadOptions &read_options, const Slice &user_key) const {
+  const auto* key_transformer = table_options_.filter_policy ?
+      table_options_.filter_policy->GetKeyTransformer() : nullptr;
+  if (key_transformer && !key_transformer->IsFilterable(user_key)) {
+    return nullptr;
+  }
   return std::make_shared<BloomFilterAwareFileFilter>(read_options, user_key);
 }
 
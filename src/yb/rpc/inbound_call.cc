@@ -32,6 +32,9 @@
 
 #include "yb/rpc/inbound_call.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "yb/common/redis_protocol.pb.h"
 
 #include "yb/gutil/strings/substitute.h"
@@ -76,6 +79,12 @@ DEFINE_int32(rpc_slow_query_threshold_ms, 10000,
 TAG_FLAG(rpc_slow_query_threshold_ms, advanced);
 TAG_FLAG(rpc_slow_query_threshold_ms, runtime);
 
+DEFINE_int32(rpc_slow_query_log_every_n, 1,
+             "Only one of each N calls that take longer than rpc_slow_query_threshold_ms is "
+             "logged.");
+TAG_FLAG(rpc_slow_query_log_every_n, advanced);
+TAG_FLAG(rpc_slow_query_log_every_n, runtime);
+
 namespace yb {
 namespace rpc {
 
@@ -140,8 +149,9 @@ void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_handled.Initialized()) << "Already marked as started";
   timing_.time_handled = MonoTime::Now();
   VLOG_WITH_PREFIX(4) << "Handling";
-  incoming_queue_time->Increment(
-      timing_.time_handled.GetDeltaSince(timing_.time_received).ToMicroseconds());
+  auto queue_time = timing_.time_handled.GetDeltaSince(timing_.time_received);
+  incoming_queue_time->Increment(queue_time.ToMicroseconds());
+  RecordRequestStage(trace_.get(), RequestStage::kQueueWait, queue_time);
 }
 
 MonoDelta InboundCall::GetTimeInQueue() const {
@@ -179,6 +189,27 @@ void InboundCall::QueueResponse(bool is_success) {
   }
 }
 
+bool InboundCall::ShouldLogSlowQuery(int64_t total_time_ms) {
+  if (FLAGS_rpc_dump_all_traces) {
+    return true;
+  }
+  if (total_time_ms <= FLAGS_rpc_slow_query_threshold_ms) {
+    return false;
+  }
+  static std::atomic<uint64_t> num_slow_queries{0};
+  const uint64_t every_n = std::max(FLAGS_rpc_slow_query_log_every_n, 1);
+  return num_slow_queries.fetch_add(1, std::memory_order_relaxed) % every_n == 0;
+}
+
+std::string InboundCall::StageBreakdown() const {
+  RequestStages stages;
+  trace_->CollectStages(&stages);
+  if (stages.empty()) {
+    return std::string();
+  }
+  return " Stages: " + stages.ToString() + ".";
+}
+
 std::string InboundCall::LogPrefix() const {
   return Format("$0: ", this);
 }
@@ -155,6 +155,13 @@ class InboundCall : public RpcCall {
   // Also can be configured to log _all_ RPC traces for help debugging.
   virtual void LogTrace() const = 0;
 
+  // Returns the durations of the request stages for the slow request log, including the stages
+  // on the remote servers called while handling this call. Empty if no stages were recorded.
+  std::string StageBreakdown() const;
+
+  // Whether a call that took 'total_time_ms' should be written to the slow query log.
+  static bool ShouldLogSlowQuery(int64_t total_time_ms);
+
   void QueueResponse(bool is_success);
 
   // The serialized bytes of the request param protobuf. Set by ParseFrom().
@@ -84,6 +84,10 @@ void LocalYBInboundCall::Respond(const google::protobuf::MessageLite& response,
     return;
   }
 
+  if (call->trace()) {
+    trace_->CollectStages(&call->trace()->stages());
+  }
+
   if (is_success) {
     call->SetFinished();
   } else {
@@ -185,6 +185,7 @@ OutboundCall::OutboundCall(
 
   if (Trace::CurrentTrace()) {
     Trace::CurrentTrace()->AddChildTrace(trace_.get());
+    collect_stage_timings_ = true;
   }
 
   DVLOG(4) << "OutboundCall " << this << " constructed with state_: " << StateName(state_)
@@ -355,6 +356,12 @@ void OutboundCall::SetResponse(CallResponse&& resp) {
   call_response_ = std::move(resp);
   Slice r(call_response_.serialized_response());
 
+  for (const auto& timing : call_response_.stage_timings()) {
+    if (timing.stage() < kRequestStageMapSize) {
+      trace_->stages().AddNanos(static_cast<RequestStage>(timing.stage()), timing.nanos());
+    }
+  }
+
   if (call_response_.is_success()) {
     // TODO: here we're deserializing the call response within the reactor thread,
     // which isn't great, since it would block processing of other RPCs in parallel.
@@ -495,6 +502,9 @@ void OutboundCall::InitHeader(RequestHeader* header) {
     header->set_timeout_millis(timeout.ToMilliseconds());
   }
   header->set_allocated_remote_method(remote_method_pool_->Take());
+  if (collect_stage_timings_) {
+    header->set_collect_stage_timings(true);
+  }
 }
 
 ///
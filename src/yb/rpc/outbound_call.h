@@ -164,6 +164,11 @@ class CallResponse {
   // See RpcController::GetSidecar()
   CHECKED_STATUS GetSidecar(int idx, Slice* sidecar) const;
 
+  const google::protobuf::RepeatedPtrField<StageTimingPB>& stage_timings() const {
+    DCHECK(parsed_);
+    return header_.stage_timings();
+  }
+
  private:
   // True once ParseFrom() is called.
   bool parsed_;
@@ -347,6 +352,10 @@ class OutboundCall : public RpcCall {
   // The trace buffer.
   scoped_refptr<Trace> trace_;
 
+  // Whether the call is a part of a traced request, so the server should return the durations of
+  // the request stages.
+  bool collect_stage_timings_ = false;
+
   std::shared_ptr<OutboundCallMetrics> outbound_call_metrics_;
 
   RemoteMethodPool* remote_method_pool_;
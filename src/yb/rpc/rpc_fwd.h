@@ -50,6 +50,7 @@ class ConnectionContext;
 class GrowableBufferAllocator;
 class Messenger;
 class MessengerBuilder;
+class PeriodicTimer;
 class Proxy;
 class ProxyCache;
 class Reactor;
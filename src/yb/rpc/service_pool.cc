@@ -49,6 +49,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
+#include "yb/util/request_stages.h"
 #include "yb/util/status.h"
 #include "yb/util/thread.h"
 #include "yb/util/trace.h"
@@ -123,6 +124,7 @@ class ServicePoolImpl {
         incoming_queue_time_(METRIC_rpc_incoming_queue_time.Instantiate(entity)),
         rpcs_timed_out_in_queue_(METRIC_rpcs_timed_out_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        stage_metrics_(std::make_shared<RequestStageMetrics>(entity)),
         tasks_pool_(max_tasks) {
   }
 
@@ -190,6 +192,7 @@ class ServicePoolImpl {
   }
 
   void Handle(InboundCallPtr incoming) {
+    incoming->trace()->set_stage_metrics(stage_metrics_);
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
 
@@ -242,6 +245,7 @@ class ServicePoolImpl {
   scoped_refptr<Histogram> incoming_queue_time_;
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  RequestStageMetricsPtr stage_metrics_;
   std::atomic<CoarseMonoClock::Duration> last_backpressure_at_;
 
   std::atomic<bool> closing_ = {false};
@@ -33,7 +33,6 @@
 using google::protobuf::io::CodedInputStream;
 using yb::operator"" _MB;
 
-DECLARE_bool(rpc_dump_all_traces);
 // Maximum size of RPC should be larger than size of consensus batch
 // At each layer, we embed the "message" from the previous layer.
 // In order to send three strings of 64, the request from cql/redis will be larger
@@ -44,7 +43,6 @@ DEFINE_int32(rpc_max_message_size, 255_MB,
              "The maximum size of a message of any RPC that the server will accept.");
 
 using std::placeholders::_1;
-DECLARE_int32(rpc_slow_query_threshold_ms);
 
 namespace yb {
 namespace rpc {
@@ -215,6 +213,18 @@ Status YBInboundCall::SerializeResponseBuffer(const google::protobuf::MessageLit
     resp_hdr.add_sidecar_offsets(absolute_sidecar_offset);
     absolute_sidecar_offset += car.size();
   }
+  if (header_.collect_stage_timings()) {
+    RequestStages stages;
+    trace_->CollectStages(&stages);
+    for (auto stage : kRequestStageList) {
+      auto nanos = stages.GetNanos(stage);
+      if (nanos != 0) {
+        auto* timing = resp_hdr.add_stage_timings();
+        timing->set_stage(to_underlying(stage));
+        timing->set_nanos(nanos);
+      }
+    }
+  }
 
   int additional_size = absolute_sidecar_offset - protobuf_msg_size;
 
@@ -273,7 +283,7 @@ void YBInboundCall::LogTrace() const {
       // TODO: consider pushing this onto another thread since it may be slow.
       // The traces may also be too large to fit in a log message.
       LOG(WARNING) << ToString() << " took " << total_time << "ms (client timeout "
-                   << header_.timeout_millis() << "ms).";
+                   << header_.timeout_millis() << "ms)." << StageBreakdown();
       std::string s = trace_->DumpToString(true);
       if (!s.empty()) {
         LOG(WARNING) << "Trace:\n" << s;
@@ -282,10 +292,9 @@ void YBInboundCall::LogTrace() const {
     }
   }
 
-  if (PREDICT_FALSE(
-          FLAGS_rpc_dump_all_traces ||
-          total_time > FLAGS_rpc_slow_query_threshold_ms)) {
-    LOG(INFO) << ToString() << " took " << total_time << "ms. Trace:";
+  if (PREDICT_FALSE(ShouldLogSlowQuery(total_time))) {
+    LOG(INFO) << ToString() << " took " << total_time << "ms." << StageBreakdown()
+              << " Trace:";
     trace_->Dump(&LOG(INFO), true);
   }
 }
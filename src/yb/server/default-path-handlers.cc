@@ -269,9 +269,32 @@ static void WriteMetricsAsJson(const MetricRegistry* const metrics,
               "Couldn't write JSON metrics over HTTP");
 }
 
+// Supported arguments, lists are comma separated:
+//   entity_types - types of the metric entities to export, e.g. server,tablet.
+//   metric_prefix - prefixes of the names of the metrics to export.
+//   tables - ids or names of the tables, whose tablet metrics are exported.
+//   aggregation - "table" (default) to sum up tablet metrics per table, or "tablet" to export
+//                 them per tablet.
 static void WriteForPrometheus(const MetricRegistry* const metrics,
                                const Webserver::WebRequest& req, std::stringstream* output) {
-  PrometheusWriter writer(output);
+  MetricPrometheusOptions opts;
+  const string* arg = FindOrNull(req.parsed_args, "entity_types");
+  if (arg != nullptr) {
+    SplitStringUsing(*arg, ",", &opts.entity_types);
+  }
+  arg = FindOrNull(req.parsed_args, "metric_prefix");
+  if (arg != nullptr) {
+    SplitStringUsing(*arg, ",", &opts.metric_prefixes);
+  }
+  arg = FindOrNull(req.parsed_args, "tables");
+  if (arg != nullptr) {
+    SplitStringUsing(*arg, ",", &opts.tables);
+  }
+  if (FindWithDefault(req.parsed_args, "aggregation", "table") == "tablet") {
+    opts.aggregation_level = MetricPrometheusOptions::AggregationLevel::kTablet;
+  }
+
+  PrometheusWriter writer(output, std::move(opts));
   WARN_NOT_OK(metrics->WriteForPrometheus(&writer), "Couldn't write text metrics for Prometheus");
 }
 
@@ -65,6 +65,7 @@
 #include "yb/util/env.h"
 #include "yb/util/logging.h"
 #include "yb/util/monotime.h"
+#include "yb/util/sampling_profiler.h"
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/status.h"
 
@@ -206,6 +207,18 @@ static void PprofContentionHandler(const Webserver::WebRequest& req, stringstrea
 #endif // defined(__linux__)
 }
 
+// Stacks collected by the continuous sampling profiler, in the folded format accepted by
+// flamegraph.pl and similar tools. The window of the last 'seconds' (60 by default) can be
+// shifted to the past by 'end_seconds_ago'.
+static void PprofFlameGraphHandler(const Webserver::WebRequest& req, stringstream* output) {
+  string secs_str = FindWithDefault(req.parsed_args, "seconds", "");
+  int32_t seconds = ParseLeadingInt32Value(secs_str.c_str(), 60);
+  string end_ago_str = FindWithDefault(req.parsed_args, "end_seconds_ago", "");
+  int32_t end_seconds_ago = ParseLeadingInt32Value(end_ago_str.c_str(), 0);
+
+  WriteFoldedStacks(MonoDelta::FromSeconds(seconds), MonoDelta::FromSeconds(end_seconds_ago),
+                    output);
+}
 
 // pprof asks for the url /pprof/symbol to map from hex addresses to variable names.
 // When the server receives a GET request for /pprof/symbol, it should return a line
@@ -269,6 +282,7 @@ void AddPprofPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/pprof/profile", "", PprofCpuProfileHandler, false, false);
   webserver->RegisterPathHandler("/pprof/symbol", "", PprofSymbolHandler, false, false);
   webserver->RegisterPathHandler("/pprof/contention", "", PprofContentionHandler, false, false);
+  webserver->RegisterPathHandler("/pprof/flamegraph", "", PprofFlameGraphHandler, false, false);
 }
 
 } // namespace yb
@@ -70,6 +70,7 @@
 #include "yb/util/user.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/rolling_log.h"
+#include "yb/util/sampling_profiler.h"
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/thread.h"
 #include "yb/util/version_info.h"
@@ -212,6 +213,7 @@ Status RpcServerBase::Init() {
   RegisterSpinLockContentionMetrics(metric_entity_);
 
   InitSpinLockContentionProfiling();
+  WARN_NOT_OK(StartSamplingProfiler(), "Failed to start sampling profiler");
 
   SetStackTraceSignal(SIGUSR2);
 
@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <deque>
+#include <thread>
 #include <vector>
 
 #include <boost/scope_exit.hpp>
@@ -320,5 +322,46 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, MonoTime::Now() + 100ms, HybridTime::kMax));
 }
 
+// Readers compute the safe time without the mutex, concurrently with operations being added.
+// AddPending checks that a new operation does not get hybrid time at or below a returned safe time.
+TEST_F(MvccTest, ConcurrentReaders) {
+  constexpr int kNumReaders = 4;
+  constexpr size_t kTotalOperations = 20000;
+  constexpr size_t kMaxPending = 10;
+
+  std::atomic<bool> stopped{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i != kNumReaders; ++i) {
+    readers.emplace_back([this, &stopped] {
+      HybridTime last_safe_time = HybridTime::kMin;
+      while (!stopped.load(std::memory_order_acquire)) {
+        auto safe_time = manager_.SafeTime(HybridTime::kMax /* ht_lease */);
+        ASSERT_GE(safe_time, last_safe_time);
+        last_safe_time = safe_time;
+      }
+    });
+  }
+
+  std::deque<HybridTime> pending;
+  for (size_t i = 0; i != kTotalOperations; ++i) {
+    if (pending.size() < kMaxPending && (pending.empty() || RandomUniformInt(0, 1) == 0)) {
+      HybridTime ht;
+      manager_.AddPending(&ht);
+      pending.push_back(ht);
+    } else {
+      manager_.Replicated(pending.front());
+      pending.pop_front();
+    }
+  }
+  for (auto ht : pending) {
+    manager_.Replicated(ht);
+  }
+
+  stopped.store(true, std::memory_order_release);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
 } // namespace tablet
 } // namespace yb
@@ -34,11 +34,27 @@
 
 #include <sstream>
 
+#include "yb/gutil/atomicops.h"
+
+#include "yb/tablet/tablet_metrics.h"
+
+#include "yb/util/atomic.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 
 namespace yb {
 namespace tablet {
 
+namespace {
+
+// Initial capacity of the queue of pending operations.
+constexpr size_t kInitialQueueCapacity = 64;
+
+// For how long a reader polls for the safe time before waiting on the condition variable.
+constexpr int64_t kSafeTimeSpinMicros = 50;
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // SafeTimeWithSource
 // ------------------------------------------------------------------------------------------------
@@ -47,44 +63,82 @@ std::string SafeTimeWithSource::ToString() const {
   return Format("{ safe_time: $0 source: $1 }", safe_time, source);
 }
 
+SafeTimeWithSource AtomicSafeTimeWithSource::Load() const {
+  return { safe_time.load(std::memory_order_acquire), source.load(std::memory_order_acquire) };
+}
+
+HybridTime AtomicSafeTimeWithSource::UpdateMax(const SafeTimeWithSource& value) {
+  auto current = safe_time.load(std::memory_order_acquire);
+  while (value.safe_time > current) {
+    if (safe_time.compare_exchange_weak(current, value.safe_time, std::memory_order_acq_rel)) {
+      source.store(value.source, std::memory_order_release);
+      return value.safe_time;
+    }
+  }
+  return current;
+}
+
 // ------------------------------------------------------------------------------------------------
 // MvccManager
 // ------------------------------------------------------------------------------------------------
 
 MvccManager::MvccManager(std::string prefix, server::ClockPtr clock)
     : prefix_(std::move(prefix)),
-      clock_(std::move(clock)) {}
+      clock_(std::move(clock)),
+      queue_(kInitialQueueCapacity) {}
+
+MvccManager::~MvccManager() {}
+
+void MvccManager::SetMetrics(const TabletMetrics& metrics) {
+  lock_contention_ = metrics.mvcc_lock_contention;
+  safe_time_wait_ = metrics.mvcc_safe_time_wait_duration;
+}
+
+std::unique_lock<std::mutex> MvccManager::LockMutex() const {
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    if (lock_contention_) {
+      lock_contention_->Increment();
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
+void MvccManager::UnlockAndNotify(std::unique_lock<std::mutex>* lock) {
+  const bool has_waiters = num_waiters_ != 0;
+  lock->unlock();
+  if (has_waiters) {
+    cond_.notify_all();
+  }
+}
 
 void MvccManager::Replicated(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    CHECK(!queue_.empty()) << LogPrefix();
-    CHECK_EQ(queue_.front(), ht) << LogPrefix();
-    PopFront(&lock);
-    last_replicated_ = ht;
-  }
-  cond_.notify_all();
+  auto lock = LockMutex();
+  CHECK(!queue_.empty()) << LogPrefix();
+  CHECK_EQ(queue_.front(), ht) << LogPrefix();
+  PopFront(&lock);
+  last_replicated_.store(ht, std::memory_order_release);
+  UnlockAndNotify(&lock);
 }
 
 void MvccManager::Aborted(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    CHECK(!queue_.empty()) << LogPrefix();
-    if (queue_.front() == ht) {
-      PopFront(&lock);
-    } else {
-      aborted_.push(ht);
-      return;
-    }
+  auto lock = LockMutex();
+  CHECK(!queue_.empty()) << LogPrefix();
+  if (queue_.front() == ht) {
+    PopFront(&lock);
+  } else {
+    aborted_.push(ht);
+    return;
   }
-  cond_.notify_all();
+  UnlockAndNotify(&lock);
 }
 
-void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
+void MvccManager::PopFront(std::unique_lock<std::mutex>* lock) {
   queue_.pop_front();
   CHECK_GE(queue_.size(), aborted_.size()) << LogPrefix();
   while (!aborted_.empty()) {
@@ -95,11 +149,19 @@ void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
     queue_.pop_front();
     aborted_.pop();
   }
+  PublishQueueFront();
+}
+
+void MvccManager::PublishQueueFront() {
+  queue_front_.store(queue_.empty() ? HybridTime::kInvalid : queue_.front(),
+                     std::memory_order_release);
 }
 
 void MvccManager::AddPending(HybridTime* ht) {
   const bool is_follower_side = ht->is_valid();
-  std::lock_guard<std::mutex> lock(mutex_);
+  auto lock = LockMutex();
+  // Readers that compute the safe time from the clock retry if they overlap with this section.
+  add_pending_seq_.fetch_add(1);
   if (is_follower_side) {
     // This must be a follower-side transaction with already known hybrid time.
     VLOG_WITH_PREFIX(1) << "AddPending(" << *ht << ")";
@@ -129,13 +191,17 @@ void MvccManager::AddPending(HybridTime* ht) {
     queue_.erase(start_iter, iter);
   }
   HybridTime last_ht_in_queue = queue_.empty() ? HybridTime::kMin : queue_.back();
+  const auto max_safe_time_returned_with_lease = max_safe_time_returned_with_lease_.Load();
+  const auto max_safe_time_returned_without_lease = max_safe_time_returned_without_lease_.Load();
+  const auto max_safe_time_returned_for_follower = max_safe_time_returned_for_follower_.Load();
+  const auto last_replicated = last_replicated_.load(std::memory_order_acquire);
 
   HybridTime sanity_check_lower_bound =
       std::max({
-          max_safe_time_returned_with_lease_.safe_time,
-          max_safe_time_returned_without_lease_.safe_time,
-          max_safe_time_returned_for_follower_.safe_time,
-          last_replicated_,
+          max_safe_time_returned_with_lease.safe_time,
+          max_safe_time_returned_without_lease.safe_time,
+          max_safe_time_returned_for_follower.safe_time,
+          last_replicated,
           last_ht_in_queue});
 
   if (!queue_.empty() && *ht <= sanity_check_lower_bound) {
@@ -150,11 +216,11 @@ void MvccManager::AddPending(HybridTime* ht) {
           << "\n  "
 
       ss << LogPrefix() << ": new operation's hybrid time too low: " << *ht
-         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_with_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_without_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_for_follower_)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_with_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_without_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_for_follower)
          << LOG_INFO_FOR_HT_LOWER_BOUND(
-                (SafeTimeWithSource{last_replicated_, SafeTimeSource::kUnknown}))
+                (SafeTimeWithSource{last_replicated, SafeTimeSource::kUnknown}))
          << LOG_INFO_FOR_HT_LOWER_BOUND(
                 (SafeTimeWithSource{last_ht_in_queue, SafeTimeSource::kUnknown}))
          << "\n  " << EXPR_VALUE_FOR_LOG(is_follower_side)
@@ -190,175 +256,223 @@ void MvccManager::AddPending(HybridTime* ht) {
       LOG(FATAL) << get_details_msg(/* drain_aborted */ true);
     }
   }
+  if (queue_.full()) {
+    queue_.set_capacity(queue_.capacity() * 2);
+  }
   queue_.push_back(*ht);
+  PublishQueueFront();
+  add_pending_seq_.fetch_add(1);
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    last_replicated_ = ht;
-  }
-  cond_.notify_all();
+  auto lock = LockMutex();
+  last_replicated_.store(ht, std::memory_order_release);
+  UnlockAndNotify(&lock);
 }
 
 void MvccManager::SetPropagatedSafeTimeOnFollower(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (ht >= propagated_safe_time_) {
-      propagated_safe_time_ = ht;
-    } else {
-      LOG(WARNING) << "Received propagated safe time " << ht << " less than the old value: "
-                   << propagated_safe_time_ << ". This could happen on followers when a new leader "
-                   << "is elected.";
-    }
+  auto lock = LockMutex();
+  auto propagated_safe_time = propagated_safe_time_.load(std::memory_order_acquire);
+  if (ht >= propagated_safe_time) {
+    propagated_safe_time_.store(ht, std::memory_order_release);
+  } else {
+    LOG(WARNING) << "Received propagated safe time " << ht << " less than the old value: "
+                 << propagated_safe_time << ". This could happen on followers when a new leader "
+                 << "is elected.";
   }
-  cond_.notify_all();
+  UnlockAndNotify(&lock);
 }
 
 void MvccManager::UpdatePropagatedSafeTimeOnLeader(HybridTime ht_lease) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht_lease << ")";
 
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    auto ht = DoGetSafeTime(HybridTime::kMin,  // min_allowed
-                            MonoTime::kMax,    // deadline
-                            ht_lease,
-                            &lock);
+  CHECK(ht_lease.is_valid());
+  const bool has_lease = ht_lease.GetPhysicalValueMicros() < kMaxHybridTimePhysicalMicros;
+  if (has_lease) {
+    UpdateAtomicMax(&max_ht_lease_seen_, ht_lease);
+  }
+
+  auto lock = LockMutex();
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  const auto previous = max_safe_time_returned.Load();
+  SafeTimeWithSource safe_time;
+  // No operation could be added while we hold the mutex, so the safe time is always computed.
+  CHECK(ComputeSafeTime(has_lease, &safe_time)) << LogPrefix();
+  auto ht = UpdateMaxSafeTimeReturned(previous, safe_time, &max_safe_time_returned);
+  auto propagated_safe_time = propagated_safe_time_.load(std::memory_order_acquire);
 #ifndef NDEBUG
-    // This should only be called from RaftConsensus::UpdateMajorityReplicated, and ht_lease passed
-    // in here should keep increasing, so we should not see propagated_safe_time_ going backwards.
-    CHECK_GE(ht, propagated_safe_time_) << LogPrefix();
-    propagated_safe_time_ = ht;
+  // This should only be called from RaftConsensus::UpdateMajorityReplicated, and ht_lease passed
+  // in here should keep increasing, so we should not see propagated_safe_time_ going backwards.
+  CHECK_GE(ht, propagated_safe_time) << LogPrefix();
+  propagated_safe_time_.store(ht, std::memory_order_release);
 #else
-    // Do not crash in production.
-    if (ht < propagated_safe_time_) {
-      YB_LOG_EVERY_N_SECS(ERROR, 5) << LogPrefix()
-          << "Previously saw " << EXPR_VALUE_FOR_LOG(propagated_safe_time_)
-          << ", but now safe time is " << ht;
+  // Do not crash in production.
+  if (ht < propagated_safe_time) {
+    YB_LOG_EVERY_N_SECS(ERROR, 5) << LogPrefix()
+        << "Previously saw " << EXPR_VALUE_FOR_LOG(propagated_safe_time)
+        << ", but now safe time is " << ht;
+  } else {
+    propagated_safe_time_.store(ht, std::memory_order_release);
+  }
+#endif
+  UnlockAndNotify(&lock);
+}
+
+template <class Predicate>
+bool MvccManager::WaitFor(const Predicate& predicate, MonoTime deadline) const {
+  if (predicate()) {
+    return true;
+  }
+
+  // The safe time usually advances soon, e.g. when the operation at the front of the queue is
+  // replicated. So poll it for a while, before taking the mutex that is used by the write path.
+  const auto start = MonoTime::Now();
+  const auto spin_deadline =
+      std::min(deadline, start + MonoDelta::FromMicroseconds(kSafeTimeSpinMicros));
+  bool result = false;
+  for (auto now = start; now < spin_deadline; now = MonoTime::Now()) {
+    base::subtle::PauseCPU();
+    if (predicate()) {
+      result = true;
+      break;
+    }
+  }
+
+  if (!result && deadline > spin_deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++num_waiters_;
+    if (deadline == MonoTime::kMax) {
+      cond_.wait(lock, predicate);
+      result = true;
     } else {
-      propagated_safe_time_ = ht;
+      result = cond_.wait_until(lock, deadline.ToSteadyTimePoint(), predicate);
     }
-#endif
+    --num_waiters_;
+  }
+
+  if (safe_time_wait_) {
+    safe_time_wait_->Increment(MonoTime::Now().GetDeltaSince(start).ToMicroseconds());
   }
-  cond_.notify_all();
+  return result;
+}
+
+SafeTimeWithSource MvccManager::ComputeSafeTimeForFollower() const {
+  auto last_replicated = last_replicated_.load(std::memory_order_acquire);
+  auto propagated_safe_time = propagated_safe_time_.load(std::memory_order_acquire);
+  // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
+  // could be greater than propagated_safe_time_.
+  if (propagated_safe_time > last_replicated) {
+    return { propagated_safe_time, SafeTimeSource::kPropagated };
+  }
+  return { last_replicated, SafeTimeSource::kLastReplicated };
+}
+
+HybridTime MvccManager::UpdateMaxSafeTimeReturned(
+    const SafeTimeWithSource& previous, const SafeTimeWithSource& value,
+    AtomicSafeTimeWithSource* max_safe_time_returned) const {
+  LOG_IF_WITH_PREFIX(DFATAL, value.safe_time < previous.safe_time)
+      << "Safe time went backwards: " << value.ToString() << ", previously returned: "
+      << previous.ToString() << ", " << EXPR_VALUE_FOR_LOG(max_ht_lease_seen_.load())
+      << ", " << EXPR_VALUE_FOR_LOG(last_replicated_.load())
+      << ", " << EXPR_VALUE_FOR_LOG(propagated_safe_time_.load())
+      << ", " << EXPR_VALUE_FOR_LOG(clock_->Now());
+  return max_safe_time_returned->UpdateMax(value);
 }
 
 HybridTime MvccManager::SafeTimeForFollower(
     HybridTime min_allowed, MonoTime deadline) const {
-  std::unique_lock<std::mutex> lock(mutex_);
+  const auto previous = max_safe_time_returned_for_follower_.Load();
   SafeTimeWithSource result;
   auto predicate = [this, &result, min_allowed] {
-    // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
-    // could be greater than propagated_safe_time_.
-    if (propagated_safe_time_ > last_replicated_) {
-      result.safe_time = propagated_safe_time_;
-      result.source = SafeTimeSource::kPropagated;
-    } else {
-      result.safe_time = last_replicated_;
-      result.source = SafeTimeSource::kLastReplicated;
-    }
+    result = ComputeSafeTimeForFollower();
     return result.safe_time >= min_allowed;
   };
-  if (deadline == MonoTime::kMax) {
-    cond_.wait(lock, predicate);
-  } else if (!cond_.wait_until(lock, deadline.ToSteadyTimePoint(), predicate)) {
+  if (!WaitFor(predicate, deadline)) {
     return HybridTime::kInvalid;
   }
   VLOG_WITH_PREFIX(1) << "SafeTimeForFollower(" << min_allowed
                       << "), result = " << result.ToString();
-  CHECK_GE(result.safe_time, max_safe_time_returned_for_follower_.safe_time)
-      << LogPrefix() << "result: " << result.ToString()
-      << ", max_safe_time_returned_for_follower_: "
-      << max_safe_time_returned_for_follower_.ToString();
-  max_safe_time_returned_for_follower_ = result;
-  return result.safe_time;
+  return UpdateMaxSafeTimeReturned(previous, result, &max_safe_time_returned_for_follower_);
+}
+
+bool MvccManager::ComputeSafeTime(bool has_lease, SafeTimeWithSource* result) const {
+  const auto seq = add_pending_seq_.load(std::memory_order_acquire);
+  if (seq & 1) {
+    return false;
+  }
+
+  const auto queue_front = queue_front_.load(std::memory_order_acquire);
+  if (queue_front.is_valid()) {
+    *result = { queue_front.Decremented(), SafeTimeSource::kNextInQueue };
+    VLOG_WITH_PREFIX(2) << "ComputeSafeTime, Queue front (decremented): " << result->safe_time;
+  } else {
+    *result = { clock_->Now(), SafeTimeSource::kNow };
+    VLOG_WITH_PREFIX(2) << "ComputeSafeTime, Now: " << result->safe_time;
+    // An operation added after this check gets a hybrid time from the clock after us, i.e. greater
+    // than the result. An operation that overlaps with us could get a lower one, so retry.
+    if (add_pending_seq_.load() != seq) {
+      return false;
+    }
+  }
+
+  if (has_lease) {
+    auto max_ht_lease_seen = max_ht_lease_seen_.load(std::memory_order_acquire);
+    if (result->safe_time > max_ht_lease_seen) {
+      *result = { max_ht_lease_seen, SafeTimeSource::kHybridTimeLease };
+    }
+  }
+
+  // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
+  // is safe to read at least at last_replicated_.
+  result->safe_time = std::max(result->safe_time, last_replicated_.load(std::memory_order_acquire));
+  return true;
 }
 
 HybridTime MvccManager::SafeTime(HybridTime min_allowed,
                                  MonoTime deadline,
                                  HybridTime ht_lease) const {
-  std::unique_lock<std::mutex> lock(mutex_);
-  return DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
-}
-
-HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
-                                      const MonoTime deadline,
-                                      const HybridTime ht_lease,
-                                      std::unique_lock<std::mutex>* lock) const {
-  DCHECK_ONLY_NOTNULL(lock);
   CHECK(ht_lease.is_valid());
   CHECK_LE(min_allowed, ht_lease) << LogPrefix();
 
   const bool has_lease = ht_lease.GetPhysicalValueMicros() < kMaxHybridTimePhysicalMicros;
   if (has_lease) {
-    max_ht_lease_seen_ = std::max(ht_lease, max_ht_lease_seen_);
+    UpdateAtomicMax(&max_ht_lease_seen_, ht_lease);
   }
 
-  HybridTime result;
-  SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, has_lease] {
-    if (queue_.empty()) {
-      result = clock_->Now();
-      source = SafeTimeSource::kNow;
-      CHECK_GE(result, min_allowed) << LogPrefix();
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
-    } else {
-      result = queue_.front().Decremented();
-      source = SafeTimeSource::kNextInQueue;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result;
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  const auto previous = max_safe_time_returned.Load();
+  SafeTimeWithSource result;
+  auto predicate = [this, &result, min_allowed, has_lease] {
+    if (!ComputeSafeTime(has_lease, &result)) {
+      return false;
     }
-
-    if (has_lease && result > max_ht_lease_seen_) {
-      result = max_ht_lease_seen_;
-      source = SafeTimeSource::kHybridTimeLease;
+    if (result.source == SafeTimeSource::kNow) {
+      CHECK_GE(result.safe_time, min_allowed) << LogPrefix();
     }
-
-    // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
-    // is safe to read at least at last_replicated_.
-    result = std::max(result, last_replicated_);
-
-    return result >= min_allowed;
+    return result.safe_time >= min_allowed;
   };
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
   // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
-  if (deadline == MonoTime::kMax) {
-    cond_.wait(*lock, predicate);
-  } else if (!cond_.wait_until(*lock, deadline.ToSteadyTimePoint(), predicate)) {
+  if (!WaitFor(predicate, deadline)) {
     return HybridTime::kInvalid;
   }
-  VLOG_WITH_PREFIX(1) << "DoGetSafeTime(" << min_allowed << ", "
-                      << ht_lease << "), result = " << result;
-
-  auto enforced_min_time = has_lease ? max_safe_time_returned_with_lease_.safe_time
-                                     : max_safe_time_returned_without_lease_.safe_time;
-  CHECK_GE(result, enforced_min_time) << LogPrefix()
-      << ": " << EXPR_VALUE_FOR_LOG(has_lease)
-      << ", " << EXPR_VALUE_FOR_LOG(enforced_min_time.ToUint64() - result.ToUint64())
-      << ", " << EXPR_VALUE_FOR_LOG(ht_lease)
-      << ", " << EXPR_VALUE_FOR_LOG(max_ht_lease_seen_)
-      << ", " << EXPR_VALUE_FOR_LOG(last_replicated_)
-      << ", " << EXPR_VALUE_FOR_LOG(clock_->Now())
-      << ", " << EXPR_VALUE_FOR_LOG(deadline.ToString())
-      << ", " << EXPR_VALUE_FOR_LOG(queue_.size())
-      << ", " << EXPR_VALUE_FOR_LOG(queue_);
+  VLOG_WITH_PREFIX(1) << "SafeTime(" << min_allowed << ", "
+                      << ht_lease << "), result = " << result.ToString();
 
-  if (has_lease) {
-    max_safe_time_returned_with_lease_ = { result, source };
-  } else {
-    max_safe_time_returned_without_lease_ = { result, source };
-  }
-  return result;
+  return UpdateMaxSafeTimeReturned(previous, result, &max_safe_time_returned);
 }
 
 HybridTime MvccManager::LastReplicatedHybridTime() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
-  return last_replicated_;
+  auto result = last_replicated_.load(std::memory_order_acquire);
+  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << result;
+  return result;
 }
 
 }  // namespace tablet
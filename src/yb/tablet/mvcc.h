@@ -32,20 +32,28 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
-#include <deque>
 #include <queue>
 #include <vector>
 
+#include <boost/circular_buffer.hpp>
+
 #include "yb/server/clock.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/opid.h"
 #include "yb/util/enums.h"
 
 namespace yb {
+
+class Counter;
+class Histogram;
+
 namespace tablet {
 
+struct TabletMetrics;
+
 // Allows us to keep track of how a particular value of safe time was obtained, for sanity
 // checking purposes.
 YB_DEFINE_ENUM(SafeTimeSource,
@@ -58,16 +66,37 @@ struct SafeTimeWithSource {
   std::string ToString() const;
 };
 
+// SafeTimeWithSource that could be read and updated concurrently.
+struct AtomicSafeTimeWithSource {
+  std::atomic<HybridTime> safe_time{HybridTime::kMin};
+  std::atomic<SafeTimeSource> source{SafeTimeSource::kUnknown};
+
+  SafeTimeWithSource Load() const;
+
+  // Stores 'value' if its safe time is greater than the current one. Returns the resulting safe
+  // time.
+  HybridTime UpdateMax(const SafeTimeWithSource& value);
+};
+
 // MvccManager is used to track operations.
 // When new operation is initiated its time should be added using AddPending.
 // When operation is replicated or aborted, MvccManager is notified using Replicated or Aborted
 // methods.
 // Operations could be replicated only in the same order as they were added.
 // Time of newly added operation should be after time of all previously added operations.
+//
+// Operations are added, replicated and aborted under the mutex, and each of these publishes the
+// state needed to compute the safe time to atomics. So readers compute the safe time without the
+// mutex. A reader whose safe time is not reached yet polls for a short time, and only then waits
+// on the condition variable.
 class MvccManager {
  public:
   // `prefix` is used for logging.
   explicit MvccManager(std::string prefix, server::ClockPtr clock);
+  ~MvccManager();
+
+  // Sets the metrics to report contention to. Should be called before the manager is used.
+  void SetMetrics(const TabletMetrics& metrics);
 
   // Sets time of last replicated operation, used after bootstrap.
   void SetLastReplicated(HybridTime ht);
@@ -126,41 +155,79 @@ class MvccManager {
   HybridTime LastReplicatedHybridTime() const;
 
  private:
-  HybridTime DoGetSafeTime(HybridTime min_allowed,
-                           MonoTime deadline,
-                           HybridTime ht_lease,
-                           std::unique_lock<std::mutex>* lock) const;
+  // Computes the safe time for the leader from the published state. Returns false if it could not
+  // be computed without the mutex, because an operation is being added concurrently.
+  bool ComputeSafeTime(bool has_lease, SafeTimeWithSource* result) const;
+
+  SafeTimeWithSource ComputeSafeTimeForFollower() const;
+
+  // Updates 'max_safe_time_returned' with 'value' and returns the resulting safe time. 'previous'
+  // is the value of 'max_safe_time_returned' loaded before 'value' was computed. The safe time
+  // computed after it was returned should not be lower, so this is reported as an error. Being
+  // lower than the current value only means that a concurrent reader returned first.
+  HybridTime UpdateMaxSafeTimeReturned(const SafeTimeWithSource& previous,
+                                       const SafeTimeWithSource& value,
+                                       AtomicSafeTimeWithSource* max_safe_time_returned) const;
+
+  // Waits until 'predicate' returns true or 'deadline' passes. Returns false in case of timeout.
+  template <class Predicate>
+  bool WaitFor(const Predicate& predicate, MonoTime deadline) const;
+
+  std::unique_lock<std::mutex> LockMutex() const;
+  void UnlockAndNotify(std::unique_lock<std::mutex>* lock);
 
   const std::string& LogPrefix() const { return prefix_; }
-  void PopFront(std::lock_guard<std::mutex>* lock);
+  void PopFront(std::unique_lock<std::mutex>* lock);
+
+  // Publishes the front of queue_ to queue_front_.
+  void PublishQueueFront();
 
   std::string prefix_;
   server::ClockPtr clock_;
   mutable std::mutex mutex_;
   mutable std::condition_variable cond_;
 
-  // An ordered queue of times of tracked operations.
-  std::deque<HybridTime> queue_;
+  // Number of readers waiting on cond_, protected by mutex_.
+  mutable size_t num_waiters_ = 0;
+
+  // An ordered queue of times of tracked operations. A ring buffer keeps them contiguous, and
+  // grows when it is full.
+  boost::circular_buffer<HybridTime> queue_;
+
+  // Time of the first operation in queue_, or invalid hybrid time if queue_ is empty.
+  std::atomic<HybridTime> queue_front_{HybridTime::kInvalid};
+
+  // Odd while AddPending picks the hybrid time for a new operation. A reader that uses the clock
+  // for the safe time checks that no operation was added concurrently. Otherwise the operation
+  // could get a hybrid time below the returned safe time.
+  std::atomic<uint64_t> add_pending_seq_{0};
 
   // Priority queue (min-heap, hence std::greater<> as the "less" comparator) of aborted operations.
   // Required because we could abort operations from the middle of the queue.
   std::priority_queue<HybridTime, std::vector<HybridTime>, std::greater<>> aborted_;
 
-  HybridTime last_replicated_ = HybridTime::kMin;
+  std::atomic<HybridTime> last_replicated_{HybridTime::kMin};
 
   // If we are a follower, this is the latest safe time sent by the leader to us. If we are the
   // leader, this is a safe time that gets updated every time the majority-replicated watermarks
   // change.
-  HybridTime propagated_safe_time_ = HybridTime::kMin;
+  std::atomic<HybridTime> propagated_safe_time_{HybridTime::kMin};
 
   // Because different calls that have current hybrid time leader lease as an argument can come to
   // us out of order, we might see an older value of hybrid time leader lease expiration after a
   // newer value. We mitigate this by always using the highest value we've seen.
-  mutable HybridTime max_ht_lease_seen_ = HybridTime::kMin;
-
-  mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
+  mutable std::atomic<HybridTime> max_ht_lease_seen_{HybridTime::kMin};
+
+  // Concurrent readers could compute the safe time in a different order than they return it, so
+  // a reader returns the maximum of its result and the safe time already returned.
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_with_lease_;
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_without_lease_;
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_for_follower_;
+
+  // Number of times the mutex was held by another thread when it was needed.
+  scoped_refptr<Counter> lock_contention_;
+  // Time spent by readers waiting for the safe time.
+  scoped_refptr<Histogram> safe_time_wait_;
 };
 
 }  // namespace tablet
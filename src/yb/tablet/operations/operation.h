@@ -57,7 +57,7 @@ class OperationCompletionCallback;
 class OperationState;
 
 YB_DEFINE_ENUM(OperationType,
-               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kEmpty));
+               (kWrite)(kChangeMetadata)(kUpdateTransaction)(kSnapshot)(kTruncate)(kSplit)(kEmpty));
 
 // Base class for transactions.  There are different implementations for different types (Write,
 // AlterSchema, etc.) OperationDriver implementations use Operations along with Consensus to execute
@@ -105,6 +105,10 @@ class Operation {
   // transaction type, but usually this is the method where data-structures are changed.
   virtual CHECKED_STATUS Apply(int64_t leader_term) = 0;
 
+  // Whether Apply() could run concurrently with the apply of the operations that precede this one
+  // in the log, see ParallelApplier.
+  virtual bool CanApplyConcurrently() const { return false; }
+
   // Executed after the transaction has been applied and the commit message has been appended to the
   // log (though it might not be durable yet), or if the transaction was aborted.  Implementations
   // are expected to perform cleanup on this method, the driver will reply to the client after this
@@ -209,6 +213,18 @@ class OperationState {
     return op_id_;
   }
 
+  // An operation applied concurrently could be written to RocksDB before the operations that
+  // precede it. Then ParallelApplier sets the op id of the latest operation that was applied along
+  // with all operations before it, and this op id is recorded in RocksDB frontiers instead of
+  // op_id(). So a flushed frontier never covers an operation that is not in RocksDB yet.
+  void set_frontier_op_id(const consensus::OpId& op_id) {
+    frontier_op_id_ = op_id;
+  }
+
+  const consensus::OpId& frontier_op_id() const {
+    return frontier_op_id_.IsInitialized() ? frontier_op_id_ : op_id_;
+  }
+
   bool has_completion_callback() const {
     return completion_clbk_ != nullptr;
   }
@@ -240,6 +256,9 @@ class OperationState {
   // This OpId stores the canonical "anchor" OpId for this transaction.
   consensus::OpId op_id_;
 
+  // Op id to record in RocksDB frontiers, when it differs from op_id_.
+  consensus::OpId frontier_op_id_;
+
   scoped_refptr<consensus::ConsensusRound> consensus_round_;
 
   // Lock that protects access to operation state.
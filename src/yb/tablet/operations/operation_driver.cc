@@ -33,6 +33,7 @@
 #include "yb/tablet/operations/operation_driver.h"
 
 #include <mutex>
+#include <thread>
 
 #include "yb/client/client.h"
 #include "yb/consensus/consensus.h"
@@ -40,10 +41,12 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/operations/operation_tracker.h"
+#include "yb/tablet/parallel_applier.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/request_stages.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
@@ -75,12 +78,14 @@ OperationDriver::OperationDriver(OperationTracker *operation_tracker,
                                  Consensus* consensus,
                                  Log* log,
                                  Preparer* preparer,
+                                 ParallelApplier* applier,
                                  OperationOrderVerifier* order_verifier,
                                  TableType table_type)
     : operation_tracker_(operation_tracker),
       consensus_(consensus),
       log_(log),
       preparer_(preparer),
+      applier_(applier),
       order_verifier_(order_verifier),
       trace_(new Trace()),
       start_time_(MonoTime::Now()),
@@ -183,6 +188,7 @@ void OperationDriver::HandleConsensusAppend() {
     return;
   }
   ADOPT_TRACE(trace());
+  replication_start_time_ = MonoTime::Now();
   auto* const replicate_msg = operation_->state()->consensus_round()->replicate_msg().get();
   CHECK(!replicate_msg->has_hybrid_time());
   replicate_msg->set_hybrid_time(operation_->state()->hybrid_time().ToUint64());
@@ -359,6 +365,11 @@ void OperationDriver::ReplicationFinished(const Status& status, int64_t leader_t
     op_id_local = op_id_copy_;
   }
 
+  if (status.ok() && replication_start_time_.Initialized()) {
+    RecordRequestStage(
+        trace(), RequestStage::kReplication, MonoTime::Now() - replication_start_time_);
+  }
+
   PrepareState prepare_state_copy;
   {
     std::lock_guard<simple_spinlock> lock(lock_);
@@ -424,8 +435,16 @@ Status OperationDriver::ApplyOperation(int64_t leader_term) {
   TRACE_EVENT_FLOW_BEGIN0("operation", "ApplyTask", this);
 
   // RocksDB-backed tables require that we apply changes in the same order they appear in the Raft
-  // log.
+  // log. ParallelApplier relaxes it for operations that do not depend on each other.
+  if (applier_) {
+    applier_->Submit(this, leader_term);
+    return Status::OK();
+  }
+
+  // We need to ref-count ourself, since Finalize() could release this driver.
+  scoped_refptr<OperationDriver> ref(this);
   ApplyTask(leader_term);
+  Finalize();
   return Status::OK();
 }
 
@@ -441,15 +460,12 @@ void OperationDriver::ApplyTask(int64_t leader_term) {
   }
 #endif
 
-  // We need to ref-count ourself, since Commit() may run very quickly
-  // and end up calling Finalize() while we're still in this code.
-  scoped_refptr<OperationDriver> ref(this);
-
-  {
-    CHECK_OK(operation_->Apply(leader_term));
+  ScopedRequestStage apply_stage(RequestStage::kApply);
+  CHECK_OK(operation_->Apply(leader_term));
+}
 
-    Finalize();
-  }
+void OperationDriver::SetFrontierOpId(const yb::OpId& op_id) {
+  mutable_state()->set_frontier_op_id(op_id.ToPB<consensus::OpId>());
 }
 
 void OperationDriver::Finalize() {
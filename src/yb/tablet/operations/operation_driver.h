@@ -40,6 +40,7 @@
 #include "yb/gutil/walltime.h"
 #include "yb/tablet/operations/operation.h"
 #include "yb/util/lockfree.h"
+#include "yb/util/opid.h"
 #include "yb/util/status.h"
 #include "yb/util/trace.h"
 
@@ -55,6 +56,7 @@ class MvccManager;
 class OperationOrderVerifier;
 class OperationTracker;
 class OperationDriver;
+class ParallelApplier;
 class Preparer;
 
 // Base class for operation drivers.
@@ -114,6 +116,7 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
                   consensus::Consensus* consensus,
                   log::Log* log,
                   Preparer* preparer,
+                  ParallelApplier* applier,
                   OperationOrderVerifier* order_verifier,
                   TableType table_type_);
 
@@ -207,6 +210,8 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
 
  private:
   friend class RefCountedThreadSafe<OperationDriver>;
+  friend class ParallelApplier;
+
   enum ReplicationState {
     // The operation has not yet been sent to consensus for replication
     NOT_REPLICATING,
@@ -237,14 +242,18 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   // Performs status checks and calls ApplyTask.
   CHECKED_STATUS ApplyOperation(int64_t leader_term);
 
-  // Calls Operation::Apply() followed by Consensus::Commit() with the
-  // results from the Apply().
+  // Calls Operation::Apply().
   void ApplyTask(int64_t leader_term);
 
-  // Called on Operation::Apply() after the CommitMsg has been successfully
-  // appended to the WAL.
+  // Called after Operation::Apply(), makes the operation visible and replies to the client.
   void Finalize();
 
+  bool CanApplyConcurrently() const {
+    return operation_ && operation_->CanApplyConcurrently();
+  }
+
+  void SetFrontierOpId(const yb::OpId& op_id);
+
   // Returns the mutable state of the operation being executed by
   // this driver.
   OperationState* mutable_state();
@@ -258,6 +267,7 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   consensus::Consensus* const consensus_;
   log::Log* const log_;
   Preparer* const preparer_;
+  ParallelApplier* const applier_;
   OperationOrderVerifier* const order_verifier_;
 
   Status operation_status_;
@@ -285,6 +295,9 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
 
   const MonoTime start_time_;
 
+  // Time when the operation was appended to the Raft log on the leader.
+  MonoTime replication_start_time_;
+
   ReplicationState replication_state_;
   PrepareState prepare_state_;
 
@@ -0,0 +1,87 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/operations/split_operation.h"
+
+#include <glog/logging.h>
+
+#include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.h"
+#include "yb/rpc/rpc_context.h"
+#include "yb/server/hybrid_clock.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/tablet_splitter.h"
+#include "yb/tserver/tserver.pb.h"
+#include "yb/util/trace.h"
+
+namespace yb {
+namespace tablet {
+
+using consensus::ReplicateMsg;
+using consensus::SPLIT_OP;
+using consensus::DriverType;
+using strings::Substitute;
+
+void SplitOperationState::UpdateRequestFromConsensusRound() {
+  request_ = consensus_round()->replicate_msg()->mutable_split_request();
+}
+
+string SplitOperationState::ToString() const {
+  return Format("SplitOperationState [hybrid_time=$0 request=$1]",
+                hybrid_time_even_if_unset(),
+                request_ ? request_->ShortDebugString() : "<none>");
+}
+
+SplitOperation::SplitOperation(std::unique_ptr<SplitOperationState> state)
+    : Operation(std::move(state), OperationType::kSplit) {
+}
+
+consensus::ReplicateMsgPtr SplitOperation::NewReplicateMsg() {
+  auto result = std::make_shared<ReplicateMsg>();
+  result->set_op_type(SPLIT_OP);
+  result->mutable_split_request()->CopyFrom(*state()->request());
+  return result;
+}
+
+void SplitOperation::DoStart() {
+  state()->TrySetHybridTimeFromClock();
+
+  TRACE("START SPLIT: hybrid time: $0",
+        server::HybridClock::GetPhysicalValueMicros(state()->hybrid_time()));
+}
+
+Status SplitOperation::Apply(int64_t leader_term) {
+  TRACE("APPLY SPLIT: started");
+
+  // Failing to create the new tablets, e.g. on an I/O error, does not fail the operation. The split
+  // tablet does not apply writes anymore, so the new tablets are created again from it when the
+  // master resends the split or the operation is replayed.
+  auto* tablet_splitter = state()->tablet()->tablet_splitter();
+  Status s = tablet_splitter ? tablet_splitter->ApplyTabletSplit(state())
+                             : STATUS(NotSupported, "Tablet split is not supported by this tablet");
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to split tablet " << state()->tablet()->tablet_id() << ": " << s;
+    state()->SetError(s, tserver::TabletServerErrorPB::TABLET_SPLIT);
+  }
+
+  TRACE("APPLY SPLIT: finished");
+  return Status::OK();
+}
+
+string SplitOperation::ToString() const {
+  return Substitute("SplitOperation [state=$0]", state()->ToString());
+}
+
+}  // namespace tablet
+}  // namespace yb
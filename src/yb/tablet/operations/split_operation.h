@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
+#define YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
+
+#include <string>
+
+#include "yb/gutil/macros.h"
+#include "yb/tablet/operations/operation.h"
+
+namespace yb {
+namespace tablet {
+
+// Operation Context for the Split operation.
+// Keeps track of the Operation states (request, result, ...)
+class SplitOperationState : public OperationState {
+ public:
+  explicit SplitOperationState(Tablet* tablet,
+                               const tserver::SplitTabletRequestPB* request = nullptr)
+      : OperationState(tablet), request_(request) {}
+  ~SplitOperationState() {}
+
+  const tserver::SplitTabletRequestPB* request() const override { return request_; }
+
+  void UpdateRequestFromConsensusRound() override;
+
+  virtual std::string ToString() const override;
+
+ private:
+  // The original RPC request.
+  const tserver::SplitTabletRequestPB *request_;
+
+  DISALLOW_COPY_AND_ASSIGN(SplitOperationState);
+};
+
+// Executes the split operation.
+class SplitOperation : public Operation {
+ public:
+  explicit SplitOperation(std::unique_ptr<SplitOperationState> operation_state);
+
+  SplitOperationState* state() override {
+    return down_cast<SplitOperationState*>(Operation::state());
+  }
+
+  const SplitOperationState* state() const override {
+    return down_cast<const SplitOperationState*>(Operation::state());
+  }
+
+  consensus::ReplicateMsgPtr NewReplicateMsg() override;
+
+  CHECKED_STATUS Prepare() override { return Status::OK(); }
+
+  // Executes an Apply for the split operation. Creates the new tablets on this server and marks
+  // this tablet as split, after that it does not apply writes.
+  CHECKED_STATUS Apply(int64_t leader_term) override;
+
+  std::string ToString() const override;
+
+ private:
+  // Starts the SplitOperation by assigning it a timestamp.
+  void DoStart() override;
+
+  DISALLOW_COPY_AND_ASSIGN(SplitOperation);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_OPERATIONS_SPLIT_OPERATION_H
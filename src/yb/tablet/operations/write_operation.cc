@@ -116,11 +116,28 @@ Status WriteOperation::Apply(int64_t leader_term) {
 
   Tablet* tablet = state()->tablet();
 
+  // Writes replicated after the split operation are not applied, the client retries them on the
+  // tablets that replaced this one.
+  if (PREDICT_FALSE(tablet->metadata()->IsSplit())) {
+    state()->SetError(
+        STATUS_FORMAT(IllegalState, "Tablet $0 was split", tablet->tablet_id()),
+        TabletServerErrorPB::TABLET_SPLIT);
+    return Status::OK();
+  }
+
   tablet->ApplyRowOperations(state());
 
   return Status::OK();
 }
 
+bool WriteOperation::CanApplyConcurrently() const {
+  // Non-transactional writes get unique RocksDB keys from their hybrid times, so they do not depend
+  // on each other. Transactional writes are applied through the transaction participant and are
+  // kept in log order.
+  const auto* request = state()->request();
+  return request != nullptr && !request->write_batch().has_transaction();
+}
+
 void WriteOperation::Finish(OperationResult result) {
   TRACE_EVENT0("txn", "WriteOperation::Finish");
   if (PREDICT_FALSE(result == Operation::ABORTED)) {
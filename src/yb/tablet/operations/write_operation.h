@@ -239,6 +239,8 @@ class WriteOperation : public Operation {
   // algorithm.
   CHECKED_STATUS Apply(int64_t leader_term) override;
 
+  bool CanApplyConcurrently() const override;
+
   // If result == COMMITTED, commits the mvcc transaction and updates
   // the metrics, if result == ABORTED aborts the mvcc transaction.
   void Finish(OperationResult result) override;
@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/parallel_applier.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "yb/tablet/operations/operation_driver.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int32(max_concurrent_applies_per_tablet, 0,
+             "Maximum number of non-transactional writes of a single tablet that are applied "
+             "concurrently. 0 means that operations are applied one by one.");
+TAG_FLAG(max_concurrent_applies_per_tablet, evolving);
+TAG_FLAG(max_concurrent_applies_per_tablet, runtime);
+
+DEFINE_test_flag(int64, parallel_apply_pause_index, 0,
+                 "Applying the operation with this index waits until the flag is changed.");
+
+namespace yb {
+namespace tablet {
+
+ParallelApplier::ParallelApplier(ThreadPool* apply_pool) : apply_pool_(apply_pool) {
+}
+
+ParallelApplier::~ParallelApplier() {
+  Shutdown();
+}
+
+void ParallelApplier::Submit(OperationDriver* driver, int64_t leader_term) {
+  // Finalize() could release the driver.
+  scoped_refptr<OperationDriver> ref(driver);
+  auto op_id = OpId::FromPB(driver->GetOpId());
+
+  std::vector<Entry*> ready;
+  Entry* inline_entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The op id of the operation before the first submitted one is not known, so the first
+    // operation is applied serially.
+    const bool concurrent = apply_pool_ && FLAGS_max_concurrent_applies_per_tablet > 0 &&
+                            last_submitted_op_id_ && driver->CanApplyConcurrently();
+    queue_.push_back(Entry{ref, leader_term, op_id, last_submitted_op_id_, concurrent});
+    last_submitted_op_id_ = op_id;
+    if (!concurrent && queue_.size() == 1 && !finalizing_) {
+      // Nothing to wait for, so apply it right away, like without the applier.
+      inline_entry = &queue_.back();
+      inline_entry->started = true;
+      ++num_applying_;
+    } else {
+      StartReadyUnlocked(&ready);
+    }
+  }
+
+  if (inline_entry) {
+    Apply(inline_entry);
+  } else {
+    ApplyStarted(ready);
+  }
+}
+
+void ParallelApplier::StartReadyUnlocked(std::vector<Entry*>* ready) {
+  // The flag could be changed to 0 while concurrent operations are queued.
+  const size_t max_concurrent = std::max(FLAGS_max_concurrent_applies_per_tablet, 1);
+  // Op id of the last operation that is applied together with all preceding operations.
+  OpId applied_op_id;
+  for (auto& entry : queue_) {
+    if (entry.applied) {
+      continue;
+    }
+    if (!entry.concurrent) {
+      // Waits until all preceding operations are finalized.
+      if (!entry.started && &entry == &queue_.front() && !finalizing_) {
+        entry.started = true;
+        ++num_applying_;
+        ready->push_back(&entry);
+      }
+      break;
+    }
+    if (!entry.started) {
+      if (num_applying_ >= max_concurrent) {
+        break;
+      }
+      // If some preceding operation is not applied yet, this operation could get to RocksDB
+      // before it, so it records the op id of the last operation that is surely applied.
+      if (applied_op_id) {
+        entry.driver->SetFrontierOpId(applied_op_id);
+      }
+      entry.started = true;
+      ++num_applying_;
+      ready->push_back(&entry);
+    }
+    if (!applied_op_id) {
+      applied_op_id = entry.previous_op_id;
+    }
+  }
+}
+
+void ParallelApplier::ApplyStarted(const std::vector<Entry*>& entries) {
+  for (auto* entry : entries) {
+    if (!apply_pool_) {
+      Apply(entry);
+      continue;
+    }
+    auto status = apply_pool_->SubmitFunc([this, entry] { Apply(entry); });
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to submit apply of " << entry->op_id << ", applying it inline: "
+                   << status;
+      Apply(entry);
+    }
+  }
+}
+
+void ParallelApplier::Apply(Entry* entry) {
+  while (PREDICT_FALSE(FLAGS_parallel_apply_pause_index == entry->op_id.index)) {
+    SleepFor(MonoDelta::FromMilliseconds(1));
+  }
+
+  entry->driver->ApplyTask(entry->leader_term);
+
+  std::vector<Entry*> ready;
+  bool finalize = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry->applied = true;
+    --num_applying_;
+    StartReadyUnlocked(&ready);
+    // Operations will be finalized by the thread that is already doing it.
+    if (!finalizing_) {
+      finalizing_ = true;
+      finalize = true;
+    }
+  }
+
+  ApplyStarted(ready);
+  if (finalize) {
+    FinalizeApplied();
+  }
+}
+
+void ParallelApplier::FinalizeApplied() {
+  std::vector<scoped_refptr<OperationDriver>> applied;
+  for (;;) {
+    std::vector<Entry*> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while (!queue_.empty() && queue_.front().applied) {
+        applied.push_back(std::move(queue_.front().driver));
+        queue_.pop_front();
+      }
+      if (applied.empty()) {
+        finalizing_ = false;
+        // An operation that is not applied concurrently could wait for this finalization.
+        StartReadyUnlocked(&ready);
+      }
+      cond_.notify_all();
+    }
+
+    if (applied.empty()) {
+      ApplyStarted(ready);
+      return;
+    }
+
+    for (const auto& driver : applied) {
+      driver->Finalize();
+    }
+    applied.clear();
+  }
+}
+
+void ParallelApplier::Shutdown() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [this] { return queue_.empty() && !finalizing_; });
+}
+
+} // namespace tablet
+} // namespace yb
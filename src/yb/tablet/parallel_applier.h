@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_PARALLEL_APPLIER_H
+#define YB_TABLET_PARALLEL_APPLIER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/opid.h"
+
+DECLARE_int32(max_concurrent_applies_per_tablet);
+
+namespace yb {
+
+class ThreadPool;
+
+namespace tablet {
+
+class OperationDriver;
+
+// Applies the committed operations of a tablet.
+//
+// Operations are submitted in log order. Operations that allow it, i.e. non-transactional writes,
+// are applied on the apply pool, up to max_concurrent_applies_per_tablet at a time, so a hot tablet
+// is not limited by a single thread writing to RocksDB. Any other operation waits for all
+// previously submitted operations to be finalized. It is applied by the submitting thread when
+// there is nothing to wait for, otherwise on the apply pool.
+//
+// Submit() never blocks: operations that have to wait are queued. The queue is bounded by the
+// operation tracker of the tablet, which keeps the operations until they are finalized and rejects
+// new writes when their memory limit is reached.
+//
+// Operations are always finalized in log order, so MVCC safe time and replies to the clients see
+// the same order as with serial apply. An operation that is written to RocksDB before the preceding
+// ones records an earlier op id in RocksDB frontiers, see OperationState::frontier_op_id().
+class ParallelApplier {
+ public:
+  // When apply_pool is null, all operations are applied serially, by the submitting thread or by
+  // the thread that finalized the preceding operations.
+  explicit ParallelApplier(ThreadPool* apply_pool);
+  ~ParallelApplier();
+
+  void Submit(OperationDriver* driver, int64_t leader_term);
+
+  // Waits until all submitted operations are finalized.
+  void Shutdown();
+
+ private:
+  struct Entry {
+    scoped_refptr<OperationDriver> driver;
+    int64_t leader_term;
+    OpId op_id;
+    // Op id of the operation submitted before this one.
+    OpId previous_op_id;
+    // Whether the operation could be applied concurrently with the neighbouring ones.
+    bool concurrent;
+    bool started = false;
+    bool applied = false;
+  };
+
+  // Marks the queued operations that do not have to wait anymore as started and adds them to
+  // 'ready'. The caller applies them after releasing the mutex, see ApplyStarted().
+  void StartReadyUnlocked(std::vector<Entry*>* ready);
+
+  void ApplyStarted(const std::vector<Entry*>& entries);
+
+  void Apply(Entry* entry);
+
+  // Finalizes applied operations from the front of the queue, until it meets an operation that is
+  // not applied yet.
+  void FinalizeApplied();
+
+  ThreadPool* const apply_pool_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+
+  // Submitted operations, in log order, that are not finalized yet.
+  // std::deque does not move its elements when adding or removing elements at the ends.
+  std::deque<Entry> queue_;
+
+  // Number of started operations that are not applied yet.
+  size_t num_applying_ = 0;
+
+  // Whether some thread is finalizing operations from queue_.
+  bool finalizing_ = false;
+
+  OpId last_submitted_op_id_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_PARALLEL_APPLIER_H
@@ -32,8 +32,14 @@
 
 #include <time.h>
 
+#include <atomic>
+
 #include <glog/logging.h>
 
+#ifdef TCMALLOC_ENABLED
+#include <gperftools/malloc_hook.h>
+#endif
+
 #include "yb/common/row.h"
 #include "yb/common/ql_rowwise_iterator_interface.h"
 
@@ -212,5 +218,41 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+#ifdef TCMALLOC_ENABLED
+
+namespace {
+
+std::atomic<int64_t> num_mallocs{0};
+
+void CountMalloc(const void* ptr, size_t size) {
+  num_mallocs.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+// Measures the number of memory allocations done by a single row write, from building the request
+// to applying it to RocksDB. Allocations of background threads are counted as well.
+TYPED_TEST(TestTablet, TestWriteMallocsMicroBenchmark) {
+  LocalTabletWriter writer(this->tablet().get());
+  const int64_t kWarmupRows = 100;
+  const int64_t num_rows = this->ClampRowCount(AllowSlowTests() ? 100000 : 1000);
+
+  for (int64_t i = 0; i != kWarmupRows; ++i) {
+    ASSERT_OK(this->InsertTestRow(&writer, i, 0));
+  }
+
+  ASSERT_TRUE(MallocHook::AddNewHook(&CountMalloc));
+  const auto mallocs_before = num_mallocs.load();
+  for (int64_t i = kWarmupRows; i != kWarmupRows + num_rows; ++i) {
+    ASSERT_OK(this->InsertTestRow(&writer, i, 0));
+  }
+  const auto mallocs = num_mallocs.load() - mallocs_before;
+  ASSERT_TRUE(MallocHook::RemoveNewHook(&CountMalloc));
+
+  LOG(INFO) << "Mallocs per write: " << static_cast<double>(mallocs) / num_rows;
+}
+
+#endif // TCMALLOC_ENABLED
+
 } // namespace tablet
 } // namespace yb
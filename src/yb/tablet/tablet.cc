@@ -97,6 +97,7 @@
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/util/atomic.h"
 #include "yb/util/bloom_filter.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/enums.h"
@@ -106,6 +107,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/request_stages.h"
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -339,7 +341,7 @@ Tablet::Tablet(
     });
 
     metric_entity_->AddExternalPrometheusMetricsCb(
-        [rocksdb_statistics, attrs](PrometheusWriter* pw) {
+        [rocksdb_statistics](PrometheusWriter* pw, const MetricEntity::AttributeMap& attrs) {
       auto s = EmitRocksDbMetricsAsPrometheus(rocksdb_statistics, pw, attrs);
       if (!s.ok()) {
         YB_LOG_EVERY_N(WARNING, 100) << "Failed to get Prometheus metrics: " << s.ToString();
@@ -347,6 +349,7 @@ Tablet::Tablet(
     });
 
     metrics_.reset(new TabletMetrics(metric_entity_));
+    mvcc_.SetMetrics(*metrics_);
 
     mem_tracker_->SetMetricEntity(metric_entity_);
   }
@@ -383,6 +386,16 @@ Tablet::Tablet(
         metrics_->expired_transactions.get());
   }
 
+  if (!metadata_->split_parent_tablet_id().empty() &&
+      metadata_->partition_schema().IsHashPartitioning()) {
+    // Hash partition keys are the encoded hash codes that follow the value type in DocDB keys.
+    const auto& partition = metadata_->partition();
+    const std::string prefix(1, static_cast<char>(docdb::ValueType::kUInt16Hash));
+    key_bounds_ = docdb::KeyBounds(
+        partition.partition_key_start().empty() ? "" : prefix + partition.partition_key_start(),
+        partition.partition_key_end().empty() ? "" : prefix + partition.partition_key_end());
+  }
+
   flush_stats_ = make_shared<TabletFlushStats>();
   tablet_options_.listeners.emplace_back(flush_stats_);
 }
@@ -479,15 +492,24 @@ std::string Tablet::LogPrefix() const {
   return Format("T $0$1: ", tablet_id(), log_prefix_suffix_);
 }
 
+size_t Tablet::BloomFilterRangeComponents() const {
+  const Schema& schema = metadata_->schema();
+  return std::min<size_t>(
+      schema.table_properties().bloom_filter_range_components(), schema.num_range_key_columns());
+}
+
 Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
-  docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_);
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_,
+      BloomFilterRangeComponents());
   rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker("RegularDB", mem_tracker_);
 
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
   rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
-      make_shared<TabletRetentionPolicy>(this));
+      make_shared<TabletRetentionPolicy>(this),
+      key_bounds_.IsInitialized() ? &key_bounds_ : nullptr);
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -662,7 +684,8 @@ void Tablet::StartOperation(WriteOperationState* operation_state) {
 }
 
 void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
-  last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
+  // Writes could be applied concurrently, so keep the maximal index.
+  UpdateAtomicMax(&last_committed_write_index_, operation_state->op_id().index());
   const KeyValueWriteBatchPB& put_batch =
       operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
           // Online case.
@@ -671,7 +694,8 @@ void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
           : operation_state->request()->write_batch();
 
   docdb::ConsensusFrontiers frontiers;
-  set_op_id({operation_state->op_id().term(), operation_state->op_id().index()}, &frontiers);
+  const auto& frontier_op_id = operation_state->frontier_op_id();
+  set_op_id({frontier_op_id.term(), frontier_op_id.index()}, &frontiers);
   set_hybrid_time(operation_state->hybrid_time(), &frontiers);
   ApplyKeyValueRowOperations(put_batch, &frontiers, operation_state->hybrid_time());
 }
@@ -718,6 +742,33 @@ Status Tablet::CreateCheckpoint(const std::string& dir) {
   return Status::OK();
 }
 
+Status Tablet::CreateSplitCheckpoint(const std::string& dir) {
+  // The frontier is only reset in the regular DB, and the transaction participants of the new
+  // tablets would not know about the running transactions of this one.
+  if (intents_db_) {
+    return STATUS_FORMAT(
+        NotSupported, "Transactional tablet $0 could not be split", tablet_id());
+  }
+  RETURN_NOT_OK(CreateCheckpoint(dir));
+
+  rocksdb::Options rocksdb_options;
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, tablet_id(), /* statistics */ nullptr, tablet_options_,
+      BloomFilterRangeComponents());
+  rocksdb_options.create_if_missing = false;
+  std::unique_ptr<rocksdb::DB> db = VERIFY_RESULT(rocksdb::DB::Open(rocksdb_options, dir));
+  auto flushed_frontier = db->GetFlushedFrontier();
+  if (!flushed_frontier) {
+    return Status::OK();
+  }
+  // Keep the hybrid time and the history cutoff, so reads below them are still rejected.
+  docdb::ConsensusFrontier frontier =
+      down_cast<docdb::ConsensusFrontier&>(*flushed_frontier);
+  frontier.set_op_id(OpId());
+  return db->ModifyFlushedFrontier(
+      frontier.Clone(), rocksdb::FrontierModificationMode::kForce);
+}
+
 void Tablet::PrepareTransactionWriteBatch(
     const KeyValueWriteBatchPB& put_batch,
     HybridTime hybrid_time,
@@ -850,6 +901,7 @@ Status Tablet::HandleRedisReadRequest(MonoTime deadline,
   RETURN_NOT_OK(scoped_read_operation);
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
+  ScopedRequestStage read_stage(RequestStage::kRead);
 
   docdb::RedisReadOperation doc_op(
       redis_read_request, {regular_db_.get(), intents_db_.get()}, deadline, read_time);
@@ -869,6 +921,7 @@ Status Tablet::HandleQLReadRequest(
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedRequestStage read_stage(RequestStage::kRead);
 
   if (metadata()->schema_version() != ql_read_request.schema_version()) {
     result->response.set_status(QLResponsePB::YQL_STATUS_SCHEMA_VERSION_MISMATCH);
@@ -878,6 +931,27 @@ Status Tablet::HandleQLReadRequest(
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
+
+  // A tablet created by a split still has the rows of its sibling until they are compacted away,
+  // so restrict scans to the hash range of the tablet.
+  if (key_bounds_.IsInitialized() && ql_read_request.hashed_column_values().empty()) {
+    const auto& partition = metadata_->partition();
+    const uint32_t min_hash_code = partition.partition_key_start().empty()
+        ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+    const uint32_t max_hash_code = partition.partition_key_end().empty()
+        ? PartitionSchema::kMaxPartitionKey
+        : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end()) - 1;
+    QLReadRequestPB bounded_request(ql_read_request);
+    if (!bounded_request.has_hash_code() || bounded_request.hash_code() < min_hash_code) {
+      bounded_request.set_hash_code(min_hash_code);
+    }
+    if (!bounded_request.has_max_hash_code() || bounded_request.max_hash_code() > max_hash_code) {
+      bounded_request.set_max_hash_code(max_hash_code);
+    }
+    return AbstractTablet::HandleQLReadRequest(
+        deadline, read_time, bounded_request, *txn_op_ctx, result);
+  }
+
   return AbstractTablet::HandleQLReadRequest(
       deadline, read_time, ql_read_request, *txn_op_ctx, result);
 }
@@ -1145,6 +1219,7 @@ Status Tablet::HandlePgsqlReadRequest(
   RETURN_NOT_OK(scoped_read_operation);
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
+  ScopedRequestStage read_stage(RequestStage::kRead);
 
   const tablet::TableInfo* table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -1294,6 +1369,10 @@ Status Tablet::Flush(FlushMode mode, FlushFlags flags) {
 }
 
 Status Tablet::CompactSync() {
+  // Keeps the DB alive until the compaction is done, even when the tablet is shut down meanwhile.
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
   std::vector<std::string> file_names;
   for (const auto& lfmd : regular_db_->GetLiveFilesMetaData()) {
     file_names.push_back(lfmd.name);
@@ -1722,6 +1801,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
 
   if (transactional_table) {
     if (isolation_level == IsolationLevel::NON_TRANSACTIONAL) {
+      ScopedRequestStage conflict_resolution_stage(RequestStage::kConflictResolution);
       auto now = clock_->Now();
       auto result = VERIFY_RESULT(docdb::ResolveOperationConflicts(
           operation->doc_ops(), now, { regular_db_.get(), intents_db_.get() },
@@ -1749,10 +1829,13 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
         }
       }
 
-      RETURN_NOT_OK(docdb::ResolveTransactionConflicts(
-          operation->doc_ops(), *write_batch, clock_->Now(),
-          { regular_db_.get(), intents_db_.get() }, transaction_participant_.get(),
-          metrics_->transaction_conflicts.get()));
+      {
+        ScopedRequestStage conflict_resolution_stage(RequestStage::kConflictResolution);
+        RETURN_NOT_OK(docdb::ResolveTransactionConflicts(
+            operation->doc_ops(), *write_batch, clock_->Now(),
+            { regular_db_.get(), intents_db_.get() }, transaction_participant_.get(),
+            metrics_->transaction_conflicts.get()));
+      }
 
       if (!read_time) {
         DSCHECK_EQ(isolation_level, IsolationLevel::SERIALIZABLE_ISOLATION, InvalidArgument,
@@ -1960,6 +2043,29 @@ uint64_t Tablet::GetUncompressedSSTFileSizes() const {
   return regular_db_->GetUncompressedSSTFileSize();
 }
 
+Tablet::MemTableStats Tablet::GetMemTableStats() const {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  std::lock_guard<rw_spinlock> lock(component_lock_);
+
+  MemTableStats result;
+  if (!pending_op_counter_.IsReady()) {
+    return result;
+  }
+  for (auto* db : {regular_db_.get(), intents_db_.get()}) {
+    if (!db) {
+      continue;
+    }
+    uint64_t value = 0;
+    if (db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &value)) {
+      result.active_bytes += value;
+    }
+    if (db->GetIntProperty(rocksdb::DB::Properties::kNumImmutableMemTable, &value)) {
+      result.num_immutable += value;
+    }
+  }
+  return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContextOpt> Tablet::CreateTransactionOperationContext(
@@ -133,6 +133,7 @@ class TabletFlushStats : public rocksdb::EventListener {
   }
 
   void AboutToWriteToDb(HybridTime hybrid_time) {
+    num_writes_.fetch_add(1, std::memory_order_relaxed);
     // Atomically do oldest_write_in_memstore_ = min(oldest_write_in_memstore_, hybrid_time)
     uint64_t curr_val = hybrid_time.ToUint64();
     uint64_t prev_val = oldest_write_in_memstore_.load(std::memory_order_acquire);
@@ -150,8 +151,14 @@ class TabletFlushStats : public rocksdb::EventListener {
     return num_flushes_.load(std::memory_order_acquire);
   }
 
+  // Number of write batches written to the DB since the tablet was opened.
+  uint64_t num_writes() const {
+    return num_writes_.load(std::memory_order_relaxed);
+  }
+
  private:
   std::atomic<size_t> num_flushes_{0};
+  std::atomic<uint64_t> num_writes_{0};
   std::atomic<uint64_t> oldest_write_in_memstore_{std::numeric_limits<uint64_t>::max()};
 };
 
@@ -347,6 +354,17 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // YQL_TABLE_TYPE.
   CHECKED_STATUS CreateCheckpoint(const std::string& dir);
 
+  // Create a RocksDB checkpoint for a tablet split from this one. The new tablet starts a new Raft
+  // log, so the flushed op id is reset in the checkpoint. Transactional tablets are not supported.
+  CHECKED_STATUS CreateSplitCheckpoint(const std::string& dir);
+
+  TabletSplitter* tablet_splitter() const { return tablet_options_.tablet_splitter; }
+
+  // Range of DocDB keys that belongs to this tablet. Only initialized for a tablet created by a
+  // split, which still has the keys of the other half of the split tablet until they are
+  // compacted away.
+  const docdb::KeyBounds& key_bounds() const { return key_bounds_; }
+
   // Create a new row iterator which yields the rows as of the current MVCC
   // state of this tablet.
   // The returned iterator is not initialized.
@@ -496,6 +514,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   uint64_t GetTotalSSTFileSizes() const;
   uint64_t GetUncompressedSSTFileSizes() const;
 
+  struct MemTableStats {
+    // Size of the memtables that accept writes, across the regular and intents DBs.
+    uint64_t active_bytes = 0;
+    // Number of memtables that are waiting to be flushed or being flushed.
+    uint64_t num_immutable = 0;
+  };
+
+  MemTableStats GetMemTableStats() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -533,6 +560,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   CHECKED_STATUS StartDocWriteOperation(WriteOperation* operation);
 
   CHECKED_STATUS OpenKeyValueTablet();
+
+  // Returns the number of range components the bloom filters of the regular DB are built on.
+  size_t BloomFilterRangeComponents() const;
+
   virtual CHECKED_STATUS CreateTabletDirectories(const string& db_dir, FsManager* fs);
 
   void DocDBDebugDump(std::vector<std::string> *lines);
@@ -668,6 +699,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::shared_ptr<yb::docdb::HistoryRetentionPolicy> retention_policy_;
 
+  docdb::KeyBounds key_bounds_;
+
   std::unique_ptr<TransactionCoordinator> transaction_coordinator_;
 
   std::unique_ptr<TransactionParticipant> transaction_participant_;
@@ -45,6 +45,8 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/tablet_splitter.h"
+#include "yb/tablet/operations/split_operation.h"
 
 using std::shared_ptr;
 using std::string;
@@ -76,6 +78,18 @@ using server::Clock;
 using server::LogicalClock;
 using tserver::WriteRequestPB;
 
+// Records the split requests replayed by bootstrap and fails them, like a tablet server that
+// could not create the new tablets.
+class FailingTabletSplitter : public TabletSplitter {
+ public:
+  CHECKED_STATUS ApplyTabletSplit(SplitOperationState* state) override {
+    requests.push_back(*state->request());
+    return STATUS(IOError, "Injected failure to create the new tablets");
+  }
+
+  std::vector<tserver::SplitTabletRequestPB> requests;
+};
+
 class BootstrapTest : public LogTestBase {
  protected:
 
@@ -114,11 +128,13 @@ class BootstrapTest : public LogTestBase {
 
   Status RunBootstrapOnTestTablet(const scoped_refptr<TabletMetadata>& meta,
                                   shared_ptr<TabletClass>* tablet,
-                                  ConsensusBootstrapInfo* boot_info) {
+                                  ConsensusBootstrapInfo* boot_info,
+                                  TabletSplitter* tablet_splitter = nullptr) {
     gscoped_ptr<TabletStatusListener> listener(new TabletStatusListener(meta));
     scoped_refptr<LogAnchorRegistry> log_anchor_registry(new LogAnchorRegistry());
     // Now attempt to recover the log
     TabletOptions tablet_options;
+    tablet_options.tablet_splitter = tablet_splitter;
     BootstrapTabletData data = {
         meta,
         std::shared_future<client::YBClientPtr>(),
@@ -140,7 +156,8 @@ class BootstrapTest : public LogTestBase {
   Status BootstrapTestTablet(int mrs_id,
                              int delta_id,
                              shared_ptr<TabletClass>* tablet,
-                             ConsensusBootstrapInfo* boot_info) {
+                             ConsensusBootstrapInfo* boot_info,
+                             TabletSplitter* tablet_splitter = nullptr) {
     scoped_refptr<TabletMetadata> meta;
     RETURN_NOT_OK_PREPEND(LoadTestTabletMetadata(mrs_id, delta_id, &meta),
                           "Unable to load test tablet metadata");
@@ -157,7 +174,7 @@ class BootstrapTest : public LogTestBase {
                                                     config, kMinimumTerm, &cmeta),
                           "Unable to create consensus metadata");
 
-    RETURN_NOT_OK_PREPEND(RunBootstrapOnTestTablet(meta, tablet, boot_info),
+    RETURN_NOT_OK_PREPEND(RunBootstrapOnTestTablet(meta, tablet, boot_info, tablet_splitter),
                           "Unable to bootstrap test tablet");
     return Status::OK();
   }
@@ -339,5 +356,40 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Test that a committed split operation is passed to the tablet splitter during bootstrap, and
+// that the tablet is still bootstrapped when the new tablets could not be created.
+TEST_F(BootstrapTest, TestSplitOperationReplay) {
+  BuildLog();
+
+  auto split_replicate = std::make_shared<ReplicateMsg>();
+  split_replicate->set_op_type(consensus::SPLIT_OP);
+  *split_replicate->mutable_id() = MakeOpId(1, 1);
+  *split_replicate->mutable_committed_op_id() = MakeOpId(0, 0);
+  split_replicate->set_hybrid_time(clock_->Now().ToUint64());
+  auto* split_request = split_replicate->mutable_split_request();
+  split_request->set_tablet_id(log::kTestTablet);
+  split_request->set_new_tablet1_id("new-tablet-1");
+  split_request->set_new_tablet2_id("new-tablet-2");
+  split_request->set_split_partition_key("split-key");
+  AppendReplicateBatch(split_replicate, true);
+
+  // Commit the split operation.
+  const auto second_opid = MakeOpId(1, 2);
+  AppendReplicateBatch(second_opid, second_opid, {TupleForAppend(1, 1, "foo")});
+
+  FailingTabletSplitter tablet_splitter;
+  ConsensusBootstrapInfo boot_info;
+  shared_ptr<TabletClass> tablet;
+  ASSERT_OK(BootstrapTestTablet(-1, -1, &tablet, &boot_info, &tablet_splitter));
+  ASSERT_OPID_EQ(boot_info.last_committed_id, second_opid);
+
+  ASSERT_EQ(1, tablet_splitter.requests.size());
+  const auto& request = tablet_splitter.requests[0];
+  ASSERT_EQ(log::kTestTablet, request.tablet_id());
+  ASSERT_EQ("new-tablet-1", request.new_tablet1_id());
+  ASSERT_EQ("new-tablet-2", request.new_tablet2_id());
+  ASSERT_EQ("split-key", request.split_partition_key());
+}
+
 } // namespace tablet
 } // namespace yb
@@ -39,7 +39,9 @@
 #include "yb/server/hybrid_clock.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/tablet_splitter.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -664,6 +666,9 @@ Status TabletBootstrap::HandleOperation(consensus::OperationType op_type,
     case consensus::TRUNCATE_OP:
       return PlayTruncateRequest(replicate);
 
+    case consensus::SPLIT_OP:
+      return PlaySplitRequest(replicate);
+
     case consensus::NO_OP:
       return PlayNoOpRequest(replicate);
 
@@ -903,7 +908,10 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   // Use committed OpId for mem store anchoring.
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
 
-  tablet_->ApplyRowOperations(&operation_state);
+  // Writes replicated after the tablet was split were rejected, see WriteOperation::Apply.
+  if (!tablet_->metadata()->IsSplit()) {
+    tablet_->ApplyRowOperations(&operation_state);
+  }
 
   tablet_->mvcc_manager()->Replicated(operation_state.hybrid_time());
 }
@@ -964,6 +972,21 @@ Status TabletBootstrap::PlayNoOpRequest(ReplicateMsg* replicate_msg) {
   return Status::OK();
 }
 
+Status TabletBootstrap::PlaySplitRequest(ReplicateMsg* replicate_msg) {
+  auto* tablet_splitter = tablet_->tablet_splitter();
+  if (!tablet_splitter) {
+    return STATUS(IllegalState, "Tablet split is not supported by this tablet");
+  }
+
+  SplitOperationState operation_state(tablet_.get(), replicate_msg->mutable_split_request());
+
+  // As in SplitOperation::Apply, the tablet could still be bootstrapped when creating the new
+  // tablets fails.
+  WARN_NOT_OK(tablet_splitter->ApplyTabletSplit(&operation_state), "Failed to split tablet");
+
+  return Status::OK();
+}
+
 Status TabletBootstrap::PlayTruncateRequest(ReplicateMsg* replicate_msg) {
   TruncateRequestPB* req = replicate_msg->mutable_truncate_request();
 
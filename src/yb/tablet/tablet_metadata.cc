@@ -513,6 +513,10 @@ Status TabletMetadata::LoadFromSuperBlock(const TabletSuperBlockPB& superblock)
       tombstone_last_logged_opid_ = OpId();
     }
 
+    split_parent_tablet_id_ = superblock.split_parent_tablet_id();
+    split_child_tablet_ids_.assign(
+        superblock.split_child_tablet_ids().begin(), superblock.split_child_tablet_ids().end());
+
     std::unique_ptr<TableInfo> table_info(new TableInfo());
     RETURN_NOT_OK(table_info->LoadFromSuperBlock(superblock));
     primary_table_id_ = table_info->table_id;
@@ -605,6 +609,12 @@ void TabletMetadata::ToSuperBlockUnlocked(TabletSuperBlockPB* superblock) const
   if (tombstone_last_logged_opid_) {
     tombstone_last_logged_opid_.ToPB(pb.mutable_tombstone_last_logged_opid());
   }
+  if (!split_parent_tablet_id_.empty()) {
+    pb.set_split_parent_tablet_id(split_parent_tablet_id_);
+  }
+  for (const auto& tablet_id : split_child_tablet_ids_) {
+    pb.add_split_child_tablet_ids(tablet_id);
+  }
 
   tables_.find(primary_table_id_)->second->ToSuperBlock(&pb);
 
@@ -704,5 +714,30 @@ TabletDataState TabletMetadata::tablet_data_state() const {
   return tablet_data_state_;
 }
 
+void TabletMetadata::set_split_parent_tablet_id(const std::string& tablet_id) {
+  std::lock_guard<LockType> l(data_lock_);
+  split_parent_tablet_id_ = tablet_id;
+}
+
+std::string TabletMetadata::split_parent_tablet_id() const {
+  std::lock_guard<LockType> l(data_lock_);
+  return split_parent_tablet_id_;
+}
+
+void TabletMetadata::set_split_child_tablet_ids(const std::vector<std::string>& tablet_ids) {
+  std::lock_guard<LockType> l(data_lock_);
+  split_child_tablet_ids_ = tablet_ids;
+}
+
+std::vector<std::string> TabletMetadata::split_child_tablet_ids() const {
+  std::lock_guard<LockType> l(data_lock_);
+  return split_child_tablet_ids_;
+}
+
+bool TabletMetadata::IsSplit() const {
+  std::lock_guard<LockType> l(data_lock_);
+  return !split_child_tablet_ids_.empty();
+}
+
 } // namespace tablet
 } // namespace yb
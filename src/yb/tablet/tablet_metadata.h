@@ -289,6 +289,17 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
   void set_tablet_data_state(TabletDataState state);
   TabletDataState tablet_data_state() const;
 
+  // Set / get the tablet this tablet was split from.
+  void set_split_parent_tablet_id(const std::string& tablet_id);
+  std::string split_parent_tablet_id() const;
+
+  // Set / get the tablets this tablet was split into.
+  void set_split_child_tablet_ids(const std::vector<std::string>& tablet_ids);
+  std::vector<std::string> split_child_tablet_ids() const;
+
+  // Whether the tablet was split, so its data is now served by the child tablets.
+  bool IsSplit() const;
+
   CHECKED_STATUS Flush();
 
   // Mark the superblock to be in state 'delete_type', sync it to disk, and
@@ -438,6 +449,9 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
   // non-tombstoned tablets.
   yb::OpId tombstone_last_logged_opid_;
 
+  std::string split_parent_tablet_id_;
+  std::vector<std::string> split_child_tablet_ids_;
+
   DISALLOW_COPY_AND_ASSIGN(TabletMetadata);
 };
 
@@ -124,6 +124,17 @@ METRIC_DEFINE_counter(tablet, expired_transactions,
   yb::MetricUnit::kRequests,
   "Number of expired distributed transactions.");
 
+METRIC_DEFINE_counter(tablet, mvcc_lock_contention,
+  "MVCC Lock Contention",
+  yb::MetricUnit::kOperations,
+  "Number of times the MVCC manager lock was held by another thread when adding, replicating "
+  "or aborting an operation.");
+
+METRIC_DEFINE_histogram(tablet, mvcc_safe_time_wait_duration,
+  "MVCC Safe Time Wait Duration",
+  yb::MetricUnit::kMicroseconds,
+  "Time spent by reads waiting for the safe time to read at.", 60000000LU, 2);
+
 METRIC_DEFINE_counter(tablet, restart_read_requests,
   "Read Requests Requiring Restart",
   yb::MetricUnit::kRequests,
@@ -145,6 +156,8 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(leader_memory_pressure_rejections),
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
+    MINIT(mvcc_lock_contention),
+    MINIT(mvcc_safe_time_wait_duration),
     MINIT(restart_read_requests) {
 }
 #undef MINIT
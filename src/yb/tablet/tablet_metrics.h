@@ -64,6 +64,8 @@ struct TabletMetrics {
   scoped_refptr<Counter> leader_memory_pressure_rejections;
   scoped_refptr<Counter> transaction_conflicts;
   scoped_refptr<Counter> expired_transactions;
+  scoped_refptr<Counter> mvcc_lock_contention;
+  scoped_refptr<Histogram> mvcc_safe_time_wait_duration;
   scoped_refptr<Counter> restart_read_requests;
 };
 
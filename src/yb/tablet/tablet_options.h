@@ -22,10 +22,15 @@ class MemoryMonitor;
 namespace yb {
 namespace tablet {
 
+class TabletSplitter;
+
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
+  // Creates the new tablets when a split operation is applied. Not set for tablets that could not
+  // be split, e.g. the system catalog.
+  TabletSplitter* tablet_splitter = nullptr;
 };
 
 } // namespace tablet
@@ -46,6 +46,7 @@
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/gutil/macros.h"
+#include "yb/rocksdb/db.h"
 #include "yb/rpc/messenger.h"
 #include "yb/server/clock.h"
 #include "yb/server/logical_clock.h"
@@ -65,6 +66,8 @@
 METRIC_DECLARE_entity(tablet);
 
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(max_concurrent_applies_per_tablet);
+DECLARE_int64(parallel_apply_pause_index);
 
 namespace yb {
 namespace tablet {
@@ -113,6 +116,7 @@ class TabletPeerTest : public YBTabletTest,
 
     ASSERT_OK(ThreadPoolBuilder("raft").Build(&raft_pool_));
     ASSERT_OK(ThreadPoolBuilder("prepare").Build(&tablet_prepare_pool_));
+    ASSERT_OK(ThreadPoolBuilder("apply").Build(&apply_pool_));
 
     rpc::MessengerBuilder builder(CURRENT_TEST_NAME());
     messenger_ = ASSERT_RESULT(builder.Build());
@@ -171,8 +175,11 @@ class TabletPeerTest : public YBTabletTest,
                                            log,
                                            metric_entity_,
                                            raft_pool_.get(),
+                                           nullptr /* log_prefetch_pool */,
                                            tablet_prepare_pool_.get(),
-                                           nullptr /* retryable_requests */));
+                                           apply_pool_.get(),
+                                           nullptr /* retryable_requests */,
+                                           nullptr /* multi_raft_manager */));
   }
 
   Status StartPeer(const ConsensusBootstrapInfo& info) {
@@ -202,6 +209,29 @@ class TabletPeerTest : public YBTabletTest,
     AddTestRowInsert(insert_counter_++, write_req);
   }
 
+  // Submits 'num_writes' inserts at once, runs 'while_pending' and waits for all of them to succeed.
+  void WriteConcurrently(int num_writes, const std::function<void()>& while_pending = nullptr) {
+    std::vector<WriteRequestPB> requests(num_writes);
+    std::vector<WriteResponsePB> responses(num_writes);
+    CountDownLatch latch(num_writes);
+    for (int i = 0; i != num_writes; ++i) {
+      GenerateSequentialInsertRequest(&requests[i]);
+      auto operation_state = std::make_unique<WriteOperationState>(
+          tablet_peer_->tablet(), &requests[i], &responses[i]);
+      operation_state->set_completion_callback(
+          std::make_unique<LatchWriteCallback>(&latch, &responses[i]));
+      tablet_peer_->WriteAsync(std::move(operation_state), 1, MonoTime::Max() /* deadline */);
+    }
+    if (while_pending) {
+      while_pending();
+    }
+    latch.Wait();
+
+    for (const auto& response : responses) {
+      ASSERT_FALSE(response.has_error()) << response.ShortDebugString();
+    }
+  }
+
   // Generate monotonic sequence of deletions, starting with 0.
   // Will assert if you try to delete more rows than you inserted.
   void GenerateSequentialDeleteRequest(WriteRequestPB* write_req) {
@@ -280,6 +310,7 @@ class TabletPeerTest : public YBTabletTest,
   std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   std::unique_ptr<ThreadPool> raft_pool_;
   std::unique_ptr<ThreadPool> tablet_prepare_pool_;
+  std::unique_ptr<ThreadPool> apply_pool_;
   std::unique_ptr<ThreadPool> append_pool_;
   std::shared_ptr<TabletPeer> tablet_peer_;
   TableType table_type_;
@@ -452,6 +483,82 @@ TEST_P(TabletPeerTest, TestGCEmptyLog) {
   ASSERT_OK(tablet_peer_->RunLogGC());
 }
 
+// Non-transactional writes are applied concurrently, but all of them are visible after their
+// callbacks are invoked and a flush does not cover an operation that was not written yet.
+TEST_P(TabletPeerTest, TestParallelApply) {
+  FLAGS_max_concurrent_applies_per_tablet = 4;
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  constexpr int kNumWrites = 200;
+  ASSERT_NO_FATALS(WriteConcurrently(kNumWrites));
+
+  std::vector<std::string> rows;
+  ASSERT_OK(DumpTablet(*tablet(), client_schema_, &rows));
+  ASSERT_EQ(kNumWrites, rows.size());
+
+  ASSERT_OK(tablet()->Flush(tablet::FlushMode::kSync));
+  auto flushed_op_id = ASSERT_RESULT(tablet()->MaxPersistentOpId()).regular;
+  ASSERT_LE(flushed_op_id.index, tablet_peer_->log()->GetLatestEntryOpId().index);
+}
+
+// While an operation is being applied, the following ones are written to RocksDB, but a flush
+// does not cover the operation that is not written yet.
+TEST_P(TabletPeerTest, TestParallelApplyFlushedFrontier) {
+  FLAGS_max_concurrent_applies_per_tablet = 4;
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  // The first write after the start is applied serially.
+  ASSERT_NO_FATALS(WriteConcurrently(1));
+  ASSERT_OK(tablet()->Flush(tablet::FlushMode::kSync));
+
+  const int64_t paused_index = tablet_peer_->log()->GetLatestEntryOpId().index + 1;
+  FLAGS_parallel_apply_pause_index = paused_index;
+  int64_t flushed_index = -1;
+  ASSERT_NO_FATALS(WriteConcurrently(10, [this, &flushed_index] {
+    auto status = WaitFor([this] {
+      uint64_t num_entries = 0;
+      return tablet()->TEST_db()->GetIntProperty(
+          rocksdb::DB::Properties::kNumEntriesActiveMemTable, &num_entries) && num_entries > 0;
+    }, MonoDelta::FromSeconds(10), "Wait for writes after the paused one");
+    if (status.ok()) {
+      status = tablet()->Flush(tablet::FlushMode::kSync);
+    }
+    if (status.ok()) {
+      auto op_ids = tablet()->MaxPersistentOpId();
+      status = op_ids.ok() ? Status::OK() : op_ids.status();
+      flushed_index = op_ids.ok() ? op_ids->regular.index : -1;
+    }
+    // Let the paused operation go before checking, so the writes complete in any case.
+    FLAGS_parallel_apply_pause_index = 0;
+    ASSERT_OK(status);
+  }));
+
+  // The writes after the paused operation record the op id that precedes it.
+  ASSERT_EQ(paused_index - 1, flushed_index);
+
+  std::vector<std::string> rows;
+  ASSERT_OK(DumpTablet(*tablet(), client_schema_, &rows));
+  ASSERT_EQ(11, rows.size());
+}
+
+// Measures the write throughput of a single tablet depending on the number of concurrent applies.
+TEST_P(TabletPeerTest, TestWriteScalingMicroBenchmark) {
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  const int num_writes = AllowSlowTests() ? 20000 : 1000;
+  for (int max_concurrent : {0, 1, 2, 4, 8}) {
+    FLAGS_max_concurrent_applies_per_tablet = max_concurrent;
+    const auto start = MonoTime::Now();
+    ASSERT_NO_FATALS(WriteConcurrently(num_writes));
+    const auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "max_concurrent_applies_per_tablet: " << max_concurrent << ", throughput: "
+              << num_writes / elapsed.ToSeconds() << " writes/sec";
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(Rocks, TabletPeerTest, ::testing::Values(YQL_TABLE_TYPE));
 
 } // namespace tablet
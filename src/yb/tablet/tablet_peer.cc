@@ -72,6 +72,7 @@
 
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/operation_driver.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
@@ -162,8 +163,11 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                   const scoped_refptr<Log> &log,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
+                                  ThreadPool* log_prefetch_pool,
                                   ThreadPool* tablet_prepare_pool,
-                                  consensus::RetryableRequests* retryable_requests) {
+                                  ThreadPool* apply_pool,
+                                  consensus::RetryableRequests* retryable_requests,
+                                  consensus::MultiRaftManager* multi_raft_manager) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -237,7 +241,9 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        log_prefetch_pool,
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
     auto ht_lease_provider = [this](MicrosTime min_allowed, MonoTime deadline) {
       MicrosTime lease_micros {
@@ -264,6 +270,9 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
     });
 
     prepare_thread_ = std::make_unique<Preparer>(consensus_.get(), tablet_prepare_pool);
+    if (apply_pool) {
+      applier_ = std::make_unique<ParallelApplier>(apply_pool);
+    }
 
     consensus_->SetMajorityReplicatedListener([mvcc_manager, ht_lease_provider] {
       auto ht_lease = ht_lease_provider(/* min_allowed */ 0, /* deadline */ MonoTime::kMax);
@@ -362,6 +371,10 @@ void TabletPeer::CompleteShutdown() {
     operation_tracker_.WaitForAllToFinish();
   }
 
+  if (applier_) {
+    applier_->Shutdown();
+  }
+
   if (prepare_thread_) {
     prepare_thread_->Stop();
   }
@@ -385,6 +398,7 @@ void TabletPeer::CompleteShutdown() {
     has_consensus_.store(false, std::memory_order_release);
     consensus_.reset();
     prepare_thread_.reset();
+    applier_.reset();
     tablet_.reset();
     auto state = state_.load(std::memory_order_acquire);
     LOG_IF_WITH_PREFIX(DFATAL, state != TabletStatePB::QUIESCING) <<
@@ -573,6 +587,9 @@ consensus::OperationType MapOperationTypeToPB(OperationType operation_type) {
     case OperationType::kTruncate:
       return consensus::TRUNCATE_OP;
 
+    case OperationType::kSplit:
+      return consensus::SPLIT_OP;
+
     case OperationType::kEmpty:
       LOG(FATAL) << "OperationType::kEmpty cannot be converted to consensus::OperationType";
   }
@@ -736,6 +753,11 @@ std::unique_ptr<Operation> TabletPeer::CreateOperation(consensus::ReplicateMsg*
       return std::make_unique<TruncateOperation>(
           std::make_unique<TruncateOperationState>(tablet()));
 
+    case consensus::SPLIT_OP:
+      DCHECK(replicate_msg->has_split_request()) << "SPLIT_OP replica"
+          " operation must receive an SplitTabletRequestPB";
+      return std::make_unique<SplitOperation>(std::make_unique<SplitOperationState>(tablet()));
+
     case consensus::SNAPSHOT_OP: FALLTHROUGH_INTENDED;
     case consensus::UNKNOWN_OP: FALLTHROUGH_INTENDED;
     case consensus::NO_OP: FALLTHROUGH_INTENDED;
@@ -875,6 +897,7 @@ scoped_refptr<OperationDriver> TabletPeer::CreateOperationDriver() {
       consensus_.get(),
       log_.get(),
       prepare_thread_.get(),
+      applier_.get(),
       &operation_order_verifier_,
       tablet_->table_type()));
 }
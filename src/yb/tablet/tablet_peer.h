@@ -55,6 +55,7 @@
 #include "yb/tablet/operation_order_verifier.h"
 #include "yb/tablet/operations/operation_tracker.h"
 #include "yb/tablet/operations/write_operation.h"
+#include "yb/tablet/parallel_applier.h"
 #include "yb/tablet/preparer.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_fwd.h"
@@ -116,8 +117,11 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
                                 const scoped_refptr<log::Log> &log,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
+                                ThreadPool* log_prefetch_pool,
                                 ThreadPool* tablet_prepare_pool,
-                                consensus::RetryableRequests* retryable_requests);
+                                ThreadPool* apply_pool,
+                                consensus::RetryableRequests* retryable_requests,
+                                consensus::MultiRaftManager* multi_raft_manager);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -385,6 +389,9 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
 
   std::unique_ptr<Preparer> prepare_thread_;
 
+  // Null when operations are applied without a thread pool, e.g. for the master sys catalog.
+  std::unique_ptr<ParallelApplier> applier_;
+
   scoped_refptr<server::Clock> clock_;
 
   scoped_refptr<log::LogAnchorRegistry> log_anchor_registry_;
@@ -0,0 +1,107 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/flush_policy.h"
+
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "yb/util/test_util.h"
+
+DECLARE_int32(memory_pressure_flush_max_tablets);
+
+METRIC_DECLARE_entity(server);
+
+namespace yb {
+namespace tserver {
+
+class FlushPolicyTest : public YBTest {
+ protected:
+  FlushPolicyTest()
+      : metric_entity_(METRIC_ENTITY_server.Instantiate(&metric_registry_, "test.flush_policy")) {
+  }
+
+  void AddCandidate(uint64_t oldest_write, uint64_t memtable_bytes, uint64_t num_writes = 0,
+                    uint64_t pinned_wal_bytes = 0, uint64_t num_immutable_memtables = 0) {
+    TabletFlushCandidate candidate;
+    candidate.tablet_id = Format("tablet-$0", candidates_.size());
+    candidate.oldest_write_in_memstore = HybridTime(oldest_write);
+    candidate.memtable_bytes = memtable_bytes;
+    candidate.num_writes = num_writes;
+    candidate.pinned_wal_bytes = pinned_wal_bytes;
+    candidate.num_immutable_memtables = num_immutable_memtables;
+    candidates_.push_back(candidate);
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  TabletFlushCandidates candidates_;
+};
+
+TEST_F(FlushPolicyTest, OldestWrite) {
+  OldestWriteFlushPolicy policy(metric_entity_);
+  ASSERT_TRUE(policy.TabletsToFlush(candidates_, 0).empty());
+
+  AddCandidate(300, 1000);
+  AddCandidate(100, 10);
+  AddCandidate(HybridTime::kMax.ToUint64(), 0);
+  AddCandidate(200, 5000);
+  ASSERT_EQ(std::vector<size_t>{1}, policy.TabletsToFlush(candidates_, 100000));
+}
+
+TEST_F(FlushPolicyTest, WeightedPicksLargestMemTables) {
+  FLAGS_memory_pressure_flush_max_tablets = 4;
+  WeightedFlushPolicy policy(metric_entity_);
+
+  AddCandidate(100, 10);
+  AddCandidate(200, 4000);
+  AddCandidate(300, 3000);
+  AddCandidate(400, 2000);
+  // Memtable that was just switched, so there is nothing to release.
+  AddCandidate(HybridTime::kMax.ToUint64(), 8000);
+
+  // Forced flush still picks one tablet.
+  ASSERT_EQ(std::vector<size_t>{1}, policy.TabletsToFlush(candidates_, 0));
+  ASSERT_EQ(std::vector<size_t>{1}, policy.TabletsToFlush(candidates_, 4000));
+  ASSERT_EQ((std::vector<size_t>{1, 2}), policy.TabletsToFlush(candidates_, 6000));
+  ASSERT_EQ((std::vector<size_t>{1, 2, 3, 0}), policy.TabletsToFlush(candidates_, 100000));
+
+  FLAGS_memory_pressure_flush_max_tablets = 2;
+  ASSERT_EQ((std::vector<size_t>{1, 2}), policy.TabletsToFlush(candidates_, 100000));
+}
+
+TEST_F(FlushPolicyTest, WeightedWalAndWriteRate) {
+  WeightedFlushPolicy policy(metric_entity_);
+
+  AddCandidate(100, 1000, /* num_writes */ 100);
+  AddCandidate(200, 1000, /* num_writes */ 100, /* pinned_wal_bytes */ 1000000);
+  AddCandidate(300, 1000, /* num_writes */ 100);
+  // The tablet that pins the most WAL goes first. First round does not know write rates yet.
+  ASSERT_EQ(std::vector<size_t>{1}, policy.TabletsToFlush(candidates_, 0));
+
+  candidates_[0].num_writes += 10;
+  candidates_[2].num_writes += 1000;
+  ASSERT_EQ((std::vector<size_t>{1, 2, 0}), policy.TabletsToFlush(candidates_, 3000));
+}
+
+TEST_F(FlushPolicyTest, WeightedPenalizesFlushBacklog) {
+  WeightedFlushPolicy policy(metric_entity_);
+
+  AddCandidate(100, 1000, 0, 0, /* num_immutable_memtables */ 2);
+  AddCandidate(200, 800);
+  ASSERT_EQ(std::vector<size_t>{1}, policy.TabletsToFlush(candidates_, 0));
+}
+
+} // namespace tserver
+} // namespace yb
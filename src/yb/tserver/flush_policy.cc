@@ -0,0 +1,181 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/flush_policy.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/gutil/strings/substitute.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_string(memory_pressure_flush_policy, "weighted",
+              "Policy used to pick the tablets to flush when the global memstore limit is "
+              "exceeded. One of: oldest_write, weighted.");
+TAG_FLAG(memory_pressure_flush_policy, advanced);
+
+DEFINE_int32(memory_pressure_flush_max_tablets, 4,
+             "Maximum number of tablets the weighted flush policy flushes in one round.");
+TAG_FLAG(memory_pressure_flush_max_tablets, advanced);
+TAG_FLAG(memory_pressure_flush_max_tablets, runtime);
+
+DEFINE_double(memory_pressure_flush_memtable_weight, 1.0,
+              "Weight of the memtable size in the weighted flush policy score.");
+TAG_FLAG(memory_pressure_flush_memtable_weight, advanced);
+TAG_FLAG(memory_pressure_flush_memtable_weight, runtime);
+
+DEFINE_double(memory_pressure_flush_wal_weight, 0.5,
+              "Weight of the WAL size retained by unflushed data in the weighted flush policy "
+              "score.");
+TAG_FLAG(memory_pressure_flush_wal_weight, advanced);
+TAG_FLAG(memory_pressure_flush_wal_weight, runtime);
+
+DEFINE_double(memory_pressure_flush_write_rate_weight, 0.25,
+              "Weight of the recent write rate in the weighted flush policy score.");
+TAG_FLAG(memory_pressure_flush_write_rate_weight, advanced);
+TAG_FLAG(memory_pressure_flush_write_rate_weight, runtime);
+
+namespace {
+
+bool ValidateFlushPolicy(const char* flagname, const std::string& value) {
+  if (value == "oldest_write" || value == "weighted") {
+    return true;
+  }
+  LOG(ERROR) << strings::Substitute("Unknown value for $0: $1", flagname, value);
+  return false;
+}
+
+bool dummy = google::RegisterFlagValidator(
+    &FLAGS_memory_pressure_flush_policy, &ValidateFlushPolicy);
+
+} // namespace
+
+namespace yb {
+namespace tserver {
+
+METRIC_DEFINE_histogram(server, memory_pressure_flush_bytes_oldest_write,
+                        "Memory Pressure Flush Bytes (oldest_write)",
+                        MetricUnit::kBytes,
+                        "Memtable bytes released by each flush scheduled by the oldest_write "
+                        "memory pressure flush policy.",
+                        16ULL * 1024 * 1024 * 1024, 2);
+
+METRIC_DEFINE_histogram(server, memory_pressure_flush_bytes_weighted,
+                        "Memory Pressure Flush Bytes (weighted)",
+                        MetricUnit::kBytes,
+                        "Memtable bytes released by each flush scheduled by the weighted "
+                        "memory pressure flush policy.",
+                        16ULL * 1024 * 1024 * 1024, 2);
+
+std::string TabletFlushCandidate::ToString() const {
+  return strings::Substitute(
+      "{ tablet_id: $0 oldest_write_in_memstore: $1 memtable_bytes: $2 num_writes: $3 "
+          "pinned_wal_bytes: $4 num_immutable_memtables: $5 }",
+      tablet_id, oldest_write_in_memstore.ToString(), memtable_bytes, num_writes,
+      pinned_wal_bytes, num_immutable_memtables);
+}
+
+OldestWriteFlushPolicy::OldestWriteFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity)
+    : FlushPolicy(METRIC_memory_pressure_flush_bytes_oldest_write.Instantiate(metric_entity)) {
+}
+
+std::vector<size_t> OldestWriteFlushPolicy::TabletsToFlush(
+    const TabletFlushCandidates& candidates, size_t bytes_to_free) {
+  HybridTime oldest_write_in_memstores = HybridTime::kMax;
+  std::vector<size_t> result;
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    if (candidates[i].oldest_write_in_memstore < oldest_write_in_memstores) {
+      oldest_write_in_memstores = candidates[i].oldest_write_in_memstore;
+      result.assign(1, i);
+    }
+  }
+  return result;
+}
+
+WeightedFlushPolicy::WeightedFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity)
+    : FlushPolicy(METRIC_memory_pressure_flush_bytes_weighted.Instantiate(metric_entity)) {
+}
+
+std::vector<size_t> WeightedFlushPolicy::TabletsToFlush(
+    const TabletFlushCandidates& candidates, size_t bytes_to_free) {
+  std::unordered_map<TabletId, uint64_t> num_writes;
+  std::vector<uint64_t> new_writes(candidates.size());
+  uint64_t max_memtable_bytes = 0;
+  uint64_t max_pinned_wal_bytes = 0;
+  uint64_t max_new_writes = 0;
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    const auto& candidate = candidates[i];
+    num_writes.emplace(candidate.tablet_id, candidate.num_writes);
+    auto it = prev_num_writes_.find(candidate.tablet_id);
+    // Writes made before the first round we see the tablet in are not counted, so a long lived
+    // tablet does not look hot just because it has a large total.
+    if (it != prev_num_writes_.end() && candidate.num_writes > it->second) {
+      new_writes[i] = candidate.num_writes - it->second;
+    }
+    max_memtable_bytes = std::max(max_memtable_bytes, candidate.memtable_bytes);
+    max_pinned_wal_bytes = std::max(max_pinned_wal_bytes, candidate.pinned_wal_bytes);
+    max_new_writes = std::max(max_new_writes, new_writes[i]);
+  }
+  prev_num_writes_ = std::move(num_writes);
+
+  auto normalize = [](uint64_t value, uint64_t max) {
+    return max ? static_cast<double>(value) / max : 0.0;
+  };
+
+  std::vector<std::pair<double, size_t>> scores;
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    const auto& candidate = candidates[i];
+    // Nothing was written since the last flush, an empty memtable still reports its arena size.
+    if (candidate.oldest_write_in_memstore == HybridTime::kMax) {
+      continue;
+    }
+    double score =
+        FLAGS_memory_pressure_flush_memtable_weight *
+            normalize(candidate.memtable_bytes, max_memtable_bytes) +
+        FLAGS_memory_pressure_flush_wal_weight *
+            normalize(candidate.pinned_wal_bytes, max_pinned_wal_bytes) +
+        FLAGS_memory_pressure_flush_write_rate_weight *
+            normalize(new_writes[i], max_new_writes);
+    score /= 1 + candidate.num_immutable_memtables;
+    scores.emplace_back(score, i);
+  }
+  std::stable_sort(scores.begin(), scores.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  const size_t max_tablets = std::max(FLAGS_memory_pressure_flush_max_tablets, 1);
+  std::vector<size_t> result;
+  size_t bytes_to_release = 0;
+  for (const auto& score : scores) {
+    if (result.size() >= max_tablets ||
+        (!result.empty() && bytes_to_release >= bytes_to_free)) {
+      break;
+    }
+    result.push_back(score.second);
+    bytes_to_release += candidates[score.second].memtable_bytes;
+  }
+  return result;
+}
+
+std::unique_ptr<FlushPolicy> CreateFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity) {
+  if (FLAGS_memory_pressure_flush_policy == "oldest_write") {
+    return std::make_unique<OldestWriteFlushPolicy>(metric_entity);
+  }
+  return std::make_unique<WeightedFlushPolicy>(metric_entity);
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,114 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_FLUSH_POLICY_H
+#define YB_TSERVER_FLUSH_POLICY_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/hybrid_time.h"
+#include "yb/gutil/ref_counted.h"
+#include "yb/tablet/tablet_fwd.h"
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace tserver {
+
+// Snapshot of the memory related state of a tablet, used to decide what to flush when the global
+// memstore limit is exceeded.
+struct TabletFlushCandidate {
+  tablet::TabletPeerPtr peer;
+  TabletId tablet_id;
+  // Hybrid time of the oldest write that is still in the active memtable.
+  HybridTime oldest_write_in_memstore = HybridTime::kMax;
+  // Bytes in the active memtables, i.e. what a flush scheduled now would release.
+  uint64_t memtable_bytes = 0;
+  // Total number of write batches written to the tablet so far.
+  uint64_t num_writes = 0;
+  // WAL bytes that cannot be garbage collected yet.
+  uint64_t pinned_wal_bytes = 0;
+  // Memtables that are already waiting to be flushed or being flushed.
+  uint64_t num_immutable_memtables = 0;
+
+  std::string ToString() const;
+};
+
+typedef std::vector<TabletFlushCandidate> TabletFlushCandidates;
+
+// Decides which tablets should be flushed to relieve memory pressure.
+class FlushPolicy {
+ public:
+  virtual ~FlushPolicy() {}
+
+  virtual const char* name() const = 0;
+
+  // Returns indexes into candidates of the tablets that should be flushed, in flush order.
+  // bytes_to_free is how far the memstore usage is above the limit, it could be 0 when a flush
+  // is forced.
+  virtual std::vector<size_t> TabletsToFlush(
+      const TabletFlushCandidates& candidates, size_t bytes_to_free) = 0;
+
+  // Called for every flush scheduled on behalf of this policy.
+  void FlushScheduled(const TabletFlushCandidate& candidate) {
+    bytes_per_flush_->Increment(candidate.memtable_bytes);
+  }
+
+ protected:
+  explicit FlushPolicy(scoped_refptr<Histogram> bytes_per_flush)
+      : bytes_per_flush_(std::move(bytes_per_flush)) {}
+
+ private:
+  scoped_refptr<Histogram> bytes_per_flush_;
+};
+
+// Flushes the single tablet with the oldest write in its memstore.
+class OldestWriteFlushPolicy : public FlushPolicy {
+ public:
+  explicit OldestWriteFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity);
+
+  const char* name() const override { return "oldest_write"; }
+
+  std::vector<size_t> TabletsToFlush(
+      const TabletFlushCandidates& candidates, size_t bytes_to_free) override;
+};
+
+// Scores tablets by memtable size, pinned WAL size and recent write rate, each normalized by the
+// largest value among the candidates. Tablets whose previous flushes are still pending are
+// penalized, since another flush would not release memory any sooner. Picks the best scored
+// tablets until the expected released memory covers bytes_to_free.
+class WeightedFlushPolicy : public FlushPolicy {
+ public:
+  explicit WeightedFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity);
+
+  const char* name() const override { return "weighted"; }
+
+  std::vector<size_t> TabletsToFlush(
+      const TabletFlushCandidates& candidates, size_t bytes_to_free) override;
+
+ private:
+  // Number of writes observed for each tablet at the previous round, used to compute write rates.
+  std::unordered_map<TabletId, uint64_t> prev_num_writes_;
+};
+
+// Creates the policy selected by --memory_pressure_flush_policy.
+std::unique_ptr<FlushPolicy> CreateFlushPolicy(const scoped_refptr<MetricEntity>& metric_entity);
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_FLUSH_POLICY_H
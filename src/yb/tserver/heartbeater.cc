@@ -48,6 +48,7 @@
 #include "yb/server/server_base.proxy.h"
 #include "yb/server/webserver.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tablet_server_options.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -57,6 +58,7 @@
 #include "yb/util/status.h"
 #include "yb/util/thread.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 
 using namespace std::literals;
 
@@ -123,6 +125,18 @@ class Heartbeater::Thread {
   CHECKED_STATUS TryHeartbeat();
   CHECKED_STATUS SetupRegistration(master::TSRegistrationPB* reg);
   void SetupCommonField(master::TSToMasterCommonPB* common);
+  struct TabletOps {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t sst_file_size = 0;
+  };
+  typedef std::unordered_map<TabletId, TabletOps> TabletOpsMap;
+
+  // Records the operation counts and size of the tablet and, if it served any operations or its
+  // size changed since the previous submission, adds its load to metrics.
+  void AddTabletLoad(tablet::TabletClass* tablet, uint64_t sst_file_size,
+                     const TabletOpsMap& prev_tablet_ops, double interval_sec,
+                     master::TServerMetricsPB* metrics);
   bool IsCurrentThread() const;
   uint64_t CalculateUptime();
 
@@ -190,6 +204,10 @@ class Heartbeater::Thread {
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  // Total read and write ops of each tablet at the previous metrics submission, for computing
+  // per-tablet iops.
+  TabletOpsMap prev_tablet_ops_;
+
   MonoTime start_time_;
 
   rpc::Rpcs rpcs_;
@@ -305,6 +323,49 @@ Status Heartbeater::Thread::ConnectToMaster() {
   return Status::OK();
 }
 
+void Heartbeater::Thread::AddTabletLoad(
+    tablet::TabletClass* tablet, uint64_t sst_file_size, const TabletOpsMap& prev_tablet_ops,
+    double interval_sec, master::TServerMetricsPB* metrics) {
+  const tablet::TabletMetrics* tablet_metrics = tablet->metrics();
+  if (tablet_metrics == nullptr) {
+    return;
+  }
+  TabletOps ops;
+  ops.reads = tablet_metrics->ql_read_latency->TotalCount() +
+              tablet_metrics->redis_read_latency->TotalCount();
+  ops.writes = tablet_metrics->write_op_duration_client_propagated_consistency->TotalCount();
+  // Tablet created by a split shares the files of its parent until they are compacted, so its
+  // own size is not known yet.
+  const bool size_known = tablet->metadata()->split_parent_tablet_id().empty();
+  ops.sst_file_size = size_known ? sst_file_size : 0;
+  prev_tablet_ops_[tablet->tablet_id()] = ops;
+
+  auto it = prev_tablet_ops.find(tablet->tablet_id());
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  if (it != prev_tablet_ops.end() && interval_sec > 0) {
+    // Counters restart from zero when the tablet is reopened.
+    reads = ops.reads >= it->second.reads ? ops.reads - it->second.reads : ops.reads;
+    writes = ops.writes >= it->second.writes ? ops.writes - it->second.writes : ops.writes;
+  }
+  // Idle tablets are reported when their size changes, e.g. after a flush, so the master knows
+  // the size of every tablet and not only of the ones being written.
+  const uint64_t prev_sst_file_size = it != prev_tablet_ops.end() ? it->second.sst_file_size : 0;
+  const bool size_changed = size_known && ops.sst_file_size != prev_sst_file_size;
+  if (reads == 0 && writes == 0 && !size_changed) {
+    return;
+  }
+  auto* load = metrics->add_tablet_loads();
+  load->set_tablet_id(tablet->tablet_id());
+  if (reads != 0 || writes != 0) {
+    load->set_read_ops_per_sec(reads / interval_sec);
+    load->set_write_ops_per_sec(writes / interval_sec);
+  }
+  if (size_known) {
+    load->set_sst_file_size(ops.sst_file_size);
+  }
+}
+
 void Heartbeater::Thread::SetupCommonField(master::TSToMasterCommonPB* common) {
   common->mutable_ts_instance()->CopyFrom(server_->instance_pb());
 }
@@ -387,17 +448,28 @@ Status Heartbeater::Thread::TryHeartbeat() {
     }
 #endif
 
+    MonoDelta diff = MonoTime::Now() - prev_tserver_metrics_submission_;
+    double_t div = diff.ToSeconds();
+
     // Get the Total SST file sizes and set it in the proto buf
     std::vector<shared_ptr<yb::tablet::TabletPeer> > tablet_peers;
     uint64_t total_file_sizes = 0;
     uint64_t uncompressed_file_sizes = 0;
     server_->tablet_manager()->GetTabletPeers(&tablet_peers);
+    // Only tablets that are still hosted are carried over to the next submission.
+    TabletOpsMap prev_tablet_ops;
+    prev_tablet_ops.swap(prev_tablet_ops_);
     for (auto it = tablet_peers.begin(); it != tablet_peers.end(); it++) {
       shared_ptr<yb::tablet::TabletPeer> tablet_peer = *it;
       if (tablet_peer) {
         shared_ptr<yb::tablet::TabletClass> tablet_class = tablet_peer->shared_tablet();
-        total_file_sizes += (tablet_class) ? tablet_class->GetTotalSSTFileSizes() : 0;
+        const uint64_t file_sizes = (tablet_class) ? tablet_class->GetTotalSSTFileSizes() : 0;
+        total_file_sizes += file_sizes;
         uncompressed_file_sizes += (tablet_class) ? tablet_class->GetUncompressedSSTFileSizes() : 0;
+        if (tablet_class) {
+          AddTabletLoad(tablet_class.get(), file_sizes, prev_tablet_ops, div,
+                        req.mutable_metrics());
+        }
       }
     }
     req.mutable_metrics()->set_total_sst_file_size(total_file_sizes);
@@ -413,9 +485,6 @@ Status Heartbeater::Thread::TryHeartbeat() {
     uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
     // Calculate the read and write ops per second.
-    MonoDelta diff = MonoTime::Now() - prev_tserver_metrics_submission_;
-    double_t div = diff.ToSeconds();
-
     double rops_per_sec = (div > 0 && num_reads > 0) ?
         (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -487,6 +556,13 @@ Status Heartbeater::Thread::TryHeartbeat() {
   // TODO: Handle TSHeartbeatResponsePB (e.g. deleted tablets and schema changes)
   server_->tablet_manager()->MarkTabletReportAcknowledged(req.tablet_report());
 
+  // Send the tablets that did not fit into this report without waiting for the heartbeat interval.
+  if (req.tablet_report().remaining_tablet_count() > 0) {
+    VLOG_WITH_PREFIX(1) << req.tablet_report().remaining_tablet_count()
+                        << " tablets remain to be reported";
+    TriggerASAP();
+  }
+
   // Update the live tserver list.
   return server_->PopulateLiveTServers(resp);
 }
@@ -32,6 +32,11 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <deque>
+#include <unordered_set>
+
+#include <boost/optional.hpp>
+#include <boost/scope_exit.hpp>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -42,6 +47,7 @@
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
+#include "yb/gutil/stringprintf.h"
 #include "yb/gutil/walltime.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
@@ -54,6 +60,7 @@
 #include "yb/tserver/remote_bootstrap.proxy.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
@@ -62,6 +69,7 @@
 #include "yb/util/net/net_util.h"
 #include "yb/util/net/rate_limiter.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -113,6 +121,17 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Maximum number of RocksDB files downloaded concurrently by a remote bootstrap "
+             "session.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunks_in_flight, 4,
+             "Maximum number of chunks of a single file requested from the remote bootstrap "
+             "source at the same time. If 1, the next chunk is only requested after the "
+             "previous one was received.");
+TAG_FLAG(remote_bootstrap_max_chunks_in_flight, advanced);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -140,6 +159,18 @@ using tablet::TabletSuperBlockPB;
 constexpr int kBytesReservedForMessageHeaders = 16384;
 std::atomic<int32_t> RemoteBootstrapClient::n_started_(0);
 
+namespace {
+
+// A FetchData call that was sent asynchronously.
+struct AsyncFetch {
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  CountDownLatch latch{1};
+};
+
+} // namespace
+
 RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id,
                                              FsManager* fs_manager,
                                              string client_permanent_uuid)
@@ -259,6 +290,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 
   session_idle_timeout_millis_ = resp.session_idle_timeout_millis();
   superblock_.reset(resp.release_superblock());
+  for (const auto& file_pb : superblock_->rocksdb_files()) {
+    total_bytes_ += file_pb.size_bytes();
+  }
 
   // Clear fields rocksdb_dir and wal_dir so we get an error if we try to use them without setting
   // them to the right path.
@@ -391,6 +425,7 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   status_listener_ = CHECK_NOTNULL(status_listener);
 
   VLOG_WITH_PREFIX(2) << "Fetching table_type: " << TableType_Name(meta_->table_type());
+  download_start_ = MonoTime::Now();
   RETURN_NOT_OK(DownloadRocksDBFiles());
   RETURN_NOT_OK(DownloadWALs());
 
@@ -572,6 +607,7 @@ Status RemoteBootstrapClient::DownloadWALs() {
     RETURN_NOT_OK(DownloadWAL(seg_seqno));
     ++counter;
   }
+  UpdateStatusMessage("Downloaded WAL segments. " + ProgressString());
 
   if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
     // Persist directory so that recently downloaded files are accessible.
@@ -589,16 +625,24 @@ Status RemoteBootstrapClient::DownloadFile(
   RETURN_NOT_OK(fs_manager_->env()->CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_file = it->second;
+      }
+    }
+    if (!linked_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = fs_manager_->env()->LinkFile(it->second, file_path);
+                          << " => " << linked_file;
+      auto link_status = fs_manager_->env()->LinkFile(linked_file, file_path);
       if (link_status.ok()) {
+        total_bytes_ -= file_pb.size_bytes();
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_file
                              << ": " << link_status;
     }
   }
@@ -615,12 +659,73 @@ Status RemoteBootstrapClient::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::DownloadRocksDBFile(
+    const tablet::FilePB& file_pb, const std::string& dir) {
+  DataIdPB data_id;
+  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(DownloadFile(file_pb, dir, &data_id));
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  LOG_WITH_PREFIX(INFO) << "Downloaded file " << file_pb.name() << " of size "
+                        << file_pb.size_bytes() << " in " << elapsed.ToSeconds() << " seconds";
+  UpdateStatusMessage(Substitute("Downloaded file $0. $1", file_pb.name(), ProgressString()));
+  return Status::OK();
+}
+
+Status RemoteBootstrapClient::DownloadRocksDBFiles(
+    const std::vector<const tablet::FilePB*>& files, const std::string& dir) {
+  const int num_threads = std::min<int>(FLAGS_remote_bootstrap_max_concurrent_files, files.size());
+  if (num_threads <= 1) {
+    for (const auto* file_pb : files) {
+      RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, dir));
+    }
+    return Status::OK();
+  }
+
+  std::unique_ptr<ThreadPool> pool;
+  RETURN_NOT_OK(ThreadPoolBuilder("rb-download").set_max_threads(num_threads).Build(&pool));
+
+  // Each task keeps picking the next file to download until all files are downloaded or one of
+  // the downloads fails.
+  std::mutex mutex;
+  size_t next_file = 0;
+  Status result;
+  auto download_files = [this, &files, &dir, &mutex, &next_file, &result]() {
+    for (;;) {
+      const tablet::FilePB* file_pb;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!result.ok() || next_file == files.size()) {
+          return;
+        }
+        file_pb = files[next_file++];
+      }
+      auto status = DownloadRocksDBFile(*file_pb, dir);
+      if (!status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result.ok()) {
+          result = status;
+        }
+        return;
+      }
+    }
+  };
+  Status submit_status;
+  for (int i = 0; i < num_threads && submit_status.ok(); ++i) {
+    submit_status = pool->SubmitFunc(download_files);
+  }
+  pool->Wait();
+  RETURN_NOT_OK(submit_status);
+  return result;
+}
+
 Status RemoteBootstrapClient::CreateTabletDirectories(const string& db_dir, FsManager* fs) {
   // Create the directory table-uuid first.
   RETURN_NOT_OK_PREPEND(fs->CreateDirIfMissing(DirName(db_dir)),
@@ -642,14 +747,21 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_sb->rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG(INFO) << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-              << " in " << elapsed.ToSeconds() << " seconds";
+  // Files sharing an inode on the source are hard links to each other. Download only the first of
+  // them, and link the others once it is downloaded.
+  std::vector<const tablet::FilePB*> files_to_download;
+  std::vector<const tablet::FilePB*> files_to_link;
+  std::unordered_set<uint64_t> inodes;
+  for (const auto& file_pb : new_sb->rocksdb_files()) {
+    if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+      files_to_link.push_back(&file_pb);
+    } else {
+      files_to_download.push_back(&file_pb);
+    }
+  }
+  RETURN_NOT_OK(DownloadRocksDBFiles(files_to_download, rocksdb_dir));
+  for (const auto* file_pb : files_to_link) {
+    RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, rocksdb_dir));
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -727,15 +839,25 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
   int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
                                 FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
 
+  active_downloads_.fetch_add(1, std::memory_order_acq_rel);
+  BOOST_SCOPE_EXIT_TPL(this_) {
+    this_->active_downloads_.fetch_sub(1, std::memory_order_acq_rel);
+  } BOOST_SCOPE_EXIT_END;
+
   std::unique_ptr<RateLimiter> rate_limiter;
 
   if (FLAGS_remote_boostrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
+    // The limit is shared by all the sessions, and by all the files downloaded concurrently by
+    // this session.
+    auto rate_updater = [this]() {
       if (n_started_.load(std::memory_order_acquire) < 1) {
         YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: " << n_started_;
         return static_cast<uint64_t>(FLAGS_remote_boostrap_rate_limit_bytes_per_sec);
       }
-      return static_cast<uint64_t>(FLAGS_remote_boostrap_rate_limit_bytes_per_sec / n_started_);
+      const int64_t active_downloads =
+          std::max(active_downloads_.load(std::memory_order_acquire), 1);
+      return static_cast<uint64_t>(
+          FLAGS_remote_boostrap_rate_limit_bytes_per_sec / n_started_ / active_downloads);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -743,17 +865,37 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
     // Inactive RateLimiter.
     rate_limiter = std::make_unique<RateLimiter>();
   }
-
-  rpc::RpcController controller;
-  controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
-  FetchDataRequestPB req;
-
+  rate_limiter->Init();
+
+  // Chunks are requested ahead of the one being written, so that the transfer is not stalled by
+  // the round trip to the source for every chunk. Until the first chunk is received the total
+  // length is not known, so only a single request is sent.
+  const size_t max_chunks_in_flight = std::max(FLAGS_remote_bootstrap_max_chunks_in_flight, 1);
+  std::deque<std::unique_ptr<AsyncFetch>> fetches;
+  // The callbacks reference the pending fetches, so wait for them before leaving.
+  BOOST_SCOPE_EXIT_TPL(&fetches) {
+    for (const auto& fetch : fetches) {
+      fetch->latch.Wait();
+    }
+  } BOOST_SCOPE_EXIT_END;
+
+  auto send_fetch = [this, &data_id](uint64_t fetch_offset, int32_t length) {
+    auto fetch = std::make_unique<AsyncFetch>();
+    fetch->controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
+    fetch->req.set_session_id(session_id_);
+    fetch->req.mutable_data_id()->CopyFrom(data_id);
+    fetch->req.set_offset(fetch_offset);
+    fetch->req.set_max_length(length);
+    auto* latch = &fetch->latch;
+    proxy_->FetchDataAsync(
+        fetch->req, &fetch->resp, &fetch->controller, [latch]() { latch->CountDown(); });
+    return fetch;
+  };
+
+  boost::optional<uint64_t> total_data_length;
+  uint64_t next_fetch_offset = 0;
   bool done = false;
   while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
     if (rate_limiter->active()) {
       auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
       if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
@@ -761,30 +903,52 @@ Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
       }
       max_length = std::min(max_length, decltype(max_length)(max_size));
     }
-    req.set_max_length(max_length);
+    if (fetches.empty()) {
+      fetches.push_back(send_fetch(next_fetch_offset, max_length));
+      next_fetch_offset += max_length;
+    }
+    while (total_data_length && fetches.size() < max_chunks_in_flight &&
+           next_fetch_offset < *total_data_length) {
+      fetches.push_back(send_fetch(next_fetch_offset, max_length));
+      next_fetch_offset += max_length;
+    }
 
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    auto& fetch = *fetches.front();
+    fetch.latch.Wait();
+    RETURN_NOT_OK_UNWIND_PREPEND(
+        fetch.controller.status(), fetch.controller, "Unable to fetch data from remote");
+    const auto& chunk = fetch.resp.chunk();
+    const size_t chunk_size = chunk.data().size();
+    DCHECK_LE(chunk_size, fetch.req.max_length());
 
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, chunk),
                           Substitute("Error validating data item $0", data_id.ShortDebugString()));
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
-    VLOG(3) << "resp size: " << resp.ByteSize()
-            << ", chunk size: " << resp.chunk().data().size();
-
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
+    VLOG(3) << "resp size: " << fetch.resp.ByteSize() << ", chunk size: " << chunk_size;
+    rate_limiter->UpdateDataSizeAndMaybeSleep(fetch.resp.ByteSize());
+
+    if (!total_data_length) {
+      total_data_length = chunk.total_data_length();
+      if (data_id.type() == DataIdPB::LOG_SEGMENT) {
+        total_bytes_ += *total_data_length;
+      }
+    }
+    offset += chunk_size;
+    downloaded_bytes_ += chunk_size;
+    done = offset == *total_data_length;
+    const uint64_t fetch_end = fetch.req.offset() + fetch.req.max_length();
+    fetches.pop_front();
+    // The source may return less than requested, e.g. when it is rate limited. Request the rest
+    // of the range before consuming the chunks that follow it.
+    if (!done && offset < fetch_end) {
+      fetches.push_front(send_fetch(offset, fetch_end - offset));
     }
-    offset += resp.chunk().data().size();
+
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += chunk_size;
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
@@ -814,6 +978,29 @@ Status RemoteBootstrapClient::VerifyData(uint64_t offset, const DataChunkPB& chu
   return Status::OK();
 }
 
+double RemoteBootstrapClient::bytes_per_sec() const {
+  if (!download_start_.Initialized()) {
+    return 0;
+  }
+  const double elapsed_sec = MonoTime::Now().GetDeltaSince(download_start_).ToSeconds();
+  return elapsed_sec > 0 ? bytes_downloaded() / elapsed_sec : 0;
+}
+
+std::string RemoteBootstrapClient::ProgressString() const {
+  const uint64_t downloaded = bytes_downloaded();
+  // Sizes of WAL segments are only known once their download starts.
+  const uint64_t total = std::max<uint64_t>(total_bytes_.load(std::memory_order_acquire),
+                                            downloaded);
+  const double rate = bytes_per_sec();
+  std::string result = StringPrintf("Downloaded %.1f of %.1f MB at %.1f MB/s",
+                                    static_cast<double>(downloaded) / 1_MB,
+                                    static_cast<double>(total) / 1_MB, rate / 1_MB);
+  if (rate > 0) {
+    StringAppendF(&result, ", ETA %.0f s", (total - downloaded) / rate);
+  }
+  return result;
+}
+
 string RemoteBootstrapClient::LogPrefix() {
   return Substitute("T $0 P $1: Remote bootstrap client: ", tablet_id_, permanent_uuid_);
 }
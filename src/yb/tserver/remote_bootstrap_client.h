@@ -35,6 +35,7 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -46,6 +47,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/tserver/remote_bootstrap.pb.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -62,6 +64,7 @@ class RaftPeerPB;
 } // namespace consensus
 
 namespace tablet {
+class FilePB;
 class TabletMetadata;
 class TabletPeer;
 class TabletStatusListener;
@@ -77,8 +80,13 @@ class TSTabletManager;
 // Client class for using remote bootstrap to copy a tablet from another host.
 // This class is not thread-safe.
 //
+// RocksDB files are downloaded concurrently (see remote_bootstrap_max_concurrent_files), and
+// several chunks of each file are requested ahead of the one being written (see
+// remote_bootstrap_max_chunks_in_flight). WAL segments are downloaded one at a time, after the
+// RocksDB files.
+//
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Parallelize download of WAL segments.
 //
 class RemoteBootstrapClient {
  public:
@@ -131,9 +139,22 @@ class RemoteBootstrapClient {
   CHECKED_STATUS VerifyChangeRoleSucceeded(
       const std::shared_ptr<consensus::Consensus>& shared_consensus);
 
+  // Number of bytes of data downloaded so far by this session.
+  uint64_t bytes_downloaded() const {
+    return downloaded_bytes_.load(std::memory_order_acquire);
+  }
+
+  // Average download rate of this session since FetchAll() was called.
+  double bytes_per_sec() const;
+
+  // Human-readable progress of the session: downloaded and total size, rate and ETA.
+  std::string ProgressString() const;
+
  protected:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesSequentially);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesInSmallChunks);
 
   // Extract the embedded Status message from the given ErrorStatusPB.
   // The given ErrorStatusPB must extend RemoteBootstrapErrorPB.
@@ -175,6 +196,13 @@ class RemoteBootstrapClient {
 
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Download the given RocksDB files into dir, up to remote_bootstrap_max_concurrent_files at a
+  // time.
+  CHECKED_STATUS DownloadRocksDBFiles(
+      const std::vector<const tablet::FilePB*>& files, const std::string& dir);
+
+  CHECKED_STATUS DownloadRocksDBFile(const tablet::FilePB& file_pb, const std::string& dir);
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
   CHECKED_STATUS DownloadFile(
@@ -218,12 +246,21 @@ class RemoteBootstrapClient {
 
   int64_t start_time_micros_;
 
+  // Download progress, updated concurrently by the RocksDB file downloads.
+  MonoTime download_start_;
+  std::atomic<uint64_t> downloaded_bytes_{0};
+  std::atomic<uint64_t> total_bytes_{0};
+
+  // Number of files being downloaded right now. The rate limit is split between them.
+  std::atomic<int> active_downloads_{0};
+
   // We track whether this session succeeded and send this information as part of the
   // EndRemoteBootstrapSessionRequestPB request.
   bool succeeded_;
 
  private:
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  std::mutex inode2file_mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_;  // Protected by inode2file_mutex_.
 
   DISALLOW_COPY_AND_ASSIGN(RemoteBootstrapClient);
 };
@@ -15,6 +15,9 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_chunks_in_flight);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
 
 using std::shared_ptr;
 
@@ -33,19 +36,13 @@ class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
   void SetUp() override {
     RemoteBootstrapClientTest::SetUp();
   }
-};
 
-// Basic begin / end remote bootstrap session.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->FetchAll(&listener));
-  ASSERT_OK(client_->Finish());
-}
+ protected:
+  // Verify that the client has the same files that the leader has.
+  void CheckDownloadedRocksDBFiles();
+};
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->DownloadRocksDBFiles());
+void RemoteBootstrapRocksDBClientTest::CheckDownloadedRocksDBFiles() {
   auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
 
   vector<std::string> rocksdb_files;
@@ -58,7 +55,6 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
   std::sort(rocksdb_files.begin(), rocksdb_files.end());
   std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-  // Verify that the client has the same files that the leader has.
   for (int i = 0; i < rocksdb_files.size(); ++i) {
     auto local_rocksdb_file = rocksdb_files[i];
     auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
@@ -78,5 +74,37 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic begin / end remote bootstrap session.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_OK(client_->Finish());
+}
+
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+}
+
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesSequentially) {
+  FLAGS_remote_bootstrap_max_concurrent_files = 1;
+  FLAGS_remote_bootstrap_max_chunks_in_flight = 1;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+}
+
+// Small chunks make every file span many pipelined chunk requests.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesInSmallChunks) {
+  FLAGS_remote_bootstrap_max_chunk_size = 1024;
+  FLAGS_remote_bootstrap_max_chunks_in_flight = 8;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_NO_FATALS(CheckDownloadedRocksDBFiles());
+  ASSERT_GT(client_->bytes_downloaded(), 0);
+}
+
 } // namespace tserver
 } // namespace yb
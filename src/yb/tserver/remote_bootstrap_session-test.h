@@ -163,8 +163,11 @@ class RemoteBootstrapTest : public YBTabletTest {
                                           log,
                                           metric_entity,
                                           raft_pool_.get(),
+                                          nullptr /* log_prefetch_pool */,
                                           tablet_prepare_pool_.get(),
-                                          nullptr /* retryable_requests */));
+                                          nullptr /* apply_pool */,
+                                          nullptr /* retryable_requests */,
+                                          nullptr /* multi_raft_manager */));
     consensus::ConsensusBootstrapInfo boot_info;
     ASSERT_OK(tablet_peer_->Start(boot_info));
 
@@ -13,6 +13,8 @@
 
 #include "yb/tserver/service_util.h"
 
+#include <gflags/gflags.h>
+
 #include "yb/consensus/consensus.h"
 
 #include "yb/tablet/tablet.h"
@@ -48,6 +50,13 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
   std::shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   auto leader_state = consensus->GetLeaderState();
+  if (leader_state.status == consensus::LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE &&
+      consensus->WakeUpIfQuiescent()) {
+    // The lease of a quiescent leader is usually restored by the first round of heartbeats, so
+    // the client retries on this server instead of looking up the leader again.
+    return STATUS(LeaderNotReadyToServe, "Leader was quiescent, waiting for a new lease")
+        .CloneAndChangeErrorCode(TabletServerErrorPB::LEADER_NOT_READY_TO_SERVE);
+  }
 
   VLOG(1) << Format(
       "Check for tablet $0 peer $1. Peer role is $2. Leader status is $3.",
@@ -45,6 +45,7 @@ class NodeInstancePB;
 class ServerRegistrationPB;
 
 namespace consensus {
+class MultiRaftManager;
 class StartRemoteBootstrapRequestPB;
 } // namespace consensus
 
@@ -72,6 +73,9 @@ class TabletPeerLookupIf {
 
   virtual CHECKED_STATUS StartRemoteBootstrap(
       const consensus::StartRemoteBootstrapRequestPB& req) = 0;
+
+  // Returns the manager of heartbeat batches and keep-alives between servers, if any.
+  virtual consensus::MultiRaftManager* multi_raft_manager() const = 0;
 };
 
 } // namespace tserver
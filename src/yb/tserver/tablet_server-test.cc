@@ -30,7 +30,9 @@
 // under the License.
 //
 
+#include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/log-test-base.h"
+#include "yb/consensus/opid_util.h"
 
 #include "yb/gutil/strings/escaping.h"
 #include "yb/gutil/strings/substitute.h"
@@ -117,6 +119,36 @@ TEST_F(TabletServerTest, TestServerClock) {
   ASSERT_GT(mini_server_->server()->clock()->Now().ToUint64(), resp.hybrid_time());
 }
 
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensus) {
+  const auto local_uuid = mini_server_->server()->fs_manager()->uuid();
+  consensus::MultiRaftConsensusRequestPB req;
+  auto add_request = [&req](const string& tablet_id, const string& dest_uuid) {
+    auto* request = req.add_consensus_request();
+    request->set_dest_uuid(dest_uuid);
+    request->set_tablet_id(tablet_id);
+    request->set_caller_uuid("stale-leader");
+    request->set_caller_term(0);
+    *request->mutable_committed_index() = consensus::MinimumOpId();
+  };
+  add_request(kTabletId, local_uuid);
+  add_request("missing-tablet", local_uuid);
+  add_request(kTabletId, "other-server");
+
+  consensus::MultiRaftConsensusResponsePB resp;
+  RpcController controller;
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &controller));
+  ASSERT_EQ(3, resp.consensus_response_size());
+
+  // Stale term is rejected by the replica, as for UpdateConsensus.
+  ASSERT_FALSE(resp.consensus_response(0).has_error());
+  ASSERT_EQ(consensus::ConsensusErrorPB::INVALID_TERM,
+            resp.consensus_response(0).status().error().code());
+
+  // Errors of other updates don't fail the batch.
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, resp.consensus_response(1).error().code());
+  ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, resp.consensus_response(2).error().code());
+}
+
 TEST_F(TabletServerTest, TestSetFlagsAndCheckWebPages) {
   server::GenericServiceProxy proxy(
       proxy_cache_.get(), HostPort::FromBoundEndpoint(mini_server_->bound_rpc_addr()));
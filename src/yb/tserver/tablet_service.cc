@@ -43,6 +43,7 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/leader_lease.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
@@ -62,6 +63,7 @@
 #include "yb/tablet/tablet_metrics.h"
 
 #include "yb/tablet/operations/change_metadata_operation.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/operations/truncate_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/operations/write_operation.h"
@@ -214,6 +216,19 @@ Status GetTabletRef(const TabletPeerPtr& tablet_peer,
   return Status::OK();
 }
 
+// A split tablet does not serve reads and writes, the client should look up the tablets that
+// replaced it.
+template <class Resp>
+bool CheckNotSplitOrRespond(const TabletPeer& tablet_peer, Resp* resp, rpc::RpcContext* context) {
+  if (PREDICT_TRUE(!tablet_peer.tablet_metadata()->IsSplit())) {
+    return true;
+  }
+  SetupErrorAndRespond(resp->mutable_error(),
+                       STATUS_FORMAT(IllegalState, "Tablet $0 was split", tablet_peer.tablet_id()),
+                       TabletServerErrorPB::TABLET_SPLIT, context);
+  return false;
+}
+
 } // namespace
 
 template<class Resp>
@@ -686,6 +701,91 @@ void TabletServiceAdminImpl::FlushTablets(const FlushTabletsRequestPB* req,
   context.RespondSuccess();
 }
 
+namespace {
+
+Status CheckCanSplit(const tablet::TabletMetadata& meta, const SplitTabletRequestPB& req) {
+  if (meta.schema().table_properties().is_transactional()) {
+    // The provisional records and running transactions are not moved to the new tablets.
+    return STATUS_FORMAT(
+        NotSupported, "Transactional tables could not be split, tablet $0 belongs to table $1",
+        meta.tablet_id(), meta.table_name());
+  }
+  if (meta.table_type() != TableType::YQL_TABLE_TYPE ||
+      !meta.partition_schema().IsHashPartitioning()) {
+    return STATUS_FORMAT(
+        NotSupported, "Only hash partitioned YCQL tables could be split, "
+        "tablet $0 belongs to table $1", meta.tablet_id(), meta.table_name());
+  }
+  if (!meta.split_parent_tablet_id().empty()) {
+    return STATUS_FORMAT(
+        IllegalState, "Tablet $0 still contains the data of its split sibling", meta.tablet_id());
+  }
+  if (req.new_tablet1_id().empty() || req.new_tablet2_id().empty() ||
+      req.new_tablet1_id() == req.new_tablet2_id()) {
+    return STATUS(InvalidArgument, "Two different new tablet ids are required");
+  }
+  const auto& partition = meta.partition();
+  const auto& split_key = req.split_partition_key();
+  if (split_key <= partition.partition_key_start() ||
+      (!partition.partition_key_end().empty() && split_key >= partition.partition_key_end())) {
+    return STATUS_FORMAT(
+        InvalidArgument, "Split partition key $0 is not inside the partition of tablet $1",
+        Slice(split_key).ToDebugHexString(), meta.tablet_id());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+void TabletServiceAdminImpl::SplitTablet(const SplitTabletRequestPB* req,
+                                         SplitTabletResponsePB* resp,
+                                         rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "SplitTablet", req, resp, &context)) {
+    return;
+  }
+  TRACE_EVENT1("tserver", "SplitTablet", "tablet_id", req->tablet_id());
+  LOG(INFO) << "Processing SplitTablet from " << context.requestor_string() << ": "
+            << req->ShortDebugString();
+
+  server::UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  const auto& meta = tablet.peer->tablet_metadata();
+  // The master resends the request until it gets a response. Tablets that could not be created
+  // when the split was applied are created now.
+  if (meta->IsSplit()) {
+    tablet::SplitOperationState state(tablet.peer->tablet(), req);
+    Status s = server_->tablet_manager()->ApplyTabletSplit(&state);
+    if (!s.ok()) {
+      SetupErrorAndRespond(resp->mutable_error(), s, TabletServerErrorPB::TABLET_SPLIT, &context);
+      return;
+    }
+    context.RespondSuccess();
+    return;
+  }
+
+  Status s = CheckCanSplit(*meta, *req);
+  if (!s.ok()) {
+    SetupErrorAndRespond(resp->mutable_error(), s, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  auto operation_state = std::make_unique<tablet::SplitOperationState>(
+      tablet.peer->tablet(), req);
+
+  operation_state->set_completion_callback(
+      MakeRpcOperationCompletionCallback(std::move(context), resp, server_->Clock()));
+
+  // Submit the split tablet op. The RPC will be responded to asynchronously.
+  tablet.peer->Submit(
+      std::make_unique<tablet::SplitOperation>(std::move(operation_state)), tablet.leader_term);
+}
+
 void TabletServiceImpl::Write(const WriteRequestPB* req,
                               WriteResponsePB* resp,
                               rpc::RpcContext context) {
@@ -704,7 +804,8 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
 
   auto tablet = LookupLeaderTabletOrRespond(
       server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
-  if (!tablet || !CheckMemoryPressure(tablet.peer->tablet(), resp, &context)) {
+  if (!tablet || !CheckMemoryPressure(tablet.peer->tablet(), resp, &context) ||
+      !CheckNotSplitOrRespond(*tablet.peer, resp, &context)) {
     return;
   }
 
@@ -802,6 +903,10 @@ bool TabletServiceImpl::DoGetTabletOrRespond(const Req* req, Resp* resp, rpc::Rp
     return false;
   }
 
+  if (!CheckNotSplitOrRespond(*tablet_peer, resp, context)) {
+    return false;
+  }
+
   // Check for leader only in strong consistency level.
   if (req->consistency_level() == YBConsistencyLevel::STRONG) {
     if (PREDICT_FALSE(FLAGS_assert_reads_served_by_follower) &&
@@ -980,7 +1085,8 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
         server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
     // Serialiable read adds intents, i.e. writes data.
     // We should check for memory pressure in this case.
-    if (!leader_peer || !CheckMemoryPressure(leader_peer.peer->tablet(), resp, &context)) {
+    if (!leader_peer || !CheckMemoryPressure(leader_peer.peer->tablet(), resp, &context) ||
+        !CheckNotSplitOrRespond(*leader_peer.peer, resp, &context)) {
       return;
     }
     read_context.tablet = leader_peer.peer->shared_tablet();
@@ -1036,6 +1142,23 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     }
   }
 
+  if (req->max_staleness_ms() > 0 &&
+      req->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    // A follower only knows the data up to its propagated safe time, so the bound is checked
+    // against it rather than against the time since the last message from the leader.
+    const auto now = server_->Clock()->Now().GetPhysicalValueMicros();
+    const auto safe_time = read_context.safe_ht_to_read.GetPhysicalValueMicros();
+    if (safe_time + req->max_staleness_ms() * MonoTime::kMicrosecondsPerMillisecond < now) {
+      TRACE("Safe time is too stale");
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS_FORMAT(IllegalState, "Safe time $0 is more than $1ms behind",
+                        read_context.safe_ht_to_read, req->max_staleness_ms()),
+          TabletServerErrorPB::STALE_FOLLOWER, &context);
+      return;
+    }
+  }
+
   RequestScope request_scope;
   if (transactional) {
     // Serial number is used for check whether this operation was initiated before
@@ -1305,6 +1428,65 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batched Consensus Update RPC: " << req->ShortDebugString();
+  auto* multi_raft_manager = tablet_manager_->multi_raft_manager();
+  if (multi_raft_manager && req->has_caller_uuid()) {
+    multi_raft_manager->ServerIsAlive(req->caller_uuid(), req->quiescent_tablet_ids());
+  }
+  const string& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  resp->mutable_consensus_response()->Reserve(req->consensus_request_size());
+  for (const auto& consensus_request : req->consensus_request()) {
+    auto* consensus_response = resp->add_consensus_response();
+    // Errors are reported per update, so one failed tablet does not fail the whole batch.
+    auto setup_error = [consensus_response](const Status& s, TabletServerErrorPB::Code code) {
+      consensus_response->Clear();
+      StatusToPB(s, consensus_response->mutable_error()->mutable_status());
+      consensus_response->mutable_error()->set_code(code);
+    };
+
+    if (PREDICT_FALSE(consensus_request.dest_uuid() != local_uuid)) {
+      setup_error(STATUS_FORMAT(InvalidArgument,
+                                "MultiRaftUpdateConsensus: Wrong destination UUID requested. "
+                                    "Local UUID: $0. Requested UUID: $1",
+                                local_uuid, consensus_request.dest_uuid()),
+                  TabletServerErrorPB::WRONG_SERVER_UUID);
+      continue;
+    }
+
+    TabletPeerPtr tablet_peer;
+    Status s = tablet_manager_->GetTabletPeer(consensus_request.tablet_id(), &tablet_peer);
+    if (PREDICT_FALSE(!s.ok())) {
+      setup_error(s, s.IsServiceUnavailable() ? TabletServerErrorPB::UNKNOWN_ERROR
+                                              : TabletServerErrorPB::TABLET_NOT_FOUND);
+      continue;
+    }
+    const auto state = tablet_peer->state();
+    if (PREDICT_FALSE(state != tablet::RUNNING)) {
+      setup_error(STATUS(IllegalState, "Tablet not RUNNING", tablet::TabletStatePB_Name(state)),
+                  TabletServerErrorPB::TABLET_NOT_RUNNING);
+      continue;
+    }
+    shared_ptr<Consensus> consensus = tablet_peer->shared_consensus();
+    if (!consensus) {
+      setup_error(STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running"),
+                  TabletServerErrorPB::TABLET_NOT_RUNNING);
+      continue;
+    }
+
+    // Same as in UpdateConsensus, heartbeats don't contain operations to move out, but Update
+    // takes a mutable request.
+    s = consensus->Update(const_cast<ConsensusRequestPB*>(&consensus_request), consensus_response);
+    if (PREDICT_FALSE(!s.ok())) {
+      setup_error(s, TabletServerErrorPB::UNKNOWN_ERROR);
+    }
+  }
+  context.RespondSuccess();
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
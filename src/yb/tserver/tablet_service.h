@@ -181,6 +181,10 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     FlushTabletsResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  void SplitTablet(const SplitTabletRequestPB* req,
+                   SplitTabletResponsePB* resp,
+                   rpc::RpcContext context) override;
+
  private:
   TabletServer* server_;
 };
@@ -196,6 +200,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  virtual void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                        consensus::MultiRaftConsensusResponsePB *resp,
+                                        rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
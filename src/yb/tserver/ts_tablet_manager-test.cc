@@ -58,6 +58,7 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_int32(tablet_report_limit);
 
 namespace yb {
 namespace tserver {
@@ -319,5 +320,40 @@ TEST_F(TsTabletManagerTest, TestTabletReports) {
   ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
 }
 
+TEST_F(TsTabletManagerTest, TestTabletReportLimit) {
+  TabletReportPB report;
+  int64_t seqno = -1;
+
+  ASSERT_OK(CreateNewTablet("tablet-1", schema_, nullptr));
+  ASSERT_OK(CreateNewTablet("tablet-2", schema_, nullptr));
+
+  FLAGS_tablet_report_limit = 1;
+
+  // The full report should contain only one tablet, and leave the other one for later.
+  tablet_manager_->GenerateFullTabletReport(&report);
+  ASSERT_FALSE(report.is_incremental());
+  ASSERT_EQ(1, report.updated_tablets().size());
+  ASSERT_EQ(1, report.remaining_tablet_count());
+  ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+  const string first_tablet = report.updated_tablets(0).tablet_id();
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  // Acknowledging a report should only clean the tablets included in it, so the tablet left out
+  // of the full report shows up in the following incremental reports. The first tablet could be
+  // marked dirty again while its initial config is committed, so give it a few attempts.
+  bool found_second_tablet = false;
+  for (int i = 0; i != 10 && !found_second_tablet; ++i) {
+    tablet_manager_->GenerateIncrementalTabletReport(&report);
+    ASSERT_TRUE(report.is_incremental());
+    ASSERT_LE(report.updated_tablets().size(), 1);
+    ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+    for (const ReportedTabletPB& reported_tablet : report.updated_tablets()) {
+      found_second_tablet = found_second_tablet || reported_tablet.tablet_id() != first_tablet;
+    }
+    tablet_manager_->MarkTabletReportAcknowledged(report);
+  }
+  ASSERT_TRUE(found_second_tablet);
+}
+
 } // namespace tserver
 } // namespace yb
@@ -36,6 +36,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/optional/optional.hpp>
@@ -50,6 +51,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -72,6 +74,7 @@
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/tserver/heartbeater.h"
@@ -128,6 +131,11 @@ DEFINE_test_flag(double, fault_crash_after_rb_files_fetched, 0.0,
                  "after fetching the files during a remote bootstrap but before "
                  "marking the superblock as TABLET_DATA_READY.")
 
+DEFINE_test_flag(double, fault_crash_before_split_tablet_ready, 0.0,
+                 "Fraction of the time when the tablet server will crash immediately "
+                 "after creating the data of a tablet during a split but before "
+                 "marking the superblock as TABLET_DATA_READY.");
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                  "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -171,6 +179,17 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
 
+DEFINE_int32(log_prefetch_pool_max_threads, 8,
+             "The maximum number of threads reading ahead the logs of lagging followers into the "
+             "log cache.");
+TAG_FLAG(log_prefetch_pool_max_threads, advanced);
+
+DEFINE_int32(tablet_report_limit, 1000,
+             "Maximum number of tablets reported to the master in a single heartbeat. Tablets "
+             "that do not fit are reported in the following heartbeats, which are sent right "
+             "away.");
+TAG_FLAG(tablet_report_limit, advanced);
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -255,36 +274,81 @@ using tablet::TabletStatusPB;
 // Only called from the background task to ensure it's synchronized
 void TSTabletManager::MaybeFlushTablet() {
   int iteration = 0;
+  size_t bytes_scheduled = 0;
+  // Tablets a flush was already requested for by this call. Their memtables are not released
+  // until the flush completes, so picking them again would just spin.
+  std::unordered_set<TabletId> flush_requested;
   while (memory_monitor()->Exceeded() ||
          (iteration++ == 0 && FLAGS_pretend_memory_exceeded_enforce_flush)) {
-    TabletPeerPtr tablet_to_flush = TabletToFlush();
-    // TODO(bojanserafimov): If tablet_to_flush flushes now because of other reasons,
-    // we will schedule a second flush, which will unnecessarily stall writes for a short time. This
-    // will not happen often, but should be fixed.
-    if (tablet_to_flush) {
-      WARN_NOT_OK(tablet_to_flush->tablet()->Flush(tablet::FlushMode::kAsync),
-          Substitute("Flush failed on $0", tablet_to_flush->tablet_id()));
+    // Memtables that are being flushed are still accounted by the memory monitor, so take the
+    // flushes scheduled by the previous rounds into account.
+    const size_t memory_usage = memory_monitor()->memory_usage();
+    const size_t limit = memory_monitor()->limit();
+    size_t bytes_to_free = memory_usage > limit ? memory_usage - limit : 0;
+    if (bytes_scheduled) {
+      if (bytes_scheduled >= bytes_to_free) {
+        break;
+      }
+      bytes_to_free -= bytes_scheduled;
+    }
+
+    auto candidates = FlushCandidates();
+    candidates.erase(
+        std::remove_if(candidates.begin(), candidates.end(), [&flush_requested](const auto& c) {
+          return flush_requested.count(c.tablet_id) != 0;
+        }),
+        candidates.end());
+    auto tablets_to_flush = flush_policy_->TabletsToFlush(candidates, bytes_to_free);
+    if (tablets_to_flush.empty()) {
+      // Nothing could be released now. The memory monitor wakes us up again on the next write.
+      break;
+    }
+    for (size_t idx : tablets_to_flush) {
+      const auto& candidate = candidates[idx];
+      VLOG(1) << "Flushing tablet with " << flush_policy_->name() << " policy, memory usage: "
+              << memory_usage << ", limit: " << limit << ", candidate: " << candidate.ToString();
+      // TODO(bojanserafimov): If the tablet flushes now because of other reasons, we will
+      // schedule a second flush, which will unnecessarily stall writes for a short time. This
+      // will not happen often, but should be fixed.
+      flush_requested.insert(candidate.tablet_id);
+      auto status = candidate.peer->tablet()->Flush(tablet::FlushMode::kAsync);
+      if (status.ok()) {
+        flush_policy_->FlushScheduled(candidate);
+        bytes_scheduled += candidate.memtable_bytes;
+      } else {
+        LOG(WARNING) << Substitute("Flush failed on $0: $1", candidate.tablet_id,
+                                   status.ToString());
+      }
     }
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all
-// tablet memstores are empty or about to flush.
-TabletPeerPtr TSTabletManager::TabletToFlush() {
-  boost::shared_lock<RWMutex> lock(lock_); // For using the tablet map
-  HybridTime oldest_write_in_memstores = HybridTime::kMax;
-  TabletPeerPtr tablet_to_flush;
-  for (const TabletMap::value_type& entry : tablet_map_) {
-    const auto tablet = entry.second->shared_tablet();
-    if (tablet) {
-      const HybridTime oldest_write_in_memstore = tablet->flush_stats()->oldest_write_in_memstore();
-      if (oldest_write_in_memstore < oldest_write_in_memstores) {
-        oldest_write_in_memstores = oldest_write_in_memstore;
-        tablet_to_flush = entry.second;
-      }
+TabletFlushCandidates TSTabletManager::FlushCandidates() {
+  auto peers = GetTabletPeers();
+  TabletFlushCandidates result;
+  result.reserve(peers.size());
+  for (const auto& peer : peers) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
     }
+    TabletFlushCandidate candidate;
+    candidate.peer = peer;
+    candidate.tablet_id = peer->tablet_id();
+    candidate.oldest_write_in_memstore = tablet->flush_stats()->oldest_write_in_memstore();
+    candidate.num_writes = tablet->flush_stats()->num_writes();
+    const auto memtable_stats = tablet->GetMemTableStats();
+    candidate.memtable_bytes = memtable_stats.active_bytes;
+    candidate.num_immutable_memtables = memtable_stats.num_immutable;
+    int64_t gcable_bytes = 0;
+    if (peer->log_available() && peer->GetGCableDataSize(&gcable_bytes).ok()) {
+      const uint64_t log_bytes = peer->log()->OnDiskSize();
+      candidate.pinned_wal_bytes =
+          log_bytes > static_cast<uint64_t>(gcable_bytes) ? log_bytes - gcable_bytes : 0;
+    }
+    result.push_back(std::move(candidate));
   }
-  return tablet_to_flush;
+  return result;
 }
 
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
@@ -332,6 +396,15 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
+  // Log cache read-ahead does blocking disk IO, so it gets its own pool to not delay the Raft tasks
+  // of other tablets. Each tablet submits its reads through a serial token.
+  CHECK_OK(ThreadPoolBuilder("log-prefetch")
+               .set_max_threads(FLAGS_log_prefetch_pool_max_threads)
+               .Build(&log_prefetch_pool_));
+  // Compactions of split tablets are long and rare, so they are run one at a time.
+  CHECK_OK(ThreadPoolBuilder("split-compact")
+               .set_max_threads(1)
+               .Build(&split_compaction_pool_));
 
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
@@ -373,11 +446,14 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
       "tablet manager",
       "flush scheduler bgtask",
       std::chrono::milliseconds(FLAGS_flush_background_task_interval_msec)));
+    flush_policy_ = CreateFlushPolicy(server_->metric_entity());
     tablet_options_.memory_monitor = std::make_shared<rocksdb::MemoryMonitor>(
         memstore_size_bytes,
         std::function<void()>([this](){
                                 YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error"); }));
   }
+
+  tablet_options_.tablet_splitter = this;
 }
 
 TSTabletManager::~TSTabletManager() {
@@ -415,6 +491,10 @@ Status TSTabletManager::Init() {
 
   InitLocalRaftPeerPB();
 
+  multi_raft_manager_ = std::make_shared<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache(), local_peer_pb_);
+  multi_raft_manager_->Start();
+
   vector<scoped_refptr<TabletMetadata> > metas;
 
   // First, load all of the tablet metadata. We do this before we start
@@ -570,6 +650,162 @@ Status TSTabletManager::CreateNewTablet(
   return Status::OK();
 }
 
+Status TSTabletManager::ApplyTabletSplit(tablet::SplitOperationState* state) {
+  MutexLock l(split_lock_);
+
+  auto* tablet = state->tablet();
+  const auto& request = *state->request();
+  auto* meta = tablet->metadata();
+  const std::vector<TabletId> new_tablet_ids = {request.new_tablet1_id(), request.new_tablet2_id()};
+  const auto split_child_tablet_ids = meta->split_child_tablet_ids();
+  if (split_child_tablet_ids.empty()) {
+    // The split tablet stops applying writes before the new tablets are created. Its data stays
+    // as of the split operation, so the new tablets could be created again from it when creating
+    // them fails.
+    meta->set_split_child_tablet_ids(new_tablet_ids);
+  } else if (split_child_tablet_ids != new_tablet_ids) {
+    return STATUS_FORMAT(IllegalState, "Tablet $0 was already split into $1",
+                         tablet->tablet_id(), split_child_tablet_ids);
+  }
+  RETURN_NOT_OK(meta->Flush());
+
+  // The new tablets have the same replicas as the split tablet.
+  std::unique_ptr<ConsensusMetadata> cmeta;
+  RETURN_NOT_OK(ConsensusMetadata::Load(
+      fs_manager_, tablet->tablet_id(), fs_manager_->uuid(), &cmeta));
+  RaftConfigPB config = cmeta->committed_config();
+  config.set_opid_index(consensus::kInvalidOpIdIndex);
+
+  PartitionPB partition_pb;
+  meta->partition().ToPB(&partition_pb);
+  Partition partition;
+  partition_pb.set_partition_key_end(request.split_partition_key());
+  Partition::FromPB(partition_pb, &partition);
+  RETURN_NOT_OK(CreateSplitChildTablet(tablet, request.new_tablet1_id(), partition, config));
+
+  meta->partition().ToPB(&partition_pb);
+  partition_pb.set_partition_key_start(request.split_partition_key());
+  Partition::FromPB(partition_pb, &partition);
+  RETURN_NOT_OK(CreateSplitChildTablet(tablet, request.new_tablet2_id(), partition, config));
+
+  LOG(INFO) << "Tablet " << tablet->tablet_id() << " split into " << request.new_tablet1_id()
+            << " and " << request.new_tablet2_id() << " at partition key "
+            << Slice(request.split_partition_key()).ToDebugHexString();
+  return Status::OK();
+}
+
+Status TSTabletManager::CreateSplitChildTablet(
+    tablet::Tablet* parent, const TabletId& tablet_id, const Partition& partition,
+    const RaftConfigPB& config) {
+  scoped_refptr<TransitionInProgressDeleter> deleter;
+  TabletPeerPtr partial_peer;
+  {
+    std::lock_guard<RWMutex> lock(lock_);
+    TRACE("Acquired tablet manager lock");
+
+    // The split is applied again when it is replayed by the bootstrap or resent by the master.
+    TabletPeerPtr existing_peer;
+    if (LookupTabletUnlocked(tablet_id, &existing_peer) &&
+        existing_peer->tablet_metadata()->tablet_data_state() == TABLET_DATA_READY) {
+      return Status::OK();
+    }
+
+    RETURN_NOT_OK(StartTabletStateTransitionUnlocked(tablet_id, "splitting tablet", &deleter));
+    if (existing_peer) {
+      // The tablet was left in TABLET_DATA_COPYING state by a crash and tombstoned on startup.
+      tablet_map_.erase(tablet_id);
+      partial_peer = std::move(existing_peer);
+    }
+  }
+
+  if (partial_peer) {
+    LOG(INFO) << "Creating again tablet " << tablet_id << " of the interrupted split of tablet "
+              << parent->tablet_id();
+    partial_peer->Shutdown();
+    RETURN_NOT_OK(DeleteSplitChildTabletData(partial_peer->tablet_metadata()));
+  }
+
+  const auto* parent_meta = parent->metadata();
+  scoped_refptr<TabletMetadata> meta;
+  string data_root_dir;
+  string wal_root_dir;
+  GetAndRegisterDataAndWalDir(fs_manager_, parent_meta->table_id(), tablet_id,
+                              parent_meta->table_type(), &data_root_dir, &wal_root_dir);
+  // The tablet stays in TABLET_DATA_COPYING state until its data is in place.
+  Status create_status = TabletMetadata::CreateNew(fs_manager_,
+                                                   parent_meta->table_id(),
+                                                   tablet_id,
+                                                   parent_meta->table_name(),
+                                                   parent_meta->table_type(),
+                                                   parent_meta->schema(),
+                                                   parent_meta->index_map(),
+                                                   parent_meta->partition_schema(),
+                                                   partition,
+                                                   boost::none /* index_info */,
+                                                   parent_meta->schema_version(),
+                                                   TABLET_DATA_COPYING,
+                                                   &meta,
+                                                   data_root_dir,
+                                                   wal_root_dir);
+  if (!create_status.ok()) {
+    UnregisterDataWalDir(parent_meta->table_id(), tablet_id, parent_meta->table_type(),
+                         data_root_dir, wal_root_dir);
+  }
+  RETURN_NOT_OK_PREPEND(create_status, "Couldn't create tablet metadata");
+
+  Status s = parent->CreateSplitCheckpoint(meta->rocksdb_dir());
+  if (s.ok()) {
+    std::unique_ptr<ConsensusMetadata> cmeta;
+    s = ConsensusMetadata::Create(fs_manager_, tablet_id, fs_manager_->uuid(),
+                                  config, consensus::kMinimumTerm, &cmeta);
+  }
+  if (s.ok()) {
+    MAYBE_FAULT(FLAGS_fault_crash_before_split_tablet_ready);
+    meta->set_split_parent_tablet_id(parent->tablet_id());
+    meta->set_tablet_data_state(TABLET_DATA_READY);
+    s = meta->Flush();
+  }
+  if (!s.ok()) {
+    // Remove what was created so far, so the next attempt starts from scratch.
+    WARN_NOT_OK(DeleteSplitChildTabletData(meta), "Failed to remove tablet " + tablet_id);
+    return s.CloneAndPrepend(
+        Format("Failed to create tablet $0 from split tablet $1", tablet_id, parent->tablet_id()));
+  }
+  LOG(INFO) << "Created tablet " << tablet_id << " from split tablet " << parent->tablet_id();
+
+  RETURN_NOT_OK(CreateAndRegisterTabletPeer(meta, NEW_PEER));
+  return open_tablet_pool_->SubmitFunc(
+      std::bind(&TSTabletManager::OpenTablet, this, meta, deleter));
+}
+
+Status TSTabletManager::DeleteSplitChildTabletData(const scoped_refptr<TabletMetadata>& meta) {
+  RETURN_NOT_OK(DeleteTabletData(meta, TABLET_DATA_DELETED, fs_manager_->uuid(), yb::OpId()));
+  RETURN_NOT_OK(meta->DeleteSuperBlock());
+  UnregisterDataWalDir(meta->table_id(), meta->tablet_id(), meta->table_type(),
+                       meta->data_root_dir(), meta->wal_root_dir());
+  return Status::OK();
+}
+
+void TSTabletManager::CompactSplitChildTablet(const TabletPeerPtr& tablet_peer) {
+  const auto& meta = tablet_peer->tablet_metadata();
+  auto tablet = tablet_peer->shared_tablet();
+  if (!tablet) {
+    LOG(INFO) << "Split tablet " << meta->tablet_id() << " was shut down before compaction";
+    return;
+  }
+  LOG_TIMING(INFO, Format("compacting split tablet $0", meta->tablet_id())) {
+    Status s = tablet->CompactSync();
+    if (s.ok()) {
+      // Key bounds are not needed once the compaction removed the keys outside of them.
+      meta->set_split_parent_tablet_id("");
+      s = meta->Flush();
+    }
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to compact split tablet " << meta->tablet_id() << ": " << s;
+    }
+  }
+}
+
 string LogPrefix(const string& tablet_id, const string& uuid) {
   return "T " + tablet_id + " P " + uuid + ": ";
 }
@@ -978,8 +1214,11 @@ void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
                                     log,
                                     tablet->GetMetricEntity(),
                                     raft_pool(),
+                                    log_prefetch_pool_.get(),
                                     tablet_prepare_pool(),
-                                    &retryable_requests);
+                                    apply_pool_.get(),
+                                    &retryable_requests,
+                                    multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1008,6 +1247,14 @@ void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
                    << Trace::CurrentTrace()->DumpToString(true);
     }
   }
+
+  if (!meta->split_parent_tablet_id().empty()) {
+    // Do not hold the open tablet pool for the duration of the compaction.
+    WARN_NOT_OK(
+        split_compaction_pool_->SubmitFunc(
+            std::bind(&TSTabletManager::CompactSplitChildTablet, this, tablet_peer)),
+        Format("Failed to schedule compaction of split tablet $0", meta->tablet_id()));
+  }
 }
 
 void TSTabletManager::StartShutdown() {
@@ -1043,6 +1290,13 @@ void TSTabletManager::StartShutdown() {
   // Shut down the bootstrap pool, so new tablets are registered after this point.
   open_tablet_pool_->Shutdown();
 
+  // Wait for the running split compaction before shutting down the tablets.
+  split_compaction_pool_->Shutdown();
+
+  if (multi_raft_manager_) {
+    multi_raft_manager_->Shutdown();
+  }
+
   // Take a snapshot of the peers list -- that way we don't have to hold
   // on to the lock while shutting them down, which might cause a lock
   // inversion. (see KUDU-308 for example).
@@ -1064,6 +1318,9 @@ void TSTabletManager::CompleteShutdown() {
   if (raft_pool_) {
     raft_pool_->Shutdown();
   }
+  if (log_prefetch_pool_) {
+    log_prefetch_pool_->Shutdown();
+  }
   if (tablet_prepare_pool_) {
     tablet_prepare_pool_->Shutdown();
   }
@@ -1287,19 +1544,8 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   vector<std::shared_ptr<TabletPeer>> to_report;
   {
     boost::shared_lock<RWMutex> shared_lock(lock_);
-    to_report.reserve(dirty_tablets_.size());
     report->set_sequence_number(next_report_seq_++);
-    for (const DirtyMap::value_type& dirty_entry : dirty_tablets_) {
-      const string& tablet_id = dirty_entry.first;
-      TabletPeerPtr* tablet_peer = FindOrNull(tablet_map_, tablet_id);
-      if (tablet_peer) {
-        // Dirty entry, report on it.
-        to_report.push_back(*tablet_peer);
-      } else {
-        // Removed.
-        report->add_removed_tablet_ids(tablet_id);
-      }
-    }
+    CollectDirtyTabletsUnlocked(report, &to_report);
   }
   for (const auto& replica : to_report) {
     CreateReportedTabletPB(replica, report->add_updated_tablets());
@@ -1309,23 +1555,50 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
 void TSTabletManager::GenerateFullTabletReport(TabletReportPB* report) {
   report->Clear();
   report->set_is_incremental(false);
-  // Creating the tablet report can be slow in the case that it is in the
-  // middle of flushing its consensus metadata. We don't want to hold
-  // lock_ for too long, even in read mode, since it can cause other readers
-  // to block if there is a waiting writer (see KUDU-2193). So, we just make
-  // a local copy of the set of replicas.
+  // As with the incremental report, the reported tablet PBs are built outside of lock_.
   vector<std::shared_ptr<TabletPeer>> to_report;
   {
-    boost::shared_lock<RWMutex> shared_lock(lock_);
+    std::lock_guard<RWMutex> l(lock_);
     report->set_sequence_number(next_report_seq_++);
-    GetTabletPeersUnlocked(&to_report);
+    // Every hosted tablet becomes dirty, so the tablets that do not fit into this report because
+    // of FLAGS_tablet_report_limit are sent by the following incremental reports. Removed tablets
+    // are implied by the full report, so there is no need to keep them.
+    dirty_tablets_.clear();
+    for (const auto& entry : tablet_map_) {
+      dirty_tablets_[entry.first].change_seq = report->sequence_number();
+    }
+    CollectDirtyTabletsUnlocked(report, &to_report);
   }
   for (const auto& replica : to_report) {
     CreateReportedTabletPB(replica, report->add_updated_tablets());
   }
+}
 
-  std::lock_guard<RWMutex> l(lock_);
-  dirty_tablets_.clear();
+void TSTabletManager::CollectDirtyTabletsUnlocked(TabletReportPB* report,
+                                                  TabletPeers* to_report) const {
+  const size_t limit = std::max(FLAGS_tablet_report_limit, 1);
+  to_report->reserve(std::min(dirty_tablets_.size(), limit));
+  int32_t remaining = 0;
+  for (const DirtyMap::value_type& dirty_entry : dirty_tablets_) {
+    if (to_report->size() + report->removed_tablet_ids_size() >= limit) {
+      ++remaining;
+      continue;
+    }
+    const string& tablet_id = dirty_entry.first;
+    const TabletPeerPtr* tablet_peer = FindOrNull(tablet_map_, tablet_id);
+    if (tablet_peer) {
+      // Dirty entry, report on it.
+      to_report->push_back(*tablet_peer);
+    } else {
+      // Removed.
+      report->add_removed_tablet_ids(tablet_id);
+    }
+  }
+  if (remaining > 0) {
+    VLOG(1) << "Tablet report #" << report->sequence_number() << " is limited to " << limit
+            << " tablets, " << remaining << " tablets left for the following reports";
+    report->set_remaining_tablet_count(remaining);
+  }
 }
 
 void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report) {
@@ -1334,19 +1607,20 @@ void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report)
   int32_t acked_seq = report.sequence_number();
   CHECK_LT(acked_seq, next_report_seq_);
 
-  // Clear the "dirty" state for any tablets which have not changed since
-  // this report.
-  auto it = dirty_tablets_.begin();
-  while (it != dirty_tablets_.end()) {
-    const TabletReportState& state = it->second;
-    if (state.change_seq <= acked_seq) {
-      // This entry has not changed since this tablet report, we no longer need
-      // to track it as dirty. If it becomes dirty again, it will be re-added
-      // with a higher sequence number.
-      it = dirty_tablets_.erase(it);
-    } else {
-      ++it;
+  // Clear the "dirty" state for the reported tablets which have not changed since this report.
+  // If they become dirty again, they will be re-added with a higher sequence number. Tablets that
+  // were left out of the report because of the size limit stay dirty.
+  auto mark_clean = [this, acked_seq](const std::string& tablet_id) {
+    auto it = dirty_tablets_.find(tablet_id);
+    if (it != dirty_tablets_.end() && it->second.change_seq <= acked_seq) {
+      dirty_tablets_.erase(it);
     }
+  };
+  for (const ReportedTabletPB& reported_tablet : report.updated_tablets()) {
+    mark_clean(reported_tablet.tablet_id());
+  }
+  for (const std::string& tablet_id : report.removed_tablet_ids()) {
+    mark_clean(tablet_id);
   }
 }
 
@@ -53,6 +53,7 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/tserver/flush_policy.h"
 #include "yb/tserver/tablet_peer_lookup.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_admin.pb.h"
@@ -62,6 +63,7 @@
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/tablet_splitter.h"
 
 namespace yb {
 
@@ -73,6 +75,7 @@ class Schema;
 class BackgroundTask;
 
 namespace consensus {
+class MultiRaftManager;
 class RaftConfigPB;
 } // namespace consensus
 
@@ -121,7 +124,7 @@ class TransitionInProgressDeleter;
 // TODO: will also be responsible for keeping the local metadata about
 // which tablets are hosted on this server persistent on disk, as well
 // as re-opening all the tablets at startup, etc.
-class TSTabletManager : public tserver::TabletPeerLookupIf {
+class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::TabletSplitter {
  public:
   typedef std::vector<std::shared_ptr<tablet::TabletPeer>> TabletPeers;
 
@@ -173,6 +176,11 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
     consensus::RaftConfigPB config,
     std::shared_ptr<tablet::TabletPeer> *tablet_peer);
 
+  // Mark the tablet as split, so it does not apply writes anymore, and create the tablets that
+  // replace it on this server. Each of them gets a checkpoint of the split tablet data and the
+  // same Raft config. Tablets that already exist are kept, so a failed split could be retried.
+  CHECKED_STATUS ApplyTabletSplit(tablet::SplitOperationState* state) override;
+
   // Delete the specified tablet.
   // 'delete_type' must be one of TABLET_DATA_DELETED or TABLET_DATA_TOMBSTONED
   // or else returns Status::IllegalArgument.
@@ -210,6 +218,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   virtual CHECKED_STATUS
       StartRemoteBootstrap(const consensus::StartRemoteBootstrapRequestPB& req) override;
 
+  consensus::MultiRaftManager* multi_raft_manager() const override {
+    return multi_raft_manager_.get();
+  }
+
   // Generate an incremental tablet report.
   //
   // This will report any tablets which have changed since the last acknowleged
@@ -223,6 +235,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   void GenerateIncrementalTabletReport(master::TabletReportPB* report);
 
   // Generate a full tablet report and reset any incremental state tracking.
+  //
+  // Both kinds of reports include at most FLAGS_tablet_report_limit tablets, the number of
+  // tablets that did not fit is stored in remaining_tablet_count. Those tablets are still
+  // dirty and will be included in the subsequent incremental reports.
   void GenerateFullTabletReport(master::TabletReportPB* report);
 
   // Mark that the master successfully received and processed the given
@@ -288,7 +304,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
-  // Flush some tablet if the memstore memory limit is exceeded
+  // Flush tablets picked by the flush policy while the memstore memory limit is exceeded.
   void MaybeFlushTablet();
 
  private:
@@ -342,6 +358,17 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   void OpenTablet(const scoped_refptr<tablet::TabletMetadata>& meta,
                   const scoped_refptr<TransitionInProgressDeleter>& deleter);
 
+  // Create a tablet that gets the given partition of a split tablet.
+  CHECKED_STATUS CreateSplitChildTablet(
+      tablet::Tablet* parent, const TabletId& tablet_id, const Partition& partition,
+      const consensus::RaftConfigPB& config);
+
+  // Delete the data, consensus metadata and superblock of a tablet partially created by a split.
+  CHECKED_STATUS DeleteSplitChildTabletData(const scoped_refptr<tablet::TabletMetadata>& meta);
+
+  // Remove the data of the sibling from a tablet created by a split.
+  void CompactSplitChildTablet(const std::shared_ptr<tablet::TabletPeer>& tablet_peer);
+
   // Open a tablet whose metadata has already been loaded.
   void BootstrapAndInitTablet(const scoped_refptr<tablet::TabletMetadata>& meta,
                               std::shared_ptr<tablet::TabletPeer>* peer);
@@ -369,6 +396,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   void CreateReportedTabletPB(const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
                               master::ReportedTabletPB* reported_tablet);
 
+  // Fill 'to_report' with the dirty tablets to include in 'report' and add the removed ones to
+  // the report directly, stopping at FLAGS_tablet_report_limit entries.
+  //
+  // NOTE: requires that the caller holds the lock.
+  void CollectDirtyTabletsUnlocked(master::TabletReportPB* report, TabletPeers* to_report) const;
+
   // Mark that the provided TabletPeer's state has changed. That should be taken into
   // account in the next report.
   //
@@ -380,8 +413,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // TABLET_DATA_READY state. Generally, we tombstone the replica.
   CHECKED_STATUS HandleNonReadyTabletOnStartup(const scoped_refptr<tablet::TabletMetadata>& meta);
 
-  // Return the tablet with oldest write still in its memstore
-  std::shared_ptr<tablet::TabletPeer> TabletToFlush();
+  // Return the memory state of the running tablets, for the flush policy.
+  TabletFlushCandidates FlushCandidates();
 
   TSTabletManagerStatePB state() const {
     boost::shared_lock<RWMutex> lock(lock_);
@@ -423,6 +456,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   TableDiskAssignmentMap table_wal_assignment_map_;
   mutable Mutex dir_assignment_lock_;
 
+  // Serializes splits, which are applied by the split tablet and retried on master requests.
+  Mutex split_lock_;
+
   // Map of tablet ids -> reason strings where the keys are tablets whose
   // bootstrap, creation, or deletion is in-progress
   TransitionInProgressMap transition_in_progress_;
@@ -451,15 +487,28 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool for Raft-related operations, shared between all tablets.
   std::unique_ptr<ThreadPool> raft_pool_;
 
+  // Thread pool for log cache read-ahead, shared between all tablets.
+  std::unique_ptr<ThreadPool> log_prefetch_pool_;
+
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Thread pool for the compactions of tablets created by a split.
+  std::unique_ptr<ThreadPool> split_compaction_pool_;
+
+  // Batches heartbeats of the tablet leaders to the same remote servers.
+  std::shared_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Picks the tablets to flush when the memstore memory limit is exceeded. Only used from the
+  // background task.
+  std::unique_ptr<FlushPolicy> flush_policy_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -130,12 +130,21 @@ class StackTrace {
     memcpy(this, &s, sizeof(s));
   }
 
-  bool Equals(const StackTrace& s) {
+  bool Equals(const StackTrace& s) const {
     return s.num_frames_ == num_frames_ &&
       strings::memeq(frames_, s.frames_,
                      num_frames_ * sizeof(frames_[0]));
   }
 
+  int num_frames() const {
+    return num_frames_;
+  }
+
+  // Returns the return address of the frame with the given index, the innermost frame is 0.
+  void* frame(int index) const {
+    return frames_[index];
+  }
+
   // Collect and store the current stack trace. Skips the top 'skip_frames' frames
   // from the stack. For example, a value of '1' will skip the 'Collect()' function
   // call itself.
@@ -125,4 +125,35 @@ TEST_F(HdrHistogramTest, PercentileAndCopyTest) {
   ASSERT_EQ(hist.TotalSum(), copy.TotalSum());
 }
 
+TEST_F(HdrHistogramTest, MergeTest) {
+  HdrHistogram hist(10000LU, kSigDigits);
+  HdrHistogram other(10000LU, kSigDigits);
+  HdrHistogram empty(10000LU, kSigDigits);
+
+  // Merging into an empty histogram takes min and max from the other one.
+  other.Increment(10);
+  other.IncrementBy(500, 2);
+  hist.MergeFrom(other);
+  ASSERT_EQ(3, hist.TotalCount());
+  ASSERT_EQ(10 + 500 * 2, hist.TotalSum());
+  ASSERT_EQ(10, hist.MinValue());
+  ASSERT_EQ(500, hist.MaxValue());
+
+  hist.Increment(1);
+  hist.MergeFrom(other);
+  hist.MergeFrom(empty);
+  ASSERT_EQ(7, hist.TotalCount());
+  ASSERT_EQ(1 + (10 + 500 * 2) * 2, hist.TotalSum());
+  ASSERT_EQ(1, hist.MinValue());
+  ASSERT_EQ(500, hist.MaxValue());
+  ASSERT_EQ(2, hist.CountInBucketForValue(10));
+  ASSERT_EQ(4, hist.CountInBucketForValue(500));
+
+  // A successful TryIncrementBy records the value like IncrementBy does.
+  ASSERT_TRUE(hist.TryIncrementBy(1000, 2));
+  ASSERT_EQ(9, hist.TotalCount());
+  ASSERT_EQ(1000, hist.MaxValue());
+  ASSERT_EQ(2, hist.CountInBucketForValue(1000));
+}
+
 } // namespace yb
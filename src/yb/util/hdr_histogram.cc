@@ -162,22 +162,64 @@ void HdrHistogram::IncrementBy(int64_t value, int64_t count) {
   DCHECK_GE(value, 0);
   DCHECK_GE(count, 0);
 
+  NoBarrier_AtomicIncrement(&total_count_, count);
+  RecordValue(value, count);
+}
+
+bool HdrHistogram::TryIncrementBy(int64_t value, int64_t count) {
+  DCHECK_GE(value, 0);
+  DCHECK_GE(count, 0);
+
+  Atomic64 old_count = NoBarrier_Load(&total_count_);
+  if (NoBarrier_CompareAndSwap(&total_count_, old_count, old_count + count) != old_count) {
+    return false;
+  }
+  RecordValue(value, count);
+  return true;
+}
+
+void HdrHistogram::MergeFrom(const HdrHistogram& other) {
+  DCHECK_EQ(highest_trackable_value_, other.highest_trackable_value_);
+  DCHECK_EQ(num_significant_digits_, other.num_significant_digits_);
+
+  NoBarrier_AtomicIncrement(&total_sum_, NoBarrier_Load(&other.total_sum_));
+  UpdateMinMax(NoBarrier_Load(&other.min_value_), NoBarrier_Load(&other.max_value_));
+
+  uint64_t total_merged_count = 0;
+  for (int i = 0; i < counts_array_length_; i++) {
+    uint64_t count = NoBarrier_Load(&other.counts_[i]);
+    if (count != 0) {
+      NoBarrier_AtomicIncrement(&counts_[i], count);
+      total_merged_count += count;
+    }
+  }
+  // Keep the total consistent with the merged counts.
+  NoBarrier_AtomicIncrement(&total_count_, total_merged_count);
+}
+
+void HdrHistogram::RecordValue(int64_t value, int64_t count) {
   // Dissect the value into bucket and sub-bucket parts, and derive index into
   // counts array:
   int bucket_index = BucketIndex(value);
   int sub_bucket_index = SubBucketIndex(value, bucket_index);
   int counts_index = CountsArrayIndex(bucket_index, sub_bucket_index);
 
-  // Increment bucket, total, and sum.
+  // Increment bucket and sum.
   NoBarrier_AtomicIncrement(&counts_[counts_index], count);
-  NoBarrier_AtomicIncrement(&total_count_, count);
   NoBarrier_AtomicIncrement(&total_sum_, value * count);
 
+  UpdateMinMax(value, value);
+}
+
+void HdrHistogram::UpdateMinMax(int64_t min, int64_t max) {
+  // Raw values are used instead of MinValue() and MaxValue(), because the total count could be
+  // updated after this call.
+
   // Update min, if needed.
   {
     Atomic64 min_val;
-    while (PREDICT_FALSE(value < (min_val = MinValue()))) {
-      Atomic64 old_val = NoBarrier_CompareAndSwap(&min_value_, min_val, value);
+    while (PREDICT_FALSE(min < (min_val = NoBarrier_Load(&min_value_)))) {
+      Atomic64 old_val = NoBarrier_CompareAndSwap(&min_value_, min_val, min);
       if (PREDICT_TRUE(old_val == min_val)) break; // CAS success.
     }
   }
@@ -185,8 +227,8 @@ void HdrHistogram::IncrementBy(int64_t value, int64_t count) {
   // Update max, if needed.
   {
     Atomic64 max_val;
-    while (PREDICT_FALSE(value > (max_val = MaxValue()))) {
-      Atomic64 old_val = NoBarrier_CompareAndSwap(&max_value_, max_val, value);
+    while (PREDICT_FALSE(max > (max_val = NoBarrier_Load(&max_value_)))) {
+      Atomic64 old_val = NoBarrier_CompareAndSwap(&max_value_, max_val, max);
       if (PREDICT_TRUE(old_val == max_val)) break; // CAS success.
     }
   }
@@ -97,6 +97,14 @@ class HdrHistogram {
   void Increment(int64_t value);
   void IncrementBy(int64_t value, int64_t count);
 
+  // Same as IncrementBy, but gives up and returns false without recording anything when some
+  // other thread concurrently updates the total count.
+  bool TryIncrementBy(int64_t value, int64_t count);
+
+  // Add all data recorded by other, which must have the same configuration, to this histogram.
+  // Like the copy constructor, it is not a consistent snapshot of other.
+  void MergeFrom(const HdrHistogram& other);
+
   // Record new data, correcting for "coordinated omission".
   //
   // See https://groups.google.com/d/msg/mechanical-sympathy/icNZJejUHfE/BfDekfBEs_sJ
@@ -186,6 +194,10 @@ class HdrHistogram {
   void Init();
   int CountsArrayIndex(int bucket_index, int sub_bucket_index) const;
 
+  // Records the value in the counts array, sum, min and max. Does not update the total count.
+  void RecordValue(int64_t value, int64_t count);
+  void UpdateMinMax(int64_t min, int64_t max);
+
   uint64_t highest_trackable_value_;
   int num_significant_digits_;
   int counts_array_length_;
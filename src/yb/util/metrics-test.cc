@@ -33,12 +33,15 @@
 #include <boost/assign/list_of.hpp>
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include "yb/gutil/bind.h"
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/strings/split.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/jsonreader.h"
 #include "yb/util/jsonwriter.h"
@@ -322,4 +325,87 @@ TEST_F(MetricsTest, TestDumpJsonPrototypes) {
   ASSERT_TRUE(ContainsKey(seen_metrics, "test_hist"));
 }
 
+METRIC_DEFINE_entity(tablet);
+METRIC_DEFINE_counter(tablet, test_tablet_reqs, "Tablet Requests", MetricUnit::kRequests,
+                      "Number of tablet requests");
+METRIC_DEFINE_counter(server, test_server_reqs, "Server Requests", MetricUnit::kRequests,
+                      "Number of server requests");
+
+// Returns the values of lines for the metric 'name' with the 'label' attribute, e.g. x="y".
+vector<string> PrometheusValues(const string& output, const string& name, const string& label) {
+  vector<string> result;
+  std::istringstream input(output);
+  string line;
+  while (std::getline(input, line)) {
+    if (HasPrefixString(line, name + "{") && line.find(label) != string::npos) {
+      // Line format: name{attributes} value timestamp
+      vector<string> parts = strings::Split(line.substr(line.find('}') + 2), " ");
+      result.push_back(parts[0]);
+    }
+  }
+  return result;
+}
+
+TEST_F(MetricsTest, PrometheusTest) {
+  vector<scoped_refptr<Counter>> counters;
+  int increments = 1;
+  for (const auto& tablet : { std::make_pair("tablet-1", "t1"), std::make_pair("tablet-2", "t1"),
+                              std::make_pair("tablet-3", "t2") }) {
+    auto entity = METRIC_ENTITY_tablet.Instantiate(
+        &registry_, tablet.first,
+        { {"table_id", tablet.second}, {"table_name", string("table_") + tablet.second} });
+    counters.push_back(METRIC_test_tablet_reqs.Instantiate(entity));
+    counters.back()->IncrementBy(increments);
+    increments *= 2;
+  }
+  auto server = METRIC_ENTITY_server.Instantiate(&registry_, "yb.test");
+  counters.push_back(METRIC_test_server_reqs.Instantiate(server));
+  counters.back()->IncrementBy(7);
+
+  auto write = [this](MetricPrometheusOptions options) {
+    std::stringstream output;
+    PrometheusWriter writer(&output, std::move(options));
+    CHECK_OK(registry_.WriteForPrometheus(&writer));
+    return output.str();
+  };
+
+  // Tablet metrics are summed up per table by default.
+  auto output = write(MetricPrometheusOptions());
+  ASSERT_EQ(vector<string>{"3"}, PrometheusValues(output, "test_tablet_reqs", "table_id=\"t1\""));
+  ASSERT_EQ(vector<string>{"4"}, PrometheusValues(output, "test_tablet_reqs", "table_id=\"t2\""));
+  ASSERT_EQ(vector<string>{"7"},
+            PrometheusValues(output, "test_server_reqs", "metric_id=\"yb.test\""));
+  // Entities of other types are not exported.
+  ASSERT_EQ(output.find("reqs_pending"), string::npos);
+
+  MetricPrometheusOptions options;
+  options.aggregation_level = MetricPrometheusOptions::AggregationLevel::kTablet;
+  output = write(options);
+  ASSERT_EQ(vector<string>{"1"},
+            PrometheusValues(output, "test_tablet_reqs", "metric_id=\"tablet-1\""));
+  ASSERT_EQ(vector<string>{"2"},
+            PrometheusValues(output, "test_tablet_reqs", "metric_id=\"tablet-2\""));
+  ASSERT_EQ(vector<string>{"4"},
+            PrometheusValues(output, "test_tablet_reqs", "metric_id=\"tablet-3\""));
+
+  options = MetricPrometheusOptions();
+  options.tables = { "table_t2" };
+  output = write(options);
+  ASSERT_EQ(vector<string>(), PrometheusValues(output, "test_tablet_reqs", "table_id=\"t1\""));
+  ASSERT_EQ(vector<string>{"4"}, PrometheusValues(output, "test_tablet_reqs", "table_id=\"t2\""));
+  ASSERT_EQ(vector<string>{"7"}, PrometheusValues(output, "test_server_reqs", ""));
+
+  options = MetricPrometheusOptions();
+  options.entity_types = { "server" };
+  output = write(options);
+  ASSERT_EQ(vector<string>(), PrometheusValues(output, "test_tablet_reqs", ""));
+  ASSERT_EQ(vector<string>{"7"}, PrometheusValues(output, "test_server_reqs", ""));
+
+  options = MetricPrometheusOptions();
+  options.metric_prefixes = { "test_tablet" };
+  output = write(options);
+  ASSERT_EQ(2, PrometheusValues(output, "test_tablet_reqs", "").size());
+  ASSERT_EQ(vector<string>(), PrometheusValues(output, "test_server_reqs", ""));
+}
+
 } // namespace yb
@@ -31,10 +31,15 @@
 //
 #include "yb/util/metrics.h"
 
+#if !defined(__APPLE__)
+#include <sched.h>
+#endif
+
 #include <iostream>
 #include <map>
 #include <regex>
 #include <set>
+#include <thread>
 
 #include <gflags/gflags.h>
 
@@ -44,6 +49,7 @@
 #include "yb/gutil/singleton.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/histogram.pb.h"
@@ -215,8 +221,33 @@ bool MatchMetricInList(const string& metric_name,
   return false;
 }
 
+bool MatchAnyPrefix(const string& str, const vector<string>& prefixes) {
+  for (const string& prefix : prefixes) {
+    if (HasPrefixString(str, prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // anonymous namespace
 
+bool MetricPrometheusOptions::MatchEntityType(const char* entity_type) const {
+  if (entity_types.empty()) {
+    return true;
+  }
+  for (const string& type : entity_types) {
+    if (type == entity_type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MetricPrometheusOptions::MatchMetricName(const string& metric_name) const {
+  return metric_prefixes.empty() || MatchAnyPrefix(metric_name, metric_prefixes);
+}
+
 
 Status MetricEntity::WriteAsJson(JsonWriter* writer,
                                  const vector<string>& requested_metrics,
@@ -285,37 +316,56 @@ Status MetricEntity::WriteAsJson(JsonWriter* writer,
 }
 
 CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const {
+  const auto& options = writer->options();
+  const bool is_tablet = strcmp(prototype_->name(), "tablet") == 0;
+  if (!is_tablet && strcmp(prototype_->name(), "server") != 0 &&
+      strcmp(prototype_->name(), "cluster") != 0) {
+    return Status::OK();
+  }
+  if (!options.MatchEntityType(prototype_->name())) {
+    return Status::OK();
+  }
+
   // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
   typedef std::map<const char*, scoped_refptr<Metric> > OrderedMetricMap;
   OrderedMetricMap metrics;
-  AttributeMap attrs;
+  AttributeMap prometheus_attr;
   std::vector<ExternalPrometheusMetricsCb> external_metrics_cbs;
   {
     // Snapshot the metrics, attributes & external metrics callbacks in this metrics entity. (Note:
-    // this is not guaranteed to be a consistent snapshot).
+    // this is not guaranteed to be a consistent snapshot). Only the metrics that pass the filters
+    // are referenced, so the lock is not held for the whole metric map, and the values are read
+    // after it is released.
     std::lock_guard<simple_spinlock> l(lock_);
-    attrs = attributes_;
+    if (is_tablet) {
+      // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
+      // We ignore the tablet part to squash at the table level.
+      prometheus_attr["table_id"] = FindWithDefault(attributes_, "table_id", "");
+      prometheus_attr["table_name"] = FindWithDefault(attributes_, "table_name", "");
+      if (!options.tables.empty() &&
+          std::find(options.tables.begin(), options.tables.end(),
+                    prometheus_attr["table_id"]) == options.tables.end() &&
+          std::find(options.tables.begin(), options.tables.end(),
+                    prometheus_attr["table_name"]) == options.tables.end()) {
+        return Status::OK();
+      }
+    } else {
+      prometheus_attr = attributes_;
+    }
     external_metrics_cbs = external_prometheus_metrics_cbs_;
     for (const MetricMap::value_type& val : metric_map_) {
       const MetricPrototype* prototype = val.first;
       const scoped_refptr<Metric>& metric = val.second;
 
-      InsertOrDie(&metrics, prototype->name(), metric);
+      if (options.MatchMetricName(prototype->name())) {
+        InsertOrDie(&metrics, prototype->name(), metric);
+      }
     }
   }
-  AttributeMap prometheus_attr;
-  // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
-  // We ignore the tablet part to squash at the table level.
-  if (strcmp(prototype_->name(), "tablet") == 0)  {
-    prometheus_attr["table_id"] = attrs["table_id"];
-    prometheus_attr["table_name"] = attrs["table_name"];
-  } else if (strcmp(prototype_->name(), "server") == 0 ||
-      strcmp(prototype_->name(), "cluster") == 0) {
-    prometheus_attr = attrs;
+  if (!is_tablet ||
+      options.aggregation_level == MetricPrometheusOptions::AggregationLevel::kTablet) {
     // This is tablet_id in the case of tablet, but otherwise names the server type, eg: yb.master
     prometheus_attr["metric_id"] = id_;
-  } else {
-    return Status::OK();
   }
   // This is currently tablet / server / cluster.
   prometheus_attr["metric_type"] = prototype_->name();
@@ -328,7 +378,7 @@ CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const
   }
   // Run the external metrics collection callback if there is one set.
   for (const ExternalPrometheusMetricsCb& cb : external_metrics_cbs) {
-    cb(writer);
+    cb(writer, prometheus_attr);
   }
 
   return Status::OK();
@@ -437,15 +487,20 @@ Status MetricRegistry::WriteAsJson(JsonWriter* writer,
 }
 
 CHECKED_STATUS MetricRegistry::WriteForPrometheus(PrometheusWriter* writer) const {
-  EntityMap entities;
+  std::vector<scoped_refptr<MetricEntity>> entities;
   {
     std::lock_guard<simple_spinlock> l(lock_);
-    entities = entities_;
+    entities.reserve(entities_.size());
+    for (const auto& e : entities_) {
+      if (writer->options().MatchEntityType(e.second->prototype().name())) {
+        entities.push_back(e.second);
+      }
+    }
   }
 
-  for (const EntityMap::value_type e : entities) {
-    WARN_NOT_OK(e.second->WriteForPrometheus(writer),
-                Substitute("Failed to write entity $0 as Prometheus", e.second->id()));
+  for (const auto& entity : entities) {
+    WARN_NOT_OK(entity->WriteForPrometheus(writer),
+                Substitute("Failed to write entity $0 as Prometheus", entity->id()));
   }
   RETURN_NOT_OK(writer->FlushAggregatedValues());
 
@@ -726,14 +781,55 @@ scoped_refptr<Histogram> HistogramPrototype::Instantiate(
 Histogram::Histogram(const HistogramPrototype* proto)
   : Metric(proto),
     histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())) {
+  for (auto& shard : shards_) {
+    shard.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+Histogram::~Histogram() {
+  for (auto& shard : shards_) {
+    delete shard.load(std::memory_order_acquire);
+  }
 }
 
 void Histogram::Increment(int64_t value) {
-  histogram_->Increment(value);
+  IncrementBy(value, 1);
 }
 
 void Histogram::IncrementBy(int64_t value, int64_t amount) {
-  histogram_->IncrementBy(value, amount);
+#if defined(__APPLE__)
+  // OSX doesn't have a way to get the CPU, so the shard is picked by thread.
+  static thread_local size_t thread_shard = std::hash<std::thread::id>()(
+      std::this_thread::get_id());
+  size_t shard_idx = thread_shard % kNumShards;
+#else
+  size_t shard_idx = static_cast<size_t>(sched_getcpu()) % kNumShards;
+#endif
+  auto& shard_ref = shards_[shard_idx];
+  auto* shard = shard_ref.load(std::memory_order_acquire);
+  if (PREDICT_TRUE(shard == nullptr)) {
+    if (PREDICT_TRUE(histogram_->TryIncrementBy(value, amount))) {
+      return;
+    }
+    // Some other thread updated the histogram concurrently, so this CPU gets its own shard.
+    std::unique_ptr<HdrHistogram> new_shard(new HdrHistogram(
+        histogram_->highest_trackable_value(), histogram_->num_significant_digits()));
+    if (shard_ref.compare_exchange_strong(shard, new_shard.get(), std::memory_order_acq_rel)) {
+      shard = new_shard.release();
+    }
+  }
+  shard->IncrementBy(value, amount);
+}
+
+std::unique_ptr<HdrHistogram> Histogram::Snapshot() const {
+  std::unique_ptr<HdrHistogram> result(new HdrHistogram(*histogram_));
+  for (const auto& shard_ref : shards_) {
+    auto* shard = shard_ref.load(std::memory_order_acquire);
+    if (shard) {
+      result->MergeFrom(*shard);
+    }
+  }
+  return result;
 }
 
 Status Histogram::WriteAsJson(JsonWriter* writer,
@@ -747,17 +843,16 @@ Status Histogram::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS Histogram::WriteForPrometheus(
     PrometheusWriter* writer, const MetricEntity::AttributeMap& attr) const {
-  HdrHistogram snapshot(*histogram_);
-
+  // Only the sum and count are exported, so the buckets are not copied to a snapshot.
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
-  auto copy_of_attr = attr;
-  RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_sum", snapshot.TotalSum()));
-  RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_count", snapshot.TotalCount()));
+  RETURN_NOT_OK(writer->WriteSingleEntry(attr, hist_name + "_sum", TotalSum()));
+  RETURN_NOT_OK(writer->WriteSingleEntry(attr, hist_name + "_count", TotalCount()));
   /*
   // Copy the label map to add the quatiles.
+  auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
+  auto copy_of_attr = attr;
   copy_of_attr["quantile"] = "0.75";
   RETURN_NOT_OK(writer->WriteSingleEntry(
         copy_of_attr, hist_name, snapshot.ValueAtPercentile(75)));
@@ -780,7 +875,8 @@ CHECKED_STATUS Histogram::WriteForPrometheus(
 
 Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
                                          const MetricJsonOptions& opts) const {
-  HdrHistogram snapshot(*histogram_);
+  auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
   snapshot_pb->set_name(prototype_->name());
   if (opts.include_schema_info) {
     snapshot_pb->set_type(MetricType::Name(prototype_->type()));
@@ -814,22 +910,40 @@ Status Histogram::GetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
 }
 
 uint64_t Histogram::CountInBucketForValueForTests(uint64_t value) const {
-  return histogram_->CountInBucketForValue(value);
+  return Snapshot()->CountInBucketForValue(value);
 }
 
 uint64_t Histogram::TotalCount() const {
-  return histogram_->TotalCount();
+  uint64_t result = histogram_->TotalCount();
+  for (const auto& shard_ref : shards_) {
+    auto* shard = shard_ref.load(std::memory_order_acquire);
+    if (shard) {
+      result += shard->TotalCount();
+    }
+  }
+  return result;
+}
+
+uint64_t Histogram::TotalSum() const {
+  uint64_t result = histogram_->TotalSum();
+  for (const auto& shard_ref : shards_) {
+    auto* shard = shard_ref.load(std::memory_order_acquire);
+    if (shard) {
+      result += shard->TotalSum();
+    }
+  }
+  return result;
 }
 
 uint64_t Histogram::MinValueForTests() const {
-  return histogram_->MinValue();
+  return Snapshot()->MinValue();
 }
 
 uint64_t Histogram::MaxValueForTests() const {
-  return histogram_->MaxValue();
+  return Snapshot()->MaxValue();
 }
 double Histogram::MeanValueForTests() const {
-  return histogram_->MeanValue();
+  return Snapshot()->MeanValue();
 }
 
 ScopedLatencyMetric::ScopedLatencyMetric(
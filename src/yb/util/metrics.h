@@ -239,6 +239,7 @@
 /////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -441,6 +442,32 @@ struct MetricJsonOptions {
   bool include_schema_info;
 };
 
+struct MetricPrometheusOptions {
+  enum class AggregationLevel {
+    // Tablet metrics are summed up per table.
+    kTable,
+    // Tablet metrics are exported per tablet, with the tablet id in the metric_id attribute.
+    kTablet,
+  };
+
+  // Types of the entities to export, e.g. "server" or "tablet". Empty means all types.
+  std::vector<std::string> entity_types;
+
+  // Only metrics with names starting with one of these prefixes are exported. Empty means all
+  // metrics.
+  std::vector<std::string> metric_prefixes;
+
+  // Only tablet metrics of tables with id or name from this list are exported. Empty means all
+  // tables.
+  std::vector<std::string> tables;
+
+  AggregationLevel aggregation_level = AggregationLevel::kTable;
+
+  // Whether the given entity type and metric name pass the filters.
+  bool MatchEntityType(const char* entity_type) const;
+  bool MatchMetricName(const std::string& metric_name) const;
+};
+
 class MetricEntityPrototype {
  public:
   explicit MetricEntityPrototype(const char* name);
@@ -474,7 +501,8 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
   typedef std::unordered_map<std::string, std::string> AttributeMap;
   typedef std::function<void (JsonWriter* writer, const MetricJsonOptions& opts)>
     ExternalJsonMetricsCb;
-  typedef std::function<void (PrometheusWriter* writer)>
+  // Receives the attributes that metrics of the entity are exported with.
+  typedef std::function<void (PrometheusWriter* writer, const AttributeMap& attr)>
     ExternalPrometheusMetricsCb;
 
   scoped_refptr<Counter> FindOrCreateCounter(const CounterPrototype* proto);
@@ -503,6 +531,7 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
                      const std::vector<std::string>& requested_metrics,
                      const MetricJsonOptions& opts) const;
 
+  // Writes the metrics that pass the filters of writer->options().
   CHECKED_STATUS WriteForPrometheus(PrometheusWriter* writer) const;
 
   const MetricMap& UnsafeMetricsMapForTests() const { return metric_map_; }
@@ -583,24 +612,28 @@ typedef scoped_refptr<MetricEntity> MetricEntityPtr;
 
 class PrometheusWriter {
  public:
-  explicit PrometheusWriter(std::stringstream* output)
+  explicit PrometheusWriter(std::stringstream* output,
+                            MetricPrometheusOptions options = MetricPrometheusOptions())
     : output_(output),
+      options_(std::move(options)),
       timestamp_(std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::system_clock::now().time_since_epoch()).count()) {}
 
+  const MetricPrometheusOptions& options() const { return options_; }
+
   template<typename T>
   CHECKED_STATUS WriteSingleEntry(
       const MetricEntity::AttributeMap& attr, const std::string& name, const T& value) {
-    auto it = attr.find("table_id");
+    if (!options_.MatchMetricName(name)) {
+      return Status::OK();
+    }
+    auto it = options_.aggregation_level == MetricPrometheusOptions::AggregationLevel::kTable
+        ? attr.find("table_id") : attr.end();
     if (it != attr.end()) {
-      // For tablet level metrics, we roll up on the table level.
-      if (per_table_attributes_.find(it->second) == per_table_attributes_.end()) {
-        // If it's the first time we see this table, create the aggregate structures.
-        per_table_attributes_[it->second] = attr;
-        per_table_values_[it->second];
-      } else {
-        per_table_values_[it->second][name] += value;
-      }
+      // For tablet level metrics, we roll up on the table level. The attributes of the first
+      // tablet seen are used for the table.
+      per_table_attributes_.emplace(it->second, attr);
+      per_table_values_[it->second][name] += value;
     } else {
       // For non-tablet level metrics, export them directly.
       RETURN_NOT_OK(FlushSingleEntry(attr, name, value));
@@ -646,6 +679,7 @@ class PrometheusWriter {
   std::map<std::string, std::map<std::string, double>> per_table_values_;
   // Output stream
   std::stringstream* output_;
+  const MetricPrometheusOptions options_;
   // Timestamp for all metrics belonging to this writer instance.
   int64_t timestamp_;
 };
@@ -1131,8 +1165,14 @@ class HistogramPrototype : public MetricPrototype {
   DISALLOW_COPY_AND_ASSIGN(HistogramPrototype);
 };
 
+// Values are recorded to a single HdrHistogram until concurrent updates start to collide. After
+// that, the colliding threads record values to per-CPU shards, that are merged into a snapshot when
+// the histogram is read. So a histogram that is updated on the hot path by many threads does not
+// bounce the same cache lines between CPUs, while a rarely used one does not pay for the shards.
 class Histogram : public Metric {
  public:
+  ~Histogram();
+
   // Increment the histogram for the given value.
   // 'value' must be non-negative.
   void Increment(int64_t value);
@@ -1145,6 +1185,9 @@ class Histogram : public Metric {
   // or IncrementBy()).
   uint64_t TotalCount() const;
 
+  // Return the sum of values added to the histogram.
+  uint64_t TotalSum() const;
+
   virtual CHECKED_STATUS WriteAsJson(JsonWriter* w,
                              const MetricJsonOptions& opts) const override;
 
@@ -1165,7 +1208,14 @@ class Histogram : public Metric {
   friend class MetricEntity;
   explicit Histogram(const HistogramPrototype* proto);
 
+  // Returns a (non-consistent) snapshot of the values recorded by all shards.
+  std::unique_ptr<HdrHistogram> Snapshot() const;
+
+  static constexpr size_t kNumShards = 16;
+
   const gscoped_ptr<HdrHistogram> histogram_;
+  // Created on the first collision on histogram_ by the thread running on the corresponding CPU.
+  std::atomic<HdrHistogram*> shards_[kNumShards];
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
 
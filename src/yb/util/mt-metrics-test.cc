@@ -40,6 +40,8 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/debug/leakcheck_disabler.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/histogram.pb.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
@@ -98,6 +100,72 @@ TEST_F(MultiThreadedMetricsTest, CounterIncrementTest) {
   ASSERT_EQ(num_threads * num_increments, counter->value());
 }
 
+METRIC_DEFINE_histogram(test_entity, test_histogram, "Test Histogram",
+                        MetricUnit::kMicroseconds, "Test histogram", 60000000LU, 2);
+
+// Record values 1..100 to a histogram a bunch of times.
+template <class HistogramType>
+static void IncrementHistogram(HistogramType* histogram, int num_increments) {
+  for (int i = 0; i < num_increments; i++) {
+    histogram->Increment(1 + i % 100);
+  }
+}
+
+// Ensure that incrementing a histogram is thread-safe, including the values recorded to shards.
+TEST_F(MultiThreadedMetricsTest, HistogramIncrementTest) {
+  scoped_refptr<MetricEntity> entity = METRIC_ENTITY_test_entity.Instantiate(&registry_, "my-test");
+  scoped_refptr<Histogram> histogram = METRIC_test_histogram.Instantiate(entity);
+  int num_threads = std::max(FLAGS_mt_metrics_test_num_threads, 8);
+  int num_increments = 10000;
+  std::function<void()> f = std::bind(
+      IncrementHistogram<Histogram>, histogram.get(), num_increments);
+  RunWithManyThreads(&f, num_threads);
+  ASSERT_EQ(num_threads * num_increments, histogram->TotalCount());
+  ASSERT_EQ(1, histogram->MinValueForTests());
+  ASSERT_EQ(100, histogram->MaxValueForTests());
+  ASSERT_DOUBLE_EQ(50.5, histogram->MeanValueForTests());
+  ASSERT_EQ(num_threads * num_increments / 100, histogram->CountInBucketForValueForTests(42));
+
+  HistogramSnapshotPB snapshot;
+  ASSERT_OK(histogram->GetHistogramSnapshotPB(&snapshot, MetricJsonOptions()));
+  ASSERT_EQ(num_threads * num_increments, snapshot.total_count());
+}
+
+// Compares the cost of recording values to a single HdrHistogram with the cost of recording them
+// to a sharded Histogram, when many threads update the same histogram.
+TEST_F(MultiThreadedMetricsTest, HistogramContentionBenchmark) {
+  scoped_refptr<MetricEntity> entity = METRIC_ENTITY_test_entity.Instantiate(&registry_, "my-test");
+  int num_increments = AllowSlowTests() ? 1000000 : 10000;
+  for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    HdrHistogram hdr_histogram(METRIC_test_histogram.max_trackable_value(),
+                               METRIC_test_histogram.num_sig_digits());
+    std::function<void()> hdr_f = std::bind(
+        IncrementHistogram<HdrHistogram>, &hdr_histogram, num_increments);
+    auto start = MonoTime::Now();
+    RunWithManyThreads(&hdr_f, num_threads);
+    auto hdr_time = MonoTime::Now() - start;
+    ASSERT_EQ(num_threads * num_increments, hdr_histogram.TotalCount());
+
+    // Histograms are owned by the entity, so each round gets its own one.
+    auto proto = std::make_unique<HistogramPrototype>(
+        MetricPrototype::CtorArgs(
+            "test_entity", "test_histogram", "Test Histogram", MetricUnit::kMicroseconds,
+            "Test histogram"),
+        METRIC_test_histogram.max_trackable_value(), METRIC_test_histogram.num_sig_digits());
+    scoped_refptr<Histogram> histogram = proto->Instantiate(entity);
+    std::function<void()> f = std::bind(
+        IncrementHistogram<Histogram>, histogram.get(), num_increments);
+    start = MonoTime::Now();
+    RunWithManyThreads(&f, num_threads);
+    auto sharded_time = MonoTime::Now() - start;
+    ASSERT_EQ(num_threads * num_increments, histogram->TotalCount());
+    entity->Remove(proto.get());
+
+    LOG(INFO) << num_threads << " threads, " << num_increments << " increments per thread: "
+              << "HdrHistogram " << hdr_time << ", sharded Histogram " << sharded_time;
+  }
+}
+
 // Helper function to register a bunch of counters in a loop.
 void MultiThreadedMetricsTest::RegisterCounters(
     const scoped_refptr<MetricEntity>& metric_entity,
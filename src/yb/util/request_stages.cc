@@ -0,0 +1,135 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/util/request_stages.h"
+
+#include "yb/gutil/stringprintf.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/trace.h"
+
+METRIC_DEFINE_histogram(server, request_stage_queue_wait, "Request Queue Wait Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent by requests in the RPC service queue",
+                        60000000LU, 2);
+
+METRIC_DEFINE_histogram(server, request_stage_lock_wait, "Request Lock Wait Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent by writes on acquiring in-memory locks",
+                        60000000LU, 2);
+
+METRIC_DEFINE_histogram(server, request_stage_conflict_resolution,
+                        "Request Conflict Resolution Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent by writes on resolving conflicts with transactions",
+                        60000000LU, 2);
+
+METRIC_DEFINE_histogram(server, request_stage_replication, "Request Replication Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds from appending an operation to the Raft log until it is "
+                        "replicated to the majority",
+                        60000000LU, 2);
+
+METRIC_DEFINE_histogram(server, request_stage_apply, "Request Apply Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent on applying replicated operations to RocksDB",
+                        60000000LU, 2);
+
+METRIC_DEFINE_histogram(server, request_stage_read, "Request Read Time",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent by the tablet on executing reads, including reading "
+                        "the rows from DocDB and building the response",
+                        60000000LU, 2);
+
+namespace yb {
+
+namespace {
+
+HistogramPrototype* const kStagePrototypes[] = {
+  &METRIC_request_stage_queue_wait,
+  &METRIC_request_stage_lock_wait,
+  &METRIC_request_stage_conflict_resolution,
+  &METRIC_request_stage_replication,
+  &METRIC_request_stage_apply,
+  &METRIC_request_stage_read,
+};
+
+static_assert(arraysize(kStagePrototypes) == kRequestStageMapSize,
+              "Histogram should be defined for each request stage");
+
+} // namespace
+
+void RequestStages::MergeFrom(const RequestStages& other) {
+  for (auto stage : kRequestStageList) {
+    auto nanos = other.GetNanos(stage);
+    if (nanos != 0) {
+      AddNanos(stage, nanos);
+    }
+  }
+}
+
+bool RequestStages::empty() const {
+  for (const auto& nanos : nanos_) {
+    if (nanos.load(std::memory_order_relaxed) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string RequestStages::ToString() const {
+  std::string result;
+  for (auto stage : kRequestStageList) {
+    auto nanos = GetNanos(stage);
+    if (nanos == 0) {
+      continue;
+    }
+    if (!result.empty()) {
+      result += ", ";
+    }
+    // Skip the 'k' prefix of the enum value.
+    StringAppendF(&result, "%s: %.3fms", ToCString(stage) + 1, nanos / 1e6);
+  }
+  return result;
+}
+
+RequestStageMetrics::RequestStageMetrics(const scoped_refptr<MetricEntity>& entity) {
+  for (auto stage : kRequestStageList) {
+    histograms_[to_underlying(stage)] = kStagePrototypes[to_underlying(stage)]->Instantiate(entity);
+  }
+}
+
+RequestStageMetrics::~RequestStageMetrics() {
+}
+
+void RequestStageMetrics::Record(RequestStage stage, MonoDelta duration) {
+  histograms_[to_underlying(stage)]->Increment(duration.ToMicroseconds());
+}
+
+void RecordRequestStage(RequestStage stage, MonoDelta duration) {
+  RecordRequestStage(Trace::CurrentTrace(), stage, duration);
+}
+
+void RecordRequestStage(Trace* trace, RequestStage stage, MonoDelta duration) {
+  if (!trace) {
+    return;
+  }
+  trace->stages().Add(stage, duration);
+  auto* metrics = trace->stage_metrics();
+  if (metrics) {
+    metrics->Record(stage, duration);
+  }
+}
+
+} // namespace yb
@@ -0,0 +1,135 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_UTIL_REQUEST_STAGES_H
+#define YB_UTIL_REQUEST_STAGES_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "yb/gutil/macros.h"
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+class Histogram;
+class MetricEntity;
+class Trace;
+
+// Stages of request processing, whose durations are tracked separately for each request.
+// Stage ids are sent over the wire, so new stages should be added only to the end.
+YB_DEFINE_ENUM(RequestStage,
+    // Time spent by the call in the queue of the RPC service.
+    (kQueueWait)
+    // Acquiring in-memory locks for the keys of a write.
+    (kLockWait)
+    // Resolving conflicts of a write with other transactions.
+    (kConflictResolution)
+    // From appending an operation to the Raft log until it is replicated to the majority. Includes
+    // the local WAL write and sync.
+    (kReplication)
+    // Applying a replicated operation to RocksDB.
+    (kApply)
+    // Executing a read by the tablet: checking the schema version, reading the rows from DocDB and
+    // building the response.
+    (kRead));
+
+// Total time spent by a request in each stage. Stages use preallocated slots, so recording a stage
+// does not allocate or take locks.
+//
+// This class is thread-safe.
+class RequestStages {
+ public:
+  RequestStages() {
+    for (auto& nanos : nanos_) {
+      nanos.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void Add(RequestStage stage, MonoDelta duration) {
+    AddNanos(stage, duration.ToNanoseconds());
+  }
+
+  void AddNanos(RequestStage stage, int64_t nanos) {
+    nanos_[to_underlying(stage)].fetch_add(nanos, std::memory_order_relaxed);
+  }
+
+  int64_t GetNanos(RequestStage stage) const {
+    return nanos_[to_underlying(stage)].load(std::memory_order_relaxed);
+  }
+
+  void MergeFrom(const RequestStages& other);
+
+  bool empty() const;
+
+  // Returns non-empty stages, e.g. "QueueWait: 0.120ms, Replication: 2.512ms".
+  std::string ToString() const;
+
+ private:
+  std::array<std::atomic<int64_t>, kRequestStageMapSize> nanos_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestStages);
+};
+
+// Per-stage latency histograms of a server. Each server creates its own instance on its metric
+// entity and attaches it to the traces of the calls it handles, see Trace::set_stage_metrics.
+//
+// This class is thread-safe.
+class RequestStageMetrics {
+ public:
+  explicit RequestStageMetrics(const scoped_refptr<MetricEntity>& entity);
+  ~RequestStageMetrics();
+
+  void Record(RequestStage stage, MonoDelta duration);
+
+ private:
+  std::array<scoped_refptr<Histogram>, kRequestStageMapSize> histograms_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestStageMetrics);
+};
+
+typedef std::shared_ptr<RequestStageMetrics> RequestStageMetricsPtr;
+
+// Records that the current request spent 'duration' in the given stage. The duration is added to
+// the current trace, if there is one, and to the stage histogram of the server the trace belongs
+// to.
+void RecordRequestStage(RequestStage stage, MonoDelta duration);
+
+// Same as above, but adds the duration to the given trace.
+void RecordRequestStage(Trace* trace, RequestStage stage, MonoDelta duration);
+
+// Records the time from its construction to its destruction as the given stage.
+class ScopedRequestStage {
+ public:
+  explicit ScopedRequestStage(RequestStage stage) : stage_(stage), start_(MonoTime::Now()) {}
+
+  ~ScopedRequestStage() {
+    RecordRequestStage(stage_, MonoTime::Now() - start_);
+  }
+
+ private:
+  const RequestStage stage_;
+  const MonoTime start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedRequestStage);
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_REQUEST_STAGES_H
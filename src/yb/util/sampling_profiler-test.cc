@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "yb/util/sampling_profiler.h"
+#include "yb/util/test_util.h"
+#include "yb/util/thread.h"
+
+namespace yb {
+
+class SamplingProfilerTest : public YBTest {};
+
+TEST_F(SamplingProfilerTest, ThreadGroupFromName) {
+  ASSERT_EQ("rpc_tp_TabletServer", ThreadGroupFromName("rpc_tp_TabletServer_3"));
+  ASSERT_EQ("raft", ThreadGroupFromName("raft [worker]"));
+  ASSERT_EQ("rocksdb:high", ThreadGroupFromName("rocksdb:high:12"));
+  ASSERT_EQ("acceptor", ThreadGroupFromName("acceptor"));
+  ASSERT_EQ("ipv6", ThreadGroupFromName("ipv6"));
+  ASSERT_EQ("other", ThreadGroupFromName(""));
+}
+
+#if defined(__linux__)
+
+TEST_F(SamplingProfilerTest, CollectStacks) {
+  FLAGS_sampling_profiler_frequency_hz = 200;
+  ASSERT_OK(StartSamplingProfiler());
+
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> counter{0};
+  scoped_refptr<Thread> thread;
+  ASSERT_OK(Thread::Create("test", "burner_1", [&stop, &counter] {
+    while (!stop.load(std::memory_order_acquire)) {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  }, &thread));
+  // Let the profiler drain the samples of the busy thread.
+  SleepFor(MonoDelta::FromSeconds(3));
+  stop.store(true, std::memory_order_release);
+  thread->Join();
+
+  std::stringstream out;
+  WriteFoldedStacks(MonoDelta::FromSeconds(60), MonoDelta::FromSeconds(0), &out);
+  LOG(INFO) << "Folded stacks: " << out.str();
+  ASSERT_STR_CONTAINS(out.str(), "burner;");
+
+  // Samples are not in the window that ended before the profiler started.
+  std::stringstream past_out;
+  WriteFoldedStacks(MonoDelta::FromSeconds(60), MonoDelta::FromSeconds(600), &past_out);
+  ASSERT_EQ("", past_out.str());
+}
+
+#endif // defined(__linux__)
+
+} // namespace yb
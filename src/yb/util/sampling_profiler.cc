@@ -0,0 +1,393 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/sampling_profiler.h"
+
+#include <signal.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include "yb/gutil/stringprintf.h"
+#include "yb/gutil/strings/util.h"
+#include "yb/util/debug-util.h"
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+
+DEFINE_int32(sampling_profiler_frequency_hz, 10,
+             "Number of stack samples taken by the continuous sampling profiler per second of "
+             "the process CPU time. 0 disables the profiler.");
+TAG_FLAG(sampling_profiler_frequency_hz, advanced);
+
+DEFINE_int32(sampling_profiler_retention_secs, 600,
+             "For how long samples of the continuous sampling profiler are kept.");
+TAG_FLAG(sampling_profiler_retention_secs, advanced);
+TAG_FLAG(sampling_profiler_retention_secs, runtime);
+
+// GLog already implements symbolization. Just import their hidden symbol.
+namespace google {
+// Symbolizes a program counter.  On success, returns true and write the
+// symbol name to "out".  The symbol name is demangled if possible
+// (supports symbols generated by GCC 3.x or newer).  Otherwise,
+// returns false.
+bool Symbolize(void *pc, char *out, int out_size);
+}
+
+namespace yb {
+
+namespace {
+
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+// Older glibc does not expose the thread id field used with SIGEV_THREAD_ID.
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+// Number of samples that could be taken between two drains of the buffer.
+constexpr size_t kMaxSamples = 4096;
+constexpr size_t kMaxThreadNameLength = 32;
+// Offset of the profiler signal from SIGRTMIN. SIGPROF is not used, so the profiler does not
+// interfere with on-demand gperftools CPU profiles.
+constexpr int kSignalOffset = 3;
+
+const auto kDrainInterval = 1s;
+// Samples drained during this interval are aggregated together.
+const auto kAggregationInterval = 10s;
+
+struct Sample {
+  enum State {
+    kEmpty,
+    kWriting,
+    kReady,
+  };
+
+  std::atomic<int> state{kEmpty};
+  char thread_name[kMaxThreadNameLength];
+  StackTrace stack;
+};
+
+struct StackKey {
+  std::string thread_group;
+  StackTrace stack;
+
+  bool operator==(const StackKey& rhs) const {
+    return thread_group == rhs.thread_group && stack.Equals(rhs.stack);
+  }
+};
+
+struct StackKeyHash {
+  size_t operator()(const StackKey& key) const {
+    return std::hash<std::string>()(key.thread_group) ^ key.stack.HashCode();
+  }
+};
+
+typedef std::unordered_map<StackKey, int64_t, StackKeyHash> StackCounts;
+
+class SamplingProfiler {
+ public:
+  // Installs the signal handler and starts the drain thread. Leaves no state behind on failure.
+  CHECKED_STATUS Start();
+
+  // Called from the signal handler, so it should be async-signal-safe.
+  void TakeSample();
+
+  // Creates a timer that signals the calling thread every interval_ns_ of its CPU time.
+  CHECKED_STATUS StartThreadTimer();
+
+  void Write(MonoDelta window, MonoDelta end_ago, std::ostream* out);
+
+ private:
+  struct Interval {
+    CoarseTimePoint start;
+    StackCounts counts;
+  };
+
+  void Run();
+
+  // Moves the samples from samples_ to intervals_.
+  void Drain();
+
+  int signum_ = 0;
+  int64_t interval_ns_ = 0;
+
+  Sample samples_[kMaxSamples];
+  std::atomic<size_t> next_sample_{0};
+  std::atomic<int64_t> dropped_samples_{0};
+
+  std::mutex mutex_;
+  // Aggregated samples in the order of time.
+  std::deque<Interval> intervals_;
+
+  scoped_refptr<Thread> thread_;
+};
+
+std::atomic<SamplingProfiler*> g_profiler{nullptr};
+
+// CPU time timer of the current thread, if it is sampled.
+thread_local bool t_has_timer = false;
+thread_local timer_t t_timer;
+
+void HandleProfilerSignal(int signum, siginfo_t* info, void* context) {
+  int old_errno = errno;
+  auto* profiler = g_profiler.load(std::memory_order_acquire);
+  if (profiler) {
+    profiler->TakeSample();
+  }
+  errno = old_errno;
+}
+
+void SamplingProfiler::TakeSample() {
+  Sample& sample = samples_[next_sample_.fetch_add(1, std::memory_order_relaxed) % kMaxSamples];
+  int expected = Sample::kEmpty;
+  if (!sample.state.compare_exchange_strong(expected, Sample::kWriting,
+                                            std::memory_order_acquire)) {
+    // The buffer is full, i.e. the samples were not drained for a while.
+    dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Thread* thread = Thread::current_thread();
+  const char* name = thread ? thread->name().c_str() : "";
+  size_t length = 0;
+  while (length + 1 < kMaxThreadNameLength && name[length]) {
+    sample.thread_name[length] = name[length];
+    ++length;
+  }
+  sample.thread_name[length] = 0;
+  // Skip Collect(), this function and the signal handler.
+  sample.stack.Collect(3);
+
+  sample.state.store(Sample::kReady, std::memory_order_release);
+}
+
+Status SamplingProfiler::Start() {
+#if defined(__linux__)
+  signum_ = SIGRTMIN + kSignalOffset;
+  interval_ns_ = MonoTime::kNanosecondsPerSecond / FLAGS_sampling_profiler_frequency_hz;
+  struct sigaction old_act;
+  if (sigaction(signum_, nullptr, &old_act) != 0) {
+    return STATUS(RuntimeError, "Failed to get signal handler", ErrnoToString(errno), errno);
+  }
+  if (old_act.sa_handler != SIG_DFL && old_act.sa_handler != SIG_IGN) {
+    return STATUS_FORMAT(IllegalState, "Handler for signal $0 is already in use", signum_);
+  }
+
+  struct sigaction act;
+  memset(&act, 0, sizeof(act));
+  act.sa_sigaction = &HandleProfilerSignal;
+  act.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&act.sa_mask);
+  if (sigaction(signum_, &act, nullptr) != 0) {
+    return STATUS(RuntimeError, "Failed to set signal handler", ErrnoToString(errno), errno);
+  }
+
+  Status status = Thread::Create("profiler", "sampling-profiler", &SamplingProfiler::Run, this,
+                                 &thread_);
+  if (!status.ok()) {
+    sigaction(signum_, &old_act, nullptr);
+    return status;
+  }
+
+  LOG(INFO) << "Started sampling profiler, frequency: " << FLAGS_sampling_profiler_frequency_hz
+            << "Hz, signal: " << signum_;
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Sampling profiler is supported only on Linux");
+#endif
+}
+
+Status SamplingProfiler::StartThreadTimer() {
+#if defined(__linux__)
+  // A process CPU time timer sends a process-directed signal, that kernels before 6.4 deliver to
+  // the thread group leader rather than to the running thread. So each thread gets a timer on its
+  // own CPU time clock, signaling that thread, and the samples are distributed between threads
+  // proportionally to the CPU time they use.
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = signum_;
+  event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+  timer_t timer;
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+    return STATUS(RuntimeError, "Failed to create timer", ErrnoToString(errno), errno);
+  }
+
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = interval_ns_ / MonoTime::kNanosecondsPerSecond;
+  spec.it_interval.tv_nsec = interval_ns_ % MonoTime::kNanosecondsPerSecond;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+    auto status = STATUS(RuntimeError, "Failed to start timer", ErrnoToString(errno), errno);
+    timer_delete(timer);
+    return status;
+  }
+
+  t_timer = timer;
+  t_has_timer = true;
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Sampling profiler is supported only on Linux");
+#endif
+}
+
+void SamplingProfiler::Run() {
+  for (;;) {
+    SleepFor(kDrainInterval);
+    Drain();
+  }
+}
+
+void SamplingProfiler::Drain() {
+  StackCounts counts;
+  for (auto& sample : samples_) {
+    if (sample.state.load(std::memory_order_acquire) != Sample::kReady) {
+      continue;
+    }
+    ++counts[StackKey{ThreadGroupFromName(sample.thread_name), sample.stack}];
+    sample.state.store(Sample::kEmpty, std::memory_order_release);
+  }
+
+  auto dropped = dropped_samples_.exchange(0, std::memory_order_relaxed);
+  YB_LOG_IF_EVERY_N(WARNING, dropped != 0, 100)
+      << "Sampling profiler dropped " << dropped << " samples";
+
+  auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (intervals_.empty() || now - intervals_.back().start >= kAggregationInterval) {
+    intervals_.push_back(Interval{now, StackCounts()});
+  }
+  auto& interval_counts = intervals_.back().counts;
+  for (const auto& entry : counts) {
+    interval_counts[entry.first] += entry.second;
+  }
+
+  auto retention = std::chrono::seconds(FLAGS_sampling_profiler_retention_secs);
+  while (!intervals_.empty() && intervals_.front().start + kAggregationInterval < now - retention) {
+    intervals_.pop_front();
+  }
+}
+
+void SamplingProfiler::Write(MonoDelta window, MonoDelta end_ago, std::ostream* out) {
+  auto end = CoarseMonoClock::Now() - end_ago.ToSteadyDuration();
+  auto start = end - window.ToSteadyDuration();
+  StackCounts counts;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& interval : intervals_) {
+      if (interval.start < end && interval.start + kAggregationInterval > start) {
+        for (const auto& entry : interval.counts) {
+          counts[entry.first] += entry.second;
+        }
+      }
+    }
+  }
+
+  std::unordered_map<void*, std::string> symbols;
+  for (const auto& entry : counts) {
+    *out << entry.first.thread_group;
+    const auto& stack = entry.first.stack;
+    for (int i = stack.num_frames(); i-- > 0;) {
+      void* pc = stack.frame(i);
+      auto it = symbols.find(pc);
+      if (it == symbols.end()) {
+        char buf[1024];
+        // Point to the call instruction instead of the return address.
+        void* call_pc = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(pc) - 1);
+        std::string symbol = google::Symbolize(call_pc, buf, sizeof(buf))
+            ? buf : StringPrintf("%p", pc);
+        // ';' separates frames, and ' ' separates the count in the folded format.
+        std::replace(symbol.begin(), symbol.end(), ';', ':');
+        std::replace(symbol.begin(), symbol.end(), ' ', '_');
+        it = symbols.emplace(pc, std::move(symbol)).first;
+      }
+      *out << ';' << it->second;
+    }
+    *out << ' ' << entry.second << '\n';
+  }
+}
+
+} // namespace
+
+Status StartSamplingProfiler() {
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (g_profiler.load(std::memory_order_acquire) || FLAGS_sampling_profiler_frequency_hz <= 0) {
+    return Status::OK();
+  }
+
+  auto profiler = std::make_unique<SamplingProfiler>();
+  RETURN_NOT_OK(profiler->Start());
+  // The profiler lives until the process exits, because the signal could be delivered at any time.
+  g_profiler.store(profiler.release(), std::memory_order_release);
+  StartThreadSampling();
+  return Status::OK();
+}
+
+void StartThreadSampling() {
+  auto* profiler = g_profiler.load(std::memory_order_acquire);
+  if (!profiler || t_has_timer) {
+    return;
+  }
+  auto status = profiler->StartThreadTimer();
+  YB_LOG_IF_EVERY_N(WARNING, !status.ok(), 100) << "Failed to sample thread: " << status;
+}
+
+void StopThreadSampling() {
+  if (t_has_timer) {
+    timer_delete(t_timer);
+    t_has_timer = false;
+  }
+}
+
+void WriteFoldedStacks(MonoDelta window, MonoDelta end_ago, std::ostream* out) {
+  auto* profiler = g_profiler.load(std::memory_order_acquire);
+  if (profiler) {
+    profiler->Write(window, end_ago, out);
+  }
+}
+
+std::string ThreadGroupFromName(const std::string& thread_name) {
+  static const std::string kWorkerSuffix = " [worker]";
+  std::string result = thread_name;
+  if (HasSuffixString(result, kWorkerSuffix)) {
+    result.resize(result.size() - kWorkerSuffix.size());
+  }
+
+  // Strip the worker index with its separator.
+  size_t length = result.size();
+  while (length > 0 && isdigit(result[length - 1])) {
+    --length;
+  }
+  if (length < result.size() && length > 0 &&
+      (result[length - 1] == '_' || result[length - 1] == ':' || result[length - 1] == '-')) {
+    result.resize(length - 1);
+  }
+
+  return result.empty() ? "other" : result;
+}
+
+} // namespace yb
@@ -0,0 +1,66 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_SAMPLING_PROFILER_H
+#define YB_UTIL_SAMPLING_PROFILER_H
+
+#include <iosfwd>
+#include <string>
+
+#include <gflags/gflags.h>
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+DECLARE_int32(sampling_profiler_frequency_hz);
+DECLARE_int32(sampling_profiler_retention_secs);
+
+namespace yb {
+
+// Continuous process-wide CPU profiler.
+//
+// A CPU time timer of each thread interrupts it sampling_profiler_frequency_hz times per second of
+// its CPU time, and the signal handler records the stack of the thread to a lock-free buffer.
+// Threads started with yb::Thread, and the thread that starts the profiler, are sampled. A
+// background thread moves the samples from this buffer to per-interval aggregates, that are kept
+// for sampling_profiler_retention_secs. So the profile for a latency spike is available after the
+// fact.
+//
+// Samples are tagged with the thread group, i.e. the name of the thread without the worker index,
+// so stacks of the RPC workers, Raft, apply or RocksDB compaction threads are easy to tell apart.
+
+// Starts the profiler, unless it is disabled by the flag or is already running.
+CHECKED_STATUS StartSamplingProfiler();
+
+// Starts sampling the calling thread if the profiler is running. Called by yb::Thread for every
+// thread it starts.
+void StartThreadSampling();
+
+// Stops sampling the calling thread. Should be called before the thread exits.
+void StopThreadSampling();
+
+// Writes the stacks sampled during the last 'window' that ended 'end_ago' before now, in the
+// folded format used by flame graph tools. One line per distinct stack:
+//   <thread group>;<outermost frame>;...;<innermost frame> <number of samples>
+//
+// Samples are aggregated per intervals of several seconds, so the window is rounded to the
+// intervals that intersect it.
+void WriteFoldedStacks(MonoDelta window, MonoDelta end_ago, std::ostream* out);
+
+// Returns the thread group for the thread with the given name, e.g. "rpc_tp_TabletServer" for
+// "rpc_tp_TabletServer_3" and "raft" for "raft [worker]".
+std::string ThreadGroupFromName(const std::string& thread_name);
+
+} // namespace yb
+
+#endif // YB_UTIL_SAMPLING_PROFILER_H
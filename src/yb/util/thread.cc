@@ -60,6 +60,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/mutex.h"
 #include "yb/util/os-util.h"
+#include "yb/util/sampling_profiler.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/url-coding.h"
 #include "yb/util/web_callback_registry.h"
@@ -595,6 +596,7 @@ void* Thread::SuperviseThread(void* arg) {
 
   thread_manager->SetThreadName(name, t->tid());
   thread_manager->AddThread(pthread_self(), name, t->category(), t->tid());
+  StartThreadSampling();
 
   // FinishThread() is guaranteed to run (even if functor_ throws an
   // exception) because pthread_cleanup_push() creates a scoped object
@@ -613,6 +615,8 @@ void Thread::FinishThread(void* arg) {
     c.Run();
   }
 
+  StopThreadSampling();
+
   // We're here either because of the explicit pthread_cleanup_pop() in
   // SuperviseThread() or through pthread_exit(). In either case,
   // thread_manager is guaranteed to be live because thread_mgr_ref in
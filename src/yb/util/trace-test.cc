@@ -41,6 +41,7 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/debug/trace_event_synthetic_delay.h"
 #include "yb/util/debug/trace_logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 
@@ -52,6 +53,9 @@ using rapidjson::Value;
 using std::string;
 using std::vector;
 
+METRIC_DECLARE_histogram(request_stage_queue_wait);
+METRIC_DECLARE_histogram(request_stage_replication);
+
 namespace yb {
 
 class TraceTest : public YBTest {
@@ -121,6 +125,64 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestRequestStages) {
+  scoped_refptr<Trace> traceA(new Trace);
+  scoped_refptr<Trace> traceB(new Trace);
+  {
+    ADOPT_TRACE(traceA.get());
+    traceA->AddChildTrace(traceB.get());
+    RecordRequestStage(RequestStage::kQueueWait, MonoDelta::FromMicroseconds(100));
+    RecordRequestStage(RequestStage::kQueueWait, MonoDelta::FromMicroseconds(20));
+  }
+  RecordRequestStage(traceB.get(), RequestStage::kReplication, MonoDelta::FromMilliseconds(3));
+  RecordRequestStage(traceB.get(), RequestStage::kQueueWait, MonoDelta::FromMicroseconds(5));
+  // Not recorded anywhere, since there is no current trace.
+  RecordRequestStage(RequestStage::kApply, MonoDelta::FromMilliseconds(1));
+
+  ASSERT_EQ(120000, traceA->stages().GetNanos(RequestStage::kQueueWait));
+  ASSERT_EQ(0, traceA->stages().GetNanos(RequestStage::kReplication));
+
+  RequestStages stages;
+  ASSERT_TRUE(stages.empty());
+  traceA->CollectStages(&stages);
+  ASSERT_FALSE(stages.empty());
+  ASSERT_EQ(125000, stages.GetNanos(RequestStage::kQueueWait));
+  ASSERT_EQ(3000000, stages.GetNanos(RequestStage::kReplication));
+  ASSERT_EQ(0, stages.GetNanos(RequestStage::kApply));
+  ASSERT_EQ("QueueWait: 0.125ms, Replication: 3.000ms", stages.ToString());
+}
+
+// Stages are recorded to the histograms of the server the trace belongs to, which are inherited by
+// the child traces.
+TEST_F(TraceTest, TestRequestStageMetrics) {
+  MetricRegistry registry;
+  auto entity1 = METRIC_ENTITY_server.Instantiate(&registry, "server1");
+  auto entity2 = METRIC_ENTITY_server.Instantiate(&registry, "server2");
+
+  scoped_refptr<Trace> traceA(new Trace);
+  scoped_refptr<Trace> traceB(new Trace);
+  scoped_refptr<Trace> traceC(new Trace);
+  traceA->set_stage_metrics(std::make_shared<RequestStageMetrics>(entity1));
+  traceA->AddChildTrace(traceB.get());
+  traceC->set_stage_metrics(std::make_shared<RequestStageMetrics>(entity2));
+
+  RecordRequestStage(traceA.get(), RequestStage::kQueueWait, MonoDelta::FromMicroseconds(100));
+  RecordRequestStage(traceB.get(), RequestStage::kReplication, MonoDelta::FromMilliseconds(3));
+  RecordRequestStage(traceC.get(), RequestStage::kQueueWait, MonoDelta::FromMicroseconds(7));
+
+  auto queue_wait1 = METRIC_request_stage_queue_wait.Instantiate(entity1);
+  auto replication1 = METRIC_request_stage_replication.Instantiate(entity1);
+  auto queue_wait2 = METRIC_request_stage_queue_wait.Instantiate(entity2);
+  auto replication2 = METRIC_request_stage_replication.Instantiate(entity2);
+  ASSERT_EQ(1, queue_wait1->TotalCount());
+  ASSERT_EQ(100, queue_wait1->TotalSum());
+  ASSERT_EQ(1, replication1->TotalCount());
+  ASSERT_EQ(3000, replication1->TotalSum());
+  ASSERT_EQ(1, queue_wait2->TotalCount());
+  ASSERT_EQ(7, queue_wait2->TotalSum());
+  ASSERT_EQ(0, replication2->TotalCount());
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
@@ -351,6 +351,9 @@ void Trace::DumpCurrentTrace() {
 
 void Trace::AddChildTrace(Trace* child_trace) {
   CHECK_NOTNULL(child_trace);
+  if (!child_trace->stage_metrics_) {
+    child_trace->stage_metrics_ = stage_metrics_;
+  }
   {
     std::lock_guard<simple_spinlock> l(lock_);
     scoped_refptr<Trace> ptr(child_trace);
@@ -359,6 +362,18 @@ void Trace::AddChildTrace(Trace* child_trace) {
   CHECK(!child_trace->HasOneRef());
 }
 
+void Trace::CollectStages(RequestStages* out) const {
+  out->MergeFrom(stages_);
+  vector<scoped_refptr<Trace> > child_traces;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    child_traces = child_traces_;
+  }
+  for (const auto& child_trace : child_traces) {
+    child_trace->CollectStages(out);
+  }
+}
+
 PlainTrace::PlainTrace() {
 }
 
@@ -49,6 +49,7 @@
 #include "yb/util/atomic.h"
 #include "yb/util/locks.h"
 #include "yb/util/memory/arena_fwd.h"
+#include "yb/util/request_stages.h"
 
 DECLARE_bool(enable_tracing);
 
@@ -153,9 +154,28 @@ class Trace : public RefCountedThreadSafe<Trace> {
   // Dump the trace buffer as a string.
   std::string DumpToString(bool include_time_deltas) const;
 
-  // Attaches the given trace which will get appended at the end when Dumping.
+  // Attaches the given trace which will get appended at the end when Dumping. The child trace
+  // inherits the stage metrics of this trace, unless it has its own.
   void AddChildTrace(Trace* child_trace);
 
+  // Durations of the request stages recorded directly to this trace.
+  RequestStages& stages() {
+    return stages_;
+  }
+
+  // Adds durations of the request stages recorded to this trace and its child traces to 'out'.
+  void CollectStages(RequestStages* out) const;
+
+  // Histograms of the server handling the request, which get the stages recorded to this trace.
+  // Should be set before the trace is shared with other threads.
+  void set_stage_metrics(RequestStageMetricsPtr stage_metrics) {
+    stage_metrics_ = std::move(stage_metrics);
+  }
+
+  RequestStageMetrics* stage_metrics() const {
+    return stage_metrics_.get();
+  }
+
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
     return threadlocal_trace_;
@@ -198,6 +218,10 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   std::vector<scoped_refptr<Trace> > child_traces_;
 
+  RequestStages stages_;
+
+  RequestStageMetricsPtr stage_metrics_;
+
   DISALLOW_COPY_AND_ASSIGN(Trace);
 };
 
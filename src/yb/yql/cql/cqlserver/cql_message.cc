@@ -16,6 +16,8 @@
 
 #include <regex>
 
+#include <gflags/gflags.h>
+
 #include "yb/client/client.h"
 #include "yb/common/ql_protocol.pb.h"
 #include "yb/yql/cql/cqlserver/cql_message.h"
@@ -23,6 +25,13 @@
 
 #include "yb/gutil/endian.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(cql_follower_read_max_staleness_ms, 0,
+             "Reads with consistency level ONE are served by the closest replica whose safe time "
+             "is at most this many milliseconds behind. Zero means any replica could serve them.");
+TAG_FLAG(cql_follower_read_max_staleness_ms, evolving);
+TAG_FLAG(cql_follower_read_max_staleness_ms, runtime);
 
 namespace yb {
 namespace cqlserver {
@@ -148,6 +157,10 @@ Status CQLMessage::QueryParameters::ValidateConsistency() {
       // Here we repurpose cassandra's ONE consistency level to be CONSISTENT_PREFIX for us since
       // that seems to be the most appropriate.
       set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      if (FLAGS_cql_follower_read_max_staleness_ms > 0) {
+        set_follower_read_max_staleness(
+            MonoDelta::FromMilliseconds(FLAGS_cql_follower_read_max_staleness_ms));
+      }
       break;
     }
     default:
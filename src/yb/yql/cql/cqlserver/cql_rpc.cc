@@ -32,8 +32,6 @@ using namespace std::placeholders;
 using yb::operator"" _KB;
 using yb::operator"" _MB;
 
-DECLARE_bool(rpc_dump_all_traces);
-DECLARE_int32(rpc_slow_query_threshold_ms);
 DEFINE_int32(rpcz_max_cql_query_dump_size, 4_KB,
              "The maximum size of the CQL query string in the RPCZ dump.");
 DEFINE_int32(rpcz_max_cql_batch_dump_count, 4_KB,
@@ -267,8 +265,9 @@ void CQLInboundCall::GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_p
 void CQLInboundCall::LogTrace() const {
   MonoTime now = MonoTime::Now();
   int total_time = now.GetDeltaSince(timing_.time_received).ToMilliseconds();
-  if (PREDICT_FALSE(FLAGS_rpc_dump_all_traces || total_time > FLAGS_rpc_slow_query_threshold_ms)) {
-      LOG(WARNING) << ToString() << " took " << total_time << "ms. Details:";
+  if (PREDICT_FALSE(ShouldLogSlowQuery(total_time))) {
+      LOG(WARNING) << ToString() << " took " << total_time << "ms." << StageBreakdown()
+                   << " Details:";
       rpc::RpcCallInProgressPB call_in_progress_pb;
       GetCallDetails(&call_in_progress_pb);
       LOG(WARNING) << call_in_progress_pb.DebugString() << "Trace: ";
@@ -27,6 +27,7 @@
 #include "yb/tserver/tablet_server.h"
 
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 
 using namespace std::placeholders;
@@ -157,29 +158,38 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
   next_available_processor_ = pos;
 }
 
+CQLServiceImpl::PreparedStatementsShard& CQLServiceImpl::GetPreparedStatementsShard(
+    const CQLMessage::QueryId& query_id) {
+  return prepared_stmts_shards_[
+      std::hash<CQLMessage::QueryId>()(query_id) % kNumPreparedStatementsShards];
+}
+
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
-  // Get exclusive lock before allocating a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  auto& shard = GetPreparedStatementsShard(query_id);
+
+  // Get exclusive lock before allocating a prepared statement.
+  std::lock_guard<rw_spinlock> guard(shard.mutex);
 
   shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = shard.map.find(query_id);
+  if (itr == shard.map.end()) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
+    stmt = shard.map.emplace(
         query_id, std::make_shared<CQLStatement>(
-            keyspace, query, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
+            keyspace, query, shard.list.end())).first->second;
+    // Insert the statement right behind the clock hand so that it is swept last.
+    stmt->set_pos(shard.list.insert(shard.clock_hand, stmt));
   } else {
     // Return existing statement if found.
     stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    stmt->MarkUsed();
   }
 
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 
   return stmt;
@@ -187,80 +197,100 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
 
 shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
     const CQLMessage::QueryId& query_id) {
-  // Get exclusive lock before looking up a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  auto& shard = GetPreparedStatementsShard(query_id);
+  shared_ptr<CQLStatement> stmt;
+  {
+    // Lookups only need a shared lock since they do not reorder the statements.
+    boost::shared_lock<rw_spinlock> guard(shard.mutex);
 
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
-    return nullptr;
+    const auto itr = shard.map.find(query_id);
+    if (itr == shard.map.end()) {
+      return nullptr;
+    }
+    stmt = itr->second;
   }
 
-  shared_ptr<CQLStatement> stmt = itr->second;
-
   // If the statement has not finished preparing, do not return it.
   if (stmt->unprepared()) {
     return nullptr;
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    DeletePreparedStatement(stmt);
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  stmt->MarkUsed();
   return stmt;
 }
 
 void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  auto& shard = GetPreparedStatementsShard(stmt->query_id());
+
   // Get exclusive lock before deleting the prepared statement.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<rw_spinlock> guard(shard.mutex);
 
-  DeletePreparedStatementUnlocked(stmt);
+  DeletePreparedStatementUnlocked(stmt, &shard);
 
-  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
-}
-
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
-  // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
-}
-
 void CQLServiceImpl::DeletePreparedStatementUnlocked(
-    const std::shared_ptr<const CQLStatement> stmt) {
+    const std::shared_ptr<const CQLStatement> stmt, PreparedStatementsShard* shard) {
   // Remove statement from cache by looking it up by query ID and only when it is same statement
   // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // a separate copy of the shared_ptr and not the very shared_ptr in the shard's map or list we
+  // are deleting.
+  const auto itr = shard->map.find(stmt->query_id());
+  if (itr != shard->map.end() && itr->second == stmt) {
+    shard->map.erase(itr);
   }
-  // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+  // Remove statement from the list only when it is in the list, i.e. pos() != end().
+  if (stmt->pos() != shard->list.end()) {
+    if (shard->clock_hand == stmt->pos()) {
+      ++shard->clock_hand;
+    }
+    shard->list.erase(stmt->pos());
+    stmt->set_pos(shard->list.end());
   }
 }
 
-void CQLServiceImpl::CollectGarbage(size_t required) {
-  // Get exclusive lock before deleting the least recently used statement at the end of the LRU
-  // list from the cache.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
-
-  if (!prepared_stmts_list_.empty()) {
-    DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
+bool CQLServiceImpl::EvictPreparedStatementUnlocked(PreparedStatementsShard* shard) {
+  if (shard->list.empty()) {
+    return false;
   }
+  // Every statement gets its used mark cleared in the first round, so the second round always
+  // finds a statement to evict.
+  for (size_t i = 0; i <= 2 * shard->list.size(); ++i) {
+    if (shard->clock_hand == shard->list.end()) {
+      shard->clock_hand = shard->list.begin();
+    }
+    const auto& stmt = *shard->clock_hand;
+    if (!stmt->ClearUsed()) {
+      DeletePreparedStatementUnlocked(stmt, shard);
+      return true;
+    }
+    ++shard->clock_hand;
+  }
+  return false;
+}
 
-  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+void CQLServiceImpl::CollectGarbage(size_t required) {
+  // Take turns among the shards so that the evictions are spread evenly. Only the shard being
+  // swept is locked.
+  const size_t start = next_gc_prepared_stmts_shard_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i != kNumPreparedStatementsShards; ++i) {
+    auto& shard = prepared_stmts_shards_[(start + i) % kNumPreparedStatementsShards];
+    std::lock_guard<rw_spinlock> guard(shard.mutex);
+    if (EvictPreparedStatementUnlocked(&shard)) {
+      VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache shard count = "
+              << shard.map.size() << "/" << shard.list.size()
+              << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+      return;
+    }
+  }
 }
 
 client::TransactionManager* CQLServiceImpl::GetTransactionManager() {
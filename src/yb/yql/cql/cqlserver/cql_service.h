@@ -17,6 +17,8 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
@@ -26,6 +28,7 @@
 #include "yb/yql/cql/cqlserver/cql_server_options.h"
 #include "yb/yql/cql/ql/statement.h"
 
+#include "yb/util/locks.h"
 #include "yb/util/string_case.h"
 
 #include "yb/client/async_initializer.h"
@@ -51,6 +54,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
                        public GarbageCollector,
                        public std::enable_shared_from_this<CQLServiceImpl> {
  public:
+  // Number of shards of the prepared statements cache.
+  static constexpr size_t kNumPreparedStatementsShards = 16;
+
   // Constructor.
   CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
                  client::LocalTabletFilter local_tablet_filter);
@@ -104,19 +110,33 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Either gets an available processor or creates a new one.
   CQLProcessor *GetProcessor();
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
-
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
-
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
-  // be locked before this call.
-  void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
-
-  // Delete the least recently used prepared statement from the cache to free up memory.
+  // Prepared statements are sharded by query id, so executions of different statements do not
+  // contend on the same lock. Lookups lock the shard in shared mode and only mark the statement as
+  // used. Statements are evicted in clock order: the clock hand sweeps the shard's list, clears
+  // the used mark of statements executed since the previous sweep and evicts the first statement
+  // that has not been.
+  struct PreparedStatementsShard {
+    // Protects the map, the list and the clock hand.
+    mutable rw_spinlock mutex;
+    CQLStatementMap map;
+    CQLStatementList list;
+    CQLStatementListPos clock_hand = list.end();
+  };
+
+  // Return the shard the prepared statement with the given id belongs to.
+  PreparedStatementsShard& GetPreparedStatementsShard(const CQLMessage::QueryId& query_id);
+
+  // Delete a prepared statement from the shard's map and list. The shard's mutex needs to be
+  // locked exclusively before this call.
+  void DeletePreparedStatementUnlocked(
+      const std::shared_ptr<const CQLStatement> stmt, PreparedStatementsShard* shard);
+
+  // Evict a prepared statement that was not used since the last sweep of the shard's clock hand.
+  // The shard's mutex needs to be locked exclusively before this call. Returns false if the shard
+  // is empty.
+  bool EvictPreparedStatementUnlocked(PreparedStatementsShard* shard);
+
+  // Delete a prepared statement that was not used recently from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
   // CQLServer of this service.
@@ -141,13 +161,10 @@ class CQLServiceImpl : public CQLServerServiceIf,
   std::mutex processors_mutex_;
 
   // Prepared statements cache.
-  CQLStatementMap prepared_stmts_map_;
-
-  // Prepared statements LRU list (least recently used one at the end).
-  CQLStatementList prepared_stmts_list_;
+  std::array<PreparedStatementsShard, kNumPreparedStatementsShards> prepared_stmts_shards_;
 
-  // Mutex that protects the prepared statements and the LRU list.
-  std::mutex prepared_stmts_mutex_;
+  // Shard to evict the next prepared statement from when collecting garbage.
+  std::atomic<size_t> next_gc_prepared_stmts_shard_{0};
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
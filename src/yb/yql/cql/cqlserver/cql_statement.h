@@ -19,6 +19,7 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_STATEMENT_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_STATEMENT_H_
 
+#include <atomic>
 #include <list>
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
@@ -34,7 +35,7 @@ class CQLStatement;
 // it when it is being executed by another client in another thread.
 using CQLStatementMap = std::unordered_map<CQLMessage::QueryId, std::shared_ptr<CQLStatement>>;
 
-// A LRU list of CQL statements and position in the list.
+// A list of cached CQL statements and position in the list.
 using CQLStatementList = std::list<std::shared_ptr<CQLStatement>>;
 using CQLStatementListPos = CQLStatementList::iterator;
 
@@ -51,12 +52,26 @@ class CQLStatement : public ql::Statement {
   CQLStatementListPos pos() const { return pos_; }
   void set_pos(CQLStatementListPos pos) const { pos_ = pos; }
 
+  // Mark the statement as used since the last eviction sweep. The flag is checked before it is
+  // set so that executing a hot statement does not keep invalidating the cache line.
+  void MarkUsed() const {
+    if (!used_.load(std::memory_order_relaxed)) {
+      used_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Clear the used mark, returning whether it was set.
+  bool ClearUsed() const { return used_.exchange(false, std::memory_order_relaxed); }
+
   // Return the query id of a statement.
   static CQLMessage::QueryId GetQueryId(const std::string& keyspace, const std::string& query);
 
  private:
   // Position of the statement in the LRU.
   mutable CQLStatementListPos pos_;
+
+  // Whether the statement was used since the last eviction sweep.
+  mutable std::atomic<bool> used_{true};
 };
 
 }  // namespace cqlserver
@@ -12,6 +12,7 @@
 //
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -19,13 +20,18 @@
 #include "yb/integration-tests/yb_table_test_base.h"
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
+#include "yb/yql/cql/cqlserver/cql_processor.h"
 #include "yb/yql/cql/cqlserver/cql_server.h"
+#include "yb/yql/cql/cqlserver/cql_service.h"
+#include "yb/yql/cql/cqlserver/cql_statement.h"
 
 #include "yb/gutil/strings/join.h"
 #include "yb/util/cast.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int64(cql_service_max_prepared_statement_size_bytes);
+
 namespace yb {
 namespace cqlserver {
 
@@ -251,5 +257,208 @@ TEST_F(TestCQLService, TestCQLServerEventConst) {
   ASSERT_EQ(0, memcmp(buffer, ptr, kSize));
 }
 
+class TestCQLPreparedStatementCache : public YBTableTestBase {
+ public:
+  void SetUp() override;
+  void TearDown() override;
+
+ protected:
+  static constexpr int kNumShards = CQLServiceImpl::kNumPreparedStatementsShards;
+
+  // Create the CQL service whose cache is tested and a processor to prepare statements with.
+  void CreateService();
+  void DestroyService();
+
+  // Prepare the i-th test statement like a PREPARE request does.
+  void PrepareStatement(int i);
+
+  static std::string QueryText(int i) {
+    return Substitute("CREATE KEYSPACE IF NOT EXISTS prepared_stmt_test_$0", i);
+  }
+
+  static CQLMessage::QueryId QueryId(int i) {
+    return CQLStatement::GetQueryId("" /* keyspace */, QueryText(i));
+  }
+
+  // Look up the i-th test statement like an EXECUTE request does, which marks it as used.
+  bool IsCached(int i) {
+    return service_->GetPreparedStatement(QueryId(i)) != nullptr;
+  }
+
+  // Run one sweep of the clock hand like the memory tracker does when the limit is hit.
+  void CollectGarbage() {
+    static_cast<GarbageCollector*>(service_.get())->CollectGarbage(0 /* required */);
+  }
+
+  int64_t memory_usage() const {
+    return service_->prepared_stmts_mem_tracker()->consumption();
+  }
+
+  std::shared_ptr<CQLServiceImpl> service_;
+
+ private:
+  CQLServerOptions opts_;
+  boost::asio::io_service io_;
+  unique_ptr<CQLServer> server_;
+  unique_ptr<ql::QLProcessor> processor_;
+};
+
+void TestCQLPreparedStatementCache::SetUp() {
+  YBTableTestBase::SetUp();
+
+  auto master_rpc_addrs = master_rpc_addresses_as_strings();
+  opts_.master_addresses_flag = JoinStrings(master_rpc_addrs, ",");
+  auto master_addresses = std::make_shared<server::MasterAddresses>();
+  for (const auto& hp_str : master_rpc_addrs) {
+    HostPort hp;
+    CHECK_OK(hp.ParseString(hp_str, CQLServer::kDefaultPort));
+    master_addresses->push_back({std::move(hp)});
+  }
+  opts_.SetMasterAddresses(master_addresses);
+
+  // The server is not started, it only provides the metrics and memory tracker of the service.
+  server_.reset(new CQLServer(opts_, &io_, nullptr, client::LocalTabletFilter()));
+}
+
+void TestCQLPreparedStatementCache::TearDown() {
+  DestroyService();
+  server_.reset();
+  YBTableTestBase::TearDown();
+}
+
+void TestCQLPreparedStatementCache::CreateService() {
+  service_ = std::make_shared<CQLServiceImpl>(server_.get(), opts_, client::LocalTabletFilter());
+  service_->CompleteInit();
+  processor_.reset(new ql::QLProcessor(
+      service_->client(), service_->metadata_cache(), service_->cql_metrics().get(),
+      service_->clock(), std::bind(&CQLServiceImpl::GetTransactionManager, service_.get())));
+}
+
+void TestCQLPreparedStatementCache::DestroyService() {
+  processor_.reset();
+  if (service_) {
+    service_->Shutdown();
+    service_.reset();
+  }
+}
+
+void TestCQLPreparedStatementCache::PrepareStatement(int i) {
+  auto stmt = service_->AllocatePreparedStatement(QueryId(i), "" /* keyspace */, QueryText(i));
+  const Status s = stmt->Prepare(processor_.get(), service_->prepared_stmts_mem_tracker());
+  if (!s.ok()) {
+    service_->DeletePreparedStatement(stmt);
+  }
+  ASSERT_OK(s);
+}
+
+TEST_F(TestCQLPreparedStatementCache, LookupAcrossShards) {
+  constexpr int kNumStatements = 8 * kNumShards;
+  CreateService();
+
+  std::set<size_t> shards;
+  for (int i = 0; i != kNumStatements; ++i) {
+    ASSERT_NO_FATALS(PrepareStatement(i));
+    shards.insert(std::hash<CQLMessage::QueryId>()(QueryId(i)) % kNumShards);
+  }
+  ASSERT_GT(shards.size(), 1U);
+
+  for (int i = 0; i != kNumStatements; ++i) {
+    auto stmt = service_->GetPreparedStatement(QueryId(i));
+    ASSERT_NE(stmt, nullptr) << "Statement " << i;
+    ASSERT_EQ(QueryText(i), stmt->text());
+    ASSERT_EQ(QueryId(i), stmt->query_id());
+    // Preparing the statement again returns the cached one.
+    ASSERT_EQ(stmt, service_->AllocatePreparedStatement(QueryId(i), "", QueryText(i)));
+  }
+  ASSERT_EQ(service_->GetPreparedStatement(QueryId(kNumStatements)), nullptr);
+
+  // A deleted statement is only removed from its own shard.
+  service_->DeletePreparedStatement(service_->GetPreparedStatement(QueryId(0)));
+  ASSERT_FALSE(IsCached(0));
+  for (int i = 1; i != kNumStatements; ++i) {
+    ASSERT_TRUE(IsCached(i)) << "Statement " << i;
+  }
+}
+
+TEST_F(TestCQLPreparedStatementCache, EvictUnderMemoryLimit) {
+  constexpr int kNumStatements = 100;
+  constexpr int kNumStatementsInLimit = 10;
+
+  // Measure the memory used by one statement without a limit.
+  CreateService();
+  ASSERT_NO_FATALS(PrepareStatement(0));
+  const int64_t statement_size = memory_usage();
+  ASSERT_GT(statement_size, 0);
+  DestroyService();
+
+  const int64_t limit = kNumStatementsInLimit * statement_size;
+  FLAGS_cql_service_max_prepared_statement_size_bytes = limit;
+  CreateService();
+  for (int i = 0; i != kNumStatements; ++i) {
+    ASSERT_NO_FATALS(PrepareStatement(i));
+    // Hitting the limit evicts a statement that frees at least what the new one allocated.
+    ASSERT_LE(memory_usage(), limit + statement_size) << "Statement " << i;
+  }
+
+  int num_cached = 0;
+  int evicted = -1;
+  for (int i = 0; i != kNumStatements; ++i) {
+    if (IsCached(i)) {
+      ++num_cached;
+    } else if (evicted < 0) {
+      evicted = i;
+    }
+  }
+  ASSERT_GT(num_cached, 0);
+  ASSERT_LE(num_cached, kNumStatementsInLimit + 1);
+  ASSERT_GE(evicted, 0);
+
+  // EXECUTE of an evicted statement does not find it and is answered with UNPREPARED, so the
+  // client prepares it again.
+  ASSERT_NO_FATALS(PrepareStatement(evicted));
+  ASSERT_TRUE(IsCached(evicted));
+  ASSERT_LE(memory_usage(), limit + statement_size);
+}
+
+TEST_F(TestCQLPreparedStatementCache, RecentlyUsedSurviveSweep) {
+  constexpr int kNumStatements = 20 * kNumShards;
+  constexpr int kHotStatementsEvery = 10;
+  CreateService();
+
+  for (int i = 0; i != kNumStatements; ++i) {
+    ASSERT_NO_FATALS(PrepareStatement(i));
+  }
+
+  // New statements start as used. The first sweep of every shard clears the used marks and
+  // evicts one statement.
+  for (int i = 0; i != kNumShards; ++i) {
+    CollectGarbage();
+  }
+
+  // Keep executing every kHotStatementsEvery-th statement. The sweeps evict only the other ones.
+  std::vector<int> hot;
+  for (int i = 0; i < kNumStatements; i += kHotStatementsEvery) {
+    if (IsCached(i)) {
+      hot.push_back(i);
+    }
+  }
+  ASSERT_FALSE(hot.empty());
+  for (int round = 0; round != kNumShards; ++round) {
+    for (int i : hot) {
+      ASSERT_TRUE(IsCached(i)) << "Statement " << i << ", round " << round;
+    }
+    CollectGarbage();
+  }
+  for (int i : hot) {
+    ASSERT_TRUE(IsCached(i)) << "Statement " << i;
+  }
+
+  int num_cached = 0;
+  for (int i = 0; i != kNumStatements; ++i) {
+    num_cached += IsCached(i);
+  }
+  ASSERT_EQ(kNumStatements - 2 * kNumShards, num_cached);
+}
+
 }  // namespace cqlserver
 }  // namespace yb
@@ -783,6 +783,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Set the consistency level for the operation. Always use strong consistency for system tables.
   select_op->set_yb_consistency_level(tnode->is_system() ? YBConsistencyLevel::STRONG
                                                          : params.yb_consistency_level());
+  select_op->set_follower_read_max_staleness(params.follower_read_max_staleness());
 
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
   // start partition here, and then iteratively scan the rest in FetchMoreRows.
@@ -800,6 +801,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
         YBqlReadOpPtr op(table->NewQLSelect());
         op->mutable_request()->CopyFrom(select_op->request());
         op->set_yb_consistency_level(select_op->yb_consistency_level());
+        op->set_follower_read_max_staleness(select_op->follower_read_max_staleness());
         tnode_context->AdvanceToNextPartition(op->mutable_request());
         RETURN_NOT_OK(AddOperation(op, tnode_context));
         select_op = op; // Use new op as base for the next one, if any.
@@ -946,6 +948,7 @@ Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
   for (const QLRow& key : keys.rows()) {
     YBqlReadOpPtr op(tnode->table()->NewQLSelect());
     op->set_yb_consistency_level(select_op->yb_consistency_level());
+    op->set_follower_read_max_staleness(select_op->follower_read_max_staleness());
     QLReadRequestPB* req = op->mutable_request();
     req->CopyFrom(select_op->request());
     RETURN_NOT_OK(WhereKeyToPB(req, schema, key));
@@ -30,6 +30,7 @@ using client::YBColumnSchema;
 const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPropertyDataTypes
     = {
     {"bloom_filter_fp_chance", KVProperty::kBloomFilterFpChance},
+    {"bloom_filter_range_components", KVProperty::kBloomFilterRangeComponents},
     {"caching", KVProperty::kCaching},
     {"comment", KVProperty::kComment},
     {"compaction", KVProperty::kCompaction},
@@ -170,6 +171,21 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
             ErrorCode::INVALID_ARGUMENTS);
       }
       break;
+    case KVProperty::kBloomFilterRangeComponents:
+      // Bloom filters of existing SST files can't be rebuilt on a different key prefix.
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+            Substitute("$0 cannot be altered", table_property_name).c_str(),
+            ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetIntValueFromExpr(rhs_, table_property_name, &int_val));
+      if (int_val < 0) {
+        return sem_context->Error(this,
+                                  Substitute("$0 must be greater than or equal to 0 (got $1)",
+                                             table_property_name, std::to_string(int_val)).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
     case KVProperty::kCrcCheckChance: FALLTHROUGH_INTENDED;
     case KVProperty::kDclocalReadRepairChance: FALLTHROUGH_INTENDED;
     case KVProperty::kReadRepairChance:
@@ -371,6 +387,15 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       table_property->SetDefaultTimeToLive(val * MonoTime::kMillisecondsPerSecond);
       break;
     }
+    case KVProperty::kBloomFilterRangeComponents: {
+      int64_t val;
+      if (!GetIntValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument,
+                      Substitute("Invalid value for bloom_filter_range_components"));
+      }
+      table_property->SetBloomFilterRangeComponents(static_cast<uint32_t>(val));
+      break;
+    }
     case KVProperty::kBloomFilterFpChance: FALLTHROUGH_INTENDED;
     case KVProperty::kComment: FALLTHROUGH_INTENDED;
     case KVProperty::kCrcCheckChance: FALLTHROUGH_INTENDED;
@@ -18,8 +18,16 @@
 
 #include "yb/common/jsonb.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/consensus/consensus.h"
+#include "yb/master/catalog_manager.h"
 #include "yb/master/master.h"
 #include "yb/master/ts_manager.h"
+#include "yb/master/yql_partitions_vtable.h"
+#include "yb/master/yql_peers_vtable.h"
+#include "yb/tablet/tablet_peer.h"
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+#include "yb/tserver/ts_tablet_manager.h"
 #include "yb/util/yb_partition.h"
 #include "yb/util/crypt.h"
 #include "yb/yql/cql/ql/test/ql-test-base.h"
@@ -29,6 +37,9 @@ using std::unique_ptr;
 using std::shared_ptr;
 using strings::Substitute;
 
+DECLARE_int32(partitions_vtable_cache_refresh_secs);
+DECLARE_int32(tserver_unresponsive_timeout_ms);
+
 namespace yb {
 namespace ql {
 
@@ -1559,6 +1570,189 @@ TEST_F(TestQLQuery, TestInvalidPeerTableEntries) {
   }
 }
 
+namespace {
+
+int CountPartitionsOfTable(const QLRowBlock& rows, const string& table_name) {
+  int result = 0;
+  for (const auto& row : rows.rows()) {
+    if (row.column(1).string_value() == table_name) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+bool HasPeer(const QLRowBlock& rows, const string& host) {
+  for (const auto& row : rows.rows()) {
+    if (row.column(0).inetaddress_value().ToString() == host) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+TEST_F(TestQLQuery, TestSystemPartitionsCache) {
+  FLAGS_partitions_vtable_cache_refresh_secs = 3600;
+  const int kNumTabletServers = 3;
+  const string kTableName = "partitions_cache_test";
+  ASSERT_NO_FATALS(CreateSimulatedCluster(kNumTabletServers));
+  ASSERT_OK(cluster_->WaitForTabletServerCount(kNumTabletServers));
+  TestQLProcessor* processor = GetQLProcessor();
+
+  auto* catalog_manager = cluster_->leader_mini_master()->master()->catalog_manager();
+  master::YQLPartitionsVTable vtable(cluster_->leader_mini_master()->master());
+  QLReadRequestPB request;
+  std::unique_ptr<QLRowBlock> rows;
+
+  // Reads the table twice. When the catalog and the tablet locations did not change in between,
+  // the second read must be served from the cache. Retries if they changed, since tablet
+  // servers report in the background.
+  auto assert_served_from_cache = [&] {
+    for (int attempt = 0; attempt != 10; ++attempt) {
+      const auto locations_version = catalog_manager->tablet_locations_version();
+      const auto catalog_version = catalog_manager->GetCatalogSnapshot()->version;
+      ASSERT_OK(vtable.RetrieveData(request, &rows));
+      const auto num_builds = vtable.TEST_num_builds();
+      std::unique_ptr<QLRowBlock> cached_rows;
+      ASSERT_OK(vtable.RetrieveData(request, &cached_rows));
+      if (locations_version == catalog_manager->tablet_locations_version() &&
+          catalog_version == catalog_manager->GetCatalogSnapshot()->version) {
+        ASSERT_EQ(num_builds, vtable.TEST_num_builds());
+        ASSERT_EQ(rows->ToString(), cached_rows->ToString());
+        return;
+      }
+    }
+    FAIL() << "Tablet locations kept changing";
+  };
+
+  // Checks that the cached contents match contents built from scratch, i.e. that nothing stale is
+  // returned once the versions were bumped.
+  auto assert_not_stale = [&] {
+    for (int attempt = 0; attempt != 10; ++attempt) {
+      const auto locations_version = catalog_manager->tablet_locations_version();
+      const auto catalog_version = catalog_manager->GetCatalogSnapshot()->version;
+      ASSERT_OK(vtable.RetrieveData(request, &rows));
+      FLAGS_partitions_vtable_cache_refresh_secs = 0;
+      std::unique_ptr<QLRowBlock> fresh_rows;
+      ASSERT_OK(vtable.RetrieveData(request, &fresh_rows));
+      FLAGS_partitions_vtable_cache_refresh_secs = 3600;
+      if (locations_version == catalog_manager->tablet_locations_version() &&
+          catalog_version == catalog_manager->GetCatalogSnapshot()->version) {
+        ASSERT_EQ(fresh_rows->ToString(), rows->ToString());
+        return;
+      }
+    }
+    FAIL() << "Tablet locations kept changing";
+  };
+
+  ASSERT_NO_FATALS(assert_served_from_cache());
+  ASSERT_EQ(0, CountPartitionsOfTable(*rows, kTableName));
+
+  // Creating a table invalidates the cache.
+  auto num_builds = vtable.TEST_num_builds();
+  ASSERT_OK(processor->Run(Substitute("CREATE TABLE $0 (h int PRIMARY KEY)", kTableName)));
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_GT(vtable.TEST_num_builds(), num_builds);
+  ASSERT_NO_FATALS(assert_not_stale());
+  ASSERT_GT(CountPartitionsOfTable(*rows, kTableName), 0);
+  ASSERT_NO_FATALS(assert_served_from_cache());
+
+  // Moving the leadership of a tablet bumps the tablet locations version and invalidates the
+  // cache.
+  const auto locations_version = catalog_manager->tablet_locations_version();
+  bool stepped_down = false;
+  for (int i = 0; i != cluster_->num_tablet_servers() && !stepped_down; ++i) {
+    auto peers = cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers();
+    for (const auto& peer : peers) {
+      if (peer->tablet_metadata()->table_name() == kTableName &&
+          peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY) {
+        consensus::LeaderStepDownRequestPB req;
+        req.set_tablet_id(peer->tablet_id());
+        consensus::LeaderStepDownResponsePB resp;
+        ASSERT_OK(peer->consensus()->StepDown(&req, &resp));
+        ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+        stepped_down = true;
+        break;
+      }
+    }
+  }
+  ASSERT_TRUE(stepped_down);
+  ASSERT_OK(WaitFor([catalog_manager, locations_version]() -> Result<bool> {
+    return catalog_manager->tablet_locations_version() > locations_version;
+  }, MonoDelta::FromSeconds(30), "Tablet locations updated"));
+  num_builds = vtable.TEST_num_builds();
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_GT(vtable.TEST_num_builds(), num_builds);
+  ASSERT_NO_FATALS(assert_not_stale());
+
+  // Dropping the table removes its partitions right away.
+  ASSERT_OK(processor->Run(Substitute("DROP TABLE $0", kTableName)));
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_EQ(0, CountPartitionsOfTable(*rows, kTableName));
+  ASSERT_NO_FATALS(assert_not_stale());
+}
+
+TEST_F(TestQLQuery, TestSystemPeersCache) {
+  FLAGS_tserver_unresponsive_timeout_ms = 5000;
+  const int kNumTabletServers = 3;
+  ASSERT_NO_FATALS(CreateSimulatedCluster(kNumTabletServers));
+  ASSERT_OK(cluster_->WaitForTabletServerCount(kNumTabletServers));
+
+  auto* master = cluster_->leader_mini_master()->master();
+  master::PeersVTable vtable(master);
+  QLReadRequestPB request;
+  auto* proxy_server = cluster_->mini_tablet_server(0)->server();
+  request.set_proxy_uuid(proxy_server->permanent_uuid());
+  request.mutable_remote_endpoint()->set_host(
+      cluster_->mini_tablet_server(0)->bound_rpc_addr().address().to_string());
+  std::unique_ptr<QLRowBlock> rows;
+
+  // The rows are built once and reused while the live tablet servers stay the same.
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_EQ(kNumTabletServers - 1, rows->row_count()) << rows->ToString();
+  const auto num_builds = vtable.TEST_num_builds();
+  std::unique_ptr<QLRowBlock> cached_rows;
+  ASSERT_OK(vtable.RetrieveData(request, &cached_rows));
+  ASSERT_EQ(num_builds, vtable.TEST_num_builds());
+  ASSERT_EQ(rows->ToString(), cached_rows->ToString());
+
+  // A tablet server joining invalidates the cache.
+  auto register_fake_ts = [master](int64_t seqno, const string& host) {
+    NodeInstancePB instance;
+    instance.set_permanent_uuid("fake-ts");
+    instance.set_instance_seqno(seqno);
+    master::TSRegistrationPB registration;
+    auto hostport_pb = registration.mutable_common()->add_private_rpc_addresses();
+    hostport_pb->set_host(host);
+    hostport_pb->set_port(123);
+    std::shared_ptr<master::TSDescriptor> desc;
+    return master->ts_manager()->RegisterTS(
+        instance, registration, CloudInfoPB(), nullptr, &desc);
+  };
+  ASSERT_OK(register_fake_ts(1, "127.0.0.10"));
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_EQ(kNumTabletServers, rows->row_count()) << rows->ToString();
+  ASSERT_TRUE(HasPeer(*rows, "127.0.0.10")) << rows->ToString();
+  ASSERT_GT(vtable.TEST_num_builds(), num_builds);
+
+  // A restarted tablet server registers with a new instance sequence number, and its new address
+  // is visible right away.
+  ASSERT_OK(register_fake_ts(2, "127.0.0.11"));
+  ASSERT_OK(vtable.RetrieveData(request, &rows));
+  ASSERT_EQ(kNumTabletServers, rows->row_count()) << rows->ToString();
+  ASSERT_TRUE(HasPeer(*rows, "127.0.0.11")) << rows->ToString();
+  ASSERT_FALSE(HasPeer(*rows, "127.0.0.10")) << rows->ToString();
+
+  // The fake tablet server never heartbeats, so it is eventually considered dead and dropped.
+  ASSERT_OK(WaitFor([&vtable, &request, &rows]() -> Result<bool> {
+    RETURN_NOT_OK(vtable.RetrieveData(request, &rows));
+    return !HasPeer(*rows, "127.0.0.11");
+  }, MonoDelta::FromSeconds(30), "Fake tablet server removed from system.peers"));
+  ASSERT_EQ(kNumTabletServers - 1, rows->row_count()) << rows->ToString();
+}
+
 TEST_F(TestQLQuery, TestPagination) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -22,6 +22,7 @@
 
 #include "yb/common/ql_protocol.pb.h"
 #include "yb/common/ql_value.h"
+#include "yb/util/monotime.h"
 
 namespace yb {
 namespace ql {
@@ -79,11 +80,20 @@ class StatementParameters {
     return yb_consistency_level_;
   }
 
+  // Staleness bound of the replica serving a CONSISTENT_PREFIX read. Not set means no bound.
+  const MonoDelta& follower_read_max_staleness() const {
+    return follower_read_max_staleness_;
+  }
+
  protected:
   void set_yb_consistency_level(const YBConsistencyLevel yb_consistency_level) {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  void set_follower_read_max_staleness(const MonoDelta& value) {
+    follower_read_max_staleness_ = value;
+  }
+
  private:
   const QLPagingStatePB& paging_state() const {
     return paging_state_ != nullptr ? *paging_state_ : QLPagingStatePB::default_instance();
@@ -97,6 +107,8 @@ class StatementParameters {
 
   // Consistency level for YB.
   YBConsistencyLevel yb_consistency_level_;
+
+  MonoDelta follower_read_max_staleness_;
 };
 
 } // namespace ql
@@ -14,6 +14,17 @@
 
 #include "yb/yql/pggate/pg_doc_op.h"
 
+#include <gflags/gflags.h>
+
+#include "yb/client/client.h"
+#include "yb/common/partition.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(ysql_scan_prefetch_pages, 4,
+             "Number of pages a YSQL scan keeps cached ahead of the PostgreSQL backend. Full scans "
+             "of hash partitioned tables also read up to this many tablets in parallel.");
+TAG_FLAG(ysql_scan_prefetch_pages, advanced);
+
 using std::shared_ptr;
 
 namespace yb {
@@ -118,8 +129,9 @@ void PgDocOp::ReadFromCacheUnlocked(string *result) {
 }
 
 Status PgDocOp::SendRequestIfNeededUnlocked() {
-  // Request more data if more execution is needed and cache is empty.
-  if (!has_cached_data_ && !end_of_data_ && !waiting_for_response_) {
+  // Request more data if more execution is needed and cache is not full.
+  const size_t prefetch_pages = std::max(FLAGS_ysql_scan_prefetch_pages, 1);
+  if (result_cache_.size() < prefetch_pages && !end_of_data_ && !waiting_for_response_) {
     return SendRequestUnlocked();
   }
   return Status::OK();
@@ -141,9 +153,50 @@ void PgDocReadOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   PgsqlReadRequestPB *req = read_op_->mutable_request();
   req->set_limit(kPrefetchLimit);
   req->set_return_paging_state(true);
+
+  InitPartitionOpsUnlocked();
+}
+
+void PgDocReadOp::InitPartitionOpsUnlocked() {
+  pending_partition_ops_.clear();
+  in_flight_partition_ops_.clear();
+
+  const auto& req = read_op_->request();
+  const auto& partitions = read_op_->table()->GetPartitions();
+  partitioned_scan_ =
+      FLAGS_ysql_scan_prefetch_pages > 1 &&
+      read_op_->table()->partition_schema().IsHashPartitioning() &&
+      partitions.size() > 1 &&
+      req.partition_column_values().empty() &&
+      !req.has_hash_code() &&
+      !req.has_max_hash_code() &&
+      !req.has_paging_state() &&
+      !req.is_aggregate();
+  if (!partitioned_scan_) {
+    return;
+  }
+
+  // Rows of a hash partitioned table are not returned in any meaningful order, so the tablets
+  // do not have to be read one after another.
+  for (size_t i = 0; i != partitions.size(); ++i) {
+    PartitionOp partition_op;
+    partition_op.op = read_op_->DeepCopy();
+    if (!partitions[i].empty()) {
+      partition_op.op->mutable_request()->set_hash_code(
+          PartitionSchema::DecodeMultiColumnHashValue(partitions[i]));
+    }
+    if (i + 1 != partitions.size()) {
+      partition_op.partition_key_end = partitions[i + 1];
+    }
+    pending_partition_ops_.push_back(std::move(partition_op));
+  }
 }
 
 Status PgDocReadOp::SendRequestUnlocked() {
+  if (partitioned_scan_) {
+    return SendPartitionRequestsUnlocked();
+  }
+
   RETURN_NOT_OK(pg_session_->PgApplyAsync(read_op_, read_time_));
   waiting_for_response_ = true;
   RETURN_NOT_OK(
@@ -181,6 +234,52 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   }
 }
 
+Status PgDocReadOp::SendPartitionRequestsUnlocked() {
+  const size_t max_ops = std::max(FLAGS_ysql_scan_prefetch_pages, 1);
+  while (!pending_partition_ops_.empty() && in_flight_partition_ops_.size() < max_ops) {
+    RETURN_NOT_OK(pg_session_->PgApplyAsync(pending_partition_ops_.front().op, read_time_));
+    in_flight_partition_ops_.push_back(std::move(pending_partition_ops_.front()));
+    pending_partition_ops_.pop_front();
+  }
+  waiting_for_response_ = true;
+  Status s = pg_session_->PgFlushAsync([this](const Status& s) {
+    PgDocReadOp::ReceivePartitionResponses(s);
+  });
+  if (!s.ok()) {
+    waiting_for_response_ = false;
+    return s;
+  }
+  return Status::OK();
+}
+
+void PgDocReadOp::ReceivePartitionResponses(Status exec_status) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  CHECK(waiting_for_response_);
+  cv_.notify_all();
+  waiting_for_response_ = false;
+  exec_status_ = exec_status;
+
+  if (!exec_status.ok() || is_canceled_) {
+    end_of_data_ = true;
+    return;
+  }
+
+  for (auto& partition_op : in_flight_partition_ops_) {
+    WriteToCacheUnlocked(partition_op.op);
+
+    // Continue reading the tablet, unless the paging state already points to the next one.
+    const PgsqlResponsePB& res = partition_op.op->response();
+    if (res.has_paging_state() &&
+        (partition_op.partition_key_end.empty() ||
+         res.paging_state().next_partition_key() < partition_op.partition_key_end)) {
+      *partition_op.op->mutable_request()->mutable_paging_state() = res.paging_state();
+      pending_partition_ops_.push_back(std::move(partition_op));
+    }
+  }
+  in_flight_partition_ops_.clear();
+  end_of_data_ = pending_partition_ops_.empty();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 PgDocWriteOp::PgDocWriteOp(PgSession::ScopedRefPtr pg_session, client::YBPgsqlWriteOp *write_op)
@@ -193,6 +292,13 @@ PgDocWriteOp::~PgDocWriteOp() {
 Status PgDocWriteOp::SendRequestUnlocked() {
   CHECK(!waiting_for_response_);
 
+  if (VERIFY_RESULT(pg_session_->PgBufferWrite(*write_op_))) {
+    // Nothing to wait for, errors are reported when the buffered writes are sent.
+    end_of_data_ = true;
+    VLOG(1) << __PRETTY_FUNCTION__ << ": Buffered request for " << this;
+    return Status::OK();
+  }
+
   RETURN_NOT_OK(pg_session_->PgApplyAsync(write_op_, read_time_));
   waiting_for_response_ = true;
   Status s = pg_session_->PgFlushAsync([this](const Status& s) {
@@ -17,6 +17,7 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 
 #include "yb/util/locks.h"
 #include "yb/client/yb_op.h"
@@ -63,8 +64,8 @@ class PgDocOp {
   void WriteToCacheUnlocked(std::shared_ptr<client::YBPgsqlOp> yb_op);
   void ReadFromCacheUnlocked(string* result);
 
-  // Send another request if no request is pending and we've already consumed
-  // all data in the cache.
+  // Send another request if no request is pending and the cache has room for more pages, see
+  // --ysql_scan_prefetch_pages.
   CHECKED_STATUS SendRequestIfNeededUnlocked();
 
   // Session control.
@@ -81,7 +82,7 @@ class PgDocOp {
   Status exec_status_ = Status::OK();
 
   // Whether or not we are waiting for a response from DocDB after sending a request. Only one
-  // request can be sent to DocDB at a time.
+  // batch of requests can be sent to DocDB at a time.
   bool waiting_for_response_ = false;
 
   // Whether all requested data by the statement has been received or there's a run-time error.
@@ -124,8 +125,25 @@ class PgDocReadOp : public PgDocOp {
   CHECKED_STATUS SendRequestUnlocked() override;
   virtual void ReceiveResponse(Status exec_status);
 
+  // A full scan of a hash partitioned table is split into one operation per tablet, and up to
+  // --ysql_scan_prefetch_pages of these operations are sent at a time.
+  void InitPartitionOpsUnlocked();
+  CHECKED_STATUS SendPartitionRequestsUnlocked();
+  void ReceivePartitionResponses(Status exec_status);
+
   // Operator.
   std::shared_ptr<client::YBPgsqlReadOp> read_op_;
+
+  struct PartitionOp {
+    std::shared_ptr<client::YBPgsqlReadOp> op;
+    // Partition key where the tablet read by this operation ends, empty for the last tablet.
+    std::string partition_key_end;
+  };
+
+  // Operations of a partitioned scan that have more data to read, and the ones in flight.
+  std::deque<PartitionOp> pending_partition_ops_;
+  std::vector<PartitionOp> in_flight_partition_ops_;
+  bool partitioned_scan_ = false;
 };
 
 class PgDocWriteOp : public PgDocOp {
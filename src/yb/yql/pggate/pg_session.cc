@@ -20,8 +20,17 @@
 #include "yb/client/transaction.h"
 #include "yb/client/batcher.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/string_util.h"
 
+DEFINE_int32(ysql_write_buffer_max_ops, 0,
+             "Maximum number of write operations that a YSQL transaction buffers before sending "
+             "them to the tablet servers. Writes that return rows are never buffered. Errors of "
+             "buffered writes, e.g. duplicate keys, are reported by the statement that flushes "
+             "them or by the commit rather than by the failing statement. 0 disables write "
+             "buffering.");
+TAG_FLAG(ysql_write_buffer_max_ops, advanced);
+
 namespace yb {
 namespace pggate {
 
@@ -148,6 +157,9 @@ Result<PgTableDesc::ScopedRefPtr> PgSession::LoadTable(const PgObjectId& table_i
 }
 
 Status PgSession::PgApplyAsync(const std::shared_ptr<client::YBPgsqlOp>& op, uint64_t* read_time) {
+  // Buffered writes have to be visible to reads and must not be flushed as part of this operation.
+  RETURN_NOT_OK(FlushBufferedWrites());
+
   if (op->IsTransactional()) {
     has_txn_ops_ = true;
   } else {
@@ -183,6 +195,27 @@ Status PgSession::PgFlushAsync(StatusFunctor callback) {
   return Status::OK();
 }
 
+Result<bool> PgSession::PgBufferWrite(const client::YBPgsqlWriteOp& op) {
+  if (FLAGS_ysql_write_buffer_max_ops <= 0 || !op.IsTransactional() ||
+      op.request().targets_size() > 0 || has_txn_ops_ || has_non_txn_ops_) {
+    return false;
+  }
+  auto session = VERIFY_RESULT(GetSession(/* transactional */ true, /* read_only_op */ false));
+  // The statement updates the request of its operation in place when it is executed again.
+  std::shared_ptr<client::YBPgsqlWriteOp> copy = op.DeepCopy();
+  RETURN_NOT_OK(session->Apply(copy));
+  pg_txn_manager_->AddBufferedWrite(std::move(copy));
+  const size_t max_buffered_writes = FLAGS_ysql_write_buffer_max_ops;
+  if (pg_txn_manager_->num_buffered_writes() >= max_buffered_writes) {
+    RETURN_NOT_OK(FlushBufferedWrites());
+  }
+  return true;
+}
+
+Status PgSession::FlushBufferedWrites() {
+  return pg_txn_manager_->FlushBufferedWrites();
+}
+
 Result<client::YBSession*> PgSession::GetSessionForOp(
     const std::shared_ptr<client::YBPgsqlOp>& op) {
   return GetSession(op->IsTransactional(), op->read_only());
@@ -89,6 +89,16 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   CHECKED_STATUS PgApplyAsync(const std::shared_ptr<client::YBPgsqlOp>& op, uint64_t* read_time);
   CHECKED_STATUS PgFlushAsync(StatusFunctor callback);
 
+  // Buffer a copy of the given write operation in the current transaction instead of sending it.
+  // Buffered writes are sent together when the buffer is full, before any other operation is
+  // applied, and when the transaction commits, so errors are reported at that point. Returns false
+  // if the operation cannot be buffered, e.g. because it returns rows, and has to be applied with
+  // PgApplyAsync.
+  Result<bool> PgBufferWrite(const client::YBPgsqlWriteOp& op);
+
+  // Send the write operations buffered in the current transaction and wait for them.
+  CHECKED_STATUS FlushBufferedWrites();
+
   // Return the number of errors which are pending.
   int CountPendingErrors() const;
 
@@ -128,6 +138,10 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
     return rowid_generator_.Next(true /* binary_id */);
   }
 
+  // Given a set of errors from operations, this function attempts to combine them into one status
+  // that is later passed to PostgreSQL and further converted into a more specific error code.
+  static Status CombineErrorsToStatus(client::CollectedErrors errors, Status status);
+
  private:
   // Returns the appropriate session to use, in most cases the one used by the current transaction.
   // read_only_op - whether this is being done in the context of a read-only operation. For
@@ -140,10 +154,6 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // is an operation on a transactional table, as well as read-only vs. non-read-only operation.
   Result<client::YBSession*> GetSessionForOp(const std::shared_ptr<client::YBPgsqlOp>& op);
 
-  // Given a set of errors from operations, this function attempts to combine them into one status
-  // that is later passed to PostgreSQL and further converted into a more specific error code.
-  Status CombineErrorsToStatus(client::CollectedErrors errors, Status status);
-
   // YBClient, an API that SQL engine uses to communicate with all servers.
   std::shared_ptr<client::YBClient> client_;
 
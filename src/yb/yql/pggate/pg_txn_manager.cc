@@ -13,6 +13,7 @@
 #include "yb/yql/pggate/pggate.h"
 #include "yb/util/status.h"
 #include "yb/client/transaction.h"
+#include "yb/client/yb_op.h"
 #include "yb/common/common.pb.h"
 
 namespace yb {
@@ -83,6 +84,8 @@ Status PgTxnManager::CommitTransaction() {
     ResetTxnAndSession();
     return Status::OK();
   }
+  // On error the transaction stays in progress, PostgreSQL aborts it.
+  RETURN_NOT_OK(FlushBufferedWrites());
   Status status = txn_->CommitFuture().get();
   ResetTxnAndSession();
   return status;
@@ -122,6 +125,28 @@ TransactionManager* PgTxnManager::GetOrCreateTransactionManager() {
   return transaction_manager_holder_.get();
 }
 
+void PgTxnManager::AddBufferedWrite(std::shared_ptr<client::YBPgsqlWriteOp> op) {
+  buffered_writes_.push_back(std::move(op));
+}
+
+Status PgTxnManager::FlushBufferedWrites() {
+  if (buffered_writes_.empty()) {
+    return Status::OK();
+  }
+  VLOG(2) << "FlushBufferedWrites: " << buffered_writes_.size() << " operations";
+  auto ops = std::move(buffered_writes_);
+  buffered_writes_.clear();
+  // The batcher groups the operations by tablet, so this is one request per tablet.
+  Status status = session_->Flush();
+  RETURN_NOT_OK(PgSession::CombineErrorsToStatus(session_->GetPendingErrors(), status));
+  for (const auto& op : ops) {
+    if (!op->succeeded()) {
+      return STATUS(QLError, op->response().error_message());
+    }
+  }
+  return Status::OK();
+}
+
 Result<client::YBSession*> PgTxnManager::GetTransactionalSession() {
   if (!txn_in_progress_) {
     RETURN_NOT_OK(BeginTransaction());
@@ -130,6 +155,11 @@ Result<client::YBSession*> PgTxnManager::GetTransactionalSession() {
 }
 
 void PgTxnManager::ResetTxnAndSession() {
+  if (session_ && !buffered_writes_.empty()) {
+    // Writes of an aborted transaction are dropped without being sent.
+    session_->Abort();
+  }
+  buffered_writes_.clear();
   txn_in_progress_ = false;
   session_ = nullptr;
   txn_ = nullptr;
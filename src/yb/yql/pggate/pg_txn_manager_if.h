@@ -15,6 +15,7 @@
 
 #ifdef YBC_CXX_DECLARATION_MODE
 #include <mutex>
+#include <vector>
 
 #include "yb/gutil/macros.h"
 #include "yb/client/client_fwd.h"
@@ -48,6 +49,14 @@ YBC_STATUS_METHOD_NO_ARGS(AbortTransaction)
 
   Status BeginWriteTransactionIfNecessary();
 
+  // Write operations that were applied to the transactional session but not sent yet. They are
+  // sent with FlushBufferedWrites, which is also done before the transaction commits.
+  void AddBufferedWrite(std::shared_ptr<client::YBPgsqlWriteOp> op);
+  size_t num_buffered_writes() const { return buffered_writes_.size(); }
+
+  // Sends the buffered write operations and waits for them to complete. Returns the first error.
+  Status FlushBufferedWrites();
+
  private:
 
   client::TransactionManager* GetOrCreateTransactionManager();
@@ -57,6 +66,7 @@ YBC_STATUS_METHOD_NO_ARGS(AbortTransaction)
   bool txn_in_progress_ = false;
   client::YBTransactionPtr txn_;
   client::YBSessionPtr session_;
+  std::vector<std::shared_ptr<client::YBPgsqlWriteOp>> buffered_writes_;
 
   client::AsyncClientInitialiser* async_client_init_ = nullptr;
   scoped_refptr<ClockBase> clock_;
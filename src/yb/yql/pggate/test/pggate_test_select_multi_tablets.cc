@@ -13,13 +13,98 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <map>
+
 #include "yb/yql/pggate/test/pggate_test.h"
 #include "yb/util/ybc-internal.h"
+#include "yb/util/ybc_util.h"
+
+DECLARE_int32(ysql_scan_prefetch_pages);
+DECLARE_int32(ysql_write_buffer_max_ops);
 
 namespace yb {
 namespace pggate {
 
 class PggateTestSelectMultiTablets : public PggateTest {
+ protected:
+  static constexpr int kColCount = 2;
+
+  // Creates a table with an INT64 hash key and an INT32 value.
+  void CreateKeyValueTable(const char* tabname, YBCPgOid tab_oid) {
+    YBCPgStatement pg_stmt;
+    CHECK_YBC_STATUS(YBCPgNewCreateTable(pg_session_, kDefaultDatabase, kDefaultSchema, tabname,
+                                         kDefaultDatabaseOid, tab_oid,
+                                         false /* is_shared_table */, true /* if_not_exist */,
+                                         false /* add_primary_key */, &pg_stmt));
+    CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "hash_key", 1, DataType::INT64,
+                                                 true, true));
+    CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "value", 2, DataType::INT32,
+                                                 false, false));
+    CHECK_YBC_STATUS(YBCPgExecCreateTable(pg_stmt));
+    CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+  }
+
+  // Inserts a row with its own statement, like PostgreSQL does for each row of a multi-row
+  // INSERT, and returns the status of the execution.
+  Status InsertRow(YBCPgOid tab_oid, int64_t key, int32_t value) {
+    YBCPgStatement pg_stmt;
+    CHECK_YBC_STATUS(YBCPgNewInsert(pg_session_, kDefaultDatabaseOid, tab_oid, &pg_stmt));
+    YBCPgExpr expr_hash;
+    CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, key, false, &expr_hash));
+    YBCPgExpr expr_value;
+    CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, value, false, &expr_value));
+    CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 1, expr_hash));
+    CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 2, expr_value));
+    Status status = ToStatus(YBCPgExecInsert(pg_stmt));
+    CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+    return status;
+  }
+
+  // Reads all rows of the table and returns their values by key.
+  std::map<int64_t, int32_t> SelectRows(YBCPgOid tab_oid) {
+    YBCPgStatement pg_stmt;
+    CHECK_YBC_STATUS(YBCPgNewSelect(
+        pg_session_, kDefaultDatabaseOid, tab_oid, &pg_stmt, nullptr /* read_time */));
+    YBCPgExpr colref;
+    YBCTestNewColumnRef(pg_stmt, 1, DataType::INT64, &colref);
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+    YBCTestNewColumnRef(pg_stmt, 2, DataType::INT32, &colref);
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+    CHECK_YBC_STATUS(YBCPgExecSelect(pg_stmt));
+
+    uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(kColCount * sizeof(uint64_t)));
+    bool *isnulls = static_cast<bool*>(YBCPAlloc(kColCount * sizeof(bool)));
+    std::map<int64_t, int32_t> rows;
+    bool has_data = true;
+    while (true) {
+      CHECK_YBC_STATUS(YBCPgDmlFetch(pg_stmt, kColCount, values, isnulls, nullptr, &has_data));
+      if (!has_data) {
+        break;
+      }
+      const int64_t key = values[0];
+      CHECK(rows.emplace(key, static_cast<int32_t>(values[1])).second) << "Duplicate row " << key;
+    }
+    CHECK_YBC_STATUS(YBCPgDeleteStatement(pg_stmt));
+    return rows;
+  }
+
+  Status CommitTransactionStatus() {
+    return ToStatus(YBCPgTxnManager_CommitTransaction_Status(YBCGetPgTxnManager()));
+  }
+
+  void AbortTransaction() {
+    CHECK_YBC_STATUS(YBCPgTxnManager_AbortTransaction_Status(YBCGetPgTxnManager()));
+  }
+
+ private:
+  static Status ToStatus(YBCStatus status) {
+    if (!status) {
+      return Status::OK();
+    }
+    Status result(static_cast<Status::Code>(status->code), __FILE__, __LINE__, status->msg);
+    YBCFreeStatus(status);
+    return result;
+  }
 };
 
 TEST_F(PggateTestSelectMultiTablets, TestSelectMultiTablets) {
@@ -271,5 +356,85 @@ TEST_F(PggateTestSelectMultiTablets, TestSelectMultiTablets) {
   pg_stmt = nullptr;
 }
 
+TEST_F(PggateTestSelectMultiTablets, TestBufferedInsertsAndParallelScan) {
+  FLAGS_ysql_write_buffer_max_ops = 16;
+  FLAGS_ysql_scan_prefetch_pages = 2;
+  CHECK_OK(Init("TestBufferedInsertsAndParallelScan"));
+
+  const YBCPgOid tab_oid = 3;
+  CreateKeyValueTable("buffered_table", tab_oid);
+
+  // INSERT rows in a single transaction. The rows are sent in batches of
+  // ysql_write_buffer_max_ops and at commit.
+  const int insert_row_count = 100;
+  for (int seed = 0; seed < insert_row_count; seed++) {
+    CHECK_OK(InsertRow(tab_oid, seed, 1000 + seed));
+  }
+  CommitTransaction();
+
+  // SELECT all rows, the tablets are read in parallel.
+  auto rows = SelectRows(tab_oid);
+  CHECK_EQ(rows.size(), static_cast<size_t>(insert_row_count));
+  for (const auto& row : rows) {
+    CHECK_EQ(row.second, 1000 + row.first);
+  }
+}
+
+TEST_F(PggateTestSelectMultiTablets, TestBufferedInsertErrors) {
+  CHECK_OK(Init("TestBufferedInsertErrors"));
+
+  const YBCPgOid tab_oid = 3;
+  CreateKeyValueTable("buffered_errors_table", tab_oid);
+  CHECK_OK(InsertRow(tab_oid, 1, 1));
+  CommitTransaction();
+
+  // Write buffering is disabled by default, so a duplicate key is reported by its statement.
+  Status s = InsertRow(tab_oid, 1, 2);
+  CHECK(!s.ok()) << "Duplicate key was not reported by the INSERT";
+  LOG(INFO) << "Unbuffered INSERT failed as expected: " << s;
+  AbortTransaction();
+
+  // A buffered write reports the duplicate key when the buffer is flushed, here at commit.
+  FLAGS_ysql_write_buffer_max_ops = 16;
+  CHECK_OK(InsertRow(tab_oid, 2, 2));
+  CHECK_OK(InsertRow(tab_oid, 1, 3));
+  s = CommitTransactionStatus();
+  CHECK(!s.ok()) << "Duplicate key was not reported by the commit";
+  LOG(INFO) << "Commit of buffered INSERT failed as expected: " << s;
+  AbortTransaction();
+
+  // None of the writes of the failed transactions is visible.
+  auto rows = SelectRows(tab_oid);
+  CHECK_EQ(rows.size(), 1U);
+  CHECK_EQ(rows[1], 1);
+}
+
+TEST_F(PggateTestSelectMultiTablets, TestAbortDiscardsBufferedWrites) {
+  FLAGS_ysql_write_buffer_max_ops = 16;
+  CHECK_OK(Init("TestAbortDiscardsBufferedWrites"));
+
+  const YBCPgOid tab_oid = 3;
+  CreateKeyValueTable("buffered_abort_table", tab_oid);
+
+  // Fewer rows than the buffer holds, so none of them was sent when the transaction is aborted.
+  const int insert_row_count = 10;
+  for (int seed = 0; seed < insert_row_count; seed++) {
+    CHECK_OK(InsertRow(tab_oid, seed, seed));
+  }
+  AbortTransaction();
+  CHECK_EQ(SelectRows(tab_oid).size(), 0U);
+
+  // The discarded writes do not conflict with the same rows written by the next transaction.
+  for (int seed = 0; seed < insert_row_count; seed++) {
+    CHECK_OK(InsertRow(tab_oid, seed, 100 + seed));
+  }
+  CommitTransaction();
+  auto rows = SelectRows(tab_oid);
+  CHECK_EQ(rows.size(), static_cast<size_t>(insert_row_count));
+  for (const auto& row : rows) {
+    CHECK_EQ(row.second, 100 + row.first);
+  }
+}
+
 } // namespace pggate
 } // namespace yb
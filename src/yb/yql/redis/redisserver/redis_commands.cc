@@ -68,7 +68,7 @@ namespace redisserver {
 
 #define REDIS_COMMANDS \
     ((get, Get, 2, READ)) \
-    ((mget, MGet, -2, READ)) \
+    ((mget, MGet, -2, MREAD)) \
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
@@ -87,7 +87,7 @@ namespace redisserver {
     ((zcard, ZCard, 2, READ)) \
     ((rename, Rename, 3, LOCAL)) \
     ((set, Set, -3, WRITE)) \
-    ((mset, MSet, -3, WRITE)) \
+    ((mset, MSet, -3, MWRITE)) \
     ((hset, HSet, 4, WRITE)) \
     ((hmset, HMSet, -4, WRITE)) \
     ((hincrby, HIncrBy, 4, WRITE)) \
@@ -108,7 +108,7 @@ namespace redisserver {
     ((zadd, ZAdd, -4, WRITE)) \
     ((getset, GetSet, 3, WRITE)) \
     ((append, Append, 3, WRITE)) \
-    ((del, Del, 2, WRITE)) \
+    ((del, Del, -2, MWRITE)) \
     ((setrange, SetRange, 4, WRITE)) \
     ((incr, Incr, 2, WRITE)) \
     ((incrby, IncrBy, 3, WRITE)) \
@@ -160,6 +160,8 @@ BOOST_PP_SEQ_FOR_EACH(DEFINE_HISTOGRAM, ~, REDIS_COMMANDS)
 
 #define READ_OP yb::client::YBRedisReadOp
 #define WRITE_OP yb::client::YBRedisWriteOp
+#define MREAD_OP yb::client::YBRedisReadOp
+#define MWRITE_OP yb::client::YBRedisWriteOp
 #define LOCAL_OP RedisResponsePB
 #define CLUSTER_OP RedisResponsePB
 
@@ -208,10 +210,138 @@ void Command(
   context->Apply(idx, std::move(op), info.metrics);
 }
 
+template<class Op>
+using MultiKeyResponder = Status(*)(
+    const std::vector<std::shared_ptr<Op>>&, const std::vector<Status>&, RedisResponsePB*);
+
+// Multi-key commands (MGET, MSET, DEL) are split into an operation per key, parsed by the
+// single key parser. The operations are grouped by tablet together with the other commands of the
+// batch, so the keys that belong to the same tablet are sent in a single RPC. The responder
+// combines the per key responses in the key order.
+template<class Op>
+void MultiKeyCommand(
+    const RedisCommandInfo& info,
+    size_t idx,
+    Parser<Op> parser,
+    MultiKeyResponder<Op> responder,
+    BatchContext* context) {
+  VLOG(1) << "Processing " << info.name << ".";
+
+  auto table = context->table();
+  if (!table) {
+    RespondWithFailure(context->call(), idx, "Could not open YBTable");
+    return;
+  }
+
+  // Number of arguments per key, i.e. 1 for MGET and 2 for MSET.
+  const size_t args_per_key = -info.arity - 1;
+  const auto& command = context->command(idx);
+  if ((command.size() - 1) % args_per_key != 0) {
+    RespondWithFailure(context->call(), idx, "wrong number of arguments");
+    return;
+  }
+
+  std::vector<std::shared_ptr<Op>> operations;
+  operations.reserve((command.size() - 1) / args_per_key);
+  RedisClientCommand key_command;
+  for (size_t i = 1; i < command.size(); i += args_per_key) {
+    key_command.assign(1, command[0]);
+    key_command.insert(key_command.end(), command.begin() + i, command.begin() + i + args_per_key);
+    operations.push_back(std::make_shared<Op>(table));
+    Status s = parser(operations.back().get(), key_command);
+    if (!s.ok()) {
+      RespondWithFailure(context->call(), idx, s.message().ToBuffer());
+      return;
+    }
+  }
+
+  auto call = context->call();
+  const auto& metrics = info.metrics;
+  auto callback = [call, idx, metrics, operations, responder](
+      const std::vector<Status>& statuses) {
+    RedisResponsePB response;
+    Status s = responder(operations, statuses, &response);
+    if (!s.ok()) {
+      call->RespondFailure(idx, s);
+      return;
+    }
+    call->RespondSuccess(idx, metrics, &response);
+  };
+  context->Apply(idx, operations, info.metrics, std::move(callback));
+}
+
+// Returns the first error of the per key operations.
+template<class Op>
+Status MultiKeyError(
+    const std::vector<std::shared_ptr<Op>>& operations, const std::vector<Status>& statuses) {
+  for (size_t i = 0; i != operations.size(); ++i) {
+    RETURN_NOT_OK(statuses[i]);
+    const auto& response = operations[i]->response();
+    if (response.code() != RedisResponsePB::OK && response.code() != RedisResponsePB::NIL) {
+      return STATUS(RuntimeError, response.error_message());
+    }
+  }
+  return Status::OK();
+}
+
+// MGET responds with an array of the values. Like Redis, it returns nil for the keys that do not
+// exist or do not hold a string, other errors are kept in the elements of their keys.
+Status RespondMGet(
+    const std::vector<std::shared_ptr<client::YBRedisReadOp>>& operations,
+    const std::vector<Status>& statuses,
+    RedisResponsePB* response) {
+  auto* array_response = response->mutable_array_response();
+  for (size_t i = 0; i != operations.size(); ++i) {
+    RefCntBuffer element;
+    const auto& key_response = operations[i]->response();
+    if (!statuses[i].ok()) {
+      element = EncodeAsError(statuses[i].message().ToBuffer());
+    } else if (key_response.code() == RedisResponsePB::OK && key_response.has_string_response()) {
+      element = EncodeAsBulkString(key_response.string_response());
+    } else if (key_response.code() == RedisResponsePB::OK ||
+               key_response.code() == RedisResponsePB::NIL ||
+               key_response.code() == RedisResponsePB::WRONG_TYPE) {
+      element = EncodeAsEncoded(kNilResponse);
+    } else {
+      element = EncodeAsError(key_response.error_message());
+    }
+    array_response->add_elements(element.data(), element.size());
+  }
+  array_response->set_encoded(true);
+  return Status::OK();
+}
+
+Status RespondMSet(
+    const std::vector<std::shared_ptr<client::YBRedisWriteOp>>& operations,
+    const std::vector<Status>& statuses,
+    RedisResponsePB* response) {
+  return MultiKeyError(operations, statuses);
+}
+
+// DEL responds with the number of keys that were removed.
+Status RespondDel(
+    const std::vector<std::shared_ptr<client::YBRedisWriteOp>>& operations,
+    const std::vector<Status>& statuses,
+    RedisResponsePB* response) {
+  RETURN_NOT_OK(MultiKeyError(operations, statuses));
+  int64_t num_deleted = 0;
+  for (const auto& operation : operations) {
+    num_deleted += operation->response().int_response();
+  }
+  response->set_int_response(num_deleted);
+  return Status::OK();
+}
+
 #define READ_COMMAND(cname) \
     Command<yb::client::YBRedisReadOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
 #define WRITE_COMMAND(cname) \
     Command<yb::client::YBRedisWriteOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
+#define MREAD_COMMAND(cname) \
+    MultiKeyCommand<yb::client::YBRedisReadOp>( \
+        info, idx, &BOOST_PP_CAT(Parse, cname), &BOOST_PP_CAT(Respond, cname), context)
+#define MWRITE_COMMAND(cname) \
+    MultiKeyCommand<yb::client::YBRedisWriteOp>( \
+        info, idx, &BOOST_PP_CAT(Parse, cname), &BOOST_PP_CAT(Respond, cname), context)
 #define LOCAL_COMMAND(cname) \
     BOOST_PP_CAT(Handle, cname)({info, idx, context});
 #define CLUSTER_COMMAND(cname) ClusterCommand(info, idx, context)
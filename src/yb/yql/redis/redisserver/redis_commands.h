@@ -35,6 +35,8 @@ namespace redisserver {
 
 typedef boost::function<void(const Status&)> StatusFunctor;
 typedef boost::function<void(int i)> IntFunctor;
+// Invoked with the status of every operation of a multi-key command, in the key order.
+typedef std::function<void(const std::vector<Status>&)> MultiKeyCallback;
 
 class RedisConnectionContext;
 
@@ -105,6 +107,21 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
       const rpc::RpcMethodMetrics& metrics,
       ManualResponse manual_response) = 0;
 
+  // Applies the per key operations of a multi-key command. Each operation is grouped with the
+  // other operations of the batch that belong to the same tablet. The command is not responded
+  // automatically, callback is invoked once all the operations are done.
+  virtual void Apply(
+      size_t index,
+      const std::vector<std::shared_ptr<client::YBRedisReadOp>>& operations,
+      const rpc::RpcMethodMetrics& metrics,
+      MultiKeyCallback callback) = 0;
+
+  virtual void Apply(
+      size_t index,
+      const std::vector<std::shared_ptr<client::YBRedisWriteOp>>& operations,
+      const rpc::RpcMethodMetrics& metrics,
+      MultiKeyCallback callback) = 0;
+
   virtual ~BatchContext() {}
 };
 
@@ -145,13 +145,15 @@ CHECKED_STATUS ParseSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// TODO: support MSET
+// Parses a single key of MSET, i.e. MSET <KEY> <VALUE>. The command is split into a SET operation
+// per key.
 CHECKED_STATUS ParseMSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
-  if (args.size() < 3 || args.size() % 2 == 0) {
+  if (args.size() != 3) {
     return STATUS_SUBSTITUTE(InvalidCommand,
-        "An MSET request must have at least 3, odd number of arguments, found $0", args.size());
+        "Each key of an MSET request must be followed by exactly one value, found $0 arguments "
+        "for the key", args.size() - 1);
   }
-  return STATUS(InvalidCommand, "MSET command not yet supported");
+  return ParseSet(op, args);
 }
 
 CHECKED_STATUS ParseHSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
@@ -518,9 +520,9 @@ CHECKED_STATUS ParseHGetLikeCommands(YBRedisReadOp* op, const RedisClientCommand
   return ParseCollection(op, args, boost::none, add_string_subkey, remove_duplicates);
 }
 
-// TODO: Support MGET
+// Parses a single key of MGET, i.e. MGET <KEY>. The command is split into a GET operation per key.
 CHECKED_STATUS ParseMGet(YBRedisReadOp* op, const RedisClientCommand& args) {
-  return STATUS(InvalidCommand, "MGET command not yet supported");
+  return ParseGet(op, args);
 }
 
 CHECKED_STATUS ParseHGet(YBRedisReadOp* op, const RedisClientCommand& args) {
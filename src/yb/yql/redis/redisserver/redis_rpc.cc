@@ -38,8 +38,6 @@ using namespace std::literals;
 using namespace std::placeholders;
 using namespace yb::size_literals;
 
-DECLARE_bool(rpc_dump_all_traces);
-DECLARE_int32(rpc_slow_query_threshold_ms);
 DEFINE_uint64(redis_max_concurrent_commands, 1,
               "Max number of redis commands received from single connection, "
               "that could be processed concurrently");
@@ -276,8 +274,9 @@ void RedisInboundCall::LogTrace() const {
   MonoTime now = MonoTime::Now();
   auto total_time = now.GetDeltaSince(timing_.time_received).ToMilliseconds();
 
-  if (PREDICT_FALSE(FLAGS_rpc_dump_all_traces || total_time > FLAGS_rpc_slow_query_threshold_ms)) {
-    LOG(WARNING) << ToString() << " took " << total_time << "ms. Details:";
+  if (PREDICT_FALSE(ShouldLogSlowQuery(total_time))) {
+    LOG(WARNING) << ToString() << " took " << total_time << "ms." << StageBreakdown()
+                 << " Details:";
     rpc::RpcCallInProgressPB call_in_progress_pb;
     GetCallDetails(&call_in_progress_pb);
     LOG(WARNING) << call_in_progress_pb.DebugString() << "Trace: ";
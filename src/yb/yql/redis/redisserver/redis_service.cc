@@ -160,19 +160,45 @@ OperationType Opposite(OperationType type) {
   FATAL_INVALID_ENUM_VALUE(OperationType, type);
 }
 
+// Collects the statuses of the per key operations of a multi-key command.
+class MultiKeyOperations {
+ public:
+  MultiKeyOperations(size_t num_operations, MultiKeyCallback callback)
+      : statuses_(num_operations), operations_left_(num_operations),
+        callback_(std::move(callback)) {}
+
+  void Done(size_t operation_index, const Status& status) {
+    statuses_[operation_index] = status;
+    if (operations_left_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      callback_(statuses_);
+    }
+  }
+
+ private:
+  std::vector<Status> statuses_;
+  std::atomic<size_t> operations_left_;
+  MultiKeyCallback callback_;
+};
+
+typedef std::shared_ptr<MultiKeyOperations> MultiKeyOperationsPtr;
+
 class Operation {
  public:
   template <class Op>
   Operation(const std::shared_ptr<RedisInboundCall>& call,
             size_t index,
             std::shared_ptr<Op> operation,
-            const rpc::RpcMethodMetrics& metrics)
+            const rpc::RpcMethodMetrics& metrics,
+            MultiKeyOperationsPtr multi_key = nullptr,
+            size_t multi_key_index = 0)
     : type_(std::is_same<Op, YBRedisReadOp>::value ? OperationType::kRead : OperationType::kWrite),
       call_(call),
       index_(index),
       operation_(std::move(operation)),
       metrics_(metrics),
-      manual_response_(ManualResponse::kFalse) {
+      manual_response_(ManualResponse::kFalse),
+      multi_key_(std::move(multi_key)),
+      multi_key_index_(multi_key_index) {
     auto status = operation_->GetPartitionKey(&partition_key_);
     if (!status.ok()) {
       Respond(status);
@@ -293,6 +319,14 @@ class Operation {
   }
 
   void Respond(const Status& status) {
+    if (multi_key_) {
+      // The command is responded once all its operations are done, so each operation should be
+      // counted once.
+      if (!responded_.exchange(true, std::memory_order_acq_rel)) {
+        multi_key_->Done(multi_key_index_, status);
+      }
+      return;
+    }
     responded_.store(true, std::memory_order_release);
     if (manual_response_) {
       return;
@@ -326,6 +360,9 @@ class Operation {
   std::string partition_key_;
   rpc::RpcMethodMetrics metrics_;
   ManualResponse manual_response_;
+  // Set when this is one of the per key operations of a multi-key command.
+  MultiKeyOperationsPtr multi_key_;
+  size_t multi_key_index_;
   client::internal::RemoteTabletPtr tablet_;
   std::atomic<bool> responded_{false};
 };
@@ -908,6 +945,22 @@ class BatchContextImpl : public BatchContext {
     DoApply(index, std::move(functor), std::move(partition_key), metrics, manual_response);
   }
 
+  void Apply(
+      size_t index,
+      const std::vector<std::shared_ptr<client::YBRedisReadOp>>& operations,
+      const rpc::RpcMethodMetrics& metrics,
+      MultiKeyCallback callback) override {
+    DoApplyMultiKey(index, operations, metrics, std::move(callback));
+  }
+
+  void Apply(
+      size_t index,
+      const std::vector<std::shared_ptr<client::YBRedisWriteOp>>& operations,
+      const rpc::RpcMethodMetrics& metrics,
+      MultiKeyCallback callback) override {
+    DoApplyMultiKey(index, operations, metrics, std::move(callback));
+  }
+
   std::string ToString() const {
     return Format("{ tablets: $0 }", tablets_);
   }
@@ -923,6 +976,18 @@ class BatchContextImpl : public BatchContext {
     }
   }
 
+  template <class Op>
+  void DoApplyMultiKey(
+      size_t index,
+      const std::vector<std::shared_ptr<Op>>& operations,
+      const rpc::RpcMethodMetrics& metrics,
+      MultiKeyCallback callback) {
+    auto multi_key = std::make_shared<MultiKeyOperations>(operations.size(), std::move(callback));
+    for (size_t i = 0; i != operations.size(); ++i) {
+      DoApply(index, operations[i], metrics, multi_key, i);
+    }
+  }
+
   void LookupDone(
       Operation* operation, int retries, const Result<client::internal::RemoteTabletPtr>& result) {
     const int kMaxRetries = 2;
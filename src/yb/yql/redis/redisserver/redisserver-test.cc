@@ -4496,6 +4496,48 @@ TEST_F(TestRedisService, TestDel) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestMultiKeyCommands) {
+  // Enough keys to have several of them in every tablet.
+  constexpr int kNumKeys = 50;
+  std::vector<std::string> mset = {"MSET"};
+  std::vector<std::string> mget = {"MGET"};
+  std::vector<std::string> del = {"DEL"};
+  std::vector<std::string> expected;
+  for (int i = 0; i < kNumKeys; ++i) {
+    mset.push_back(Format("key_$0", i));
+    mset.push_back(Format("value_$0", i));
+    mget.push_back(Format("key_$0", i));
+    if (i % 2 == 0) {
+      del.push_back(Format("key_$0", i));
+    }
+    expected.push_back(Format("value_$0", i));
+  }
+  DoRedisTestOk(__LINE__, mset);
+  SyncClient();
+  DoRedisTestArray(__LINE__, mget, expected);
+  SyncClient();
+
+  // Missing keys and keys that do not hold a string return nil, in the key order.
+  DoRedisTestOk(__LINE__, {"HSET", "map_key", "subkey", "value"});
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"MGET", "key_1", "map_key", "missing_key", "key_2"},
+                   {"value_1", "", "", "value_2"});
+  SyncClient();
+
+  DoRedisTestInt(__LINE__, del, kNumKeys / 2);
+  SyncClient();
+  for (int i = 0; i < kNumKeys; ++i) {
+    if (i % 2 == 0) {
+      expected[i] = "";
+    }
+  }
+  DoRedisTestArray(__LINE__, mget, expected);
+  DoRedisTestInt(__LINE__, {"DEL", "key_0", "key_1", "map_key"}, 2);
+  DoRedisTestExpectError(__LINE__, {"MSET", "key_0", "value", "key_1"});
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestHDel) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;